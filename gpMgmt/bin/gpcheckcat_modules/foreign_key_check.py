@@ -65,7 +65,8 @@ class ForeignKeyCheck:
         # skip these master-only tables
         skipped_masteronly = ['gp_relation_node', 'pg_description',
                               'pg_shdescription', 'pg_stat_last_operation',
-                              'pg_stat_last_shoperation', 'pg_statistic']
+                              'pg_stat_last_shoperation', 'pg_statistic',
+                              'pg_statistic_multicol']
 
         if catname in skipped_masteronly:
             return
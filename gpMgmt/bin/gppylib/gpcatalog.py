@@ -31,6 +31,7 @@ MASTER_ONLY_TABLES = [
     'pg_stat_last_operation',
     'pg_stat_last_shoperation',
     'pg_statistic',
+    'pg_statistic_multicol',
     'pg_partition_encoding',
     ]
 
@@ -40,6 +41,7 @@ SEGMENT_LOCAL_TABLES = [
     'pg_shdepend', # (not if we fix oid inconsistencies)
     'gp_fastsequence', # AO segment row id allocations
     'pg_statistic',
+    'pg_statistic_multicol',
     ]
 
 # These catalog tables either do not use pg_depend or does not create an
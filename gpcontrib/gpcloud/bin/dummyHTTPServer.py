@@ -6,6 +6,8 @@ Usage::
     ./dummyHTTPServer.py [<port>]
 Send a GET request::
     curl http://localhost
+Send a GET request for a body of 1024 bytes::
+    curl http://localhost/?size=1024
 Send a HEAD request::
     curl -I http://localhost
 Send a POST request::
@@ -18,6 +20,7 @@ import getopt
 import sys
 import os
 import ssl
+import urlparse
 
 help_msg = '''./dummyHTTPServer.py 
 [-h] | [-p (--port=) <port>][-f (--filename=) <filename>][-s][-t(--type=)<S|PARAM_S>]
@@ -38,6 +41,12 @@ class S(BaseHTTPRequestHandler):
         self.end_headers()
 
     def do_GET(self):
+        query = urlparse.parse_qs(urlparse.urlparse(self.path).query)
+        if 'size' in query:
+            size = int(query['size'][0])
+            self._set_headers(size)
+            self.wfile.write('x' * size)
+            return
         self._set_headers(11)
         self.wfile.write('Pong to GET')
 
@@ -103,6 +112,9 @@ class PARAM_S(BaseHTTPRequestHandler):
 def run(server_class=HTTPServer, handler_class=S, port=8553, https=False):
     server_address = ('', port)
     handler_class.protocol_version = 'HTTP/1.1'
+    # responses are written in several pieces, without TCP_NODELAY a kept-alive
+    # connection waits for the delayed ACK of the client between them
+    handler_class.disable_nagle_algorithm = True
     httpd = server_class(server_address, handler_class)
     if https:
         datadir = os.getcwd()
@@ -143,7 +155,7 @@ if __name__ == "__main__":
         elif opt in ("-t", "--type"):
             servertype = arg
     if servertype == "Common_Server":
-        run(handler_class=S, port=port)
+        run(handler_class=S, port=port, https=use_ssl)
     else:
         run(handler_class=PARAM_S, port=port, https=use_ssl)
 
@@ -142,14 +142,22 @@ static void printTemplate() {
         "accessid = \"aws access id\"\n"
         "threadnum = 4\n"
         "chunksize = 67108864\n"
+        "adaptive_download = true\n"
+        "key_split_size = 0\n"
         "low_speed_limit = 10240\n"
         "low_speed_time = 60\n"
+        "connection_idle_time = 15\n"
         "encryption = true\n"
         "version = 1\n"
         "proxy = \"\"\n"
         "autocompress = true\n"
+        "compression = gzip\n"
+        "compress_threads = 1\n"
         "verifycert = true\n"
         "server_side_encryption = \"\"\n"
+        "key_distribution = size\n"
+        "share_listing = false\n"
+        "shared_listing_dir = \"\"\n"
         "# gpcheckcloud config\n"
         "gpcheckcloud_newline = \"\\n\"\n");
 }
@@ -1,6 +1,8 @@
 #ifndef INCLUDE_COMPRESS_WRITER_H_
 #define INCLUDE_COMPRESS_WRITER_H_
 
+#include <deque>
+
 #include "s3common_headers.h"
 #include "s3exception.h"
 #include "s3macros.h"
@@ -9,6 +11,22 @@
 // 2MB by default
 extern uint64_t S3_ZIP_COMPRESS_CHUNKSIZE;
 
+// A block of the input compressed by one of the workers, see CompressWriter::compressBlock().
+struct CompressBlock {
+    vector<char> in;
+    vector<char> out;  // raw deflate data, ends on a byte boundary
+    uLong crc;         // crc32 of in
+    bool last;         // whether the block ends the deflate stream
+    int status;        // zlib status of the compression
+    bool done;         // set by the worker, protected by CompressWriter::mutex
+};
+
+// With compressThreads > 1, the input is cut into blocks of S3_ZIP_COMPRESS_CHUNKSIZE bytes
+// compressed in parallel, like pigz does. The blocks are written in order as one gzip member, the
+// crc32 of the member is combined from the ones of the blocks.
+//
+// The blocks are compressed by compressThreads workers started by open(), which take them from a
+// queue and are stopped when the writer is closed.
 class CompressWriter : public Writer {
    public:
     CompressWriter();
@@ -30,8 +48,32 @@ class CompressWriter : public Writer {
     void flush();
     uint64_t writeOneChunk(const char *buf, uint64_t count);
 
+    static void *CompressThreadFunc(void *data);
+    static void compressBlock(CompressBlock *block);
+    void startWorkers();
+    void stopWorkers();
+    void submitBlock(bool last);
+    void writeFirstBlock();
+    void discardBlocks();
+    void closeBlocks();
+
     Writer *writer;
 
+    // Parallel compression, used when compressThreads > 1.
+    uint64_t compressThreads;
+    vector<char> blockData;               // input of the next block
+    std::deque<CompressBlock *> blocks;  // blocks being compressed, in input order
+    uLong crc;                            // crc32 of the blocks written so far
+    uint64_t totalIn;                     // size of the blocks written so far
+
+    // Compression workers, blocks and queue are protected by mutex.
+    vector<pthread_t> workers;
+    std::deque<CompressBlock *> queue;  // blocks not taken by a worker yet
+    bool stopping;                      // tells the workers to exit
+    pthread_mutex_t mutex;
+    pthread_cond_t queueReady;  // a block was queued or the workers are stopping
+    pthread_cond_t blockDone;   // a worker compressed a block
+
     // zlib related variables.
     z_stream zstream;
     char *out;  // Output buffer for compression.
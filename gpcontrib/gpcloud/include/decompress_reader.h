@@ -10,6 +10,9 @@
 // 2MB by default
 extern uint64_t S3_ZIP_DECOMPRESS_CHUNKSIZE;
 
+// DecompressReader inflates gzip and zlib streams, including files made of several concatenated
+// gzip members. A thread decompresses the next chunk of data while read() returns the current one.
+// If the upstream reader can lease its buffers, the compressed data is inflated in place.
 class DecompressReader : public Reader {
    public:
     DecompressReader();
@@ -29,19 +32,40 @@ class DecompressReader : public Reader {
     void resizeDecompressReaderBuffer(uint64_t size);
 
    private:
-    void decompress();
+    static void *DecompressThreadFunc(void *data);
+    void decompressChunks();
+    void stopDecompressThread();
 
-    uint64_t getDecompressedBytesNum() {
-        return S3_ZIP_DECOMPRESS_CHUNKSIZE - this->zstream.avail_out;
-    }
+    // Decompress the next part of the stream into buf, return its size.
+    uint64_t decompress(char *buf);
+    uint64_t readInput(const char **data);
 
     Reader *reader;
+    bool leasing;  // Whether the compressed data is inflated in the buffers of reader.
 
     // zlib related variables.
     z_stream zstream;
     char *in;            // Input buffer for decompression.
     char *out;           // Output buffer for decompression.
+    uint64_t outSize;    // Size of the data in out buffer.
     uint64_t outOffset;  // Next position to read in out buffer.
+    bool eof;            // Whether out buffer holds the last data.
+
+    // Used by the decompression thread only.
+    uint64_t members;  // Number of gzip members decompressed.
+    bool memberEnded;  // Whether the next data starts a new member.
+    bool finished;     // Whether there is no more data to decompress.
+
+    // The decompression thread fills nextOut while read() consumes out.
+    pthread_t thread;
+    bool threadStarted;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    char *nextOut;
+    uint64_t nextOutSize;
+    bool nextOutReady;  // Whether nextOut is filled, protected by mutex.
+    bool stopping;      // Whether close() asks the thread to stop, protected by mutex.
+    std::exception_ptr sharedException;
 
     bool isClosed;
 };
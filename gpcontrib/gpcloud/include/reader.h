@@ -2,6 +2,8 @@
 #define __S3_READER_H__
 
 #include "s3common_headers.h"
+#include "s3exception.h"
+#include "s3macros.h"
 #include "s3params.h"
 
 class Reader {
@@ -16,6 +18,21 @@ class Reader {
     // errors.
     virtual uint64_t read(char *buf, uint64_t count) = 0;
 
+    // Readers keeping the data in their own buffers can hand out read-only views of them, so that
+    // the data is used in place instead of being copied by read().
+    virtual bool canLease() {
+        return false;
+    }
+
+    // lease() points data at the next data and returns its size, 0 if EOF. The data stays valid
+    // until release(), which must be called before the next lease(), read() or close().
+    virtual uint64_t lease(const char **data) {
+        S3_DIE(S3RuntimeError, "lease() is not supported by this reader");
+    }
+
+    virtual void release() {
+    }
+
     // This should be reentrant, has no side effects when called multiple times.
     virtual void close() = 0;
 };
@@ -5,6 +5,15 @@
 #include "s3common_headers.h"
 #include "s3exception.h"
 #include "s3interface.h"
+#include "s3key_lister.h"
+
+// A byte range [begin, end) of a key. The range holds the lines that start in it, a line starting
+// before begin belongs to the previous range, the last line may end after end.
+struct KeyRange {
+    uint64_t keyIndex;  // index of the key in ListBucketResult::contents
+    uint64_t begin;
+    uint64_t end;
+};
 
 // S3BucketReader read multiple files in a bucket.
 class S3BucketReader : public Reader {
@@ -25,6 +34,8 @@ class S3BucketReader : public Reader {
     }
 
     const ListBucketResult &getKeyList() {
+        while (this->addNextKey()) {
+        }
         return keyList;
     }
 
@@ -45,10 +56,43 @@ class S3BucketReader : public Reader {
     // copy valid data into buf and return its size.
     uint64_t readWithoutHeaderLine(char *buf, uint64_t count);
 
+    // Skip data until the given line terminator, copy the data after it into buf and return its
+    // size.
+    uint64_t readAfterLineEnd(char *buf, uint64_t count, const char *lineEnd);
+
+    // Cut the data read from the current range after the line the range ends in.
+    uint64_t trimToRange(char *buf, uint64_t count);
+    uint64_t trimAfterSkippedLine(char *buf, uint64_t count);
+
     ListBucketResult keyList;  // List of matched keys/files.
-    uint64_t keyIndex;         // BucketContent index of keylist->contents.
 
-    BucketContent &getNextKey();
+    // With KEY_DISTRIBUTION_INDEX, the ranges of a key are assigned as soon as the key is listed.
+    S3KeyLister keyLister;
+    bool keyListing;        // Whether keyLister has more keys.
+    uint64_t listedRanges;  // Number of ranges of the keys listed so far.
+
+    vector<KeyRange> segmentRanges;  // Ranges of keys this segment reads.
+    uint64_t keyIndex;               // Index in segmentRanges of the next range to read.
+
+    uint64_t keyPos;      // Offset in the current key of the next byte from upstreamReader.
+    uint64_t rangeEnd;    // End of the current range, UINT64_MAX if it is the end of the key.
+    bool rangeFinished;   // Whether the last line of the current range has been read.
+
+    // List the keys, or read the listing shared by another segment of the query on this host.
+    void listKeys(S3Url &s3Url);
+    bool readSharedListing(const string &path);
+    void writeSharedListing(const string &path);
+    void removeStaleListings();
+
+    // Take the next key from keyLister and add its ranges of this segment, return false after the
+    // last key.
+    bool addNextKey();
+
+    void splitKey(uint64_t keyIndex, vector<KeyRange> &ranges);
+    void assignRangesBySize(const vector<KeyRange> &ranges);
+
+    bool hasNextRange();
+    const KeyRange &getNextRange();
     S3Params constructReaderParams(BucketContent &key);
 };
 
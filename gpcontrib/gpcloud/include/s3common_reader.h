@@ -5,6 +5,7 @@
 #include "s3common_headers.h"
 #include "s3exception.h"
 #include "s3key_reader.h"
+#include "zstd_decompress_reader.h"
 
 class S3CommonReader : public Reader {
    public:
@@ -34,6 +35,9 @@ class S3CommonReader : public Reader {
     S3Interface* s3InterfaceService;
     S3KeyReader keyReader;
     DecompressReader decompressReader;
+#ifdef HAVE_LIBZSTD
+    ZstdDecompressReader zstdDecompressReader;
+#endif
 };
 
 #endif /* INCLUDE_S3COMMON_READER_H_ */
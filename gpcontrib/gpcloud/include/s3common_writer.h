@@ -5,6 +5,7 @@
 #include "s3common_headers.h"
 #include "s3key_writer.h"
 #include "s3url.h"
+#include "zstd_compress_writer.h"
 
 class S3CommonWriter : public Writer {
    public:
@@ -35,6 +36,9 @@ class S3CommonWriter : public Writer {
     S3Interface* s3InterfaceService;
     S3KeyWriter keyWriter;
     CompressWriter compressWriter;
+#ifdef HAVE_LIBZSTD
+    ZstdCompressWriter zstdCompressWriter;
+#endif
 };
 
 #endif
@@ -48,6 +48,18 @@ class S3ConnectionError : public S3Exception {
     string message;
 };
 
+// 503 Slow Down or Service Unavailable, the server asks for fewer requests
+class S3SlowDownError : public S3ConnectionError {
+   public:
+    S3SlowDownError(const string& msg) : S3ConnectionError(msg) {
+    }
+    virtual ~S3SlowDownError() {
+    }
+    virtual string getType() {
+        return "S3SlowDownError";
+    }
+};
+
 class S3ResolveError : public S3Exception {
    public:
     S3ResolveError(const string& msg) : message(msg) {
@@ -15,12 +15,6 @@
 
 #define S3_RANGE_HEADER_STRING_LEN 128
 
-enum S3CompressionType {
-    S3_COMPRESSION_GZIP,
-    S3_COMPRESSION_PLAIN,
-    S3_COMPRESSION_DEFLATE,
-};
-
 struct BucketContent {
     BucketContent() : name(""), size(0) {
     }
@@ -55,6 +49,10 @@ class S3Interface {
 
     virtual ListBucketResult listBucket(S3Url &s3Url) = 0;
 
+    // List the keys after marker, a page at a time, and append them to result. marker is set to
+    // where the next page starts, or to "" after the last page.
+    virtual void listBucketPage(const S3Url &s3Url, string &marker, ListBucketResult &result) = 0;
+
     virtual uint64_t fetchData(uint64_t offset, S3VectorUInt8 &data, uint64_t len,
                                const S3Url &s3Url) = 0;
 
@@ -71,6 +69,11 @@ class S3Interface {
                                    const vector<string> &etagArray) = 0;
 
     virtual bool abortUpload(const S3Url &s3Url, const string &uploadId) = 0;
+
+    // Number of GET requests the server has answered with 503 Slow Down so far.
+    virtual uint64_t getSlowDownCount() {
+        return 0;
+    }
 };
 
 class S3InterfaceService : public S3Interface {
@@ -81,12 +84,18 @@ class S3InterfaceService : public S3Interface {
 
     ListBucketResult listBucket(S3Url &s3Url);
 
+    void listBucketPage(const S3Url &s3Url, string &marker, ListBucketResult &result);
+
     uint64_t fetchData(uint64_t offset, S3VectorUInt8 &data, uint64_t len, const S3Url &s3Url);
 
     S3CompressionType checkCompressionType(const S3Url &s3Url);
 
     bool checkKeyExistence(const S3Url &s3Url);
 
+    uint64_t getSlowDownCount() {
+        return __sync_add_and_fetch(&this->slowDowns, 0);
+    }
+
     void setRESTfulService(RESTfulService *restfullService) {
         this->restfulService = restfullService;
     }
@@ -130,6 +139,8 @@ class S3InterfaceService : public S3Interface {
    private:
     RESTfulService *restfulService;
     S3Params params;
+
+    uint64_t slowDowns;  // shared by the download threads
 };
 
 #endif /* INCLUDE_S3INTERFACE_H_ */
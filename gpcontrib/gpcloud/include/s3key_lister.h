@@ -0,0 +1,54 @@
+#ifndef INCLUDE_S3KEY_LISTER_H_
+#define INCLUDE_S3KEY_LISTER_H_
+
+#include <deque>
+
+#include "s3common_headers.h"
+#include "s3exception.h"
+#include "s3interface.h"
+
+// S3KeyLister lists the keys of a bucket page by page in a background thread, the keys of a page
+// are available as soon as it is parsed, while the next pages are still being listed.
+class S3KeyLister {
+   public:
+    S3KeyLister();
+    virtual ~S3KeyLister();
+
+    // Start listing the keys under the prefix of s3Url.
+    void open(const S3Url& s3Url);
+
+    // Wait for the next key, return false after the last one. Errors of the listing thread are
+    // rethrown here.
+    bool next(BucketContent& key);
+
+    // Stop listing after the current page and wait for the thread.
+    void close();
+
+    void setS3InterfaceService(S3Interface* s3) {
+        this->s3Interface = s3;
+    }
+
+   private:
+    static void* ListThreadFunc(void* data);
+    void listKeys();
+
+    S3Interface* s3Interface;
+    S3Url s3Url;
+
+    pthread_t thread;
+    bool threadStarted;
+
+    // protects all the fields below
+    pthread_mutex_t mutex;
+    pthread_cond_t keysReady;
+
+    std::deque<BucketContent> keys;
+    bool finished;  // no more keys will be added
+    bool stopping;  // close() asks the thread to stop
+    uint64_t requests;
+
+    // exception of the listing thread, rethrown by next()
+    std::exception_ptr sharedException;
+};
+
+#endif /* INCLUDE_S3KEY_LISTER_H_ */
@@ -59,6 +59,63 @@ class OffsetMgr {
     uint64_t curPos;
 };
 
+// Chunks smaller than this are not worth a request of their own when the chunk size is adapted to
+// the key.
+#define S3_MIN_ADAPTIVE_CHUNKSIZE (8 * 1024 * 1024)
+
+// A chunk downloading at this fraction of the best rate of a connection so far means another
+// connection would add throughput.
+#define S3_ADAPTIVE_RATE_THRESHOLD 0.8
+
+// DownloadLimiter starts the downloads of the chunks of a key in the order of their offsets, with
+// at most limit of them at a time. When adaptive, the limit grows by one while the rate of each
+// connection holds, and is halved when the server asks to slow down. It also collects the
+// bandwidth statistics of the key.
+class DownloadLimiter {
+   public:
+    DownloadLimiter();
+    ~DownloadLimiter();
+
+    void reset(uint64_t maxDownloads, bool adaptive);
+
+    // Wait for the chunk to be the next one and for a free download slot, return false if the
+    // limiter is stopped.
+    bool acquire(uint64_t chunkIndex);
+
+    // Free the slot of a download of len bytes that took seconds, the slow down counts of the
+    // S3Interface before and after it tell whether the server asked to slow down meanwhile.
+    void release(uint64_t len, double seconds, uint64_t slowDownsBefore, uint64_t slowDownsAfter);
+
+    // Wake up all the chunks waiting for a slot, acquire() fails from now on.
+    void stop();
+
+    void logStats(const string& keyUrl);
+
+    uint64_t getLimit();
+    uint64_t getPeakDownloads();
+
+   private:
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    bool adaptive;
+    bool stopped;
+    uint64_t maxDownloads;
+    uint64_t limit;
+    uint64_t activeDownloads;
+    uint64_t startedChunks;
+    double bestRate;  // bytes per second of a connection
+
+    struct timeval startTime;
+    struct timeval endTime;  // when the last download finished
+    uint64_t downloads;
+    uint64_t downloadedBytes;
+    double downloadSeconds;  // sum of the time of all downloads
+    uint64_t peakDownloads;
+    uint64_t slowDowns;         // slow down events, 503s seen by concurrent downloads count once
+    uint64_t lastSlowDownSeen;  // slow down count of the S3Interface when the limit was last halved
+};
+
 enum ChunkStatus {
     ReadyToRead,
     ReadyToFill,
@@ -72,8 +129,14 @@ class S3KeyReader : public Reader {
         : sharedError(false),
           numOfChunks(0),
           curReadingChunk(0),
+          keyOffset(0),
           transferredKeyLen(0),
           s3Interface(NULL),
+          viewData(NULL),
+          viewLen(0),
+          viewOffset(0),
+          leasedChunk(NULL),
+          appendEol(true),
           hasEol(false),
           eolAppended(false) {
         pthread_mutex_init(&this->mutexErrorMessage, NULL);
@@ -87,6 +150,13 @@ class S3KeyReader : public Reader {
     uint64_t read(char* buf, uint64_t count);
     void close();
 
+    // The views are the downloaded chunks, read() copies from them too.
+    bool canLease() {
+        return true;
+    }
+    uint64_t lease(const char** data);
+    void release();
+
     void setS3InterfaceService(S3Interface* s3) {
         this->s3Interface = s3;
     }
@@ -132,6 +202,10 @@ class S3KeyReader : public Reader {
         return transferredKeyLen;
     }
 
+    uint64_t getKeyOffset() const {
+        return keyOffset;
+    }
+
     OffsetMgr& getOffsetMgr() {
         return offsetMgr;
     }
@@ -140,6 +214,15 @@ class S3KeyReader : public Reader {
         return region;
     }
 
+    DownloadLimiter& getDownloadLimiter() {
+        return downloadLimiter;
+    }
+
+    // A line terminator is appended to a key not ending with one, unless it is compressed data.
+    void setAppendEol(bool appendEol) {
+        this->appendEol = appendEol;
+    }
+
    private:
     pthread_mutex_t mutexErrorMessage;
 
@@ -151,17 +234,30 @@ class S3KeyReader : public Reader {
 
     uint64_t numOfChunks;
     uint64_t curReadingChunk;
+    uint64_t keyOffset;  // offset in the key the reading starts at
     uint64_t transferredKeyLen;
     string region;
+    string keyUrl;
     OffsetMgr offsetMgr;
+    DownloadLimiter downloadLimiter;
 
     vector<ChunkBuffer> chunkBuffers;
     vector<pthread_t> threads;
 
     S3Interface* s3Interface;
 
+    // The chunk data read() and lease() are working on.
+    const char* viewData;
+    uint64_t viewLen;
+    uint64_t viewOffset;       // size of the data of the view already handed out
+    ChunkBuffer* leasedChunk;  // chunk of the view, NULL for the EOL or after releaseView()
+
+    uint64_t nextView();
+    void releaseView();
+
     void reset();
 
+    bool appendEol;
     bool hasEol;
     bool eolAppended;
 };
@@ -186,7 +282,11 @@ class ChunkBuffer {
         return this->sharedKeyReader.isSharedError();
     }
 
-    uint64_t read(char* buf, uint64_t len);
+    // Wait for the chunk to be filled, point data at it and return its size. The chunk is not
+    // refilled until release().
+    uint64_t lease(const char** data);
+    void release();
+
     uint64_t fill();
 
     void setS3InterfaceService(S3Interface* s3) {
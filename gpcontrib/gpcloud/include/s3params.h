@@ -7,21 +7,42 @@
 
 enum S3SSEType { SSE_NONE, SSE_S3 };
 
+enum S3CompressionType {
+    S3_COMPRESSION_GZIP,
+    S3_COMPRESSION_PLAIN,
+    S3_COMPRESSION_DEFLATE,
+    S3_COMPRESSION_ZSTD,
+};
+
+// How the keys of a bucket are spread over the segments. KEY_DISTRIBUTION_INDEX hands out keys
+// round-robin by their position in the listing, KEY_DISTRIBUTION_SIZE balances the number of bytes
+// each segment reads.
+enum S3KeyDistribution { KEY_DISTRIBUTION_INDEX, KEY_DISTRIBUTION_SIZE };
+
 class S3Params {
    public:
     S3Params(const string& sourceUrl = "", bool useHttps = true, const string& version = "",
              const string& region = "")
         : s3Url(sourceUrl, useHttps, version, region),
           keySize(0),
+          keyOffset(0),
+          keySplitSize(0),
           chunkSize(0),
           numOfChunks(0),
+          adaptiveDownload(false),
+          compressThreads(1),
           lowSpeedLimit(0),
           lowSpeedTime(0),
+          connectionIdleTime(0),
           proxy(""),
           debugCurl(false),
           autoCompress(false),
           verifyCert(false),
+          compressionType(S3_COMPRESSION_GZIP),
           sseType(SSE_NONE),
+          keyDistribution(KEY_DISTRIBUTION_SIZE),
+          listingId(""),
+          sharedListingDir(""),
           gpcheckcloud_newline("") {
     }
 
@@ -64,6 +85,22 @@ class S3Params {
         this->numOfChunks = numOfChunks;
     }
 
+    bool isAdaptiveDownload() const {
+        return adaptiveDownload;
+    }
+
+    void setAdaptiveDownload(bool adaptiveDownload) {
+        this->adaptiveDownload = adaptiveDownload;
+    }
+
+    uint64_t getCompressThreads() const {
+        return compressThreads;
+    }
+
+    void setCompressThreads(uint64_t compressThreads) {
+        this->compressThreads = compressThreads;
+    }
+
     uint64_t getKeySize() const {
         return keySize;
     }
@@ -72,6 +109,22 @@ class S3Params {
         this->keySize = size;
     }
 
+    uint64_t getKeyOffset() const {
+        return keyOffset;
+    }
+
+    void setKeyOffset(uint64_t offset) {
+        this->keyOffset = offset;
+    }
+
+    uint64_t getKeySplitSize() const {
+        return keySplitSize;
+    }
+
+    void setKeySplitSize(uint64_t keySplitSize) {
+        this->keySplitSize = keySplitSize;
+    }
+
     uint64_t getLowSpeedLimit() const {
         return lowSpeedLimit;
     }
@@ -88,6 +141,14 @@ class S3Params {
         this->lowSpeedTime = lowSpeedTime;
     }
 
+    uint64_t getConnectionIdleTime() const {
+        return connectionIdleTime;
+    }
+
+    void setConnectionIdleTime(uint64_t connectionIdleTime) {
+        this->connectionIdleTime = connectionIdleTime;
+    }
+
     bool isDebugCurl() const {
         return debugCurl;
     }
@@ -111,6 +172,14 @@ class S3Params {
         this->autoCompress = autoCompress;
     }
 
+    S3CompressionType getCompressionType() const {
+        return compressionType;
+    }
+
+    void setCompressionType(S3CompressionType compressionType) {
+        this->compressionType = compressionType;
+    }
+
     const S3MemoryContext& getMemoryContext() const {
         return memoryContext;
     }
@@ -131,6 +200,30 @@ class S3Params {
         this->sseType = sseType;
     }
 
+    S3KeyDistribution getKeyDistribution() const {
+        return keyDistribution;
+    }
+
+    void setKeyDistribution(S3KeyDistribution keyDistribution) {
+        this->keyDistribution = keyDistribution;
+    }
+
+    const string& getListingId() const {
+        return listingId;
+    }
+
+    void setListingId(const string& listingId) {
+        this->listingId = listingId;
+    }
+
+    const string& getSharedListingDir() const {
+        return sharedListingDir;
+    }
+
+    void setSharedListingDir(const string& sharedListingDir) {
+        this->sharedListingDir = sharedListingDir;
+    }
+
     const string& getProxy() const {
         return proxy;
     }
@@ -152,14 +245,23 @@ class S3Params {
 
     uint64_t keySize;  // key/file size.
 
+    uint64_t keyOffset;     // offset in the key/file to start reading at.
+    uint64_t keySplitSize;  // keys larger than this are read by several segments, 0 to disable.
+
     S3Credential cred;  // S3 credential.
 
     uint64_t chunkSize;    // chunk size
     uint64_t numOfChunks;  // number of chunks(threads).
 
+    bool adaptiveDownload;  // chunkSize and numOfChunks are upper bounds adapted to each key
+
+    uint64_t compressThreads;  // number of threads compressing data before uploading
+
     uint64_t lowSpeedLimit;  // low speed limit
     uint64_t lowSpeedTime;   // low speed timeout
 
+    uint64_t connectionIdleTime;  // seconds an idle connection is kept for reuse, 0 to disable
+
     string proxy;  // proxy
 
     bool debugCurl;     // debug curl or not
@@ -167,8 +269,15 @@ class S3Params {
     bool verifyCert;  // This option determines whether curl verifies the authenticity of the peer's
                       // certificate.
 
+    S3CompressionType compressionType;  // codec used to compress data before uploading
+
     S3SSEType sseType;
 
+    S3KeyDistribution keyDistribution;
+
+    string listingId;         // same for all segments of a query that read the same location
+    string sharedListingDir;  // where segments share listings, empty if they don't
+
     S3MemoryContext memoryContext;
 
     string gpcheckcloud_newline;  // newline LF, CRLF, CR
@@ -10,6 +10,8 @@
 #include "s3macros.h"
 #include "s3params.h"
 
+struct CURLWrapper;
+
 class S3RESTfulService : public RESTfulService {
    public:
     S3RESTfulService();
@@ -28,9 +30,26 @@ class S3RESTfulService : public RESTfulService {
     Response deleteRequest(const string& url, HTTPHeaders& headers);
 
    private:
+    friend struct CURLWrapper;
+
+    struct IdleHandle {
+        CURL* curl;
+        time_t lastUsed;
+    };
+
     uint64_t lowSpeedLimit;
     uint64_t lowSpeedTime;
 
+    // Seconds a connection may stay idle before it is closed instead of reused, 0 disables
+    // connection reuse.
+    uint64_t connectionIdleTime;
+
+    // Handles of finished requests, most recently used last. They keep their connections to the
+    // server open, so that the next request saves the TCP and TLS handshakes. Requests are issued
+    // by the download and upload threads concurrently, hence the lock.
+    vector<IdleHandle> idleHandles;
+    pthread_mutex_t idleHandlesLock;
+
     string proxy;
 
     bool debugCurl;
@@ -39,7 +58,10 @@ class S3RESTfulService : public RESTfulService {
     uint64_t chunkBufferSize;
     S3MemoryContext s3MemContext;
 
-    void performCurl(CURL* curl, Response& response);
+    CURL* acquireHandle();
+    void releaseHandle(CURL* curl, bool reusable);
+
+    void performCurl(CURLWrapper& wrapper, Response& response);
 };
 
 class S3MessageParser {
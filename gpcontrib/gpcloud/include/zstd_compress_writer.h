@@ -0,0 +1,43 @@
+#ifndef INCLUDE_ZSTD_COMPRESS_WRITER_H_
+#define INCLUDE_ZSTD_COMPRESS_WRITER_H_
+
+#ifdef HAVE_LIBZSTD
+
+#include <zstd.h>
+
+#include "s3common_headers.h"
+#include "s3exception.h"
+#include "writer.h"
+
+// ZstdCompressWriter compresses the data written into one zstd frame. With compressThreads > 1
+// the frame is compressed by zstd worker threads if the library is built with them.
+class ZstdCompressWriter : public Writer {
+   public:
+    ZstdCompressWriter();
+    virtual ~ZstdCompressWriter();
+
+    virtual void open(const S3Params &params);
+
+    // write() attempts to write up to count bytes from the buffer.
+    // Throw exception if encounters errors.
+    virtual uint64_t write(const char *buf, uint64_t count);
+
+    // This should be reentrant, has no side effects when called multiple times.
+    virtual void close();
+
+    void setWriter(Writer *writer);
+
+   private:
+    // Compress the input with the given directive, write the output to the upstream writer.
+    // Return the last result of ZSTD_compressStream2().
+    size_t compress(ZSTD_inBuffer &input, ZSTD_EndDirective mode);
+
+    Writer *writer;
+
+    ZSTD_CCtx *cctx;
+    vector<char> out;  // Output buffer for compression.
+};
+
+#endif
+
+#endif
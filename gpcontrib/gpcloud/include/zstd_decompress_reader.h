@@ -0,0 +1,45 @@
+#ifndef INCLUDE_ZSTD_DECOMPRESS_READER_H_
+#define INCLUDE_ZSTD_DECOMPRESS_READER_H_
+
+#ifdef HAVE_LIBZSTD
+
+#include <zstd.h>
+
+#include "reader.h"
+#include "s3common_headers.h"
+#include "s3exception.h"
+#include "s3params.h"
+
+// ZstdDecompressReader decompresses zstd data read from the upstream reader, the frames of files
+// made of several concatenated frames are decompressed one after another. If the upstream reader
+// can lease its buffers, the compressed data is decompressed in place.
+class ZstdDecompressReader : public Reader {
+   public:
+    ZstdDecompressReader();
+    virtual ~ZstdDecompressReader();
+
+    virtual void open(const S3Params &params);
+
+    // read() attempts to read up to count bytes into the buffer.
+    // Return 0 if EOF. Throw exception if encounters errors.
+    virtual uint64_t read(char *buf, uint64_t count);
+
+    // This should be reentrant, has no side effects when called multiple times.
+    virtual void close();
+
+    void setReader(Reader *reader);
+
+   private:
+    Reader *reader;
+    bool leasing;  // Whether the compressed data is decompressed in the buffers of reader.
+
+    ZSTD_DCtx *dctx;
+    vector<char> in;      // Input buffer for decompression.
+    ZSTD_inBuffer input;  // Data of in buffer not decompressed yet.
+    size_t hint;          // Last result of ZSTD_decompressStream(), 0 at the end of a frame.
+    bool outputPending;   // Whether zstd may have decompressed data left to flush.
+};
+
+#endif
+
+#endif
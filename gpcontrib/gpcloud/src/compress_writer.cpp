@@ -2,8 +2,15 @@
 
 uint64_t S3_ZIP_COMPRESS_CHUNKSIZE = S3_ZIP_DEFAULT_CHUNKSIZE;
 
-CompressWriter::CompressWriter() : writer(NULL), isClosed(true) {
+// gzip header without file name and time stamp, written by this OS
+static const char GZIP_HEADER[] = {0x1f, (char)0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, 0, 3};
+
+CompressWriter::CompressWriter()
+    : writer(NULL), compressThreads(1), crc(0), totalIn(0), stopping(false), isClosed(true) {
     this->out = new char[S3_ZIP_COMPRESS_CHUNKSIZE];
+    pthread_mutex_init(&this->mutex, NULL);
+    pthread_cond_init(&this->queueReady, NULL);
+    pthread_cond_init(&this->blockDone, NULL);
 }
 
 CompressWriter::~CompressWriter() {
@@ -11,10 +18,28 @@ CompressWriter::~CompressWriter() {
         this->close();
     } catch (...) {
     }
+    this->discardBlocks();
     delete this->out;
+    pthread_mutex_destroy(&this->mutex);
+    pthread_cond_destroy(&this->queueReady);
+    pthread_cond_destroy(&this->blockDone);
 }
 
 void CompressWriter::open(const S3Params& params) {
+    this->compressThreads = params.getCompressThreads();
+    if (this->compressThreads > 1) {
+        this->isClosed = false;
+        this->crc = crc32(0, Z_NULL, 0);
+        this->totalIn = 0;
+        this->blockData.clear();
+        this->blockData.reserve(S3_ZIP_COMPRESS_CHUNKSIZE);
+        this->startWorkers();
+
+        this->writer->open(params);
+        this->writer->write(GZIP_HEADER, sizeof(GZIP_HEADER));
+        return;
+    }
+
     this->zstream.zalloc = Z_NULL;
     this->zstream.zfree = Z_NULL;
     this->zstream.opaque = Z_NULL;
@@ -74,6 +99,21 @@ uint64_t CompressWriter::write(const char* buf, uint64_t count) {
         return 0;
     }
 
+    if (this->compressThreads > 1) {
+        uint64_t offset = 0;
+        while (offset < count) {
+            uint64_t len = std::min(count - offset,
+                                    S3_ZIP_COMPRESS_CHUNKSIZE - (uint64_t)this->blockData.size());
+            this->blockData.insert(this->blockData.end(), buf + offset, buf + offset + len);
+            offset += len;
+
+            if (this->blockData.size() == S3_ZIP_COMPRESS_CHUNKSIZE) {
+                this->submitBlock(false);
+            }
+        }
+        return count;
+    }
+
     uint64_t writtenLen = 0;
 
     for (uint64_t i = 0; i < (count / S3_ZIP_COMPRESS_CHUNKSIZE); i++) {
@@ -92,6 +132,11 @@ void CompressWriter::close() {
         return;
     }
 
+    if (this->compressThreads > 1) {
+        this->closeBlocks();
+        return;
+    }
+
     int status;
     do {
         status = deflate(&this->zstream, Z_FINISH);
@@ -123,3 +168,192 @@ void CompressWriter::flush() {
         this->zstream.avail_out = S3_ZIP_COMPRESS_CHUNKSIZE;
     }
 }
+
+void* CompressWriter::CompressThreadFunc(void* data) {
+    MaskThreadSignals();
+
+    CompressWriter* compressWriter = static_cast<CompressWriter*>(data);
+
+    UniqueLock lock(&compressWriter->mutex);
+    while (true) {
+        while (compressWriter->queue.empty() && !compressWriter->stopping) {
+            pthread_cond_wait(&compressWriter->queueReady, &compressWriter->mutex);
+        }
+        if (compressWriter->stopping) {
+            break;
+        }
+
+        CompressBlock* block = compressWriter->queue.front();
+        compressWriter->queue.pop_front();
+
+        pthread_mutex_unlock(&compressWriter->mutex);
+        compressBlock(block);
+        pthread_mutex_lock(&compressWriter->mutex);
+
+        block->done = true;
+        pthread_cond_broadcast(&compressWriter->blockDone);
+    }
+
+    return NULL;
+}
+
+void CompressWriter::compressBlock(CompressBlock* block) {
+    block->crc = crc32(crc32(0, Z_NULL, 0), (Byte*)block->in.data(), block->in.size());
+
+    z_stream zstream;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree = Z_NULL;
+    zstream.opaque = Z_NULL;
+
+    // raw deflate, the gzip header and trailer are written by CompressWriter
+    block->status = deflateInit2(&zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                                 Z_DEFAULT_STRATEGY);
+    if (block->status != Z_OK) {
+        return;
+    }
+
+    block->out.resize(deflateBound(&zstream, block->in.size()) + 16);
+    zstream.next_in = (Byte*)block->in.data();
+    zstream.avail_in = block->in.size();
+    zstream.next_out = (Byte*)block->out.data();
+    zstream.avail_out = block->out.size();
+
+    // Z_SYNC_FLUSH ends the block on a byte boundary without ending the stream, so that the next
+    // block can follow it. With room left in the output, the flush is complete.
+    int flush = block->last ? Z_FINISH : Z_SYNC_FLUSH;
+    bool done = false;
+    do {
+        if (zstream.avail_out == 0) {
+            uint64_t used = block->out.size();
+            block->out.resize(used * 2);
+            zstream.next_out = (Byte*)block->out.data() + used;
+            zstream.avail_out = used;
+        }
+
+        block->status = deflate(&zstream, flush);
+        done = block->last ? (block->status == Z_STREAM_END)
+                           : (block->status == Z_OK && zstream.avail_out > 0);
+    } while (!done && block->status == Z_OK);
+
+    block->out.resize(zstream.total_out);
+    deflateEnd(&zstream);
+
+    if (done) {
+        block->status = Z_OK;
+    }
+}
+
+void CompressWriter::startWorkers() {
+    if (!this->workers.empty()) {
+        return;
+    }
+
+    this->stopping = false;
+    for (uint64_t i = 0; i < this->compressThreads; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, CompressThreadFunc, this) != 0) {
+            this->stopWorkers();
+            S3_DIE(S3RuntimeError, "Failed to create compression thread");
+        }
+        this->workers.push_back(thread);
+    }
+}
+
+// The workers finish the block they are compressing, the queued ones are left as they are.
+void CompressWriter::stopWorkers() {
+    {
+        UniqueLock lock(&this->mutex);
+        this->stopping = true;
+        pthread_cond_broadcast(&this->queueReady);
+    }
+
+    for (size_t i = 0; i < this->workers.size(); i++) {
+        pthread_join(this->workers[i], NULL);
+    }
+    this->workers.clear();
+}
+
+// At most compressThreads blocks are being compressed at a time, the next one waits for the
+// first of them to be written.
+void CompressWriter::submitBlock(bool last) {
+    while (this->blocks.size() >= this->compressThreads) {
+        this->writeFirstBlock();
+    }
+
+    CompressBlock* block = new CompressBlock();
+    block->in.swap(this->blockData);
+    block->last = last;
+    block->status = Z_OK;
+    block->done = false;
+
+    {
+        UniqueLock lock(&this->mutex);
+        this->blocks.push_back(block);
+        this->queue.push_back(block);
+        pthread_cond_signal(&this->queueReady);
+    }
+
+    this->blockData.reserve(S3_ZIP_COMPRESS_CHUNKSIZE);
+}
+
+void CompressWriter::writeFirstBlock() {
+    CompressBlock* block;
+    {
+        UniqueLock lock(&this->mutex);
+        block = this->blocks.front();
+        while (!block->done) {
+            pthread_cond_wait(&this->blockDone, &this->mutex);
+        }
+        this->blocks.pop_front();
+    }
+    std::unique_ptr<CompressBlock> holder(block);
+
+    S3_CHECK_OR_DIE(block->status == Z_OK, S3RuntimeError,
+                    string("Failed to compress data: ") +
+                        std::to_string((unsigned long long)block->status));
+
+    this->crc = crc32_combine(this->crc, block->crc, block->in.size());
+    this->totalIn += block->in.size();
+
+    this->writer->write(block->out.data(), block->out.size());
+}
+
+// Stop the workers and drop the blocks, when writing failed.
+void CompressWriter::discardBlocks() {
+    this->stopWorkers();
+
+    while (!this->blocks.empty()) {
+        delete this->blocks.front();
+        this->blocks.pop_front();
+    }
+    this->queue.clear();
+}
+
+void CompressWriter::closeBlocks() {
+    // not closed again by the destructor if it fails
+    this->isClosed = true;
+
+    try {
+        this->submitBlock(true);
+        while (!this->blocks.empty()) {
+            this->writeFirstBlock();
+        }
+        this->stopWorkers();
+    } catch (...) {
+        this->discardBlocks();
+        throw;
+    }
+
+    // gzip trailer: crc32 and size of the input modulo 2^32, little endian
+    char trailer[8];
+    for (int i = 0; i < 4; i++) {
+        trailer[i] = (char)((this->crc >> (8 * i)) & 0xff);
+        trailer[4 + i] = (char)((this->totalIn >> (8 * i)) & 0xff);
+    }
+    this->writer->write(trailer, sizeof(trailer));
+
+    S3DEBUG("Compression finished: %" PRIu64 " bytes in blocks of %" PRIu64 " bytes.",
+            this->totalIn, S3_ZIP_COMPRESS_CHUNKSIZE);
+
+    this->writer->close();
+}
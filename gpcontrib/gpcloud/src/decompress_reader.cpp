@@ -4,24 +4,47 @@ uint64_t S3_ZIP_DECOMPRESS_CHUNKSIZE = S3_ZIP_DEFAULT_CHUNKSIZE;
 
 DecompressReader::DecompressReader() : isClosed(true) {
     this->reader = NULL;
+    this->leasing = false;
     this->in = new char[S3_ZIP_DECOMPRESS_CHUNKSIZE];
     this->out = new char[S3_ZIP_DECOMPRESS_CHUNKSIZE];
+    this->nextOut = new char[S3_ZIP_DECOMPRESS_CHUNKSIZE];
+    this->outSize = 0;
     this->outOffset = 0;
+    this->eof = false;
+
+    this->members = 0;
+    this->memberEnded = false;
+    this->finished = false;
+
+    this->thread = 0;
+    this->threadStarted = false;
+    this->nextOutSize = 0;
+    this->nextOutReady = false;
+    this->stopping = false;
+    pthread_mutex_init(&this->mutex, NULL);
+    pthread_cond_init(&this->cond, NULL);
 }
 
 DecompressReader::~DecompressReader() {
     this->close();
 
+    pthread_cond_destroy(&this->cond);
+    pthread_mutex_destroy(&this->mutex);
+
     delete this->in;
     delete this->out;
+    delete this->nextOut;
 }
 
 // Used for unit test to adjust buffer size
 void DecompressReader::resizeDecompressReaderBuffer(uint64_t size) {
     delete this->in;
     delete this->out;
+    delete this->nextOut;
     this->in = new char[size];
     this->out = new char[size];
+    this->nextOut = new char[size];
+    this->outSize = 0;
     this->outOffset = 0;
     this->zstream.avail_out = size;
 }
@@ -41,7 +64,17 @@ void DecompressReader::open(const S3Params &params) {
     zstream.avail_in = 0;
     zstream.avail_out = S3_ZIP_DECOMPRESS_CHUNKSIZE;
 
+    this->outSize = 0;
     this->outOffset = 0;
+    this->eof = false;
+
+    this->members = 0;
+    this->memberEnded = false;
+    this->finished = false;
+
+    this->nextOutReady = false;
+    this->stopping = false;
+    this->sharedException = std::exception_ptr();
 
     // with S3_INFLATE_WINDOWSBITS, it could recognize and decode both zlib and gzip stream.
     int ret = inflateInit2(&zstream, S3_INFLATE_WINDOWSBITS);
@@ -50,15 +83,89 @@ void DecompressReader::open(const S3Params &params) {
     this->isClosed = false;
 
     this->reader->open(params);
+    this->leasing = this->reader->canLease();
+}
+
+void *DecompressReader::DecompressThreadFunc(void *data) {
+    MaskThreadSignals();
+
+    DecompressReader *decompressReader = static_cast<DecompressReader *>(data);
+    decompressReader->decompressChunks();
+    return NULL;
+}
+
+// Fill nextOut whenever read() has taken it, until the end of the stream or an error.
+void DecompressReader::decompressChunks() {
+    while (true) {
+        {
+            UniqueLock lock(&this->mutex);
+            while (this->nextOutReady && !this->stopping) {
+                pthread_cond_wait(&this->cond, &this->mutex);
+            }
+            if (this->stopping) {
+                return;
+            }
+        }
+
+        uint64_t size = 0;
+        try {
+            do {
+                size = this->decompress(this->nextOut);
+            } while (size == 0 && !this->finished);
+        } catch (...) {
+            UniqueLock lock(&this->mutex);
+            this->sharedException = std::current_exception();
+            this->nextOutReady = true;
+            pthread_cond_signal(&this->cond);
+            return;
+        }
+
+        UniqueLock lock(&this->mutex);
+        this->nextOutSize = size;
+        this->nextOutReady = true;
+        pthread_cond_signal(&this->cond);
+
+        if (size == 0) {
+            return;
+        }
+    }
 }
 
 uint64_t DecompressReader::read(char *buf, uint64_t bufSize) {
-    uint64_t remainingOutLen = this->getDecompressedBytesNum() - this->outOffset;
+    uint64_t remainingOutLen = this->outSize - this->outOffset;
 
     if (remainingOutLen == 0) {
-        this->decompress();
+        if (this->eof) {
+            return 0;
+        }
+
+        // started by the first read, not by open(), so that tests can resize the buffers
+        if (!this->threadStarted) {
+            int ret = pthread_create(&this->thread, NULL, DecompressThreadFunc, this);
+            S3_CHECK_OR_DIE(ret == 0, S3RuntimeError, "Failed to create decompression thread");
+            this->threadStarted = true;
+        }
+
+        UniqueLock lock(&this->mutex);
+        while (!this->nextOutReady) {
+            pthread_cond_wait(&this->cond, &this->mutex);
+        }
+
+        if (this->sharedException != NULL) {
+            std::rethrow_exception(this->sharedException);
+        }
+
+        std::swap(this->out, this->nextOut);
+        this->outSize = this->nextOutSize;
         this->outOffset = 0;  // reset cursor for out buffer to read from beginning.
-        remainingOutLen = this->getDecompressedBytesNum();
+        this->nextOutReady = false;
+        pthread_cond_signal(&this->cond);
+
+        remainingOutLen = this->outSize;
+        if (remainingOutLen == 0) {
+            this->eof = true;
+            return 0;
+        }
     }
 
     uint64_t count = std::min(remainingOutLen, bufSize);
@@ -69,17 +176,15 @@ uint64_t DecompressReader::read(char *buf, uint64_t bufSize) {
     return count;
 }
 
-// Read compressed data from underlying reader and decompress to this->out buffer.
-// If no more data to consume, this->zstream.avail_out == S3_ZIP_DECOMPRESS_CHUNKSIZE;
-void DecompressReader::decompress() {
-    if (this->zstream.avail_in == 0) {
-        this->zstream.avail_out = S3_ZIP_DECOMPRESS_CHUNKSIZE;
-        this->zstream.next_out = (Byte *)this->out;
+// Read compressed data from underlying reader and decompress to buf.
+// If no more data to consume, this->finished is set and 0 is returned.
+uint64_t DecompressReader::decompress(char *buf) {
+    this->zstream.avail_out = S3_ZIP_DECOMPRESS_CHUNKSIZE;
+    this->zstream.next_out = (Byte *)buf;
 
-        // read S3_ZIP_DECOMPRESS_CHUNKSIZE data from underlying reader and put into this->in
-        // buffer. read() might happen more than once when reaching EOF, make sure every time read()
-        // will return 0.
-        uint64_t hasRead = this->reader->read(this->in, S3_ZIP_DECOMPRESS_CHUNKSIZE);
+    if (this->zstream.avail_in == 0) {
+        const char *data = NULL;
+        uint64_t hasRead = this->readInput(&data);
 
         // EOF, no more data to decompress.
         if (hasRead == 0) {
@@ -88,44 +193,97 @@ void DecompressReader::decompress() {
                 "total_out = %u",
                 zstream.avail_in, zstream.avail_out,
 		(unsigned int) zstream.total_in, (unsigned int) zstream.total_out);
-            return;
-        }
-
-        // Fill this->in as possible as it could, otherwise data in this->in might not be able to be
-        // inflated.
-        while (hasRead < S3_ZIP_DECOMPRESS_CHUNKSIZE) {
-            uint64_t count =
-                this->reader->read(this->in + hasRead, S3_ZIP_DECOMPRESS_CHUNKSIZE - hasRead);
-
-            if (count == 0) {
-                break;
-            }
-
-            hasRead += count;
+            this->finished = true;
+            return 0;
         }
 
-        this->zstream.next_in = (Byte *)this->in;
+        this->zstream.next_in = (Byte *)data;
         this->zstream.avail_in = hasRead;
-    } else {
-        // Still have more data in 'in' buffer to decode.
-        this->zstream.avail_out = S3_ZIP_DECOMPRESS_CHUNKSIZE;
-        this->zstream.next_out = (Byte *)this->out;
+    }
+
+    // A gzip file may be several members concatenated, e.g. by cat, each one is a whole stream.
+    if (this->memberEnded) {
+        inflateReset(&this->zstream);
+        this->memberEnded = false;
     }
 
     int status = inflate(&this->zstream, Z_NO_FLUSH);
     if (status == Z_STREAM_END) {
         S3DEBUG("Decompression finished: Z_STREAM_END.");
+        this->members++;
+        this->memberEnded = true;
     } else if (status < 0 || status == Z_NEED_DICT) {
+        // like gzip, ignore padding or garbage after the last member
+        if (this->members > 0 && this->zstream.total_out == 0) {
+            S3WARN("Ignored trailing data after %" PRIu64 " compressed streams", this->members);
+            this->zstream.avail_in = 0;
+            this->finished = true;
+            return 0;
+        }
+
         inflateEnd(&this->zstream);
         S3_CHECK_OR_DIE(
             false, S3RuntimeError,
             string("Failed to decompress data: ") + std::to_string((unsigned long long)status));
     }
+
+    return S3_ZIP_DECOMPRESS_CHUNKSIZE - this->zstream.avail_out;
+}
+
+// Point data at the next compressed data and return its size, 0 if EOF. The data is a view of the
+// buffers of the upstream reader if it can lease them, or it is read into this->in buffer.
+uint64_t DecompressReader::readInput(const char **data) {
+    if (this->leasing) {
+        // all the data of the previous view is consumed
+        this->reader->release();
+        return this->reader->lease(data);
+    }
+
+    // read S3_ZIP_DECOMPRESS_CHUNKSIZE data from underlying reader and put into this->in
+    // buffer. read() might happen more than once when reaching EOF, make sure every time read()
+    // will return 0.
+    uint64_t hasRead = this->reader->read(this->in, S3_ZIP_DECOMPRESS_CHUNKSIZE);
+
+    // Fill this->in as possible as it could, otherwise data in this->in might not be able to be
+    // inflated.
+    while (hasRead > 0 && hasRead < S3_ZIP_DECOMPRESS_CHUNKSIZE) {
+        uint64_t count =
+            this->reader->read(this->in + hasRead, S3_ZIP_DECOMPRESS_CHUNKSIZE - hasRead);
+
+        if (count == 0) {
+            break;
+        }
+
+        hasRead += count;
+    }
+
+    *data = this->in;
+    return hasRead;
+}
+
+// Stop the decompression thread, it finishes decompressing the current chunk first.
+void DecompressReader::stopDecompressThread() {
+    if (!this->threadStarted) {
+        return;
+    }
+
+    {
+        UniqueLock lock(&this->mutex);
+        this->stopping = true;
+        pthread_cond_signal(&this->cond);
+    }
+
+    pthread_join(this->thread, NULL);
+    this->threadStarted = false;
 }
 
 void DecompressReader::close() {
     if (!this->isClosed) {
+        this->stopDecompressThread();
         inflateEnd(&zstream);
+        if (this->leasing) {
+            this->reader->release();
+        }
         this->reader->close();
         this->isClosed = true;
     }
@@ -80,7 +80,10 @@ GPWriter* writer_init(const char* url_with_options, const char* format) {
         // Prepare memory to be used for thread chunk buffer.
         PrepareS3MemContext(params);
 
-        string extName = params.isAutoCompress() ? string(format) + ".gz" : format;
+        string extName = format;
+        if (params.isAutoCompress()) {
+            extName += params.getCompressionType() == S3_COMPRESSION_ZSTD ? ".zst" : ".gz";
+        }
         writer = new GPWriter(params, extName);
         if (writer == NULL) {
             return NULL;
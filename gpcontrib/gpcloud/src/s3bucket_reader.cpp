@@ -1,5 +1,33 @@
 #include "s3bucket_reader.h"
 
+#include <dirent.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <queue>
+
+#include "s3utils.h"
+
+#ifndef S3_STANDALONE
+extern "C" {
+#include "c.h"
+#include "storage/fd.h"
+}
+#else
+#define PG_TEMP_FILE_PREFIX "pgsql_tmp"
+#endif
+
+// Reading a key costs a few requests besides the data itself, count it as that many bytes when
+// balancing the segments, so that lots of small keys are spread as well.
+#define KEY_OPEN_COST (1024 * 1024)
+
+// Shared listings are named after the hash of the listing id, older ones are never read and are
+// removed by the next segment writing a listing. They are temporary files of the segment, so that
+// the server removes them at startup when they are in its temporary directory.
+#define SHARED_LISTING_PREFIX PG_TEMP_FILE_PREFIX "_gpcloud_listing_"
+#define SHARED_LISTING_TTL 600
+#define SHARED_LISTING_MAGIC "gpcloud listing 1"
+
 S3BucketReader::S3BucketReader() : Reader() {
     this->keyIndex = 0;  // doesn't matter, be set in open()
 
@@ -8,6 +36,13 @@ S3BucketReader::S3BucketReader() : Reader() {
 
     this->needNewReader = true;
     this->isFirstFile = true;
+
+    this->keyPos = 0;
+    this->rangeEnd = UINT64_MAX;
+    this->rangeFinished = false;
+
+    this->keyListing = false;
+    this->listedRanges = 0;
 }
 
 S3BucketReader::~S3BucketReader() {
@@ -17,7 +52,7 @@ S3BucketReader::~S3BucketReader() {
 void S3BucketReader::open(const S3Params& params) {
     this->params = params;
 
-    this->keyIndex = s3ext_segid;  // we may change it in unit tests
+    this->keyIndex = 0;
 
     S3_CHECK_OR_DIE(this->s3Interface != NULL, S3RuntimeError, "s3Interface is NULL");
 
@@ -26,13 +61,331 @@ void S3BucketReader::open(const S3Params& params) {
     S3_CHECK_OR_DIE(s3Url.isValidUrl(), S3ConfigError, s3Url.getFullUrlForCurl() + " is not valid",
                     s3Url.getFullUrlForCurl());
 
-    this->keyList = this->s3Interface->listBucket(s3Url);
+    this->segmentRanges.clear();
+
+    // Round-robin assignment doesn't need the whole listing, start reading the first key while the
+    // next ones are being listed.
+    if (this->params.getKeyDistribution() == KEY_DISTRIBUTION_INDEX) {
+        this->keyList = ListBucketResult();
+        this->listedRanges = 0;
+        this->keyLister.setS3InterfaceService(this->s3Interface);
+        this->keyLister.open(s3Url);
+        this->keyListing = true;
+        return;
+    }
+
+    this->listKeys(s3Url);
+
+    vector<KeyRange> ranges;
+    for (uint64_t i = 0; i < this->keyList.contents.size(); i++) {
+        this->splitKey(i, ranges);
+    }
+
+    this->assignRangesBySize(ranges);
+
+    S3DEBUG("Segment %d reads %" PRIu64 " of %" PRIu64 " ranges of %" PRIu64 " keys", s3ext_segid,
+            (uint64_t)this->segmentRanges.size(), (uint64_t)ranges.size(),
+            (uint64_t)this->keyList.contents.size());
+}
+
+// Every segment needs the whole listing to compute the same plan, and listing a large bucket takes
+// many requests. The segments of a query on a host take a file lock in turn: the first one lists
+// the bucket and leaves the listing in sharedListingDir, the others read it from there. Without a
+// listing id or a directory, or when the shared listing can't be used, the segment lists the bucket
+// itself.
+void S3BucketReader::listKeys(S3Url& s3Url) {
+    const string& listingId = this->params.getListingId();
+    const string& listingDir = this->params.getSharedListingDir();
+    if (listingId.empty() || listingDir.empty()) {
+        this->keyList = this->s3Interface->listBucket(s3Url);
+        return;
+    }
+
+    char hash[SHA256_DIGEST_STRING_LENGTH];
+    sha256_hex(listingId.c_str(), hash);
+    string path = listingDir + "/" SHARED_LISTING_PREFIX + hash;
+
+    // the default directory, pgsql_tmp of the segment, only exists once a query spilled
+    if (mkdir(listingDir.c_str(), 0700) != 0 && errno != EEXIST) {
+        S3WARN("Failed to create \"%s\" (%s), list the bucket directly", listingDir.c_str(),
+               strerror(errno));
+        this->keyList = this->s3Interface->listBucket(s3Url);
+        return;
+    }
+
+    // The names of the files are easy to guess, another user of the host could plant them in a
+    // shared directory: links are not followed, and files of other users are not used.
+    int lockFd = ::open((path + ".lock").c_str(), O_CREAT | O_RDWR | O_NOFOLLOW, 0600);
+    struct stat lockStat;
+    if (lockFd >= 0 && (fstat(lockFd, &lockStat) != 0 || lockStat.st_uid != geteuid())) {
+        ::close(lockFd);
+        lockFd = -1;
+        errno = EPERM;
+    }
+    if (lockFd < 0) {
+        S3WARN("Failed to open \"%s.lock\" (%s), list the bucket directly", path.c_str(),
+               strerror(errno));
+        this->keyList = this->s3Interface->listBucket(s3Url);
+        return;
+    }
+
+    try {
+        // poll rather than block, so that a cancelled query doesn't wait for the listing segment
+        while (flock(lockFd, LOCK_EX | LOCK_NB) != 0) {
+            if (errno != EWOULDBLOCK && errno != EINTR) {
+                S3WARN("Failed to lock \"%s.lock\" (%s), list the bucket directly", path.c_str(),
+                       strerror(errno));
+                ::close(lockFd);
+                this->keyList = this->s3Interface->listBucket(s3Url);
+                return;
+            }
+            if (S3QueryIsAbortInProgress()) {
+                S3_DIE(S3QueryAbort, "Listing is interrupted");
+            }
+            usleep(100 * 1000);
+        }
+
+        if (this->readSharedListing(path)) {
+            S3INFO("Read the listing of %" PRIu64 " keys shared by another segment from \"%s\"",
+                   (uint64_t)this->keyList.contents.size(), path.c_str());
+        } else {
+            this->keyList = this->s3Interface->listBucket(s3Url);
+            this->writeSharedListing(path);
+            this->removeStaleListings();
+        }
+    } catch (...) {
+        ::close(lockFd);
+        throw;
+    }
+
+    // closing the file releases the lock
+    ::close(lockFd);
+}
+
+// A shared listing is the magic line, the number of keys, then the size, the name length and the
+// name of each key, the names may contain any character.
+bool S3BucketReader::readSharedListing(const string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_NOFOLLOW);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_mtime + SHARED_LISTING_TTL < time(NULL)) {
+        ::close(fd);
+        return false;
+    }
+
+    // only a listing written by a segment can be trusted
+    if (!S_ISREG(st.st_mode) || st.st_uid != geteuid()) {
+        S3WARN("Shared listing \"%s\" is not a file of this user, list the bucket directly",
+               path.c_str());
+        ::close(fd);
+        return false;
+    }
+
+    FILE* file = fdopen(fd, "r");
+    if (file == NULL) {
+        ::close(fd);
+        return false;
+    }
+
+    ListBucketResult result;
+    char magic[sizeof(SHARED_LISTING_MAGIC)];
+    uint64_t count = 0;
+    bool valid = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 memcmp(magic, SHARED_LISTING_MAGIC "\n", sizeof(magic)) == 0 &&
+                 fscanf(file, "%" SCNu64, &count) == 1 && fgetc(file) == '\n';
+
+    for (uint64_t i = 0; valid && i < count; i++) {
+        uint64_t size = 0;
+        uint64_t nameLen = 0;
+        valid = fscanf(file, "%" SCNu64 " %" SCNu64, &size, &nameLen) == 2 && fgetc(file) == ' ';
+        if (!valid) {
+            break;
+        }
+
+        string name(nameLen, '\0');
+        valid = fread(&name[0], 1, nameLen, file) == nameLen && fgetc(file) == '\n';
+        result.contents.emplace_back(name, size);
+    }
+    fclose(file);
+
+    if (!valid) {
+        S3WARN("Shared listing \"%s\" is corrupted, list the bucket directly", path.c_str());
+        return false;
+    }
+
+    this->keyList = result;
+    return true;
+}
+
+// Write the listing to a temporary file and rename it, so that a listing is never read half
+// written. Failing to share the listing is not an error, the other segments list the bucket then.
+void S3BucketReader::writeSharedListing(const string& path) {
+    stringstream tmpPath;
+    tmpPath << path << "." << getpid() << ".tmp";
+
+    int fd = ::open(tmpPath.str().c_str(), O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+    FILE* file = (fd < 0) ? NULL : fdopen(fd, "w");
+    if (file == NULL) {
+        S3WARN("Failed to create \"%s\" (%s), the listing is not shared",
+               tmpPath.str().c_str(), strerror(errno));
+        if (fd >= 0) {
+            ::close(fd);
+            unlink(tmpPath.str().c_str());
+        }
+        return;
+    }
+
+    const vector<BucketContent>& contents = this->keyList.contents;
+    fprintf(file, SHARED_LISTING_MAGIC "\n%" PRIu64 "\n", (uint64_t)contents.size());
+    for (uint64_t i = 0; i < contents.size(); i++) {
+        fprintf(file, "%" PRIu64 " %" PRIu64 " ", contents[i].size,
+                (uint64_t)contents[i].name.size());
+        fwrite(contents[i].name.data(), 1, contents[i].name.size(), file);
+        fputc('\n', file);
+    }
+
+    bool written = !ferror(file);
+    written = (fclose(file) == 0) && written;
+    if (!written || rename(tmpPath.str().c_str(), path.c_str()) != 0) {
+        S3WARN("Failed to write \"%s\" (%s), the listing is not shared", path.c_str(),
+               strerror(errno));
+        unlink(tmpPath.str().c_str());
+    }
+}
+
+void S3BucketReader::removeStaleListings() {
+    const string& listingDir = this->params.getSharedListingDir();
+
+    DIR* dir = opendir(listingDir.c_str());
+    if (dir == NULL) {
+        return;
+    }
+
+    time_t expired = time(NULL) - SHARED_LISTING_TTL;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, SHARED_LISTING_PREFIX, strlen(SHARED_LISTING_PREFIX)) != 0) {
+            continue;
+        }
+
+        string path = listingDir + "/" + entry->d_name;
+        struct stat st;
+        if (lstat(path.c_str(), &st) == 0 && st.st_uid == geteuid() && st.st_mtime < expired) {
+            unlink(path.c_str());
+        }
+    }
+    closedir(dir);
 }
 
-BucketContent& S3BucketReader::getNextKey() {
-    BucketContent& key = this->keyList.contents[this->keyIndex];
-    this->keyIndex += s3ext_segnum;
-    return key;
+// Split a key larger than keySplitSize into ranges of about the same size, so that several
+// segments read it. Compressed keys can only be read from their beginning and are not split.
+void S3BucketReader::splitKey(uint64_t keyIndex, vector<KeyRange>& ranges) {
+    uint64_t splitSize = this->params.getKeySplitSize();
+    BucketContent& key = this->keyList.contents[keyIndex];
+    uint64_t numOfRanges = 1;
+
+    if (splitSize != 0 && key.getSize() > splitSize) {
+        S3Url keyUrl = this->constructReaderParams(key).getS3Url();
+        if (this->s3Interface->checkCompressionType(keyUrl) == S3_COMPRESSION_PLAIN) {
+            numOfRanges = (key.getSize() + splitSize - 1) / splitSize;
+        }
+    }
+
+    for (uint64_t j = 0; j < numOfRanges; j++) {
+        KeyRange range = {keyIndex, key.getSize() * j / numOfRanges,
+                          key.getSize() * (j + 1) / numOfRanges};
+        ranges.push_back(range);
+    }
+}
+
+// Segment i reads ranges i, i + segnum, i + 2 * segnum, ... in listing order.
+bool S3BucketReader::addNextKey() {
+    if (!this->keyListing) {
+        return false;
+    }
+
+    BucketContent key;
+    if (!this->keyLister.next(key)) {
+        this->keyListing = false;
+        S3DEBUG("Segment %d reads %" PRIu64 " of %" PRIu64 " ranges of %" PRIu64 " keys",
+                s3ext_segid, (uint64_t)this->segmentRanges.size(), this->listedRanges,
+                (uint64_t)this->keyList.contents.size());
+        return false;
+    }
+
+    this->keyList.contents.push_back(key);
+
+    vector<KeyRange> ranges;
+    this->splitKey(this->keyList.contents.size() - 1, ranges);
+    for (uint64_t i = 0; i < ranges.size(); i++, this->listedRanges++) {
+        if (this->listedRanges % s3ext_segnum == (uint64_t)s3ext_segid) {
+            this->segmentRanges.push_back(ranges[i]);
+        }
+    }
+
+    return true;
+}
+
+// Longest processing time first: going from the largest range to the smallest one, each range
+// goes to the segment with the fewest bytes so far. Every segment lists the same keys and computes
+// the same plan, no coordination between them is needed. Ranges of equal size, as well as ties
+// between segments, are ordered by index, so for ranges of equal size the plan is the round-robin
+// one.
+void S3BucketReader::assignRangesBySize(const vector<KeyRange>& ranges) {
+    this->segmentRanges.clear();
+
+    vector<uint64_t> order(ranges.size());
+    for (uint64_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&ranges](uint64_t a, uint64_t b) {
+        return ranges[a].end - ranges[a].begin > ranges[b].end - ranges[b].begin;
+    });
+
+    // (bytes assigned so far, segment id), the least loaded segment on top
+    typedef std::pair<uint64_t, int32_t> SegmentLoad;
+    std::priority_queue<SegmentLoad, vector<SegmentLoad>, std::greater<SegmentLoad> > loads;
+    for (int32_t i = 0; i < s3ext_segnum; i++) {
+        loads.push(SegmentLoad(0, i));
+    }
+
+    vector<uint64_t> assigned;
+    for (uint64_t i = 0; i < order.size(); i++) {
+        SegmentLoad load = loads.top();
+        loads.pop();
+
+        const KeyRange& range = ranges[order[i]];
+        if (load.second == s3ext_segid) {
+            assigned.push_back(order[i]);
+        }
+
+        load.first += range.end - range.begin + KEY_OPEN_COST;
+        loads.push(load);
+    }
+
+    // read the ranges in listing order
+    std::sort(assigned.begin(), assigned.end());
+    for (uint64_t i = 0; i < assigned.size(); i++) {
+        this->segmentRanges.push_back(ranges[assigned[i]]);
+    }
+}
+
+bool S3BucketReader::hasNextRange() {
+    while (this->keyIndex >= this->segmentRanges.size()) {
+        if (!this->addNextKey()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const KeyRange& S3BucketReader::getNextRange() {
+    const KeyRange& range = this->segmentRanges[this->keyIndex];
+    this->keyIndex++;
+    return range;
 }
 
 S3Params S3BucketReader::constructReaderParams(BucketContent& key) {
@@ -51,9 +404,13 @@ S3Params S3BucketReader::constructReaderParams(BucketContent& key) {
 }
 
 uint64_t S3BucketReader::readWithoutHeaderLine(char* buf, uint64_t count) {
+    return this->readAfterLineEnd(buf, count, eolString);
+}
+
+uint64_t S3BucketReader::readAfterLineEnd(char* buf, uint64_t count, const char* lineEnd) {
     char* current = NULL;
     char* end = NULL;
-    char* currentEOL = eolString;
+    const char* currentEOL = lineEnd;
 
     // check one char at a time
     while (*currentEOL != '\0') {
@@ -64,6 +421,7 @@ uint64_t S3BucketReader::readWithoutHeaderLine(char* buf, uint64_t count) {
                 S3WARN("%s", "Reach end of file before matching line terminator");
                 return 0;
             }
+            this->keyPos += readCount;
 
             current = buf;
             end = buf + readCount;
@@ -76,7 +434,7 @@ uint64_t S3BucketReader::readWithoutHeaderLine(char* buf, uint64_t count) {
                 current++;
                 break;
             } else {
-                currentEOL = eolString;
+                currentEOL = lineEnd;
             }
         }
     }
@@ -93,35 +451,93 @@ uint64_t S3BucketReader::readWithoutHeaderLine(char* buf, uint64_t count) {
     return remain;
 }
 
+// The count bytes in buf are the last ones read from the key, they end at keyPos. Lines are told
+// apart by the last char of the line terminator, a range ends with the first one at or after its
+// last byte. The next range skips through that same char.
+uint64_t S3BucketReader::trimToRange(char* buf, uint64_t count) {
+    if (this->keyPos < this->rangeEnd || this->rangeEnd == UINT64_MAX) {
+        return count;
+    }
+
+    uint64_t bufStart = this->keyPos - count;
+
+    char lineEnd = eolString[strlen(eolString) - 1];
+    uint64_t i = (bufStart + 1 >= this->rangeEnd) ? 0 : this->rangeEnd - 1 - bufStart;
+    for (; i < count; i++) {
+        if (buf[i] == lineEnd) {
+            this->rangeFinished = true;
+            return i + 1;
+        }
+    }
+
+    return count;
+}
+
+// Like trimToRange(), for the data following a skipped line. If the skipped line ends in the last
+// byte of the range or after it, the range has no line of its own.
+uint64_t S3BucketReader::trimAfterSkippedLine(char* buf, uint64_t count) {
+    if (this->keyPos - count >= this->rangeEnd) {
+        this->rangeFinished = true;
+        return 0;
+    }
+
+    return this->trimToRange(buf, count);
+}
+
 uint64_t S3BucketReader::read(char* buf, uint64_t count) {
     S3_CHECK_OR_DIE(this->upstreamReader != NULL, S3RuntimeError, "upstreamReader is NULL");
     uint64_t readCount = 0;
     while (true) {
         if (this->needNewReader) {
-            if (this->keyIndex >= this->keyList.contents.size()) {
+            if (!this->hasNextRange()) {
                 S3DEBUG("Read finished for segment: %d", s3ext_segid);
                 return 0;
             }
-            BucketContent& key = this->getNextKey();
+            const KeyRange& range = this->getNextRange();
+            BucketContent& key = this->keyList.contents[range.keyIndex];
 
-            this->upstreamReader->open(constructReaderParams(key));
+            // A range not at the beginning of the key is read from the byte before it, the line
+            // that byte belongs to is skipped: if it ends right there, the range starts a line.
+            this->keyPos = (range.begin == 0) ? 0 : range.begin - 1;
+            this->rangeEnd = (range.end == key.getSize()) ? UINT64_MAX : range.end;
+            this->rangeFinished = false;
+
+            S3Params readerParams = constructReaderParams(key);
+            readerParams.setKeyOffset(this->keyPos);
+
+            this->upstreamReader->open(readerParams);
             this->needNewReader = false;
 
-            // ignore header line if it is not the first file
-            if (hasHeader && !this->isFirstFile) {
-                readCount = readWithoutHeaderLine(buf, count);
+            if (range.begin != 0) {
+                // With a header line, the first line of a segment is skipped downstream, the
+                // partial line will do as the header.
+                if (!hasHeader || !this->isFirstFile) {
+                    char lineEnd[2] = {eolString[strlen(eolString) - 1], '\0'};
+                    readCount = trimAfterSkippedLine(buf, readAfterLineEnd(buf, count, lineEnd));
+                    if (readCount != 0) {
+                        return readCount;
+                    }
+                }
+            } else if (hasHeader && !this->isFirstFile) {
+                // ignore header line if it is not the first file
+                readCount = trimAfterSkippedLine(buf, readWithoutHeaderLine(buf, count));
                 if (readCount != 0) {
                     return readCount;
                 }
             }
         }
 
-        readCount = this->upstreamReader->read(buf, count);
-        if (readCount != 0) {
-            return readCount;
+        if (!this->rangeFinished) {
+            readCount = this->upstreamReader->read(buf, count);
+            this->keyPos += readCount;
+
+            readCount = trimToRange(buf, readCount);
+            if (readCount != 0) {
+                return readCount;
+            }
         }
 
-        // Finished one file, continue to next
+        // Finished one range, continue to next
         this->upstreamReader->close();
         this->needNewReader = true;
         this->isFirstFile = false;
@@ -129,6 +545,9 @@ uint64_t S3BucketReader::read(char* buf, uint64_t count) {
 }
 
 void S3BucketReader::close() {
+    this->keyLister.close();
+    this->keyListing = false;
+
     if (this->upstreamReader != NULL) {
         this->upstreamReader->close();
         this->upstreamReader = NULL;
@@ -137,4 +556,6 @@ void S3BucketReader::close() {
     if (!this->keyList.contents.empty()) {
         this->keyList.contents.clear();
     }
+
+    this->segmentRanges.clear();
 }
\ No newline at end of file
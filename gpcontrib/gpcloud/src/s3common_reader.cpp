@@ -5,12 +5,23 @@ void S3CommonReader::open(const S3Params &params) {
 
     S3CompressionType compressionType = s3InterfaceService->checkCompressionType(params.getS3Url());
 
+    // a line terminator after the compressed stream would be taken as trailing garbage
+    this->keyReader.setAppendEol(compressionType == S3_COMPRESSION_PLAIN);
+
     switch (compressionType) {
         case S3_COMPRESSION_DEFLATE:
         case S3_COMPRESSION_GZIP:
             this->upstreamReader = &this->decompressReader;
             this->decompressReader.setReader(&this->keyReader);
             break;
+        case S3_COMPRESSION_ZSTD:
+#ifdef HAVE_LIBZSTD
+            this->upstreamReader = &this->zstdDecompressReader;
+            this->zstdDecompressReader.setReader(&this->keyReader);
+            break;
+#else
+            S3_DIE(S3RuntimeError, "zstd compressed data is not supported by this build");
+#endif
         case S3_COMPRESSION_PLAIN:
             this->upstreamReader = &this->keyReader;
             break;
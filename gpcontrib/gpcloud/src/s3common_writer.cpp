@@ -3,7 +3,14 @@
 void S3CommonWriter::open(const S3Params& params) {
     this->keyWriter.setS3InterfaceService(this->s3InterfaceService);
 
-    if (params.isAutoCompress()) {
+    if (params.isAutoCompress() && params.getCompressionType() == S3_COMPRESSION_ZSTD) {
+#ifdef HAVE_LIBZSTD
+        this->upstreamWriter = &this->zstdCompressWriter;
+        this->zstdCompressWriter.setWriter(&this->keyWriter);
+#else
+        S3_DIE(S3RuntimeError, "zstd compression is not supported by this build");
+#endif
+    } else if (params.isAutoCompress()) {
         this->upstreamWriter = &this->compressWriter;
         this->compressWriter.setWriter(&this->keyWriter);
     } else {
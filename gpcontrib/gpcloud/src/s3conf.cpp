@@ -15,6 +15,7 @@ void write_log(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
 extern "C" {
 #include "c.h"
 #include "cdb/cdbvars.h"
+#include "storage/fd.h"
 extern int getgpsegmentCount(void);
 extern char *DataDir;
 }
@@ -115,16 +116,46 @@ S3Params InitConfig(const string& urlWithOptions) {
                                        8 * 1024 * 1024, 128 * 1024 * 1024);
     params.setChunkSize(chunkSize);
 
+    // threadnum and chunksize become upper bounds, adapted to the size of each key and to the
+    // throughput of the connections
+    params.setAdaptiveDownload(s3Cfg.GetBool(configSection, "adaptive_download", "true"));
+
+    // splitting keys into ranges smaller than a chunk only adds requests
+    int64_t keySplitSize = s3Cfg.SafeScan("key_split_size", configSection, 0, 0, INT64_MAX);
+    if (keySplitSize != 0) {
+        keySplitSize = std::max(keySplitSize, chunkSize);
+    }
+    params.setKeySplitSize(keySplitSize);
+
     int64_t lowSpeedLimit = s3Cfg.SafeScan("low_speed_limit", configSection, 10240, 0, INT_MAX);
     params.setLowSpeedLimit(lowSpeedLimit);
 
     int64_t lowSpeedTime = s3Cfg.SafeScan("low_speed_time", configSection, 60, 0, INT_MAX);
     params.setLowSpeedTime(lowSpeedTime);
 
+    int64_t connectionIdleTime =
+        s3Cfg.SafeScan("connection_idle_time", configSection, 15, 0, INT_MAX);
+    params.setConnectionIdleTime(connectionIdleTime);
+
     params.setProxy(s3Cfg.Get(configSection, "proxy", ""));
 
     params.setAutoCompress(s3Cfg.GetBool(configSection, "autocompress", "true"));
 
+    string compression = s3Cfg.Get(configSection, "compression", "gzip");
+    if (compression == "zstd") {
+#ifndef HAVE_LIBZSTD
+        S3_DIE(S3ConfigError, "zstd compression is not supported by this build", "compression");
+#endif
+        params.setCompressionType(S3_COMPRESSION_ZSTD);
+    } else if (compression == "gzip") {
+        params.setCompressionType(S3_COMPRESSION_GZIP);
+    } else {
+        S3_DIE(S3ConfigError, "compression must be gzip or zstd", "compression");
+    }
+
+    int64_t compressThreads = s3Cfg.SafeScan("compress_threads", configSection, 1, 1, 8);
+    params.setCompressThreads(compressThreads);
+
     params.setVerifyCert(s3Cfg.GetBool(configSection, "verifycert", "true"));
 
     string sse_type = s3Cfg.Get(configSection, "server_side_encryption", "");
@@ -134,6 +165,34 @@ S3Params InitConfig(const string& urlWithOptions) {
         params.setSSEType(SSE_NONE);
     }
 
+    string keyDistribution = s3Cfg.Get(configSection, "key_distribution", "size");
+    if (keyDistribution == "index") {
+        params.setKeyDistribution(KEY_DISTRIBUTION_INDEX);
+    } else {
+        params.setKeyDistribution(KEY_DISTRIBUTION_SIZE);
+    }
+
+    // Listings are only shared by default when a directory common to the segments of a host is
+    // configured.
+    string sharedListingDir = s3Cfg.Get(configSection, "shared_listing_dir", "");
+    if (s3Cfg.GetBool(configSection, "share_listing", sharedListingDir.empty() ? "false" : "true")) {
+#ifndef S3_STANDALONE
+        // the temporary directory of the segment, only the administrative user can write there,
+        // the listings are only shared by the scans of the segment
+        if (sharedListingDir.empty()) {
+            sharedListingDir = string(DataDir) + "/base/" PG_TEMP_FILES_DIR;
+        }
+#endif
+        params.setSharedListingDir(sharedListingDir);
+    }
+
+#ifndef S3_STANDALONE
+    // All segments of a query see the same session id and command count.
+    stringstream listingId;
+    listingId << gp_session_id << " " << gp_command_count << " " << urlWithOptions;
+    params.setListingId(listingId.str());
+#endif
+
     params.setGpcheckcloud_newline(s3Cfg.Get(configSection, "gpcheckcloud_newline", "\n"));
 
     CheckEssentialConfig(params);
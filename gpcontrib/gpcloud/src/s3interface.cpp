@@ -16,11 +16,12 @@ class XMLContextHolder {
     xmlParserCtxtPtr context;
 };
 
-S3InterfaceService::S3InterfaceService() : restfulService(NULL), params("") {
+S3InterfaceService::S3InterfaceService() : restfulService(NULL), params(""), slowDowns(0) {
     xmlInitParser();
 }
 
-S3InterfaceService::S3InterfaceService(const S3Params &p) : restfulService(NULL), params(p) {
+S3InterfaceService::S3InterfaceService(const S3Params &p)
+    : restfulService(NULL), params(p), slowDowns(0) {
     xmlInitParser();
 }
 
@@ -38,6 +39,13 @@ Response S3InterfaceService::getResponseWithRetries(const string &url, HTTPHeade
     while (retry--) {
         try {
             return this->restfulService->get(url, headers);
+        } catch (S3SlowDownError &e) {
+            message = e.getMessage();
+            __sync_add_and_fetch(&this->slowDowns, 1);
+            if (S3QueryIsAbortInProgress()) {
+                S3_DIE(S3QueryAbort, "Downloading is interrupted");
+            }
+            S3WARN("Slowed down by the server in GET from '%s', retrying ...", url.c_str());
         } catch (S3ConnectionError &e) {
             message = e.getMessage();
             if (S3QueryIsAbortInProgress()) {
@@ -276,55 +284,65 @@ bool S3InterfaceService::parseBucketXML(ListBucketResult *result, xmlParserCtxtP
     return true;
 }
 
-// ListBucket lists all keys in given bucket with given prefix.
-//
-// Return NULL when there is failure due to network instability or
-// service unstable, so that caller could retry.
-//
-// Caller should delete returned object.
-ListBucketResult S3InterfaceService::listBucket(S3Url &s3Url) {
-    ListBucketResult result;
+void S3InterfaceService::listBucketPage(const S3Url &s3Url, string &marker,
+                                        ListBucketResult &result) {
+    // S3 requires query parameters specified alphabetically.
 
-    string marker = "";
+    // marker and prefix are used as the values of query parameters here
+    // so URI encode their whole string, "/" also.
     string encodedPrefix = s3Url.getPrefix();
     FindAndReplace(encodedPrefix, "/", "%2F");
-    do {
-        // To get next set(up to 1000) keys in one iteration.
-        // S3 requires query parameters specified alphabetically.
 
-        // marker and prefix are used as the values of query parameters here
-        // so URI encode their whole string, "/" also.
+    // transfer /bucket/prefix to /bucket/?prefix=prefix because we need to "GET" a real thing
+    stringstream querySs;
+    if (!marker.empty()) {
+        querySs << "marker=" << UriEncode(marker);
+    }
 
-        // transfer /bucket/prefix to /bucket/?prefix=prefix because we need to "GET" a real thing
-        stringstream querySs;
-        if (!marker.empty()) {
-            querySs << "marker=" << UriEncode(marker);
-        }
+    if (!encodedPrefix.empty()) {
+        querySs << (marker.empty() ? "prefix=" : "&prefix=") << encodedPrefix;
+    }
 
-        if (!encodedPrefix.empty()) {
-            querySs << (marker.empty() ? "prefix=" : "&prefix=") << encodedPrefix;
-        }
-        s3Url.setPrefix("");
-        string queryStr = querySs.str();
+    S3Url bucketUrl = s3Url;
+    bucketUrl.setPrefix("");
+    string queryStr = querySs.str();
 
-        Response resp = getBucketResponse(s3Url, queryStr);
+    Response resp = getBucketResponse(bucketUrl, queryStr);
 
-        if (resp.getStatus() == RESPONSE_OK) {
-            xmlParserCtxtPtr xmlContext = getXMLContext(resp);
-            XMLContextHolder holder(xmlContext);
-            if (parseBucketXML(&result, xmlContext, marker)) {
-                continue;
-            }
-        } else if (resp.getStatus() == RESPONSE_ERROR) {
-            S3MessageParser s3msg(resp);
-            S3_DIE(S3LogicError, s3msg.getCode(), s3msg.getMessage());
-        } else {
-            S3_DIE(S3RuntimeError, "unexpected response status");
+    if (resp.getStatus() == RESPONSE_OK) {
+        xmlParserCtxtPtr xmlContext = getXMLContext(resp);
+        XMLContextHolder holder(xmlContext);
+        if (!parseBucketXML(&result, xmlContext, marker)) {
+            marker = "";
         }
+    } else if (resp.getStatus() == RESPONSE_ERROR) {
+        S3MessageParser s3msg(resp);
+        S3_DIE(S3LogicError, s3msg.getCode(), s3msg.getMessage());
+    } else {
+        S3_DIE(S3RuntimeError, "unexpected response status");
+    }
+}
 
-        return result;
+// ListBucket lists all keys in given bucket with given prefix, up to 1000 keys per request.
+ListBucketResult S3InterfaceService::listBucket(S3Url &s3Url) {
+    ListBucketResult result;
+
+    uint64_t requests = 0;
+    struct timeval startTime;
+    gettimeofday(&startTime, NULL);
+
+    string marker = "";
+    do {
+        this->listBucketPage(s3Url, marker, result);
+        requests++;
     } while (!marker.empty());
 
+    struct timeval endTime;
+    gettimeofday(&endTime, NULL);
+    S3INFO("Listed %" PRIu64 " keys of prefix \"%s\" in %" PRIu64 " requests, %.3f seconds",
+           (uint64_t)result.contents.size(), s3Url.getPrefix().c_str(), requests,
+           (endTime.tv_sec - startTime.tv_sec) + (endTime.tv_usec - startTime.tv_usec) / 1e6);
+
     return result;
 }
 
@@ -391,6 +409,12 @@ S3CompressionType S3InterfaceService::checkCompressionType(const S3Url &s3Url) {
         if ((responseData[0] == 0x1f) && (responseData[1] == 0x8b)) {
             return S3_COMPRESSION_GZIP;
         }
+
+        // zstd frame magic number 0xFD2FB528, little endian
+        if ((responseData[0] == 0x28) && (responseData[1] == 0xb5) && (responseData[2] == 0x2f) &&
+            (responseData[3] == 0xfd)) {
+            return S3_COMPRESSION_ZSTD;
+        }
     } else if (resp.getStatus() == RESPONSE_ERROR) {
         S3MessageParser s3msg(resp);
         S3_DIE(S3LogicError, s3msg.getCode(), s3msg.getMessage());
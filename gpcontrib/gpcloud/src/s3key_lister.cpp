@@ -0,0 +1,127 @@
+#include "s3key_lister.h"
+
+S3KeyLister::S3KeyLister()
+    : s3Interface(NULL),
+      s3Url(""),
+      thread(0),
+      threadStarted(false),
+      finished(true),
+      stopping(false),
+      requests(0) {
+    pthread_mutex_init(&this->mutex, NULL);
+    pthread_cond_init(&this->keysReady, NULL);
+}
+
+S3KeyLister::~S3KeyLister() {
+    this->close();
+    pthread_cond_destroy(&this->keysReady);
+    pthread_mutex_destroy(&this->mutex);
+}
+
+void* S3KeyLister::ListThreadFunc(void* data) {
+    MaskThreadSignals();
+
+    S3KeyLister* lister = static_cast<S3KeyLister*>(data);
+    lister->listKeys();
+    return NULL;
+}
+
+void S3KeyLister::listKeys() {
+    struct timeval startTime;
+    gettimeofday(&startTime, NULL);
+
+    uint64_t numOfKeys = 0;
+    string marker = "";
+    try {
+        do {
+            {
+                UniqueLock lock(&this->mutex);
+                if (this->stopping) {
+                    break;
+                }
+            }
+
+            if (S3QueryIsAbortInProgress()) {
+                S3_DIE(S3QueryAbort, "Listing is interrupted");
+            }
+
+            ListBucketResult page;
+            this->s3Interface->listBucketPage(this->s3Url, marker, page);
+            numOfKeys += page.contents.size();
+
+            UniqueLock lock(&this->mutex);
+            this->requests++;
+            this->keys.insert(this->keys.end(), page.contents.begin(), page.contents.end());
+            pthread_cond_signal(&this->keysReady);
+        } while (!marker.empty());
+    } catch (...) {
+        UniqueLock lock(&this->mutex);
+        this->sharedException = std::current_exception();
+    }
+
+    uint64_t requests;
+    {
+        UniqueLock lock(&this->mutex);
+        this->finished = true;
+        requests = this->requests;
+        pthread_cond_signal(&this->keysReady);
+    }
+
+    struct timeval endTime;
+    gettimeofday(&endTime, NULL);
+    S3INFO("Listed %" PRIu64 " keys of prefix \"%s\" in %" PRIu64 " requests, %.3f seconds",
+           numOfKeys, this->s3Url.getPrefix().c_str(), requests,
+           (endTime.tv_sec - startTime.tv_sec) + (endTime.tv_usec - startTime.tv_usec) / 1e6);
+}
+
+void S3KeyLister::open(const S3Url& s3Url) {
+    S3_CHECK_OR_DIE(this->s3Interface != NULL, S3RuntimeError, "s3Interface must not be NULL");
+
+    this->close();
+
+    this->s3Url = s3Url;
+    this->keys.clear();
+    this->finished = false;
+    this->stopping = false;
+    this->requests = 0;
+    this->sharedException = std::exception_ptr();
+
+    int ret = pthread_create(&this->thread, NULL, ListThreadFunc, this);
+    S3_CHECK_OR_DIE(ret == 0, S3RuntimeError, "Failed to create listing thread");
+    this->threadStarted = true;
+}
+
+bool S3KeyLister::next(BucketContent& key) {
+    UniqueLock lock(&this->mutex);
+
+    while (this->keys.empty() && !this->finished) {
+        pthread_cond_wait(&this->keysReady, &this->mutex);
+    }
+
+    if (this->sharedException != NULL) {
+        std::rethrow_exception(this->sharedException);
+    }
+
+    if (this->keys.empty()) {
+        return false;
+    }
+
+    key = this->keys.front();
+    this->keys.pop_front();
+    return true;
+}
+
+void S3KeyLister::close() {
+    if (!this->threadStarted) {
+        return;
+    }
+
+    {
+        UniqueLock lock(&this->mutex);
+        this->stopping = true;
+    }
+
+    pthread_join(this->thread, NULL);
+    this->threadStarted = false;
+    this->keys.clear();
+}
@@ -20,6 +20,131 @@ Range OffsetMgr::getNextOffset() {
     return ret;
 }
 
+DownloadLimiter::DownloadLimiter() {
+    pthread_mutex_init(&this->mutex, NULL);
+    pthread_cond_init(&this->cond, NULL);
+    this->reset(1, false);
+}
+
+DownloadLimiter::~DownloadLimiter() {
+    pthread_cond_destroy(&this->cond);
+    pthread_mutex_destroy(&this->mutex);
+}
+
+void DownloadLimiter::reset(uint64_t maxDownloads, bool adaptive) {
+    UniqueLock lock(&this->mutex);
+
+    this->adaptive = adaptive;
+    this->stopped = false;
+    this->maxDownloads = std::max(maxDownloads, (uint64_t)1);
+
+    // start with half of the connections, so that a server or link already busy is not flooded
+    this->limit = adaptive ? (this->maxDownloads + 1) / 2 : this->maxDownloads;
+
+    this->activeDownloads = 0;
+    this->startedChunks = 0;
+    this->bestRate = 0;
+
+    gettimeofday(&this->startTime, NULL);
+    this->endTime = this->startTime;
+    this->downloads = 0;
+    this->downloadedBytes = 0;
+    this->downloadSeconds = 0;
+    this->peakDownloads = 0;
+    this->slowDowns = 0;
+    this->lastSlowDownSeen = 0;
+}
+
+bool DownloadLimiter::acquire(uint64_t chunkIndex) {
+    UniqueLock lock(&this->mutex);
+
+    // chunks start in order, the chunk read next must not wait for a slot taken by a later one
+    while (!this->stopped &&
+           (chunkIndex > this->startedChunks || this->activeDownloads >= this->limit)) {
+        pthread_cond_wait(&this->cond, &this->mutex);
+    }
+
+    if (this->stopped) {
+        return false;
+    }
+
+    this->startedChunks = std::max(this->startedChunks, chunkIndex + 1);
+    this->activeDownloads++;
+    this->peakDownloads = std::max(this->peakDownloads, this->activeDownloads);
+
+    // the next chunk might be waiting for this one to start
+    pthread_cond_broadcast(&this->cond);
+
+    return true;
+}
+
+void DownloadLimiter::release(uint64_t len, double seconds, uint64_t slowDownsBefore,
+                              uint64_t slowDownsAfter) {
+    UniqueLock lock(&this->mutex);
+
+    this->activeDownloads--;
+    this->downloads++;
+    this->downloadedBytes += len;
+    this->downloadSeconds += seconds;
+    gettimeofday(&this->endTime, NULL);
+
+    // The downloads running when the server asks to slow down all see it, only the first one to
+    // finish halves the limit, unless there were more 503s since. None of them raises it.
+    if (slowDownsAfter > slowDownsBefore) {
+        if (slowDownsAfter > this->lastSlowDownSeen) {
+            this->lastSlowDownSeen = slowDownsAfter;
+            this->slowDowns++;
+            if (this->adaptive) {
+                this->limit = std::max(this->limit / 2, (uint64_t)1);
+            }
+        }
+    } else if (this->adaptive && len > 0 && seconds > 0) {
+        double rate = len / seconds;
+        if (rate >= this->bestRate * S3_ADAPTIVE_RATE_THRESHOLD) {
+            this->limit = std::min(this->limit + 1, this->maxDownloads);
+        }
+        this->bestRate = std::max(this->bestRate, rate);
+    }
+
+    pthread_cond_broadcast(&this->cond);
+}
+
+void DownloadLimiter::stop() {
+    UniqueLock lock(&this->mutex);
+    this->stopped = true;
+    pthread_cond_broadcast(&this->cond);
+}
+
+void DownloadLimiter::logStats(const string& keyUrl) {
+    UniqueLock lock(&this->mutex);
+
+    if (this->downloads == 0) {
+        return;
+    }
+
+    double seconds = (this->endTime.tv_sec - this->startTime.tv_sec) +
+                     (this->endTime.tv_usec - this->startTime.tv_usec) / 1e6;
+    double mb = this->downloadedBytes / (1024.0 * 1024.0);
+
+    S3INFO("Downloaded %" PRIu64 " bytes of '%s' in %" PRIu64
+           " requests, %.3f seconds, %.2f MB/s, %.2f MB/s per connection, up to %" PRIu64
+           " connections, slowed down %" PRIu64 " times",
+           this->downloadedBytes, keyUrl.c_str(), this->downloads, seconds,
+           seconds > 0 ? mb / seconds : 0,
+           this->downloadSeconds > 0 ? mb / this->downloadSeconds : 0,
+           this->peakDownloads, this->slowDowns);
+}
+
+uint64_t DownloadLimiter::getLimit() {
+    UniqueLock lock(&this->mutex);
+    return this->limit;
+}
+
+uint64_t DownloadLimiter::getPeakDownloads() {
+    UniqueLock lock(&this->mutex);
+    return this->peakDownloads;
+}
+
 ChunkBuffer::ChunkBuffer(const S3Url& s3Url, S3KeyReader& reader, const S3MemoryContext& context)
     : s3Url(s3Url), chunkData(context), offsetMgr(reader.getOffsetMgr()), sharedKeyReader(reader) {
     s3Interface = NULL;
@@ -49,13 +174,9 @@ ChunkBuffer& ChunkBuffer::operator=(const ChunkBuffer& other) {
     return *this;
 }
 
-// ret < len means EMPTY
-// that's why it checks if leftLen is larger than *or equal to* len below[1], provides a chance ret
-// is 0, which is smaller than len. Otherwise, other functions won't know when to read next buffer.
-uint64_t ChunkBuffer::read(char* buf, uint64_t len) {
-    // GPDB abort signal stops s3_import(), this check is not needed if s3_import() every time calls
-    // ChunkBuffer->Read() only once, otherwise(as we did in downstreamReader->read() for
-    // decompression feature before), first call sets buffer to ReadyToFill, second call hangs.
+uint64_t ChunkBuffer::lease(const char** data) {
+    // GPDB abort signal stops s3_import(), otherwise a query canceled while waiting for a chunk
+    // hangs until the download finishes.
     S3_CHECK_OR_DIE(!S3QueryIsAbortInProgress(), S3QueryAbort, "");
 
     UniqueLock statusLock(&this->statusMutex);
@@ -68,33 +189,31 @@ uint64_t ChunkBuffer::read(char* buf, uint64_t len) {
         return 0;
     }
 
-    uint64_t leftLen = this->chunkDataSize - this->curChunkOffset;
-    uint64_t lenToRead = std::min(len, leftLen);
+    *data = (const char*)this->chunkData.data() + this->curChunkOffset;
+    uint64_t len = this->chunkDataSize - this->curChunkOffset;
+    this->curChunkOffset = this->chunkDataSize;
 
-    if (lenToRead != 0) {
-        memcpy(buf, this->chunkData.data() + this->curChunkOffset, lenToRead);
-    }
+    return len;
+}
 
-    if (len <= leftLen) {                   // [1]
-        this->curChunkOffset += lenToRead;  // not empty
-    } else {                                // empty, reset everything
-        this->curChunkOffset = 0;
+// Hand the chunk back to the downloading thread, to be filled with the next part of the key.
+void ChunkBuffer::release() {
+    UniqueLock statusLock(&this->statusMutex);
 
-        if (!this->isEOF()) {
-            // Release chunkData memory to reduce consumption.
-            this->chunkData.release();
+    this->curChunkOffset = 0;
 
-            this->status = ReadyToFill;
+    if (!this->isEOF()) {
+        // Release chunkData memory to reduce consumption.
+        this->chunkData.release();
 
-            Range range = this->offsetMgr.getNextOffset();
-            this->curFileOffset = range.offset;
-            this->chunkDataSize = range.length;
+        this->status = ReadyToFill;
 
-            pthread_cond_signal(&this->statusCondVar);
-        }
-    }
+        Range range = this->offsetMgr.getNextOffset();
+        this->curFileOffset = range.offset;
+        this->chunkDataSize = range.length;
 
-    return lenToRead;
+        pthread_cond_signal(&this->statusCondVar);
+    }
 }
 
 // returning uint64_t(-1) means error
@@ -117,7 +236,15 @@ uint64_t ChunkBuffer::fill() {
 
     uint64_t readLen = 0;
 
-    if (leftLen != 0) {
+    DownloadLimiter& limiter = this->sharedKeyReader.getDownloadLimiter();
+    uint64_t chunkIndex =
+        (offset - this->sharedKeyReader.getKeyOffset()) / this->offsetMgr.getChunkSize();
+
+    if (leftLen != 0 && limiter.acquire(chunkIndex)) {
+        struct timeval startTime;
+        gettimeofday(&startTime, NULL);
+        uint64_t slowDowns = this->s3Interface->getSlowDownCount();
+
         try {
             readLen = this->s3Interface->fetchData(offset, this->chunkData, leftLen, this->s3Url);
             if (readLen != leftLen) {
@@ -130,6 +257,13 @@ uint64_t ChunkBuffer::fill() {
             S3DEBUG("Failed to fetch expected data from S3");
             this->setSharedError(true);
         }
+
+        struct timeval endTime;
+        gettimeofday(&endTime, NULL);
+        limiter.release(this->isError() ? 0 : readLen,
+                        (endTime.tv_sec - startTime.tv_sec) +
+                            (endTime.tv_usec - startTime.tv_usec) / 1e6,
+                        slowDowns, this->s3Interface->getSlowDownCount());
     }
 
     if (offset + leftLen >= offsetMgr.getKeySize()) {
@@ -189,11 +323,27 @@ void S3KeyReader::open(const S3Params& params) {
     this->numOfChunks = params.getNumOfChunks();
     S3_CHECK_OR_DIE(this->numOfChunks > 0, S3RuntimeError, "numOfChunks must not be zero");
 
+    this->keyOffset = std::min(params.getKeyOffset(), params.getKeySize());
+
+    uint64_t chunkSize = params.getChunkSize();
+    S3_CHECK_OR_DIE(chunkSize > 0, S3RuntimeError, "chunk size must be greater than zero");
+
+    if (params.isAdaptiveDownload()) {
+        // Spread the key over the threads, in chunks not smaller than S3_MIN_ADAPTIVE_CHUNKSIZE,
+        // and only start the threads there are chunks for.
+        uint64_t len = params.getKeySize() - this->keyOffset;
+        uint64_t spreadSize = (len + this->numOfChunks - 1) / this->numOfChunks;
+        chunkSize = std::min(chunkSize, std::max(spreadSize, (uint64_t)S3_MIN_ADAPTIVE_CHUNKSIZE));
+        this->numOfChunks =
+            std::max(std::min(this->numOfChunks, (len + chunkSize - 1) / chunkSize), (uint64_t)1);
+    }
+
     this->offsetMgr.setKeySize(params.getKeySize());
-    this->offsetMgr.setChunkSize(params.getChunkSize());
+    this->offsetMgr.setChunkSize(chunkSize);
+    this->offsetMgr.setCurPos(this->keyOffset);
 
-    S3_CHECK_OR_DIE(params.getChunkSize() > 0, S3RuntimeError,
-                    "chunk size must be greater than zero");
+    this->keyUrl = params.getS3Url().getFullUrlForCurl();
+    this->downloadLimiter.reset(this->numOfChunks, params.isAdaptiveDownload());
 
     this->chunkBuffers.reserve(this->numOfChunks);
 
@@ -210,28 +360,30 @@ void S3KeyReader::open(const S3Params& params) {
     }
 }
 
-uint64_t S3KeyReader::read(char* buf, uint64_t count) {
-    uint64_t fileLen = this->offsetMgr.getKeySize();
-    uint64_t readLen = 0;
+// Lease the next non-empty chunk of the key, or the EOL appended to the key, and make it the view.
+// Return 0 if EOF.
+uint64_t S3KeyReader::nextView() {
+    uint64_t fileLen = this->offsetMgr.getKeySize() - this->keyOffset;
 
-    do {
+    this->viewOffset = 0;
+    this->viewLen = 0;
+
+    while (true) {
         // confirm there is no more available data, done with this file
         if (this->transferredKeyLen >= fileLen) {
-            if (!this->hasEol && !this->eolAppended) {
-                uint64_t eolLen = strlen(eolString);
-                memcpy(buf, eolString, eolLen);
-
+            if (this->appendEol && !this->hasEol && !this->eolAppended) {
                 this->eolAppended = true;
 
-                return eolLen;
+                this->viewData = eolString;
+                this->viewLen = strlen(eolString);
             }
 
-            return 0;
+            return this->viewLen;
         }
 
         ChunkBuffer& buffer = chunkBuffers[this->curReadingChunk % this->numOfChunks];
 
-        readLen = buffer.read(buf, count);
+        uint64_t len = buffer.lease(&this->viewData);
 
         if (this->isSharedError()) {
             if (this->sharedException != NULL) {
@@ -241,35 +393,100 @@ uint64_t S3KeyReader::read(char* buf, uint64_t count) {
             }
         }
 
-        this->transferredKeyLen += readLen;
+        this->leasedChunk = &buffer;
+
+        // the chunk is empty when thread reading is finished
+        if (len == 0) {
+            this->releaseView();
+            continue;
+        }
+
+        this->transferredKeyLen += len;
         if (this->transferredKeyLen == fileLen) {
-            if (buf[readLen - 1] == '\r' || buf[readLen - 1] == '\n') {
+            if (this->viewData[len - 1] == '\r' || this->viewData[len - 1] == '\n') {
                 this->hasEol = true;
             }
         }
 
-        if (readLen < count) {
-            this->curReadingChunk++;
+        this->viewLen = len;
+        return len;
+    }
+}
+
+// Give the chunk of the view back to its downloading thread and move on to the next chunk.
+void S3KeyReader::releaseView() {
+    if (this->leasedChunk != NULL) {
+        this->leasedChunk->release();
+        this->leasedChunk = NULL;
+        this->curReadingChunk++;
+    }
+}
+
+uint64_t S3KeyReader::read(char* buf, uint64_t count) {
+    // GPDB abort signal stops s3_import(), check it even if the data is at hand.
+    S3_CHECK_OR_DIE(!S3QueryIsAbortInProgress(), S3QueryAbort, "");
+
+    if (this->viewOffset == this->viewLen) {
+        this->releaseView();
+
+        if (this->nextView() == 0) {
+            return 0;
         }
+    }
 
-        count -= readLen;
-    } while (readLen == 0);  // retry to confirm whether thread reading is finished or chunk size is
-                             // divisible by get()'s buffer size
+    uint64_t readLen = std::min(count, this->viewLen - this->viewOffset);
+    memcpy(buf, this->viewData + this->viewOffset, readLen);
+    this->viewOffset += readLen;
+
+    // let the downloading thread refill the chunk while the caller consumes the data
+    if (this->viewOffset == this->viewLen) {
+        this->releaseView();
+    }
 
     return readLen;
 }
 
+// The view is the rest of the current chunk if read() has started it, the next chunk otherwise.
+uint64_t S3KeyReader::lease(const char** data) {
+    S3_CHECK_OR_DIE(!S3QueryIsAbortInProgress(), S3QueryAbort, "");
+
+    if (this->viewOffset == this->viewLen) {
+        this->releaseView();
+
+        if (this->nextView() == 0) {
+            return 0;
+        }
+    }
+
+    *data = this->viewData + this->viewOffset;
+    uint64_t len = this->viewLen - this->viewOffset;
+    this->viewOffset = this->viewLen;
+
+    return len;
+}
+
+void S3KeyReader::release() {
+    this->releaseView();
+}
+
 // reset marks before reading next key
 void S3KeyReader::reset() {
     this->sharedError = false;
     this->curReadingChunk = 0;
+    this->keyOffset = 0;
     this->transferredKeyLen = 0;
 
     this->offsetMgr.reset();
+    this->downloadLimiter.reset(1, false);
 
     this->chunkBuffers.clear();
     this->threads.clear();
 
+    this->viewData = NULL;
+    this->viewLen = 0;
+    this->viewOffset = 0;
+    this->leasedChunk = NULL;
+
     this->hasEol = false;
     this->eolAppended = false;
 }
@@ -279,6 +496,7 @@ void S3KeyReader::close() {
     // 1. set condition to ReadyToFill and signal conditional_variable.
     // 2. set the shared error status to prevent download thread from continuing.
     this->sharedError = true;
+    this->downloadLimiter.stop();
 
     for (uint64_t i = 0; i < this->chunkBuffers.size(); i++) {
         UniqueLock lock(this->chunkBuffers[i].getStatMutex());
@@ -296,5 +514,7 @@ void S3KeyReader::close() {
         this->threads[i] = 0;
     }
 
+    this->downloadLimiter.logStats(this->keyUrl);
+
     this->reset();
 }
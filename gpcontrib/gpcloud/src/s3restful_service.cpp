@@ -3,29 +3,36 @@
 S3RESTfulService::S3RESTfulService()
     : lowSpeedLimit(0),
       lowSpeedTime(0),
+      connectionIdleTime(0),
       proxy(""),
       debugCurl(false),
       verifyCert(true),
       chunkBufferSize(64 * 1024) {
+    pthread_mutex_init(&this->idleHandlesLock, NULL);
 }
 
 S3RESTfulService::S3RESTfulService(const string &proxy)
     : lowSpeedLimit(0),
       lowSpeedTime(0),
+      connectionIdleTime(0),
       proxy(proxy),
       debugCurl(false),
       verifyCert(true),
       chunkBufferSize(64 * 1024) {
+    pthread_mutex_init(&this->idleHandlesLock, NULL);
 }
 
 S3RESTfulService::S3RESTfulService(const S3Params &params)
     : s3MemContext(const_cast<S3MemoryContext &>(params.getMemoryContext())) {
+    pthread_mutex_init(&this->idleHandlesLock, NULL);
+
     // This function is not thread safe, must NOT call it when any other
     // threads are running, that is, do NOT put it in threads.
     curl_global_init(CURL_GLOBAL_ALL);
 
     this->lowSpeedLimit = params.getLowSpeedLimit();
     this->lowSpeedTime = params.getLowSpeedTime();
+    this->connectionIdleTime = params.getConnectionIdleTime();
     this->debugCurl = params.isDebugCurl();
     this->chunkBufferSize = params.getChunkSize();
     this->verifyCert = params.isVerifyCert();
@@ -33,6 +40,11 @@ S3RESTfulService::S3RESTfulService(const S3Params &params)
 }
 
 S3RESTfulService::~S3RESTfulService() {
+    for (size_t i = 0; i < this->idleHandles.size(); i++) {
+        curl_easy_cleanup(this->idleHandles[i].curl);
+    }
+    pthread_mutex_destroy(&this->idleHandlesLock);
+
     // This function is not thread safe, must NOT call it when any other
     // threads are running, that is, do NOT put it in threads.
     curl_global_cleanup();
@@ -94,32 +106,90 @@ static size_t RESTfulServiceReadFuncCallback(char *ptr, size_t size, size_t nmem
     return copiedItemNum;
 }
 
+// Take the most recently used idle handle, or a new one if there is none. Handles idle for longer
+// than connectionIdleTime are closed, the server may have dropped their connections already.
+CURL *S3RESTfulService::acquireHandle() {
+    CURL *curl = NULL;
+    vector<IdleHandle> expiredHandles;
+
+    {
+        UniqueLock lock(&this->idleHandlesLock);
+
+        if (!this->idleHandles.empty()) {
+            IdleHandle &handle = this->idleHandles.back();
+            if (time(NULL) - handle.lastUsed < (time_t) this->connectionIdleTime) {
+                curl = handle.curl;
+                this->idleHandles.pop_back();
+            } else {
+                // the others have been idle even longer
+                expiredHandles.swap(this->idleHandles);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < expiredHandles.size(); i++) {
+        curl_easy_cleanup(expiredHandles[i].curl);
+    }
+
+    if (curl == NULL) {
+        return curl_easy_init();
+    }
+
+    // Reset the options of the previous request, the connection is kept.
+    curl_easy_reset(curl);
+    return curl;
+}
+
+// Keep the handle for later requests, unless its request failed. After an error the state of the
+// connection is unknown, the next request will connect again.
+void S3RESTfulService::releaseHandle(CURL *curl, bool reusable) {
+    if (curl == NULL) {
+        return;
+    }
+
+    if (!reusable || this->connectionIdleTime == 0) {
+        curl_easy_cleanup(curl);
+        return;
+    }
+
+    IdleHandle handle = {curl, time(NULL)};
+
+    UniqueLock lock(&this->idleHandlesLock);
+    this->idleHandles.push_back(handle);
+}
+
 struct CURLWrapper {
-    CURLWrapper(const string &url, curl_slist *headers, uint64_t lowSpeedLimit,
-                uint64_t lowSpeedTime, bool debugCurl, string proxy) {
-        curl = curl_easy_init();
+    CURLWrapper(S3RESTfulService *service, const string &url, curl_slist *headers)
+        : service(service), reusable(false) {
+        curl = service->acquireHandle();
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, 1L);
         curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, lowSpeedLimit);
-        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, lowSpeedTime);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, service->lowSpeedLimit);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, service->lowSpeedTime);
 
-        if (debugCurl) {
+        if (service->connectionIdleTime == 0) {
+            curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, 1L);
+        }
+
+        if (service->debugCurl) {
             curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
         }
 
-        if (!proxy.empty()) {
-            curl_easy_setopt(curl, CURLOPT_PROXY, proxy.c_str());
+        if (!service->proxy.empty()) {
+            curl_easy_setopt(curl, CURLOPT_PROXY, service->proxy.c_str());
         }
     }
     ~CURLWrapper() {
-        curl_easy_cleanup(curl);
+        service->releaseHandle(curl, reusable);
     }
+    S3RESTfulService *service;
     CURL *curl;
+    bool reusable;  // whether the request completed, so the connection can be reused
 };
 
-void S3RESTfulService::performCurl(CURL *curl, Response &response) {
+void S3RESTfulService::performCurl(CURLWrapper &wrapper, Response &response) {
+    CURL *curl = wrapper.curl;
     CURLcode res = curl_easy_perform(curl);
     if (res != CURLE_OK) {
         if (res == CURLE_COULDNT_RESOLVE_HOST || res == CURLE_COULDNT_RESOLVE_PROXY) {
@@ -130,6 +200,8 @@ void S3RESTfulService::performCurl(CURL *curl, Response &response) {
             S3_DIE(S3ConnectionError, curl_easy_strerror(res));
         }
     } else {
+        wrapper.reusable = true;
+
         long responseCode;
         // Get the HTTP response status code from HTTP header
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
@@ -148,15 +220,14 @@ Response S3RESTfulService::get(const string &url, HTTPHeaders &headers) {
     response.getRawData().reserve(this->chunkBufferSize);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, RESTfulServiceWriteFuncCallback);
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, this->verifyCert);
 
-    this->performCurl(curl, response);
+    this->performCurl(wrapper, response);
 
     if (response.getStatus() == RESPONSE_OK) {
 	return response;
@@ -165,7 +236,10 @@ Response S3RESTfulService::get(const string &url, HTTPHeaders &headers) {
     S3MessageParser s3msg(response);
     ResponseCode responseCode = response.getResponseCode();
 
-    if ((responseCode == 500) || (responseCode == 503)) {
+    if (responseCode == 503) {
+        S3_DIE(S3SlowDownError, s3msg.getMessage());
+    }
+    if (responseCode == 500) {
         S3_DIE(S3ConnectionError, s3msg.getMessage());
     }
     if (responseCode == 400) {
@@ -181,8 +255,7 @@ Response S3RESTfulService::put(const string &url, HTTPHeaders &headers, const S3
     Response response(RESPONSE_ERROR);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response);
@@ -198,7 +271,7 @@ Response S3RESTfulService::put(const string &url, HTTPHeaders &headers, const S3
     curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)&response);
     curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, RESTfulServiceHeadersWriteFuncCallback);
 
-    this->performCurl(curl, response);
+    this->performCurl(wrapper, response);
 
     S3MessageParser s3msg(response);
     ResponseCode responseCode = response.getResponseCode();
@@ -224,8 +297,7 @@ Response S3RESTfulService::post(const string &url, HTTPHeaders &headers,
     Response response(RESPONSE_ERROR);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response);
@@ -239,7 +311,7 @@ Response S3RESTfulService::post(const string &url, HTTPHeaders &headers,
     curl_easy_setopt(curl, CURLOPT_READFUNCTION, RESTfulServiceReadFuncCallback);
     curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, (curl_off_t)data.size());
 
-    this->performCurl(curl, response);
+    this->performCurl(wrapper, response);
 
     if (response.getStatus() == RESPONSE_OK) {
 	return response;
@@ -269,15 +341,14 @@ ResponseCode S3RESTfulService::head(const string &url, HTTPHeaders &headers) {
     Response response(RESPONSE_ERROR);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "HEAD");
     curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, this->verifyCert);
 
-    this->performCurl(curl, response);
+    this->performCurl(wrapper, response);
 
     if (response.getStatus() == RESPONSE_OK) {
 	return response.getResponseCode();
@@ -302,8 +373,7 @@ Response S3RESTfulService::deleteRequest(const string &url, HTTPHeaders &headers
     Response response(RESPONSE_ERROR);
 
     headers.CreateList();
-    CURLWrapper wrapper(url, headers.GetList(), this->lowSpeedLimit, this->lowSpeedTime,
-                        this->debugCurl, this->proxy);
+    CURLWrapper wrapper(this, url, headers.GetList());
     CURL *curl = wrapper.curl;
 
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)&response);
@@ -317,7 +387,7 @@ Response S3RESTfulService::deleteRequest(const string &url, HTTPHeaders &headers
     curl_easy_setopt(curl, CURLOPT_READFUNCTION, RESTfulServiceReadFuncCallback);
     curl_easy_setopt(curl, CURLOPT_INFILESIZE_LARGE, (curl_off_t)data.size());
 
-    this->performCurl(curl, response);
+    this->performCurl(wrapper, response);
 
     if (response.getStatus() == RESPONSE_OK) {
 	return response;
@@ -0,0 +1,88 @@
+#include "zstd_compress_writer.h"
+
+#ifdef HAVE_LIBZSTD
+
+ZstdCompressWriter::ZstdCompressWriter() : writer(NULL), cctx(NULL) {
+    this->out.resize(ZSTD_CStreamOutSize());
+}
+
+ZstdCompressWriter::~ZstdCompressWriter() {
+    try {
+        this->close();
+    } catch (...) {
+    }
+
+    if (this->cctx != NULL) {
+        ZSTD_freeCCtx(this->cctx);
+    }
+}
+
+void ZstdCompressWriter::setWriter(Writer *writer) {
+    this->writer = writer;
+}
+
+void ZstdCompressWriter::open(const S3Params &params) {
+    this->cctx = ZSTD_createCCtx();
+    S3_CHECK_OR_DIE(this->cctx != NULL, S3RuntimeError, "failed to initialize zstd library");
+
+    ZSTD_CCtx_setParameter(this->cctx, ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+    ZSTD_CCtx_setParameter(this->cctx, ZSTD_c_checksumFlag, 1);
+
+    if (params.getCompressThreads() > 1) {
+        size_t ret = ZSTD_CCtx_setParameter(this->cctx, ZSTD_c_nbWorkers,
+                                            params.getCompressThreads());
+        if (ZSTD_isError(ret)) {
+            S3WARN("zstd library is built without threads, compress_threads is ignored: %s",
+                   ZSTD_getErrorName(ret));
+        }
+    }
+
+    this->writer->open(params);
+}
+
+size_t ZstdCompressWriter::compress(ZSTD_inBuffer &input, ZSTD_EndDirective mode) {
+    size_t ret;
+    do {
+        ZSTD_outBuffer output = {this->out.data(), this->out.size(), 0};
+
+        ret = ZSTD_compressStream2(this->cctx, &output, &input, mode);
+        S3_CHECK_OR_DIE(!ZSTD_isError(ret), S3RuntimeError,
+                        string("Failed to compress data: ") + ZSTD_getErrorName(ret));
+
+        if (output.pos > 0) {
+            this->writer->write(this->out.data(), output.pos);
+        }
+    } while (input.pos < input.size);
+
+    return ret;
+}
+
+uint64_t ZstdCompressWriter::write(const char *buf, uint64_t count) {
+    // Defensive code
+    if (buf == NULL || count == 0) {
+        return 0;
+    }
+
+    ZSTD_inBuffer input = {buf, count, 0};
+    this->compress(input, ZSTD_e_continue);
+
+    return count;
+}
+
+void ZstdCompressWriter::close() {
+    if (this->cctx == NULL) {
+        return;
+    }
+
+    // ZSTD_e_end returns the size of the data left to flush, loop until the frame is complete.
+    ZSTD_inBuffer input = {NULL, 0, 0};
+    while (this->compress(input, ZSTD_e_end) != 0) {
+    }
+
+    ZSTD_freeCCtx(this->cctx);
+    this->cctx = NULL;
+
+    this->writer->close();
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include "zstd_decompress_reader.h"
+
+#ifdef HAVE_LIBZSTD
+
+ZstdDecompressReader::ZstdDecompressReader()
+    : reader(NULL), leasing(false), dctx(NULL), hint(0), outputPending(false) {
+    this->in.resize(ZSTD_DStreamInSize());
+    this->input.src = this->in.data();
+    this->input.size = 0;
+    this->input.pos = 0;
+}
+
+ZstdDecompressReader::~ZstdDecompressReader() {
+    this->close();
+}
+
+void ZstdDecompressReader::setReader(Reader *reader) {
+    this->reader = reader;
+}
+
+void ZstdDecompressReader::open(const S3Params &params) {
+    this->dctx = ZSTD_createDCtx();
+    S3_CHECK_OR_DIE(this->dctx != NULL, S3RuntimeError, "failed to initialize zstd library");
+
+    this->input.size = 0;
+    this->input.pos = 0;
+    this->hint = 0;
+    this->outputPending = false;
+
+    this->reader->open(params);
+    this->leasing = this->reader->canLease();
+}
+
+// Decompress straight into buf, there is no output buffer to copy from.
+uint64_t ZstdDecompressReader::read(char *buf, uint64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    ZSTD_outBuffer output = {buf, count, 0};
+    while (output.pos == 0) {
+        if (this->input.pos == this->input.size && !this->outputPending) {
+            const char *data = this->in.data();
+            uint64_t hasRead;
+            if (this->leasing) {
+                // all the data of the previous view is consumed
+                this->reader->release();
+                hasRead = this->reader->lease(&data);
+            } else {
+                hasRead = this->reader->read(this->in.data(), this->in.size());
+            }
+
+            // EOF, no more data to decompress.
+            if (hasRead == 0) {
+                S3_CHECK_OR_DIE(this->hint == 0, S3RuntimeError,
+                                "Failed to decompress data: zstd frame is truncated");
+                return 0;
+            }
+
+            this->input.src = data;
+            this->input.size = hasRead;
+            this->input.pos = 0;
+        }
+
+        this->hint = ZSTD_decompressStream(this->dctx, &output, &this->input);
+        S3_CHECK_OR_DIE(!ZSTD_isError(this->hint), S3RuntimeError,
+                        string("Failed to decompress data: ") + ZSTD_getErrorName(this->hint));
+
+        // a full output buffer may leave data inside zstd, get it before reading more input
+        this->outputPending = (output.pos == output.size);
+    }
+
+    return output.pos;
+}
+
+void ZstdDecompressReader::close() {
+    if (this->dctx != NULL) {
+        ZSTD_freeDCtx(this->dctx);
+        this->dctx = NULL;
+        if (this->leasing) {
+            this->reader->release();
+        }
+        this->reader->close();
+    }
+}
+
+#endif
@@ -210,3 +210,111 @@ TEST_F(CompressWriterTest, CompressCompressedData) {
 
     EXPECT_TRUE(memcmp(compressedData.data(), result.get(), compressedData.size()) == 0);
 }
+
+class ParallelCompressWriterTest : public CompressWriterTest {
+   protected:
+    virtual void SetUp() {
+        S3Params params("s3://abc/def/");
+        params.setCompressThreads(4);
+
+        compressWriter.setWriter(&writer);
+        compressWriter.open(params);
+
+        this->out = new Byte[S3_ZIP_DECOMPRESS_CHUNKSIZE];
+    }
+
+    // Uncompress the whole gzip stream, reaching its end verifies the crc32 and the size.
+    string uncompressAll() {
+        z_stream zstream;
+        zstream.zalloc = Z_NULL;
+        zstream.zfree = Z_NULL;
+        zstream.opaque = Z_NULL;
+
+        int ret = inflateInit2(&zstream, S3_INFLATE_WINDOWSBITS);
+        S3_CHECK_OR_DIE(ret == Z_OK, S3RuntimeError, "failed to initialize zlib library");
+
+        zstream.next_in = (Byte *)writer.getRawData();
+        zstream.avail_in = writer.getDataSize();
+
+        string result;
+        do {
+            zstream.next_out = this->out;
+            zstream.avail_out = S3_ZIP_DECOMPRESS_CHUNKSIZE;
+            ret = inflate(&zstream, Z_NO_FLUSH);
+            result.append((const char *)this->out, S3_ZIP_DECOMPRESS_CHUNKSIZE - zstream.avail_out);
+        } while (ret == Z_OK);
+
+        EXPECT_EQ(Z_STREAM_END, ret);
+        EXPECT_EQ((uInt)0, zstream.avail_in);
+        inflateEnd(&zstream);
+
+        return result;
+    }
+};
+
+TEST_F(ParallelCompressWriterTest, AbleToCompressEmptyData) {
+    compressWriter.close();
+
+    EXPECT_EQ("", this->uncompressAll());
+}
+
+TEST_F(ParallelCompressWriterTest, AbleToCompressOneSmallString) {
+    const char input[] = "The quick brown fox jumps over the lazy dog";
+
+    compressWriter.write(input, sizeof(input));
+    compressWriter.close();
+    compressWriter.close();
+
+    EXPECT_EQ(string(input, sizeof(input)), this->uncompressAll());
+}
+
+TEST_F(ParallelCompressWriterTest, AbleToWriteManyBlocks) {
+    string input;
+    for (uint64_t i = 0; input.size() < S3_ZIP_COMPRESS_CHUNKSIZE * 10 + 12345; i++) {
+        input.append(std::to_string(i)).append("|The quick brown fox jumps over the lazy dog\n");
+    }
+
+    // writes not aligned with the blocks
+    for (uint64_t offset = 0; offset < input.size(); offset += 1000003) {
+        uint64_t len = std::min<uint64_t>(1000003, input.size() - offset);
+        compressWriter.write(input.data() + offset, len);
+    }
+    compressWriter.close();
+
+    EXPECT_LT(writer.getDataSize(), input.size() / 2);
+    EXPECT_TRUE(input == this->uncompressAll());
+}
+
+TEST_F(ParallelCompressWriterTest, AbleToCompressIncompressibleData) {
+    std::default_random_engine re(42);
+
+    string input(S3_ZIP_COMPRESS_CHUNKSIZE * 3 + 7, '\0');
+    for (uint64_t i = 0; i < input.size(); i++) {
+        input[i] = (char)re();
+    }
+
+    compressWriter.write(input.data(), input.size());
+    compressWriter.close();
+
+    EXPECT_TRUE(input == this->uncompressAll());
+}
+
+TEST_F(ParallelCompressWriterTest, AbleToReopenAfterClose) {
+    const char input[] = "The quick brown fox jumps over the lazy dog";
+
+    compressWriter.write(input, sizeof(input));
+    compressWriter.close();
+    EXPECT_EQ(string(input, sizeof(input)), this->uncompressAll());
+
+    writer.getRawDataVector().clear();
+
+    S3Params params("s3://abc/def/");
+    params.setCompressThreads(4);
+    compressWriter.open(params);
+
+    string second(S3_ZIP_COMPRESS_CHUNKSIZE * 2 + 3, 'x');
+    compressWriter.write(second.data(), second.size());
+    compressWriter.close();
+
+    EXPECT_TRUE(second == this->uncompressAll());
+}
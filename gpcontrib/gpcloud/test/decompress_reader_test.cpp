@@ -311,3 +311,142 @@ TEST_F(DecompressReaderTest, AbleToDecompressWithIncorrectEncodedStream) {
 
     EXPECT_THROW(decompressReader.read(outputBuffer, sizeof(outputBuffer)), S3RuntimeError);
 }
+
+// Append data compressed as a whole gzip member to members.
+static void appendGzipMember(vector<uint8_t> &members, const char *data, uint64_t len) {
+    z_stream zstream;
+    zstream.zalloc = Z_NULL;
+    zstream.zfree = Z_NULL;
+    zstream.opaque = Z_NULL;
+    ASSERT_EQ(Z_OK, deflateInit2(&zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                 S3_DEFLATE_WINDOWSBITS, 8, Z_DEFAULT_STRATEGY));
+
+    vector<uint8_t> out(deflateBound(&zstream, len));
+    zstream.next_in = (Bytef *)data;
+    zstream.avail_in = len;
+    zstream.next_out = out.data();
+    zstream.avail_out = out.size();
+    ASSERT_EQ(Z_STREAM_END, deflate(&zstream, Z_FINISH));
+
+    members.insert(members.end(), out.begin(), out.begin() + zstream.total_out);
+    deflateEnd(&zstream);
+}
+
+TEST_F(DecompressReaderTest, AbleToDecompressConcatenatedGzipMembers) {
+    S3_ZIP_DECOMPRESS_CHUNKSIZE = 16;
+    decompressReader.resizeDecompressReaderBuffer(S3_ZIP_DECOMPRESS_CHUNKSIZE);
+
+    const char first[] = "The quick brown fox ";
+    const char second[] = "jumps over the lazy dog";
+    vector<uint8_t> members;
+    appendGzipMember(members, first, strlen(first));
+    appendGzipMember(members, second, strlen(second));
+    appendGzipMember(members, "", 0);
+    appendGzipMember(members, second, strlen(second));
+    bufReader.setData(members.data(), members.size());
+
+    string result;
+    char outputBuffer[10];
+    uint64_t count;
+    while ((count = decompressReader.read(outputBuffer, sizeof(outputBuffer))) > 0) {
+        result.append(outputBuffer, count);
+    }
+
+    EXPECT_EQ(string(first) + second + second, result);
+    EXPECT_EQ((uint64_t)0, decompressReader.read(outputBuffer, sizeof(outputBuffer)));
+}
+
+TEST_F(DecompressReaderTest, IgnoreTrailingGarbageAfterGzipMembers) {
+    const char hello[] = "The quick brown fox jumps over the lazy dog";
+    vector<uint8_t> members;
+    appendGzipMember(members, hello, strlen(hello));
+    members.insert(members.end(), 512, 0);
+    bufReader.setData(members.data(), members.size());
+
+    char outputBuffer[10000];
+    EXPECT_EQ(strlen(hello), decompressReader.read(outputBuffer, sizeof(outputBuffer)));
+    EXPECT_EQ(0, strncmp(hello, outputBuffer, strlen(hello)));
+    EXPECT_EQ((uint64_t)0, decompressReader.read(outputBuffer, sizeof(outputBuffer)));
+}
+
+TEST_F(DecompressReaderTest, CloseWhileDecompressingAhead) {
+    S3_ZIP_DECOMPRESS_CHUNKSIZE = 16;
+    decompressReader.resizeDecompressReaderBuffer(S3_ZIP_DECOMPRESS_CHUNKSIZE);
+
+    string data(4096, 'x');
+    vector<uint8_t> members;
+    appendGzipMember(members, data.c_str(), data.size());
+    bufReader.setData(members.data(), members.size());
+
+    char outputBuffer[4];
+    EXPECT_EQ((uint64_t)4, decompressReader.read(outputBuffer, sizeof(outputBuffer)));
+
+    // the thread has decompressed the next chunk and waits, close() should not hang
+    decompressReader.close();
+}
+
+// Lease the data in pieces of chunkSize bytes, like S3KeyReader hands out its chunks.
+class MockLeaseReader : public MockBufferReader {
+   public:
+    MockLeaseReader() : leases(0), releases(0), leased(false) {
+    }
+
+    bool canLease() {
+        return true;
+    }
+
+    uint64_t lease(const char **data) {
+        EXPECT_FALSE(this->leased);
+        this->piece.resize(1024);
+        uint64_t size = this->read(this->piece.data(), this->piece.size());
+        *data = this->piece.data();
+        this->leases++;
+        this->leased = true;
+        return size;
+    }
+
+    void release() {
+        if (this->leased) {
+            // the view must not be used after release()
+            memset(this->piece.data(), 0, this->piece.size());
+            this->releases++;
+            this->leased = false;
+        }
+    }
+
+    uint64_t leases;
+    uint64_t releases;
+    bool leased;
+
+   private:
+    vector<char> piece;
+};
+
+TEST(DecompressReader, AbleToDecompressLeasedData) {
+    string data;
+    for (int i = 0; i < 10000; i++) {
+        data += std::to_string(i) + "\n";
+    }
+    vector<uint8_t> members;
+    appendGzipMember(members, data.c_str(), data.size());
+
+    MockLeaseReader leaseReader;
+    leaseReader.setChunkSize(100);
+    leaseReader.setData(members.data(), members.size());
+
+    DecompressReader reader;
+    reader.setReader(&leaseReader);
+    reader.open(S3Params("s3://abc/def"));
+
+    string result;
+    char outputBuffer[1000];
+    uint64_t count;
+    while ((count = reader.read(outputBuffer, sizeof(outputBuffer))) > 0) {
+        result.append(outputBuffer, count);
+    }
+    reader.close();
+
+    EXPECT_EQ(data, result);
+    EXPECT_LT((uint64_t)1, leaseReader.leases);
+    EXPECT_FALSE(leaseReader.leased);
+}
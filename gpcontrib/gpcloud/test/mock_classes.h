@@ -12,6 +12,8 @@ class MockS3Interface : public S3Interface {
     MOCK_METHOD1(listBucket,
                  ListBucketResult(S3Url &));
 
+    MOCK_METHOD3(listBucketPage, void(const S3Url &, string &, ListBucketResult &));
+
     MOCK_METHOD4(fetchData,
                  uint64_t(uint64_t , S3VectorUInt8& , uint64_t len, const S3Url &));
 
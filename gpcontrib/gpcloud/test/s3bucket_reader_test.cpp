@@ -1,4 +1,5 @@
 #include "s3bucket_reader.cpp"
+#include <atomic>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "mock_classes.h"
@@ -148,6 +149,191 @@ TEST_F(S3BucketReaderTest, ReaderShouldSkipIfFileIsNotForThisSegment) {
     EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
 }
 
+TEST_F(S3BucketReaderTest, ReaderShouldBalanceKeysBySize) {
+    ListBucketResult result;
+    result.contents.emplace_back("big", 100 * 1024 * 1024);
+    result.contents.emplace_back("small1", 10 * 1024 * 1024);
+    result.contents.emplace_back("small2", 10 * 1024 * 1024);
+    result.contents.emplace_back("small3", 10 * 1024 * 1024);
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+
+    // segment 0 reads "big", segment 1 the three small keys
+    EXPECT_CALL(s3Reader, read(_, _)).Times(3).WillRepeatedly(Return(0));
+    EXPECT_CALL(s3Reader, open(_)).Times(3);
+
+    s3ext_segid = 1;
+    s3ext_segnum = 2;
+
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&s3Reader);
+
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+}
+
+TEST_F(S3BucketReaderTest, ReaderShouldAssignKeysByIndex) {
+    ListBucketResult result;
+    result.contents.emplace_back("big", 100 * 1024 * 1024);
+    result.contents.emplace_back("small1", 10 * 1024 * 1024);
+    result.contents.emplace_back("small2", 10 * 1024 * 1024);
+    result.contents.emplace_back("small3", 10 * 1024 * 1024);
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setKeyDistribution(KEY_DISTRIBUTION_INDEX);
+
+    EXPECT_CALL(s3Interface, listBucketPage(_, _, _))
+        .Times(1)
+        .WillOnce(Invoke([&result](const S3Url&, string& marker, ListBucketResult& page) {
+            page.contents = result.contents;
+            marker = "";
+        }));
+
+    // segment 1 reads "small1" and "small3"
+    EXPECT_CALL(s3Reader, read(_, _)).Times(2).WillRepeatedly(Return(0));
+    EXPECT_CALL(s3Reader, open(_)).Times(2);
+
+    s3ext_segid = 1;
+    s3ext_segnum = 2;
+
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&s3Reader);
+
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+}
+
+TEST_F(S3BucketReaderTest, SegmentsShouldShareListing) {
+    ListBucketResult result;
+    result.contents.emplace_back("key1", 1024);
+    result.contents.emplace_back("key with spaces\nand newline", 2048);
+    result.contents.emplace_back("", 0);
+
+    char listingDir[] = "/tmp/gpcloud_listing_test_XXXXXX";
+    ASSERT_TRUE(mkdtemp(listingDir) != NULL);
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setListingId("1 1 s3://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setSharedListingDir(listingDir);
+
+    // only the first segment lists the bucket
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+    bucketReader->open(params);
+
+    MockS3Interface otherS3Interface;
+    EXPECT_CALL(otherS3Interface, listBucket(_)).Times(0);
+    S3BucketReader otherReader;
+    otherReader.setS3InterfaceService(&otherS3Interface);
+    otherReader.open(params);
+
+    const vector<BucketContent>& contents = otherReader.getKeyList().contents;
+    ASSERT_EQ(result.contents.size(), contents.size());
+    for (uint64_t i = 0; i < contents.size(); i++) {
+        EXPECT_EQ(result.contents[i].getName(), contents[i].getName());
+        EXPECT_EQ(result.contents[i].getSize(), contents[i].getSize());
+    }
+
+    // a different query lists the bucket again
+    params.setListingId("1 2 s3://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+    S3BucketReader thirdReader;
+    thirdReader.setS3InterfaceService(&s3Interface);
+    thirdReader.open(params);
+
+    EXPECT_EQ(0, system((string("rm -rf ") + listingDir).c_str()));
+}
+
+TEST_F(S3BucketReaderTest, SharedListingShouldNotFollowLinks) {
+    ListBucketResult result;
+    result.contents.emplace_back("key1", 1024);
+
+    char listingDir[] = "/tmp/gpcloud_listing_test_XXXXXX";
+    ASSERT_TRUE(mkdtemp(listingDir) != NULL);
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setListingId("1 1 s3://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setSharedListingDir(listingDir);
+
+    char hash[SHA256_DIGEST_STRING_LENGTH];
+    sha256_hex(params.getListingId().c_str(), hash);
+    string path = string(listingDir) + "/" SHARED_LISTING_PREFIX + hash;
+
+    // a planted listing must not be read, nor the file it points to be overwritten
+    string target = string(listingDir) + "/target";
+    FILE* file = fopen(target.c_str(), "w");
+    ASSERT_TRUE(file != NULL);
+    fprintf(file, SHARED_LISTING_MAGIC "\n1\n1 4 evil\n");
+    fclose(file);
+
+    stringstream tmpPath;
+    tmpPath << path << "." << getpid() << ".tmp";
+    ASSERT_EQ(0, symlink(target.c_str(), path.c_str()));
+    ASSERT_EQ(0, symlink(target.c_str(), tmpPath.str().c_str()));
+
+    EXPECT_CALL(s3Interface, listBucket(_)).Times(1).WillOnce(Return(result));
+    bucketReader->open(params);
+
+    ASSERT_EQ((uint64_t)1, bucketReader->getKeyList().contents.size());
+    EXPECT_EQ("key1", bucketReader->getKeyList().contents[0].getName());
+
+    char content[64] = {0};
+    file = fopen(target.c_str(), "r");
+    ASSERT_TRUE(file != NULL);
+    EXPECT_EQ(strlen(SHARED_LISTING_MAGIC "\n1\n1 4 evil\n"),
+              fread(content, 1, sizeof(content) - 1, file));
+    fclose(file);
+
+    EXPECT_EQ(0, system((string("rm -rf ") + listingDir).c_str()));
+}
+
+TEST_F(S3BucketReaderTest, ReaderShouldReadFirstKeyBeforeListingCompletes) {
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setKeyDistribution(KEY_DISTRIBUTION_INDEX);
+
+    std::atomic<bool> firstKeyOpened(false);
+
+    // the second page is only listed once the first key is being read
+    EXPECT_CALL(s3Interface, listBucketPage(_, _, _))
+        .Times(2)
+        .WillOnce(Invoke([](const S3Url&, string& marker, ListBucketResult& page) {
+            page.contents.emplace_back("key1", 1024);
+            marker = "key1";
+        }))
+        .WillOnce(Invoke([&firstKeyOpened](const S3Url&, string& marker, ListBucketResult& page) {
+            for (int i = 0; i < 1000 && !firstKeyOpened; i++) {
+                usleep(1000);
+            }
+            EXPECT_TRUE(firstKeyOpened);
+            page.contents.emplace_back("key2", 1024);
+            marker = "";
+        }));
+
+    EXPECT_CALL(s3Reader, open(_))
+        .Times(2)
+        .WillRepeatedly(Invoke([&firstKeyOpened](const S3Params&) { firstKeyOpened = true; }));
+    EXPECT_CALL(s3Reader, read(_, _)).Times(2).WillRepeatedly(Return(0));
+
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&s3Reader);
+
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+    EXPECT_EQ((uint64_t)2, bucketReader->getKeyList().contents.size());
+}
+
+TEST_F(S3BucketReaderTest, ReaderShouldThrowListingError) {
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setKeyDistribution(KEY_DISTRIBUTION_INDEX);
+
+    EXPECT_CALL(s3Interface, listBucketPage(_, _, _))
+        .Times(1)
+        .WillOnce(Throw(S3RuntimeError("unexpected response status")));
+
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&s3Reader);
+
+    EXPECT_THROW(bucketReader->read(buf, sizeof(buf)), S3RuntimeError);
+}
+
 TEST_F(S3BucketReaderTest, UpstreamReaderThrowException) {
     ListBucketResult result;
     result.contents.emplace_back("foo", 0);
@@ -285,3 +471,138 @@ TEST_F(S3BucketReaderTest, ReadBucketFileWithHeaderAndFuzyMatch) {
     eolString[0] = '\n';
     eolString[1] = '\0';
 }
+
+// Serves the content of a key from the offset in the params, count bytes at most per read.
+class StringReader : public Reader {
+   public:
+    StringReader(const string& content, uint64_t maxCount)
+        : content(content), maxCount(maxCount), pos(0) {
+    }
+
+    void open(const S3Params& params) {
+        pos = params.getKeyOffset();
+    }
+
+    uint64_t read(char* buf, uint64_t count) {
+        uint64_t len = std::min(std::min(count, maxCount), content.size() - pos);
+        memcpy(buf, content.data() + pos, len);
+        pos += len;
+        return len;
+    }
+
+    void close() {
+    }
+
+   private:
+    string content;
+    uint64_t maxCount;
+    uint64_t pos;
+};
+
+// Read the key with the given content on every segment and return the lines read, in order.
+// With a header, the first line read by every segment is dropped, as GPDB does.
+static vector<string> readSplitKey(const string& content, uint64_t splitSize, int32_t segnum,
+                                   uint64_t maxCount) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo", content.size());
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setKeySplitSize(splitSize);
+
+    vector<string> lines;
+    for (s3ext_segid = 0; s3ext_segid < segnum; s3ext_segid++) {
+        s3ext_segnum = segnum;
+
+        MockS3Interface s3Interface;
+        EXPECT_CALL(s3Interface, listBucket(_)).WillOnce(Return(result));
+        EXPECT_CALL(s3Interface, checkCompressionType(_))
+            .WillRepeatedly(Return(S3_COMPRESSION_PLAIN));
+
+        StringReader reader(content, maxCount);
+        S3BucketReader bucketReader;
+        bucketReader.setS3InterfaceService(&s3Interface);
+        bucketReader.open(params);
+        bucketReader.setUpstreamReader(&reader);
+
+        string data;
+        char buf[64];
+        uint64_t len;
+        while ((len = bucketReader.read(buf, sizeof(buf))) != 0) {
+            data.append(buf, len);
+        }
+
+        string eol(eolString);
+        bool skipLine = hasHeader;
+        size_t pos = 0;
+        while (pos < data.size()) {
+            size_t end = data.find(eol, pos);
+            end = (end == string::npos) ? data.size() : end + eol.size();
+            if (!skipLine) {
+                lines.push_back(data.substr(pos, end - pos));
+            }
+            skipLine = false;
+            pos = end;
+        }
+    }
+
+    std::sort(lines.begin(), lines.end());
+    return lines;
+}
+
+TEST_F(S3BucketReaderTest, ReadSplitKeyShouldReadEveryLineOnce) {
+    string content = "aaaa\nbb\ncccccc\nd\n\neeeeeeeeeee\nf\n";
+    vector<string> expected = {"\n", "aaaa\n", "bb\n", "cccccc\n", "d\n", "eeeeeeeeeee\n", "f\n"};
+
+    for (uint64_t splitSize = 1; splitSize <= content.size(); splitSize++) {
+        EXPECT_EQ(expected, readSplitKey(content, splitSize, 3, 64)) << "split size " << splitSize;
+        EXPECT_EQ(expected, readSplitKey(content, splitSize, 5, 3)) << "split size " << splitSize;
+    }
+}
+
+TEST_F(S3BucketReaderTest, ReadSplitKeyShouldReadEveryLineOnceWithCRLF) {
+    eolString[0] = '\r';
+    eolString[1] = '\n';
+    eolString[2] = '\0';
+
+    string content = "aaaa\r\nbb\r\ncccccc\r\nd\r\n\r\neeeeeeeeeee\r\nf";
+    vector<string> expected = {"\r\n", "aaaa\r\n", "bb\r\n", "cccccc\r\n",
+                               "d\r\n", "eeeeeeeeeee\r\n", "f"};
+
+    for (uint64_t splitSize = 1; splitSize <= content.size(); splitSize++) {
+        EXPECT_EQ(expected, readSplitKey(content, splitSize, 4, 64)) << "split size " << splitSize;
+    }
+}
+
+TEST_F(S3BucketReaderTest, ReadSplitKeyWithHeader) {
+    hasHeader = true;
+
+    string content = "header\naaaa\nbb\ncccccc\nd\neeeeeeeeeee\nf\n";
+    vector<string> expected = {"aaaa\n", "bb\n", "cccccc\n", "d\n", "eeeeeeeeeee\n", "f\n"};
+
+    for (uint64_t splitSize = 1; splitSize <= content.size(); splitSize++) {
+        EXPECT_EQ(expected, readSplitKey(content, splitSize, 3, 64)) << "split size " << splitSize;
+    }
+
+    // reset to test following tests
+    hasHeader = false;
+}
+
+TEST_F(S3BucketReaderTest, CompressedKeyShouldNotBeSplit) {
+    ListBucketResult result;
+    result.contents.emplace_back("foo.gz", 100);
+
+    S3Params params("https://s3-us-east-2.amazonaws.com/s3test.pivotal.io/whatever");
+    params.setKeySplitSize(10);
+
+    EXPECT_CALL(s3Interface, listBucket(_)).WillOnce(Return(result));
+    EXPECT_CALL(s3Interface, checkCompressionType(_)).WillOnce(Return(S3_COMPRESSION_GZIP));
+
+    // segment 1 of 2 gets nothing
+    s3ext_segid = 1;
+    s3ext_segnum = 2;
+
+    bucketReader->open(params);
+    bucketReader->setUpstreamReader(&s3Reader);
+
+    EXPECT_EQ((uint64_t)0, bucketReader->read(buf, sizeof(buf)));
+}
@@ -61,6 +61,21 @@ TEST_F(S3CommonReaderTest, OpenPlain) {
     ASSERT_TRUE(NULL != dynamic_cast<S3KeyReader *>(this->upstreamReader));
 }
 
+TEST_F(S3CommonReaderTest, OpenZstd) {
+    EXPECT_CALL(mockS3Interface, checkCompressionType(_)).WillOnce(Return(S3_COMPRESSION_ZSTD));
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(1);
+    params.setChunkSize(1024 * 1024 * 2);
+
+#ifdef HAVE_LIBZSTD
+    this->open(params);
+
+    ASSERT_EQ(this->upstreamReader, &this->zstdDecompressReader);
+#else
+    EXPECT_THROW(this->open(params), S3RuntimeError);
+#endif
+}
+
 TEST_F(S3CommonReaderTest, ReadGZip) {
     Byte compressionBuff[0x100];
     uLong compressedLen = sizeof(compressionBuff);
@@ -86,3 +101,32 @@ TEST_F(S3CommonReaderTest, ReadGZip) {
     EXPECT_EQ((uint64_t)0, this->upstreamReader->read(result, sizeof(result)));
     EXPECT_EQ(0, memcmp(result, hello, sizeof(hello)));
 }
+
+#ifdef HAVE_LIBZSTD
+TEST_F(S3CommonReaderTest, ReadZstd) {
+    Byte compressionBuff[0x100];
+    const char hello[] = "The quick brown fox jumps over the lazy dog";
+
+    uLong compressedLen =
+        ZSTD_compress(compressionBuff, sizeof(compressionBuff), hello, sizeof(hello), 1);
+
+    mockS3Interface.setData(compressionBuff, compressedLen);
+
+    EXPECT_CALL(mockS3Interface, checkCompressionType(_)).WillOnce(Return(S3_COMPRESSION_ZSTD));
+
+    EXPECT_CALL(mockS3Interface, fetchData(_, _, _, _))
+        .WillOnce(Invoke(&mockS3Interface, &MockS3InterfaceForCompressionRead::mockFetchData));
+
+    char result[0x100];
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(1);
+    params.setChunkSize(1024 * 1024 * 2);
+    params.setKeySize(compressedLen);
+    this->open(params);
+
+    // no line terminator is appended to the compressed data
+    EXPECT_EQ(sizeof(hello), this->upstreamReader->read(result, sizeof(result)));
+    EXPECT_EQ((uint64_t)0, this->upstreamReader->read(result, sizeof(result)));
+    EXPECT_EQ(0, memcmp(result, hello, sizeof(hello)));
+}
+#endif
@@ -195,6 +195,39 @@ TEST_F(S3CommonWriteTest, WriteGZipData) {
     EXPECT_STREQ(input, (const char *)this->out);
 }
 
+#ifdef HAVE_LIBZSTD
+TEST_F(S3CommonWriteTest, WriteZstdData) {
+    EXPECT_CALL(mockS3Interface, getUploadId(_))
+        .WillOnce(Invoke(&mockS3Interface, &MockS3InterfaceForCompressionWrite::mockGetUploadId));
+    EXPECT_CALL(mockS3Interface, uploadPartOfData(_, _, _, _))
+        .WillOnce(
+            Invoke(&mockS3Interface, &MockS3InterfaceForCompressionWrite::mockUploadPartOfData));
+    EXPECT_CALL(mockS3Interface, completeMultiPart(_, _, _))
+        .WillOnce(
+            Invoke(&mockS3Interface, &MockS3InterfaceForCompressionWrite::mockCompleteMultiPart));
+
+    S3Params params("s3://abc/def");
+    params.setAutoCompress(true);
+    params.setCompressionType(S3_COMPRESSION_ZSTD);
+    params.setNumOfChunks(1);
+    params.setChunkSize(S3_ZIP_COMPRESS_CHUNKSIZE + 1);
+
+    this->open(params);
+    ASSERT_EQ(this->upstreamWriter, &this->zstdCompressWriter);
+
+    // 44 bytes
+    const char input[] = "The quick brown fox jumps over the lazy dog";
+    this->write(input, sizeof(input));
+    this->close();
+
+    char output[0x100];
+    size_t size = ZSTD_decompress(output, sizeof(output), this->mockS3Interface.getRawData(),
+                                  this->mockS3Interface.getDataSize());
+    ASSERT_EQ(sizeof(input), size);
+    EXPECT_STREQ(input, output);
+}
+#endif
+
 TEST_F(S3CommonWriteTest, WriteGZipDataMultipleTimes) {
     EXPECT_CALL(mockS3Interface, getUploadId(_))
         .WillRepeatedly(
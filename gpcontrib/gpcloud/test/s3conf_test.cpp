@@ -18,7 +18,9 @@ TEST(Config, Basic) {
 #endif
 
     EXPECT_EQ((uint64_t)6, params.getNumOfChunks());
+    EXPECT_EQ((uint64_t)1, params.getCompressThreads());
     EXPECT_EQ((uint64_t)(64 * 1024 * 1024 + 1), params.getChunkSize());
+    EXPECT_TRUE(params.isAdaptiveDownload());
 
     EXPECT_EQ(EXT_INFO, s3ext_loglevel);
     EXPECT_EQ(STDERR_LOG, s3ext_logtype);
@@ -29,6 +31,8 @@ TEST(Config, Basic) {
     EXPECT_EQ((uint64_t)1024, params.getLowSpeedLimit());
     EXPECT_EQ((uint64_t)600, params.getLowSpeedTime());
 
+    EXPECT_EQ((uint64_t)15, params.getConnectionIdleTime());
+
     EXPECT_FALSE(params.isDebugCurl());
 
     EXPECT_EQ("", params.getProxy());
@@ -38,6 +42,10 @@ TEST(Config, Basic) {
 
     EXPECT_EQ(SSE_S3, params.getSSEType());
 
+    EXPECT_EQ(KEY_DISTRIBUTION_SIZE, params.getKeyDistribution());
+    EXPECT_EQ((uint64_t)0, params.getKeySplitSize());
+    EXPECT_EQ("", params.getSharedListingDir());
+
     EXPECT_EQ("\n", params.getGpcheckcloud_newline());
 }
 
@@ -46,6 +54,7 @@ TEST(Config, SpecialSectionValues) {
 
     EXPECT_EQ((uint64_t)8, params.getNumOfChunks());
     EXPECT_EQ((uint64_t)(128 * 1024 * 1024), params.getChunkSize());
+    EXPECT_EQ((uint64_t)8, params.getCompressThreads());
 
     EXPECT_EQ((uint64_t)10240, params.getLowSpeedLimit());
     EXPECT_EQ((uint64_t)60, params.getLowSpeedTime());
@@ -59,6 +68,8 @@ TEST(Config, SpecialSectionLowValues) {
 
     EXPECT_EQ((uint64_t)1, params.getNumOfChunks());
     EXPECT_EQ((uint64_t)(8 * 1024 * 1024), params.getChunkSize());
+    EXPECT_EQ((uint64_t)0, params.getConnectionIdleTime());
+    EXPECT_EQ((uint64_t)(8 * 1024 * 1024), params.getKeySplitSize());
 }
 
 TEST(Config, SpecialSectionWrongKeyName) {
@@ -73,6 +84,15 @@ TEST(Config, SpecialSwitches) {
 
     EXPECT_TRUE(params.isDebugCurl());
     EXPECT_FALSE(params.isAutoCompress());
+    EXPECT_FALSE(params.isAdaptiveDownload());
+    EXPECT_EQ(KEY_DISTRIBUTION_INDEX, params.getKeyDistribution());
+    EXPECT_EQ("", params.getSharedListingDir());
+}
+
+TEST(Config, SharedListingDir) {
+    S3Params params = InitConfig("s3://abc/a config=data/s3test.conf section=shared_listing");
+
+    EXPECT_EQ("/tmp/gpcloud_shared", params.getSharedListingDir());
 }
 
 TEST(Config, SectionExist) {
@@ -121,6 +141,22 @@ TEST(Config, Gpcheckcloud_eol) {
         InitConfig("s3://abc/a config=data/s3test.conf section=gpcheckcloud_newline_error"),
         S3ConfigError);
 }
+
+TEST(Config, Compression) {
+    S3Params params = InitConfig("s3://abc/a config=data/s3test.conf section=default");
+    EXPECT_EQ(S3_COMPRESSION_GZIP, params.getCompressionType());
+
+#ifdef HAVE_LIBZSTD
+    params = InitConfig("s3://abc/a config=data/s3test.conf section=compression_zstd");
+    EXPECT_EQ(S3_COMPRESSION_ZSTD, params.getCompressionType());
+#else
+    EXPECT_THROW(InitConfig("s3://abc/a config=data/s3test.conf section=compression_zstd"),
+                 S3ConfigError);
+#endif
+
+    EXPECT_THROW(InitConfig("s3://abc/a config=data/s3test.conf section=compression_error"),
+                 S3ConfigError);
+}
 /* HttpParam test: because the unittest is compiled with S3_STANDLONE, so if we want to test
  * this case, we need change the code of s3conf.cpp line 67 like this:
  #if !defined(S3_STANDALONE)
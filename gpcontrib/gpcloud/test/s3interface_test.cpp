@@ -86,6 +86,20 @@ TEST_F(S3InterfaceServiceTest, GetResponseWithRetriesAndSuccess) {
     EXPECT_EQ(RESPONSE_OK, this->getResponseWithRetries(url, headers).getStatus());
 }
 
+TEST_F(S3InterfaceServiceTest, GetResponseCountsSlowDowns) {
+    string url("https://s3-us-west-2.amazonaws.com/s3test.pivotal.io/whatever");
+    HTTPHeaders headers;
+
+    EXPECT_CALL(mockRESTfulService, get(_, _))
+        .Times(3)
+        .WillOnce(Throw(S3SlowDownError("")))
+        .WillOnce(Throw(S3ConnectionError("")))
+        .WillOnce(Return(Response(RESPONSE_OK)));
+
+    EXPECT_EQ(RESPONSE_OK, this->getResponseWithRetries(url, headers).getStatus());
+    EXPECT_EQ((uint64_t)1, this->getSlowDownCount());
+}
+
 TEST_F(S3InterfaceServiceTest, PutResponseWithZeroRetry) {
     string url = "https://s3-us-west-2.amazonaws.com/s3test.pivotal.io/whatever";
     HTTPHeaders headers;
@@ -414,6 +428,20 @@ TEST_F(S3InterfaceServiceTest, checkItsGzipCompressed) {
     EXPECT_EQ(S3_COMPRESSION_GZIP, this->checkCompressionType(s3Url));
 }
 
+TEST_F(S3InterfaceServiceTest, checkItsZstdCompressed) {
+    vector<uint8_t> raw;
+    raw.resize(4);
+    raw[0] = 0x28;
+    raw[1] = 0xb5;
+    raw[2] = 0x2f;
+    raw[3] = 0xfd;
+    Response response(RESPONSE_OK, raw);
+    EXPECT_CALL(mockRESTfulService, get(_, _)).WillOnce(Return(response));
+
+    S3Url s3Url("https://s3-us-west-2.amazonaws.com/s3test.pivotal.io/whatever");
+    EXPECT_EQ(S3_COMPRESSION_ZSTD, this->checkCompressionType(s3Url));
+}
+
 TEST_F(S3InterfaceServiceTest, checkItsNotCompressed) {
     vector<uint8_t> raw;
     raw.resize(4);
@@ -0,0 +1,114 @@
+#include "s3key_lister.cpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "mock_classes.h"
+
+using ::testing::_;
+using ::testing::AtMost;
+using ::testing::Invoke;
+using ::testing::Throw;
+
+// Return a page with the given keys, the last one is the marker of the next page if there is one.
+static void listPage(string& marker, ListBucketResult& page, const vector<string>& names,
+                     bool truncated) {
+    for (uint64_t i = 0; i < names.size(); i++) {
+        page.contents.emplace_back(names[i], 1024);
+    }
+    marker = truncated ? names.back() : "";
+}
+
+class S3KeyListerTest : public testing::Test {
+   protected:
+    virtual void SetUp() {
+        lister.setS3InterfaceService(&mockS3Interface);
+    }
+
+    S3KeyLister lister;
+    MockS3Interface mockS3Interface;
+};
+
+TEST_F(S3KeyListerTest, OpenThrowExceptionWhenS3InterfaceIsNULL) {
+    lister.setS3InterfaceService(NULL);
+    EXPECT_THROW(lister.open(S3Url("https://s3-us-west-2.amazonaws.com/bucket/prefix")),
+                 S3RuntimeError);
+}
+
+TEST_F(S3KeyListerTest, NextShouldReturnKeysOfAllPages) {
+    EXPECT_CALL(mockS3Interface, listBucketPage(_, _, _))
+        .Times(3)
+        .WillOnce(Invoke([](const S3Url&, string& marker, ListBucketResult& page) {
+            EXPECT_EQ("", marker);
+            listPage(marker, page, {"a", "b"}, true);
+        }))
+        .WillOnce(Invoke([](const S3Url&, string& marker, ListBucketResult& page) {
+            EXPECT_EQ("b", marker);
+            listPage(marker, page, {"c"}, true);
+        }))
+        .WillOnce(Invoke([](const S3Url& s3Url, string& marker, ListBucketResult& page) {
+            EXPECT_EQ("c", marker);
+            EXPECT_EQ("prefix", s3Url.getPrefix());
+            listPage(marker, page, {"d"}, false);
+        }));
+
+    lister.open(S3Url("https://s3-us-west-2.amazonaws.com/bucket/prefix"));
+
+    BucketContent key;
+    vector<string> names;
+    while (lister.next(key)) {
+        names.push_back(key.getName());
+        EXPECT_EQ((uint64_t)1024, key.getSize());
+    }
+
+    EXPECT_EQ((vector<string>{"a", "b", "c", "d"}), names);
+    EXPECT_FALSE(lister.next(key));
+}
+
+TEST_F(S3KeyListerTest, NextShouldReturnFalseForEmptyBucket) {
+    EXPECT_CALL(mockS3Interface, listBucketPage(_, _, _))
+        .Times(1)
+        .WillOnce(Invoke([](const S3Url&, string& marker, ListBucketResult& page) {
+            marker = "";
+        }));
+
+    lister.open(S3Url("https://s3-us-west-2.amazonaws.com/bucket/prefix"));
+
+    BucketContent key;
+    EXPECT_FALSE(lister.next(key));
+}
+
+TEST_F(S3KeyListerTest, NextShouldRethrowListingError) {
+    EXPECT_CALL(mockS3Interface, listBucketPage(_, _, _))
+        .Times(2)
+        .WillOnce(Invoke([](const S3Url&, string& marker, ListBucketResult& page) {
+            listPage(marker, page, {"a"}, true);
+        }))
+        .WillOnce(Throw(S3ConnectionError("timeout")));
+
+    lister.open(S3Url("https://s3-us-west-2.amazonaws.com/bucket/prefix"));
+
+    BucketContent key;
+    while (true) {
+        try {
+            if (!lister.next(key)) {
+                ADD_FAILURE() << "listing error is not thrown";
+                break;
+            }
+            EXPECT_EQ("a", key.getName());
+        } catch (S3ConnectionError& e) {
+            break;
+        }
+    }
+}
+
+TEST_F(S3KeyListerTest, CloseShouldStopListing) {
+    // every page is truncated, only close() ends the listing
+    EXPECT_CALL(mockS3Interface, listBucketPage(_, _, _))
+        .Times(AtMost(1))
+        .WillRepeatedly(Invoke([](const S3Url&, string& marker, ListBucketResult& page) {
+            usleep(10 * 1000);
+            listPage(marker, page, {"a"}, true);
+        }));
+
+    lister.open(S3Url("https://s3-us-west-2.amazonaws.com/bucket/prefix"));
+    lister.close();
+}
@@ -263,6 +263,23 @@ TEST_F(S3KeyReaderTest, ReadWithSingleChunk) {
     EXPECT_EQ((uint64_t)0, this->read(buffer, 64 * 1024));
 }
 
+TEST_F(S3KeyReaderTest, ReadWithoutAppendingEol) {
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(1);
+    params.setKeySize(255);
+    params.setChunkSize(8192);
+
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _)).WillOnce(Invoke(MockFetchData(255, 8192)));
+
+    this->setAppendEol(false);
+    this->open(params);
+
+    EXPECT_EQ((uint64_t)255, this->read(buffer, 64 * 1024));
+    EXPECT_EQ((uint64_t)0, this->read(buffer, 64 * 1024));
+
+    this->setAppendEol(true);
+}
+
 TEST_F(S3KeyReaderTest, ReadWithSingleChunkNormalCase) {
     // Read buffer < chunk size < key size
     S3Params params("s3://abc/def");
@@ -309,6 +326,41 @@ TEST_F(S3KeyReaderTest, ReadWithSmallBuffer) {
     EXPECT_EQ((uint64_t)0, this->read(buffer, 64));
 }
 
+TEST_F(S3KeyReaderTest, LeaseChunksWithoutCopy) {
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(2);
+    params.setKeySize(255);
+    params.setChunkSize(64);
+
+    EXPECT_CALL(s3Interface, fetchData(_, _, _, _))
+        .WillOnce(Invoke(MockFetchData(64, 64)))
+        .WillOnce(Invoke(MockFetchData(64, 64)))
+        .WillOnce(Invoke(MockFetchData(64, 64)))
+        .WillOnce(Invoke(MockFetchData(63, 64)));
+
+    this->open(params);
+    ASSERT_TRUE(this->canLease());
+
+    const char *data = NULL;
+    EXPECT_EQ((uint64_t)64, this->lease(&data));
+    this->release();
+    EXPECT_EQ((uint64_t)64, this->lease(&data));
+    this->release();
+
+    // the rest of a chunk read() has started
+    EXPECT_EQ((uint64_t)16, this->read(buffer, 16));
+    EXPECT_EQ((uint64_t)48, this->lease(&data));
+    this->release();
+
+    EXPECT_EQ((uint64_t)63, this->lease(&data));
+    this->release();
+    EXPECT_EQ((uint64_t)1, this->lease(&data));
+    EXPECT_EQ('\n', data[0]);
+    this->release();
+    EXPECT_EQ((uint64_t)0, this->lease(&data));
+    EXPECT_EQ((uint64_t)0, this->read(buffer, 64));
+}
+
 TEST_F(S3KeyReaderTest, CloseWithoutFinishReading) {
     S3Params params("s3://abc/def");
 
@@ -833,6 +885,146 @@ TEST_F(S3KeyReaderTest, MTReadWithHundredsOfThreadsAndSignalCancel) {
     EXPECT_THROW(this->read(buffer, 31), S3QueryAbort);
 }
 
+TEST_F(S3KeyReaderTest, AdaptiveDownloadReadsSmallKeyInOneChunk) {
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(4);
+    params.setKeySize(5 * 1024 * 1024);
+    params.setChunkSize(64 * 1024 * 1024);
+    params.setAdaptiveDownload(true);
+
+    EXPECT_CALL(s3Interface, fetchData(0, _, 5 * 1024 * 1024, _))
+        .WillOnce(Invoke(MockFetchData(5 * 1024 * 1024, 5 * 1024 * 1024)));
+
+    this->open(params);
+
+    EXPECT_EQ((uint64_t)1, this->getThreads().size());
+    EXPECT_EQ((uint64_t)S3_MIN_ADAPTIVE_CHUNKSIZE, this->getOffsetMgr().getChunkSize());
+
+    const char *data = NULL;
+    EXPECT_EQ((uint64_t)(5 * 1024 * 1024), this->lease(&data));
+    EXPECT_EQ((uint64_t)1, this->lease(&data));
+    EXPECT_EQ((uint64_t)0, this->lease(&data));
+}
+
+TEST_F(S3KeyReaderTest, AdaptiveDownloadSpreadsKeyOverThreads) {
+    S3Params params("s3://abc/def");
+    params.setNumOfChunks(4);
+    params.setKeySize(100 * 1024 * 1024);
+    params.setChunkSize(64 * 1024 * 1024);
+    params.setAdaptiveDownload(true);
+
+    const uint64_t chunkSize = 25 * 1024 * 1024;
+    for (uint64_t offset = 0; offset < 100 * 1024 * 1024; offset += chunkSize) {
+        EXPECT_CALL(s3Interface, fetchData(offset, _, chunkSize, _))
+            .WillOnce(Invoke(MockFetchData(chunkSize, chunkSize)));
+    }
+
+    this->open(params);
+
+    EXPECT_EQ((uint64_t)4, this->getThreads().size());
+    EXPECT_EQ(chunkSize, this->getOffsetMgr().getChunkSize());
+
+    const char *data = NULL;
+    for (uint64_t i = 0; i < 4; i++) {
+        EXPECT_EQ(chunkSize, this->lease(&data));
+    }
+    EXPECT_EQ((uint64_t)1, this->lease(&data));
+    EXPECT_EQ((uint64_t)0, this->lease(&data));
+    EXPECT_LE(this->getDownloadLimiter().getPeakDownloads(), (uint64_t)4);
+}
+
+TEST(DownloadLimiter, RampUpWhileRateHolds) {
+    DownloadLimiter limiter;
+    limiter.reset(4, true);
+    EXPECT_EQ((uint64_t)2, limiter.getLimit());
+
+    EXPECT_TRUE(limiter.acquire(0));
+    limiter.release(1000, 1.0, 0, 0);
+    EXPECT_EQ((uint64_t)3, limiter.getLimit());
+
+    EXPECT_TRUE(limiter.acquire(1));
+    limiter.release(900, 1.0, 0, 0);
+    EXPECT_EQ((uint64_t)4, limiter.getLimit());
+
+    EXPECT_TRUE(limiter.acquire(2));
+    limiter.release(1000, 1.0, 0, 0);
+    EXPECT_EQ((uint64_t)4, limiter.getLimit());
+}
+
+TEST(DownloadLimiter, HoldWhenRateDrops) {
+    DownloadLimiter limiter;
+    limiter.reset(4, true);
+
+    EXPECT_TRUE(limiter.acquire(0));
+    limiter.release(1000, 1.0, 0, 0);
+    EXPECT_EQ((uint64_t)3, limiter.getLimit());
+
+    EXPECT_TRUE(limiter.acquire(1));
+    limiter.release(500, 1.0, 0, 0);
+    EXPECT_EQ((uint64_t)3, limiter.getLimit());
+}
+
+TEST(DownloadLimiter, HalveOnSlowDown) {
+    DownloadLimiter limiter;
+    limiter.reset(8, true);
+    EXPECT_EQ((uint64_t)4, limiter.getLimit());
+
+    EXPECT_TRUE(limiter.acquire(0));
+    limiter.release(1000, 1.0, 0, 1);
+    EXPECT_EQ((uint64_t)2, limiter.getLimit());
+
+    EXPECT_TRUE(limiter.acquire(1));
+    limiter.release(1000, 1.0, 1, 2);
+    EXPECT_EQ((uint64_t)1, limiter.getLimit());
+
+    EXPECT_TRUE(limiter.acquire(2));
+    limiter.release(1000, 1.0, 2, 3);
+    EXPECT_EQ((uint64_t)1, limiter.getLimit());
+}
+
+TEST(DownloadLimiter, HalveOncePerSlowDown) {
+    DownloadLimiter limiter;
+    limiter.reset(8, true);
+
+    for (uint64_t i = 0; i < 4; i++) {
+        EXPECT_TRUE(limiter.acquire(i));
+    }
+
+    // a 503 during four downloads
+    limiter.release(1000, 1.0, 0, 1);
+    EXPECT_EQ((uint64_t)2, limiter.getLimit());
+    limiter.release(1000, 1.0, 0, 1);
+    limiter.release(1000, 1.0, 0, 1);
+    EXPECT_EQ((uint64_t)2, limiter.getLimit());
+
+    // another one later
+    limiter.release(1000, 1.0, 0, 2);
+    EXPECT_EQ((uint64_t)1, limiter.getLimit());
+}
+
+TEST(DownloadLimiter, FixedLimitWhenNotAdaptive) {
+    DownloadLimiter limiter;
+    limiter.reset(4, false);
+    EXPECT_EQ((uint64_t)4, limiter.getLimit());
+
+    EXPECT_TRUE(limiter.acquire(0));
+    EXPECT_TRUE(limiter.acquire(1));
+    limiter.release(1000, 1.0, 3, 4);
+    EXPECT_EQ((uint64_t)4, limiter.getLimit());
+    EXPECT_EQ((uint64_t)2, limiter.getPeakDownloads());
+}
+
+TEST(DownloadLimiter, AcquireFailsAfterStop) {
+    DownloadLimiter limiter;
+    limiter.reset(1, false);
+
+    EXPECT_TRUE(limiter.acquire(0));
+    limiter.stop();
+
+    // would wait for the slot of chunk 0 otherwise
+    EXPECT_FALSE(limiter.acquire(1));
+}
+
 TEST(ChunkBuffer, ChunkBufferOperatorEqual) {
     S3Url s3Url("s3://whatever");
     S3KeyReader reader;
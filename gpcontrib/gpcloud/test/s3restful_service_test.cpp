@@ -1,6 +1,8 @@
 #include "s3restful_service.cpp"
 #include "gtest/gtest.h"
 
+#include <chrono>
+
 TEST(S3RESTfulService, GetWithWrongHeader) {
     HTTPHeaders headers;
     S3RESTfulService service;
@@ -321,6 +323,58 @@ TEST(S3RESTfulService, DISABLED_DeleteToDummyServerWithData) {
     EXPECT_EQ(RESPONSE_OK, resp.getStatus());
 }
 
+TEST(S3RESTfulService, GetWithConnectionReuse) {
+    HTTPHeaders headers;
+    S3Params params;
+    params.setConnectionIdleTime(15);
+    S3RESTfulService service(params);
+
+    string url = "https://www.bing.com/";
+
+    // the second request takes the handle, and connection, of the first one
+    for (int i = 0; i < 2; i++) {
+        Response resp = service.get(url, headers);
+        EXPECT_EQ(RESPONSE_OK, resp.getStatus());
+    }
+}
+
+static void benchmarkGet(uint64_t connectionIdleTime, const string &url, int requests) {
+    S3Params params;
+    params.setConnectionIdleTime(connectionIdleTime);
+    S3RESTfulService service(params);
+
+    uint64_t bytes = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < requests; i++) {
+        HTTPHeaders headers;
+        Response resp = service.get(url, headers);
+        ASSERT_EQ(RESPONSE_OK, resp.getStatus());
+        bytes += resp.getRawData().size();
+    }
+    double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("connection_idle_time = %" PRIu64
+           ": %d requests, %.3f ms/request, %.1f requests/s, %.2f MB/s\n",
+           connectionIdleTime, requests, seconds * 1000 / requests, requests / seconds,
+           bytes / seconds / (1024 * 1024));
+}
+
+/*
+ * Run './bin/dummyHTTPServer.py -t Common_Server' before enabling this test, or
+ * './bin/dummyHTTPServer.py -t Common_Server -s' and an https url for TLS connections.
+ * It compares the latency and throughput of GET requests with and without connection reuse.
+ */
+TEST(S3RESTfulService, DISABLED_BenchmarkConnectionReuseAgainstDummyServer) {
+    const int requests = 1000;
+
+    benchmarkGet(0, "http://localhost:8553/?size=1024", requests);
+    benchmarkGet(15, "http://localhost:8553/?size=1024", requests);
+
+    benchmarkGet(0, "http://localhost:8553/?size=1048576", requests / 10);
+    benchmarkGet(15, "http://localhost:8553/?size=1048576", requests / 10);
+}
+
 TEST(S3RESTfulService, GetWithWrongProxy) {
     HTTPHeaders headers;
     S3RESTfulService service("https://127.0.0.1:8080");
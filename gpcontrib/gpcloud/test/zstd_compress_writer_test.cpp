@@ -0,0 +1,125 @@
+#include "zstd_compress_writer.cpp"
+#include <random>
+#include "gtest/gtest.h"
+
+#ifdef HAVE_LIBZSTD
+
+class ZstdBufferWriter : public Writer {
+   public:
+    ZstdBufferWriter() : closed(false) {
+    }
+
+    virtual void open(const S3Params &params) {
+    }
+
+    virtual uint64_t write(const char *buf, uint64_t count) {
+        this->data.insert(this->data.end(), buf, buf + count);
+        return count;
+    }
+
+    virtual void close() {
+        this->closed = true;
+    }
+
+    vector<char> data;
+    bool closed;
+};
+
+class ZstdCompressWriterTest : public testing::Test {
+   protected:
+    virtual void SetUp() {
+        writer.setWriter(&bufWriter);
+    }
+
+    // Decompress all the frames written.
+    string decompress() {
+        ZSTD_DCtx *dctx = ZSTD_createDCtx();
+        ZSTD_inBuffer input = {bufWriter.data.data(), bufWriter.data.size(), 0};
+
+        string result;
+        vector<char> buf(ZSTD_DStreamOutSize());
+        size_t ret = 0;
+        do {
+            ZSTD_outBuffer output = {buf.data(), buf.size(), 0};
+            ret = ZSTD_decompressStream(dctx, &output, &input);
+            EXPECT_FALSE(ZSTD_isError(ret));
+            if (ZSTD_isError(ret)) {
+                break;
+            }
+            result.append(buf.data(), output.pos);
+        } while (input.pos < input.size || ret != 0);
+
+        ZSTD_freeDCtx(dctx);
+        return result;
+    }
+
+    ZstdCompressWriter writer;
+    ZstdBufferWriter bufWriter;
+};
+
+TEST_F(ZstdCompressWriterTest, AbleToCompressEmptyData) {
+    writer.open(S3Params("s3://abc/def"));
+    writer.close();
+
+    EXPECT_TRUE(bufWriter.closed);
+    EXPECT_NE((uint64_t)0, bufWriter.data.size());
+    EXPECT_EQ("", decompress());
+}
+
+TEST_F(ZstdCompressWriterTest, AbleToCompressOneSmallString) {
+    const string hello = "The quick brown fox jumps over the lazy dog";
+
+    writer.open(S3Params("s3://abc/def"));
+    EXPECT_EQ(hello.size(), writer.write(hello.data(), hello.size()));
+    writer.close();
+
+    // frame magic number, little endian
+    ASSERT_LE((uint64_t)4, bufWriter.data.size());
+    EXPECT_EQ((char)0x28, bufWriter.data[0]);
+    EXPECT_EQ((char)0xb5, bufWriter.data[1]);
+    EXPECT_EQ((char)0x2f, bufWriter.data[2]);
+    EXPECT_EQ((char)0xfd, bufWriter.data[3]);
+
+    EXPECT_EQ(hello, decompress());
+}
+
+TEST_F(ZstdCompressWriterTest, AbleToWriteManyTimesBeforeClose) {
+    string data;
+    writer.open(S3Params("s3://abc/def"));
+    for (int i = 0; i < 100000; i++) {
+        string line = std::to_string(i) + "\n";
+        writer.write(line.data(), line.size());
+        data += line;
+    }
+    writer.close();
+
+    EXPECT_GT(data.size(), bufWriter.data.size());
+    EXPECT_EQ(data, decompress());
+}
+
+TEST_F(ZstdCompressWriterTest, AbleToCompressWithThreads) {
+    std::mt19937 gen(1);
+    vector<char> data(4 * 1024 * 1024);
+    for (uint64_t i = 0; i < data.size(); i++) {
+        data[i] = 'a' + gen() % 4;
+    }
+
+    S3Params params("s3://abc/def");
+    params.setCompressThreads(4);
+    writer.open(params);
+    EXPECT_EQ(data.size(), writer.write(data.data(), data.size()));
+    writer.close();
+
+    EXPECT_EQ(string(data.begin(), data.end()), decompress());
+}
+
+TEST_F(ZstdCompressWriterTest, CloseMultipleTimes) {
+    writer.open(S3Params("s3://abc/def"));
+    writer.write("abc", 3);
+    writer.close();
+    writer.close();
+
+    EXPECT_EQ("abc", decompress());
+}
+
+#endif
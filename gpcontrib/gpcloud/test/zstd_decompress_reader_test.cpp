@@ -0,0 +1,166 @@
+#include "zstd_decompress_reader.cpp"
+#include "gtest/gtest.h"
+
+#ifdef HAVE_LIBZSTD
+
+// Return at most chunkSize bytes of data on each read().
+class ZstdBufferReader : public Reader {
+   public:
+    ZstdBufferReader() : offset(0), chunkSize(1024 * 1024) {
+    }
+
+    void open(const S3Params &params) {
+    }
+    void close() {
+    }
+
+    uint64_t read(char *buf, uint64_t count) {
+        uint64_t size = std::min(std::min(this->data.size() - this->offset, count), chunkSize);
+        memcpy(buf, this->data.data() + this->offset, size);
+        this->offset += size;
+        return size;
+    }
+
+    vector<char> data;
+    uint64_t offset;
+    uint64_t chunkSize;
+};
+
+class ZstdDecompressReaderTest : public testing::Test {
+   protected:
+    virtual void SetUp() {
+        reader.setReader(&bufReader);
+        reader.open(S3Params("s3://abc/def"));
+    }
+
+    virtual void TearDown() {
+        reader.close();
+    }
+
+    // Append data compressed as one zstd frame to the upstream reader.
+    void appendFrame(const string &data) {
+        vector<char> frame(ZSTD_compressBound(data.size()));
+        size_t size = ZSTD_compress(frame.data(), frame.size(), data.data(), data.size(), 1);
+        ASSERT_FALSE(ZSTD_isError(size));
+        bufReader.data.insert(bufReader.data.end(), frame.begin(), frame.begin() + size);
+    }
+
+    string readAll(uint64_t bufSize) {
+        string result;
+        vector<char> buf(bufSize);
+        uint64_t count;
+        while ((count = reader.read(buf.data(), buf.size())) > 0) {
+            result.append(buf.data(), count);
+        }
+        return result;
+    }
+
+    ZstdDecompressReader reader;
+    ZstdBufferReader bufReader;
+};
+
+TEST_F(ZstdDecompressReaderTest, AbleToDecompressEmptyData) {
+    char buf[100];
+    EXPECT_EQ((uint64_t)0, reader.read(buf, sizeof(buf)));
+}
+
+TEST_F(ZstdDecompressReaderTest, AbleToDecompressSmallCompressedData) {
+    const string hello = "The quick brown fox jumps over the lazy dog";
+    appendFrame(hello);
+
+    EXPECT_EQ(hello, readAll(10000));
+}
+
+TEST_F(ZstdDecompressReaderTest, AbleToDecompressWithSmallReadBuffer) {
+    string data;
+    for (int i = 0; i < 100000; i++) {
+        data += std::to_string(i) + "\n";
+    }
+    appendFrame(data);
+    bufReader.chunkSize = 1000;
+
+    EXPECT_EQ(data, readAll(7));
+}
+
+TEST_F(ZstdDecompressReaderTest, AbleToDecompressConcatenatedFrames) {
+    appendFrame("The quick brown fox ");
+    appendFrame("");
+    appendFrame("jumps over the lazy dog");
+
+    EXPECT_EQ("The quick brown fox jumps over the lazy dog", readAll(10));
+}
+
+// Lease the data in pieces of chunkSize bytes, like S3KeyReader hands out its chunks.
+class ZstdLeaseReader : public ZstdBufferReader {
+   public:
+    ZstdLeaseReader() : leases(0), leased(false) {
+    }
+
+    bool canLease() {
+        return true;
+    }
+
+    uint64_t lease(const char **data) {
+        EXPECT_FALSE(this->leased);
+        uint64_t size = std::min(this->data.size() - this->offset, this->chunkSize);
+        *data = this->data.data() + this->offset;
+        this->offset += size;
+        this->leases++;
+        this->leased = true;
+        return size;
+    }
+
+    void release() {
+        this->leased = false;
+    }
+
+    uint64_t leases;
+    bool leased;
+};
+
+TEST(ZstdDecompressReader, AbleToDecompressLeasedData) {
+    string data;
+    for (int i = 0; i < 100000; i++) {
+        data += std::to_string(i) + "\n";
+    }
+    vector<char> frame(ZSTD_compressBound(data.size()));
+    size_t size = ZSTD_compress(frame.data(), frame.size(), data.data(), data.size(), 1);
+    ASSERT_FALSE(ZSTD_isError(size));
+
+    ZstdLeaseReader leaseReader;
+    leaseReader.data.assign(frame.begin(), frame.begin() + size);
+    leaseReader.chunkSize = 1000;
+
+    ZstdDecompressReader reader;
+    reader.setReader(&leaseReader);
+    reader.open(S3Params("s3://abc/def"));
+
+    string result;
+    char buf[4096];
+    uint64_t count;
+    while ((count = reader.read(buf, sizeof(buf))) > 0) {
+        result.append(buf, count);
+    }
+    reader.close();
+
+    EXPECT_EQ(data, result);
+    EXPECT_LT((uint64_t)1, leaseReader.leases);
+    EXPECT_FALSE(leaseReader.leased);
+}
+
+TEST_F(ZstdDecompressReaderTest, ThrowOnTruncatedFrame) {
+    appendFrame(string(10000, 'x'));
+    bufReader.data.resize(bufReader.data.size() - 4);
+
+    EXPECT_THROW(readAll(100000), S3RuntimeError);
+}
+
+TEST_F(ZstdDecompressReaderTest, ThrowOnIncorrectEncodedStream) {
+    const char hello[] = "abcdefghigklmnopqrstuvwxyz";
+    bufReader.data.assign(hello, hello + sizeof(hello));
+
+    char buf[100];
+    EXPECT_THROW(reader.read(buf, sizeof(buf)), S3RuntimeError);
+}
+
+#endif
@@ -63,6 +63,7 @@
 #include "catalog/pg_partition.h"
 #include "catalog/pg_partition_rule.h"
 #include "catalog/pg_statistic.h"
+#include "catalog/pg_statistic_multicol.h"
 #include "catalog/pg_stat_last_operation.h"
 #include "catalog/pg_stat_last_shoperation.h"
 #include "catalog/pg_tablespace.h"
@@ -134,6 +135,7 @@ static Oid AddNewRelationType(const char *typeName,
 				   Oid new_row_type,
 				   Oid new_array_type);
 static void RelationRemoveInheritance(Oid relid);
+static void RemoveMultiColumnStatistics(Oid relid, AttrNumber attnum);
 static void StoreRelCheck(Relation rel, char *ccname, Node *expr,
 			  bool is_validated, bool is_local, int inhcount,
 			  bool is_no_inherit, bool is_internal);
@@ -3357,6 +3359,51 @@ RemoveStatistics(Oid relid, AttrNumber attnum)
 	systable_endscan(scan);
 
 	heap_close(pgstatistic, RowExclusiveLock);
+
+	RemoveMultiColumnStatistics(relid, attnum);
+}
+
+/*
+ * RemoveMultiColumnStatistics --- remove entries in pg_statistic_multicol
+ *
+ * If attnum is zero, remove all entries for rel; else remove only the
+ * groups that contain that column.
+ */
+static void
+RemoveMultiColumnStatistics(Oid relid, AttrNumber attnum)
+{
+	Relation	pgstatmulticol;
+	SysScanDesc scan;
+	ScanKeyData key;
+	HeapTuple	tuple;
+
+	pgstatmulticol = heap_open(StatisticMultiColRelationId, RowExclusiveLock);
+
+	ScanKeyInit(&key,
+				Anum_pg_statistic_multicol_starelid,
+				BTEqualStrategyNumber, F_OIDEQ,
+				ObjectIdGetDatum(relid));
+
+	scan = systable_beginscan(pgstatmulticol, StatisticMultiColRelidIndexId,
+							  true, NULL, 1, &key);
+
+	while (HeapTupleIsValid(tuple = systable_getnext(scan)))
+	{
+		Form_pg_statistic_multicol form;
+		bool		remove = (attnum == 0);
+		int			i;
+
+		form = (Form_pg_statistic_multicol) GETSTRUCT(tuple);
+		for (i = 0; !remove && i < form->stakeys.dim1; i++)
+			remove = (form->stakeys.values[i] == attnum);
+
+		if (remove)
+			CatalogTupleDelete(pgstatmulticol, &tuple->t_self);
+	}
+
+	systable_endscan(scan);
+
+	heap_close(pgstatmulticol, RowExclusiveLock);
 }
 
 
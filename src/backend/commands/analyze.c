@@ -89,6 +89,7 @@
 #include "catalog/pg_collation.h"
 #include "catalog/pg_inherits_fn.h"
 #include "catalog/pg_namespace.h"
+#include "catalog/pg_statistic_multicol.h"
 #include "commands/dbcommands.h"
 #include "commands/tablecmds.h"
 #include "commands/vacuum.h"
@@ -106,8 +107,11 @@
 #include "storage/procarray.h"
 #include "utils/acl.h"
 #include "utils/attoptcache.h"
+#include "utils/cardfeedback.h"
 #include "utils/datum.h"
+#include "utils/fmgroids.h"
 #include "utils/guc.h"
+#include "utils/inval.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/pg_rusage.h"
@@ -166,6 +170,26 @@ typedef struct AnlIndexData
 } AnlIndexData;
 
 
+/* A group of columns to collect multi-column statistics on */
+typedef struct AnlMultiColGroup
+{
+	int			nkeys;
+	int16		keys[STATISTIC_MULTICOL_MAX_KEYS];
+	VacAttrStats *stats[STATISTIC_MULTICOL_MAX_KEYS];	/* per-key column stats */
+	double		ndistinct;		/* results, as stored in the catalog */
+	double		dependency;
+} AnlMultiColGroup;
+
+typedef struct
+{
+	int			nkeys;			/* number of leading keys to compare */
+	int			stride;			/* number of keys of each row in values[] */
+	Datum	   *values;
+	bool	   *nulls;
+	SortSupport ssup;
+} CompareMultiColContext;
+
+
 /* Default statistics target (GUC parameter) */
 int			default_statistics_target = 100;
 
@@ -187,6 +211,17 @@ static void compute_index_stats(Relation onerel, double totalrows,
 					AnlIndexData *indexdata, int nindexes,
 					HeapTuple *rows, int numrows,
 					MemoryContext col_context);
+static void compute_multicol_stats(Relation onerel, Relation *Irel,
+					   int nindexes, int attr_cnt,
+					   VacAttrStats **vacattrstats,
+					   HeapTuple *rows, int numrows, double totalrows);
+static List *add_multicol_group(List *groups, const int16 *keys, int nkeys,
+				   int attr_cnt, VacAttrStats **vacattrstats);
+static void compute_multicol_group_stats(AnlMultiColGroup *group,
+							 HeapTuple *rows, int numrows,
+							 double totalrows, TupleDesc tupDesc);
+static int	compare_multicol_rows(const void *a, const void *b, void *arg);
+static void update_multicol_stats(Oid relid, List *groups);
 static VacAttrStats *examine_attribute(Relation onerel, int attnum,
 				  Node *index_expr, int elevel);
 static int acquire_sample_rows_dispatcher(Relation onerel, bool inh, int elevel,
@@ -904,6 +939,17 @@ do_analyze_rel(Relation onerel, VacuumStmt *vacstmt,
 			update_attstats(RelationGetRelid(Irel[ind]), false,
 							thisdata->attr_cnt, thisdata->vacattrstats);
 		}
+
+		/*
+		 * Statistics on groups of columns are only collected when all columns
+		 * of the relation were analyzed, so that a column list does not drop
+		 * the groups it does not cover.
+		 */
+		if (gp_statistics_multicol &&
+			sample_needed && !inh && vacstmt->va_cols == NIL)
+			compute_multicol_stats(onerel, Irel, nindexes,
+								   attr_cnt, vacattrstats,
+								   rows, numrows, totalrows);
 	}
 
 	/*
@@ -927,6 +973,12 @@ do_analyze_rel(Relation onerel, VacuumStmt *vacstmt,
 							in_outer_xact,
 							false /* isvacuum */);
 
+	/*
+	 * GPORCA's row counts observed while executing earlier plans on the
+	 * relation give way to the new statistics.
+	 */
+	CardFeedbackInvalidateRelation(RelationGetRelid(onerel));
+
 	/*
 	 * Same for indexes. Vacuum always scans all indexes, so if we're part of
 	 * VACUUM ANALYZE, don't overwrite the accurate count already inserted by
@@ -1217,6 +1269,322 @@ compute_index_stats(Relation onerel, double totalrows,
 	MemoryContextDelete(ind_context);
 }
 
+/*
+ * compute_multicol_stats() -- compute and store statistics on groups of columns
+ *
+ * Per-column statistics cannot tell correlated columns, such as (country,
+ * city), apart from independent ones, so the planner multiplies their
+ * selectivities and number of distinct values.  For the groups of columns
+ * that are likely to be queried together, namely the key columns of
+ * multi-column indexes and the distribution key, we compute the number of
+ * distinct value combinations, and the degree to which the last column of the
+ * group is determined by the others, from the sample rows.
+ */
+static void
+compute_multicol_stats(Relation onerel, Relation *Irel, int nindexes,
+					   int attr_cnt, VacAttrStats **vacattrstats,
+					   HeapTuple *rows, int numrows, double totalrows)
+{
+	MemoryContext multicol_context,
+				old_context;
+	GpPolicy   *policy = onerel->rd_cdbpolicy;
+	List	   *groups = NIL;
+	ListCell   *lc;
+	int			ind;
+
+	multicol_context = AllocSetContextCreate(anl_context,
+											 "Analyze Multiple Columns",
+											 ALLOCSET_DEFAULT_MINSIZE,
+											 ALLOCSET_DEFAULT_INITSIZE,
+											 ALLOCSET_DEFAULT_MAXSIZE);
+	old_context = MemoryContextSwitchTo(multicol_context);
+
+	for (ind = 0; ind < nindexes; ind++)
+	{
+		Form_pg_index index = Irel[ind]->rd_index;
+
+		groups = add_multicol_group(groups, index->indkey.values,
+									index->indnatts, attr_cnt, vacattrstats);
+	}
+
+	if (GpPolicyIsHashPartitioned(policy))
+		groups = add_multicol_group(groups, policy->attrs, policy->nattrs,
+									attr_cnt, vacattrstats);
+
+	foreach(lc, groups)
+		compute_multicol_group_stats((AnlMultiColGroup *) lfirst(lc),
+									 rows, numrows, totalrows,
+									 onerel->rd_att);
+
+	update_multicol_stats(RelationGetRelid(onerel), groups);
+
+	MemoryContextSwitchTo(old_context);
+	MemoryContextDelete(multicol_context);
+}
+
+/*
+ * add_multicol_group() -- add a group of columns to analyze, unless it is
+ * already there, or some of its columns cannot be analyzed
+ */
+static List *
+add_multicol_group(List *groups, const int16 *keys, int nkeys,
+				   int attr_cnt, VacAttrStats **vacattrstats)
+{
+	AnlMultiColGroup *group;
+	ListCell   *lc;
+	int			i,
+				j;
+
+	if (nkeys < 2 || nkeys > STATISTIC_MULTICOL_MAX_KEYS)
+		return groups;
+
+	foreach(lc, groups)
+	{
+		AnlMultiColGroup *other = (AnlMultiColGroup *) lfirst(lc);
+
+		if (other->nkeys == nkeys &&
+			memcmp(other->keys, keys, nkeys * sizeof(int16)) == 0)
+			return groups;
+	}
+
+	group = (AnlMultiColGroup *) palloc0(sizeof(AnlMultiColGroup));
+	group->nkeys = nkeys;
+	for (i = 0; i < nkeys; i++)
+	{
+		/* expression index columns have a zero key */
+		if (keys[i] <= 0)
+			return groups;
+
+		group->keys[i] = keys[i];
+		for (j = 0; j < attr_cnt; j++)
+		{
+			if (vacattrstats[j]->attr->attnum == keys[i])
+				group->stats[i] = vacattrstats[j];
+		}
+
+		if (group->stats[i] == NULL ||
+			!OidIsValid(lookup_type_cache(group->stats[i]->attrtypid,
+										  TYPECACHE_LT_OPR)->lt_opr))
+			return groups;
+	}
+
+	return lappend(groups, group);
+}
+
+/*
+ * compute_multicol_group_stats() -- compute the statistics of one group
+ *
+ * The sample rows are sorted on all key columns of the group, so that rows
+ * with the same values of the group are adjacent, and so are rows with the
+ * same values of all but the last column.
+ */
+static void
+compute_multicol_group_stats(AnlMultiColGroup *group, HeapTuple *rows,
+							 int numrows, double totalrows, TupleDesc tupDesc)
+{
+	int			nkeys = group->nkeys;
+	Datum	   *values;
+	bool	   *nulls;
+	int		   *tupnos;
+	SortSupport ssup;
+	CompareMultiColContext cxt;
+	int			ndistinct = 0;
+	int			f1 = 0;
+	int			dupcnt;
+	int			nsupporting = 0;
+	int			i,
+				j;
+
+	values = (Datum *) palloc(numrows * nkeys * sizeof(Datum));
+	nulls = (bool *) palloc(numrows * nkeys * sizeof(bool));
+	tupnos = (int *) palloc(numrows * sizeof(int));
+	ssup = (SortSupport) palloc0(nkeys * sizeof(SortSupportData));
+
+	for (j = 0; j < nkeys; j++)
+	{
+		VacAttrStats *stats = group->stats[j];
+
+		ssup[j].ssup_cxt = CurrentMemoryContext;
+		ssup[j].ssup_collation = stats->attr->attcollation;
+		ssup[j].ssup_nulls_first = false;
+		PrepareSortSupportFromOrderingOp(lookup_type_cache(stats->attrtypid,
+														   TYPECACHE_LT_OPR)->lt_opr,
+										 &ssup[j]);
+	}
+
+	for (i = 0; i < numrows; i++)
+	{
+		tupnos[i] = i;
+		for (j = 0; j < nkeys; j++)
+			values[i * nkeys + j] = heap_getattr(rows[i], group->keys[j],
+												 tupDesc,
+												 &nulls[i * nkeys + j]);
+		vacuum_delay_point();
+	}
+
+	cxt.nkeys = nkeys;
+	cxt.stride = nkeys;
+	cxt.values = values;
+	cxt.nulls = nulls;
+	cxt.ssup = ssup;
+	qsort_arg((void *) tupnos, numrows, sizeof(int),
+			  compare_multicol_rows, (void *) &cxt);
+
+	/* count the distinct combinations, and those seen only once */
+	dupcnt = 1;
+	for (i = 1; i <= numrows; i++)
+	{
+		if (i == numrows ||
+			compare_multicol_rows(&tupnos[i - 1], &tupnos[i], &cxt) != 0)
+		{
+			ndistinct++;
+			if (dupcnt == 1)
+				f1++;
+			dupcnt = 1;
+		}
+		else
+			dupcnt++;
+	}
+
+	/*
+	 * Count the rows of the groups of the leading columns in which the last
+	 * column has a single value; those rows support the dependency.
+	 */
+	cxt.nkeys = nkeys - 1;
+	for (i = 0; i < numrows; i = j)
+	{
+		bool		single = true;
+
+		for (j = i + 1; j < numrows; j++)
+		{
+			if (compare_multicol_rows(&tupnos[i], &tupnos[j], &cxt) != 0)
+				break;
+
+			single = single &&
+				ApplySortComparator(values[tupnos[j] * nkeys + nkeys - 1],
+									nulls[tupnos[j] * nkeys + nkeys - 1],
+									values[tupnos[i] * nkeys + nkeys - 1],
+									nulls[tupnos[i] * nkeys + nkeys - 1],
+									&ssup[nkeys - 1]) == 0;
+		}
+
+		if (single)
+			nsupporting += j - i;
+	}
+
+	group->dependency = (double) nsupporting / (double) numrows;
+
+	/*
+	 * Estimate the number of distinct combinations the same way
+	 * compute_scalar_stats() does for a single column.
+	 */
+	if (f1 == numrows)
+		group->ndistinct = -1.0;
+	else if (f1 == 0 || (double) numrows >= totalrows)
+		group->ndistinct = ndistinct;
+	else
+	{
+		double		numer,
+					denom,
+					stadistinct;
+
+		numer = (double) numrows * (double) ndistinct;
+		denom = (double) (numrows - f1) +
+			(double) f1 * (double) numrows / totalrows;
+
+		stadistinct = numer / denom;
+		/* Clamp to sane range in case of roundoff error */
+		if (stadistinct < (double) ndistinct)
+			stadistinct = (double) ndistinct;
+		if (stadistinct > totalrows)
+			stadistinct = totalrows;
+		group->ndistinct = floor(stadistinct + 0.5);
+	}
+
+	if (group->ndistinct > 0.1 * totalrows)
+		group->ndistinct = -(group->ndistinct / totalrows);
+}
+
+/*
+ * qsort_arg comparator for sorting sample rows, given by their number, on the
+ * leading key columns of a group
+ */
+static int
+compare_multicol_rows(const void *a, const void *b, void *arg)
+{
+	CompareMultiColContext *cxt = (CompareMultiColContext *) arg;
+	int			ta = *(const int *) a;
+	int			tb = *(const int *) b;
+	int			j;
+
+	for (j = 0; j < cxt->nkeys; j++)
+	{
+		int			compare;
+
+		compare = ApplySortComparator(cxt->values[ta * cxt->stride + j],
+									  cxt->nulls[ta * cxt->stride + j],
+									  cxt->values[tb * cxt->stride + j],
+									  cxt->nulls[tb * cxt->stride + j],
+									  &cxt->ssup[j]);
+		if (compare != 0)
+			return compare;
+	}
+
+	return 0;
+}
+
+/*
+ * update_multicol_stats() -- replace the statistics on groups of columns of a
+ * relation in pg_statistic_multicol
+ */
+static void
+update_multicol_stats(Oid relid, List *groups)
+{
+	Relation	sd;
+	SysScanDesc scan;
+	ScanKeyData key;
+	HeapTuple	tuple;
+	ListCell   *lc;
+
+	sd = heap_open(StatisticMultiColRelationId, RowExclusiveLock);
+
+	ScanKeyInit(&key,
+				Anum_pg_statistic_multicol_starelid,
+				BTEqualStrategyNumber, F_OIDEQ,
+				ObjectIdGetDatum(relid));
+	scan = systable_beginscan(sd, StatisticMultiColRelidIndexId, true,
+							  NULL, 1, &key);
+	while (HeapTupleIsValid(tuple = systable_getnext(scan)))
+		CatalogTupleDelete(sd, &tuple->t_self);
+	systable_endscan(scan);
+
+	foreach(lc, groups)
+	{
+		AnlMultiColGroup *group = (AnlMultiColGroup *) lfirst(lc);
+		Datum		values[Natts_pg_statistic_multicol];
+		bool		nulls[Natts_pg_statistic_multicol];
+
+		MemSet(nulls, false, sizeof(nulls));
+		values[Anum_pg_statistic_multicol_starelid - 1] =
+			ObjectIdGetDatum(relid);
+		values[Anum_pg_statistic_multicol_standistinct - 1] =
+			Float4GetDatum((float4) group->ndistinct);
+		values[Anum_pg_statistic_multicol_stadependency - 1] =
+			Float4GetDatum((float4) group->dependency);
+		values[Anum_pg_statistic_multicol_stakeys - 1] =
+			PointerGetDatum(buildint2vector(group->keys, group->nkeys));
+
+		tuple = heap_form_tuple(RelationGetDescr(sd), values, nulls);
+		CatalogTupleInsert(sd, tuple);
+		heap_freetuple(tuple);
+	}
+
+	heap_close(sd, RowExclusiveLock);
+
+	/* there is no syscache on the catalog, have planners refetch it */
+	CacheInvalidateRelcacheByRelid(relid);
+}
+
 /*
  * examine_attribute -- pre-analysis of a single column
  *
@@ -23,6 +23,7 @@
 
 bool			gp_statistics_pullup_from_child_partition = FALSE;
 bool			gp_statistics_use_fkeys = FALSE;
+bool			gp_statistics_multicol = TRUE;
 
 typedef struct
 {
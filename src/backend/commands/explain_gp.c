@@ -112,6 +112,7 @@ typedef struct CdbExplain_StatInst
 	ExplainSortMethod sortMethod;	/* Type of sort */
 	ExplainSortSpaceType sortSpaceType; /* Sort space type */
 	long		sortSpaceUsed;	/* Memory / Disk used by sort(KBytes) */
+	bool		eos;			/* node returned end-of-stream */
 	int			bnotes;			/* Offset to beginning of node's extra text */
 	int			enotes;			/* Offset to end of node's extra text */
 } CdbExplain_StatInst;
@@ -795,6 +796,82 @@ cdbexplain_recvExecStats(struct PlanState *planstate,
 }								/* cdbexplain_recvExecStats */
 
 
+/*
+ * cdbexplain_gatherExecStats
+ *	  Called by qDisp at the end of execution to transfer the EXPLAIN ANALYZE
+ *	  statistics of all slices to the PlanState tree, unless that has
+ *	  already been done.
+ *
+ * This does what ExplainPrintPlan() does for EXPLAIN ANALYZE, for callers
+ * that need the statistics without printing the plan.  It must be called
+ * before the results of the gangs are freed.
+ */
+void
+cdbexplain_gatherExecStats(struct QueryDesc *queryDesc)
+{
+	EState	   *estate = queryDesc->estate;
+	CdbExplain_ShowStatCtx *showstatctx = queryDesc->showstatctx;
+	Slice	   *currentSlice;
+
+	Assert(Gp_role == GP_ROLE_DISPATCH);
+
+	if (!showstatctx || showstatctx->stats_gathered)
+		return;
+
+	/* Get local stats if root slice was executed here in the qDisp. */
+	currentSlice = getCurrentSlice(estate, LocallyExecutingSliceIndex(estate));
+	if (!currentSlice || sliceRunsOnQD(currentSlice))
+		cdbexplain_localExecStats(queryDesc->planstate, showstatctx);
+
+	/* Fill in the plan's Instrumentation with stats from qExecs. */
+	if (estate->dispatcherState && estate->dispatcherState->primaryResults)
+		cdbexplain_recvExecStats(queryDesc->planstate,
+								 estate->dispatcherState->primaryResults,
+								 LocallyExecutingSliceIndex(estate),
+								 showstatctx);
+}								/* cdbexplain_gatherExecStats */
+
+
+/*
+ * cdbexplain_getActualRows
+ *	  Called by qDisp to get the total number of rows a PlanState node
+ *	  produced in all the processes that executed it.  Returns false if the
+ *	  statistics of the node have not been gathered, or if some process
+ *	  executed the node other than exactly once, e.g. because the node was
+ *	  rescanned, or was squelched before it returned end-of-stream, e.g. the
+ *	  outer side of a hash join with an empty inner side.  In those cases the
+ *	  row count is not a cardinality.
+ */
+bool
+cdbexplain_getActualRows(struct PlanState *planstate, double *rows)
+{
+	CdbExplain_NodeSummary *ns;
+	double		ntuples = 0;
+	int			i;
+
+	if (!planstate->instrument || !planstate->instrument->cdbNodeSummary)
+		return false;
+
+	ns = planstate->instrument->cdbNodeSummary;
+	for (i = 0; i < ns->ninst; i++)
+	{
+		CdbExplain_StatInst *nsi = &ns->insts[i];
+
+		/* skip segments that did not run the slice */
+		if (nsi->pstype == T_Invalid)
+			continue;
+
+		if (nsi->nloops != 1 || !nsi->eos)
+			return false;
+
+		ntuples += nsi->ntuples;
+	}
+
+	*rows = ntuples;
+	return true;
+}								/* cdbexplain_getActualRows */
+
+
 /*
  * cdbexplain_recvStatWalker
  *	  Update the given PlanState node's Instrument node with statistics
@@ -995,6 +1072,7 @@ cdbexplain_collectStatsFromNode(PlanState *planstate, CdbExplain_SendStatCtx *ct
 	si->sortMethod = String2ExplainSortMethod(instr->sortMethod);
 	si->sortSpaceType = String2ExplainSortSpaceType(instr->sortSpaceType, si->sortMethod);
 	si->sortSpaceUsed = instr->sortSpaceUsed;
+	si->eos = instr->eos;
 }								/* cdbexplain_collectStatsFromNode */
 
 
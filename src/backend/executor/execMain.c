@@ -78,6 +78,7 @@
 #include "tcop/utility.h"
 #include "utils/acl.h"
 #include "utils/builtins.h" /* dumpDynamicTableScanPidIndex() */
+#include "utils/cardfeedback.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/snapmgr.h"
@@ -192,6 +193,9 @@ static PartitionNode *BuildPartitionNodeFromRoot(Oid relid);
 static void InitializeQueryPartsMetadata(PlannedStmt *plannedstmt, EState *estate);
 static void AdjustReplicatedTableCounts(EState *estate);
 static void check_epq_safe_on_qes(Plan *plan);
+static void RecordCardinalityFeedback(QueryDesc *queryDesc);
+static CdbVisitOpt RecordCardinalityFeedbackWalker(PlanState *planstate,
+												   void *context);
 
 /* end of local decls */
 
@@ -208,6 +212,13 @@ typedef struct ResultPartHashEntry
 	ResultRelInfo resultRelInfo;
 } ResultPartHashEntry;
 
+/* State for RecordCardinalityFeedbackWalker() */
+typedef struct RecordCardinalityFeedbackContext
+{
+	PlannedStmt *stmt;			/* plan carrying the feedback keys */
+	uint64		relmask;		/* relation mask of the plan */
+} RecordCardinalityFeedbackContext;
+
 
 typedef struct CopyDirectDispatchToSliceContext
 {
@@ -459,6 +470,30 @@ standard_ExecutorStart(QueryDesc *queryDesc, int eflags)
 	if ((XactReadOnly || Gp_role == GP_ROLE_DISPATCH) && !(eflags & EXEC_FLAG_EXPLAIN_ONLY))
 		ExecCheckXactReadOnly(queryDesc->plannedstmt);
 
+	/*
+	 * GPDB: to feed the actual row counts of a GPORCA plan back into the
+	 * optimizer, collect the row counts of all slices as EXPLAIN ANALYZE
+	 * does.  The statistics context is allocated in the caller's memory
+	 * context, and released by FreeQueryDesc().
+	 */
+	if (Gp_role == GP_ROLE_DISPATCH &&
+		optimizer_cardinality_feedback &&
+		queryDesc->plannedstmt->feedbackKeys != NIL &&
+		CardFeedbackEnabled() &&
+		!(eflags & EXEC_FLAG_EXPLAIN_ONLY))
+	{
+		queryDesc->instrument_options |= INSTRUMENT_ROWS | INSTRUMENT_CDB;
+
+		if (queryDesc->showstatctx == NULL)
+		{
+			instr_time	starttime;
+
+			INSTR_TIME_SET_CURRENT(starttime);
+			queryDesc->showstatctx = cdbexplain_showExecStatsBegin(queryDesc,
+																   starttime);
+		}
+	}
+
 	/*
 	 * Build EState, switch into per-query memory context for startup.
 	 */
@@ -1403,6 +1438,19 @@ standard_ExecutorEnd(QueryDesc *queryDesc)
         Gp_role == GP_ROLE_EXECUTE)
         cdbexplain_sendExecStats(queryDesc);
 
+	/*
+	 * If the plan ran to completion, feed the row counts of its nodes back
+	 * into GPORCA.  This has to happen before the results of the gangs, which
+	 * carry the statistics of the qExecs, are freed.
+	 */
+	if (Gp_role == GP_ROLE_DISPATCH &&
+		optimizer_cardinality_feedback &&
+		estate->es_got_eos &&
+		estate->showstatctx &&
+		(estate->es_instrument & INSTRUMENT_CDB) &&
+		queryDesc->plannedstmt->feedbackKeys != NIL)
+		RecordCardinalityFeedback(queryDesc);
+
 	/*
 	 * Free the results of all gangs.
 	 */
@@ -5516,6 +5564,51 @@ check_epq_safe_on_qes(Plan *plan)
 	}
 }
 
+/*
+ * Record the actual number of rows produced by the nodes of a completed
+ * GPORCA plan that carry a cardinality feedback key.
+ */
+static void
+RecordCardinalityFeedback(QueryDesc *queryDesc)
+{
+	RecordCardinalityFeedbackContext ctx;
+
+	cdbexplain_gatherExecStats(queryDesc);
+
+	ctx.stmt = queryDesc->plannedstmt;
+	ctx.relmask = CardFeedbackRelationMask(ctx.stmt->relationOids);
+
+	planstate_walk_node(queryDesc->planstate, RecordCardinalityFeedbackWalker,
+						&ctx);
+}
+
+static CdbVisitOpt
+RecordCardinalityFeedbackWalker(PlanState *planstate, void *context)
+{
+	RecordCardinalityFeedbackContext *ctx =
+		(RecordCardinalityFeedbackContext *) context;
+	PlannedStmt *stmt = ctx->stmt;
+	int			planNodeId = planstate->plan->plan_node_id;
+	double		rows;
+
+	/*
+	 * Nodes that were stopped early, e.g. below a Limit or on the outer side
+	 * of a hash join whose inner side is empty, are rejected by
+	 * cdbexplain_getActualRows().
+	 */
+	if (planNodeId >= 0 && planNodeId < list_length(stmt->feedbackKeys))
+	{
+		uint32		key = (uint32) list_nth_int(stmt->feedbackKeys, planNodeId);
+		uint32		fingerprint = (uint32)
+			list_nth_int(stmt->feedbackFingerprints, planNodeId);
+
+		if (key != 0 && cdbexplain_getActualRows(planstate, &rows))
+			CardFeedbackRecord(key, fingerprint, ctx->relmask, rows);
+	}
+
+	return CdbVisit_Walk;
+}
+
 /*
  * Greenplum specific code:
  * For details, see comments at the definition of static var executor_run_nesting_level
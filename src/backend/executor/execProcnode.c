@@ -1190,7 +1190,15 @@ ExecProcNode(PlanState *node)
 	}
 
 	if (node->instrument)
+	{
+		/*
+		 * CDB: remember whether the node ran to completion, rather than being
+		 * squelched before it ran out of tuples.
+		 */
+		if (TupIsNull(result))
+			node->instrument->eos = true;
 		InstrStopNode(node->instrument, TupIsNull(result) ? 0 : 1);
+	}
 
 	if (node->plan)
 		TRACE_POSTGRESQL_EXECPROCNODE_EXIT(GpIdentity.segindex, currentSliceId, nodeTag(node), node->plan->plan_node_id);
@@ -17,6 +17,7 @@ extern "C" {
 #include "postgres.h"
 
 #include "utils/guc.h"
+#include "cdb/cdbvars.h"
 }
 #include "gpopt/config/CConfigParamMapping.h"
 #include "gpopt/xforms/CXform.h"
@@ -283,6 +284,14 @@ CConfigParamMapping::SConfigMappingElem CConfigParamMapping::m_elements[] = {
 	 true,	// m_negate_param
 	 GPOS_WSZ_LIT(
 		 "Penalize a hash join with a skewed redistribute as a child.")},
+	{EopttracePenalizeMCVSkew, &optimizer_penalize_mcv_skew,
+	 false,	 // m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Cost hashed distributions by the rows of the segment that receives the most common value.")},
+	{EopttraceDisableMultiColStats, &gp_statistics_multicol,
+	 true,	// m_negate_param
+	 GPOS_WSZ_LIT(
+		 "Do not use the statistics on groups of columns collected by ANALYZE.")},
 	{EopttraceTranslateUnusedColrefs, &optimizer_prune_unused_columns,
 	 true,	// m_negate_param
 	 GPOS_WSZ_LIT("Prune unused columns from the query.")},
@@ -30,7 +30,12 @@
 #include "naucrates/exception.h"
 extern "C" {
 #include "catalog/pg_collation.h"
+#include "cdb/cdbvars.h"
+#include "utils/cardfeedback.h"
+#include "utils/mdsharedcache.h"
 #include "utils/memutils.h"
+#include "utils/resgroup.h"
+#include "utils/resource_manager.h"
 #include "utils/snapmgr.h"
 }
 #define GP_WRAP_START                                            \
@@ -707,6 +712,18 @@ gpdb::GetAttStats(Oid relid, AttrNumber attnum)
 	return NULL;
 }
 
+List *
+gpdb::GetMultiColStats(Oid relid)
+{
+	GP_WRAP_START;
+	{
+		/* catalog tables: pg_statistic_multicol */
+		return get_multicol_stats(relid);
+	}
+	GP_WRAP_END;
+	return NIL;
+}
+
 Oid
 gpdb::GetCommutatorOp(Oid opno)
 {
@@ -2564,6 +2581,7 @@ register_mdcache_invalidation_callbacks(void)
 		/* pg_class */
 		/* pg_index */
 		/* pg_trigger */
+		/* pg_statistic_multicol, which ANALYZE updates along with pg_class */
 
 		/*
 		 * pg_exttable is only updated when a new external table is dropped/created,
@@ -2663,6 +2681,68 @@ gpdb::MDCacheInTransientState(void)
 	return false;
 }
 
+uint64
+gpdb::GetQueryMemoryKB(void)
+{
+	GP_WRAP_START;
+	{
+		if (Gp_role == GP_ROLE_DISPATCH && IsResGroupActivated() &&
+			ResGroupIsAssigned())
+		{
+			return (uint64) ResourceGroupGetQueryMemoryLimit() / 1024;
+		}
+
+		return (uint64) statement_mem;
+	}
+	GP_WRAP_END;
+	return 0;
+}
+
+uint64
+gpdb::MDSharedCacheBeginQuery(void)
+{
+	GP_WRAP_START;
+	{
+		return ::MDSharedCacheBeginQuery();
+	}
+	GP_WRAP_END;
+	return 0;
+}
+
+char *
+gpdb::MDSharedCacheLookup(uint64 generation, const char *key, Size *len)
+{
+	GP_WRAP_START;
+	{
+		return ::MDSharedCacheLookup(generation, key, len);
+	}
+	GP_WRAP_END;
+	return NULL;
+}
+
+bool
+gpdb::MDSharedCacheInsert(uint64 generation, const char *key,
+						  const char *data, Size len)
+{
+	GP_WRAP_START;
+	{
+		return ::MDSharedCacheInsert(generation, key, data, len);
+	}
+	GP_WRAP_END;
+	return false;
+}
+
+CardFeedbackObservation *
+gpdb::CardFeedbackSnapshot(int *num_observations)
+{
+	GP_WRAP_START;
+	{
+		return ::CardFeedbackSnapshot(num_observations);
+	}
+	GP_WRAP_END;
+	return NULL;
+}
+
 // returns true if a query cancel is requested in GPDB
 bool
 gpdb::IsAbortRequested(void)
@@ -2770,6 +2850,31 @@ gpdb::GPDBAllocSetContextCreate()
 	return NULL;
 }
 
+MemoryContext
+gpdb::GPDBTempAllocSetContextCreate(const char *name)
+{
+	GP_WRAP_START;
+	{
+		return AllocSetContextCreate(CurrentMemoryContext, name,
+									 ALLOCSET_DEFAULT_MINSIZE,
+									 ALLOCSET_DEFAULT_INITSIZE,
+									 ALLOCSET_DEFAULT_MAXSIZE);
+	}
+	GP_WRAP_END;
+	return NULL;
+}
+
+Size
+gpdb::GPDBMemoryContextGetPeakSpace(MemoryContext context)
+{
+	GP_WRAP_START;
+	{
+		return MemoryContextGetPeakSpace(context);
+	}
+	GP_WRAP_END;
+	return 0;
+}
+
 
 // Returns true if type is a RANGE
 // pg_type (typtype = 'r')
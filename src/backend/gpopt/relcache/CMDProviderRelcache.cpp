@@ -16,7 +16,11 @@
 
 extern "C" {
 #include "postgres.h"
+
+#include "utils/guc.h"
+#include "utils/mdsharedcache.h"
 }
+#include "gpopt/gpdbwrappers.h"
 #include "gpopt/mdcache/CMDAccessor.h"
 #include "gpopt/relcache/CMDProviderRelcache.h"
 #include "gpopt/translate/CTranslatorRelcacheToDXL.h"
@@ -27,11 +31,55 @@ using namespace gpos;
 using namespace gpdxl;
 using namespace gpmd;
 
-CMDProviderRelcache::CMDProviderRelcache(CMemoryPool *mp) : m_mp(mp)
+CMDProviderRelcache::CMDProviderRelcache(CMemoryPool *mp,
+										 ULLONG shared_cache_generation)
+	: m_mp(mp), m_shared_cache_generation(shared_cache_generation)
 {
 	GPOS_ASSERT(NULL != m_mp);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderRelcache::GetSharedCacheKey
+//
+//	@doc:
+//		Build the key of the given mdid in the shared metadata cache tier.
+//		The key starts with the values of the session settings that change
+//		the translated object, so that sessions with different settings do
+//		not share it. Returns false if the mdid cannot be used as a key.
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDProviderRelcache::GetSharedCacheKey(IMDId *md_id, CHAR *key, ULONG key_len)
+{
+	const WCHAR *mdid_str = md_id->GetBuffer();
+
+	// optimizer_multilevel_partitioning changes the partition keys of a
+	// relation, gp_enable_relsize_collection its estimated size
+	INT prefix_len = snprintf(key, key_len, "m%dr%d:",
+							  optimizer_multilevel_partitioning ? 1 : 0,
+							  gp_enable_relsize_collection ? 1 : 0);
+	GPOS_ASSERT(0 < prefix_len && (ULONG) prefix_len < key_len);
+
+	for (ULONG ul = prefix_len; ul < key_len; ul++)
+	{
+		// serialized mdids only consist of digits and dots
+		const WCHAR wc = mdid_str[ul - prefix_len];
+		if (wc > 127)
+		{
+			return false;
+		}
+
+		key[ul] = (CHAR) wc;
+		if ('\0' == key[ul])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDProviderRelcache::GetMDObjDXLStr
@@ -45,6 +93,28 @@ CMDProviderRelcache::GetMDObjDXLStr(CMemoryPool *mp, CMDAccessor *md_accessor,
 									IMDId *md_id,
 									IMDCacheObject::Emdtype mdtype) const
 {
+	CHAR key[MDSHAREDCACHE_KEYLEN];
+	BOOL use_shared_cache = 0 != m_shared_cache_generation &&
+							IMDId::EmdidGPDBCtas != md_id->MdidType() &&
+							GetSharedCacheKey(md_id, key, MDSHAREDCACHE_KEYLEN);
+
+	if (use_shared_cache)
+	{
+		// another session may have translated the object already
+		Size len = 0;
+		char *data =
+			gpdb::MDSharedCacheLookup(m_shared_cache_generation, key, &len);
+		if (NULL != data)
+		{
+			GPOS_ASSERT(0 == len % sizeof(WCHAR));
+			CWStringDynamic *str =
+				GPOS_NEW(m_mp) CWStringDynamic(m_mp, (const WCHAR *) data);
+			gpdb::GPDBFree(data);
+
+			return str;
+		}
+	}
+
 	IMDCacheObject *md_obj = CTranslatorRelcacheToDXL::RetrieveObject(
 		mp, md_accessor, md_id, mdtype);
 
@@ -56,6 +126,15 @@ CMDProviderRelcache::GetMDObjDXLStr(CMemoryPool *mp, CMDAccessor *md_accessor,
 	// cleanup DXL object
 	md_obj->Release();
 
+	// objects translated while some index was invisible to our snapshot are
+	// not shared, see MDCacheSetTransientState()
+	if (use_shared_cache && !gpdb::MDCacheInTransientState())
+	{
+		(void) gpdb::MDSharedCacheInsert(
+			m_shared_cache_generation, key, (const char *) str->GetBuffer(),
+			(str->Length() + 1) * sizeof(WCHAR));
+	}
+
 	return str;
 }
 
@@ -53,6 +53,8 @@ CContextDXLToPlStmt::CContextDXLToPlStmt(
 	  m_rtable_entries_list(rtable_entries_list),
 	  m_partitioned_tables_list(NULL),
 	  m_num_partition_selectors_array(NULL),
+	  m_feedback_keys_array(NULL),
+	  m_feedback_fingerprints_array(NULL),
 	  m_subplan_entries_list(subplan_entries_list),
 	  m_result_relation_index(0),
 	  m_into_clause(NULL),
@@ -60,6 +62,8 @@ CContextDXLToPlStmt::CContextDXLToPlStmt(
 {
 	m_cte_consumer_info = GPOS_NEW(m_mp) HMUlCTEConsumerInfo(m_mp);
 	m_num_partition_selectors_array = GPOS_NEW(m_mp) ULongPtrArray(m_mp);
+	m_feedback_keys_array = GPOS_NEW(m_mp) ULongPtrArray(m_mp);
+	m_feedback_fingerprints_array = GPOS_NEW(m_mp) ULongPtrArray(m_mp);
 }
 
 //---------------------------------------------------------------------------
@@ -74,6 +78,8 @@ CContextDXLToPlStmt::~CContextDXLToPlStmt()
 {
 	m_cte_consumer_info->Release();
 	m_num_partition_selectors_array->Release();
+	m_feedback_keys_array->Release();
+	m_feedback_fingerprints_array->Release();
 }
 
 //---------------------------------------------------------------------------
@@ -292,6 +298,31 @@ CContextDXLToPlStmt::IncrementPartitionSelectors(ULONG scan_id)
 	(*ul)++;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CContextDXLToPlStmt::AddFeedbackKey
+//
+//	@doc:
+//		Record the cardinality feedback key of the given plan node; the high
+//		half of the key locates the entry in the feedback store, the low
+//		half is the fingerprint verified on lookup
+//
+//---------------------------------------------------------------------------
+void
+CContextDXLToPlStmt::AddFeedbackKey(ULONG plan_node_id, ULLONG feedback_key)
+{
+	// add extra elements to the arrays if necessary
+	const ULONG len = m_feedback_keys_array->Size();
+	for (ULONG ul = len; ul <= plan_node_id; ul++)
+	{
+		m_feedback_keys_array->Append(GPOS_NEW(m_mp) ULONG(0));
+		m_feedback_fingerprints_array->Append(GPOS_NEW(m_mp) ULONG(0));
+	}
+
+	*(*m_feedback_keys_array)[plan_node_id] = (ULONG)(feedback_key >> 32);
+	*(*m_feedback_fingerprints_array)[plan_node_id] = (ULONG) feedback_key;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CContextDXLToPlStmt::GetNumPartitionSelectorsList
@@ -315,6 +346,55 @@ CContextDXLToPlStmt::GetNumPartitionSelectorsList() const
 	return partition_selectors_list;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CContextDXLToPlStmt::GetFeedbackKeysList
+//
+//	@doc:
+//		Return list containing the cardinality feedback key of every plan
+//		node, indexed by plan node id; 0 marks nodes without a key. Returns
+//		NIL if no node has a key.
+//
+//---------------------------------------------------------------------------
+List *
+CContextDXLToPlStmt::GetFeedbackKeysList() const
+{
+	List *feedback_keys_list = NIL;
+	const ULONG len = m_feedback_keys_array->Size();
+	for (ULONG ul = 0; ul < len; ul++)
+	{
+		ULONG *feedback_key = (*m_feedback_keys_array)[ul];
+		feedback_keys_list =
+			gpdb::LAppendInt(feedback_keys_list, (int) *feedback_key);
+	}
+
+	return feedback_keys_list;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CContextDXLToPlStmt::GetFeedbackFingerprintsList
+//
+//	@doc:
+//		Return list containing the cardinality feedback key fingerprint of
+//		every plan node, indexed by plan node id
+//
+//---------------------------------------------------------------------------
+List *
+CContextDXLToPlStmt::GetFeedbackFingerprintsList() const
+{
+	List *feedback_fingerprints_list = NIL;
+	const ULONG len = m_feedback_fingerprints_array->Size();
+	for (ULONG ul = 0; ul < len; ul++)
+	{
+		ULONG *feedback_fingerprint = (*m_feedback_fingerprints_array)[ul];
+		feedback_fingerprints_list = gpdb::LAppendInt(
+			feedback_fingerprints_list, (int) *feedback_fingerprint);
+	}
+
+	return feedback_fingerprints_list;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CContextDXLToPlStmt::AddSubplan
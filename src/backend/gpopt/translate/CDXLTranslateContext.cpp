@@ -54,6 +54,26 @@ CDXLTranslateContext::CDXLTranslateContext(CMemoryPool *mp,
 	CopyParamHashmap(original);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLTranslateContext::CDXLTranslateContext
+//
+//	@doc:
+//		Ctor sharing the params hashmap of the plan
+//
+//---------------------------------------------------------------------------
+CDXLTranslateContext::CDXLTranslateContext(
+	CMemoryPool *mp, BOOL is_child_agg_node, const Query *query,
+	ULongToColParamMap *shared_colid_to_paramid_map)
+	: m_mp(mp), m_is_child_agg_node(is_child_agg_node), m_query(query)
+{
+	GPOS_ASSERT(NULL != shared_colid_to_paramid_map);
+
+	m_colid_to_target_entry_map = GPOS_NEW(m_mp) ULongToTargetEntryMap(m_mp);
+	shared_colid_to_paramid_map->AddRef();
+	m_colid_to_paramid_map = shared_colid_to_paramid_map;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLTranslateContext::~CDXLTranslateContext
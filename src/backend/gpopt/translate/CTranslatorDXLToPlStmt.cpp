@@ -255,6 +255,9 @@ CTranslatorDXLToPlStmt::GetPlannedStmtFromDXL(const CDXLNode *dxlnode,
 	planned_stmt->relationOids = oids_list;
 	planned_stmt->numSelectorsPerScanId =
 		m_dxl_to_plstmt_context->GetNumPartitionSelectorsList();
+	planned_stmt->feedbackKeys = m_dxl_to_plstmt_context->GetFeedbackKeysList();
+	planned_stmt->feedbackFingerprints =
+		m_dxl_to_plstmt_context->GetFeedbackFingerprintsList();
 
 	plan->nMotionNodes = m_dxl_to_plstmt_context->GetCurrentMotionId() - 1;
 	planned_stmt->nMotionNodes =
@@ -341,8 +344,26 @@ CTranslatorDXLToPlStmt::TranslateDXLOperatorToPlan(
 				   dxlnode->GetOperator()->GetOpNameStr()->GetBuffer());
 	}
 
-	return (this->*dxlnode_to_logical_funct)(dxlnode, output_context,
-											 ctxt_translation_prev_siblings);
+	Plan *plan = (this->*dxlnode_to_logical_funct)(
+		dxlnode, output_context, ctxt_translation_prev_siblings);
+
+	// remember the cardinality feedback key of the node, so that the
+	// executor can report the actual number of rows it produced
+	CDXLProperties *properties = dxlnode->GetProperties();
+	if (NULL != plan && NULL != properties &&
+		EdxlpropertyPhysical == properties->GetDXLPropertyType())
+	{
+		ULLONG feedback_key =
+			CDXLPhysicalProperties::PdxlpropConvert(properties)
+				->GetFeedbackKey();
+		if (0 != feedback_key)
+		{
+			m_dxl_to_plstmt_context->AddFeedbackKey(plan->plan_node_id,
+													feedback_key);
+		}
+	}
+
+	return plan;
 }
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,1095 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CTranslatorExprToPlStmt.cpp
+//
+//	@doc:
+//		Implementation of the methods translating the physical plan found by
+//		the optimizer directly into a GPDB PlannedStmt
+//
+//	@test:
+//
+//
+//---------------------------------------------------------------------------
+
+extern "C" {
+#include "postgres.h"
+
+#include "nodes/nodes.h"
+#include "nodes/plannodes.h"
+#include "nodes/primnodes.h"
+}
+
+#include "gpos/base.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "gpopt/base/CColRefSetIter.h"
+#include "gpopt/base/CColRefTable.h"
+#include "gpopt/base/CDrvdPropPlan.h"
+#include "gpopt/base/COptCtxt.h"
+#include "gpopt/base/CUtils.h"
+#include "gpopt/exception.h"
+#include "gpopt/gpdbwrappers.h"
+#include "gpopt/mdcache/CMDAccessor.h"
+#include "gpopt/operators/CExpression.h"
+#include "gpopt/operators/CPhysicalMotionGather.h"
+#include "gpopt/operators/CPhysicalTableScan.h"
+#include "gpopt/operators/CPhysicalUnionAll.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/translate/CTranslatorExprToPlStmt.h"
+#include "gpopt/translate/CTranslatorUtils.h"
+#include "naucrates/exception.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/statistics/CStatistics.h"
+
+using namespace gpdxl;
+using namespace gpos;
+using namespace gpopt;
+using namespace gpmd;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::CTranslatorExprToPlStmt
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CTranslatorExprToPlStmt::CTranslatorExprToPlStmt(
+	CMemoryPool *mp, CMDAccessor *md_accessor, MemoryContext plan_cxt,
+	const Query *orig_query, bool can_set_tag,
+	DistributionHashOpsKind distribution_hashops)
+	: m_mp(mp),
+	  m_md_accessor(md_accessor),
+	  m_plan_cxt(plan_cxt),
+	  m_query(orig_query),
+	  m_can_set_tag(can_set_tag),
+	  m_plan_id_generator(1 /* ulStartId */),
+	  m_motion_id_generator(1 /* ulStartId */),
+	  m_param_id_generator(0 /* ulStartId */),
+	  m_table_list(NULL),
+	  m_subplans_list(NULL),
+	  m_dxl_to_plstmt_context(mp, &m_plan_id_generator, &m_motion_id_generator,
+							  &m_param_id_generator, distribution_hashops,
+							  &m_table_list, &m_subplans_list),
+	  m_colid_to_paramid_map(NULL),
+	  m_planned_stmt(NULL)
+{
+	GPOS_ASSERT(NULL != md_accessor);
+	GPOS_ASSERT(NULL != plan_cxt);
+
+	m_colid_to_paramid_map = GPOS_NEW(m_mp) ULongToColParamMap(m_mp);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::~CTranslatorExprToPlStmt
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CTranslatorExprToPlStmt::~CTranslatorExprToPlStmt()
+{
+	m_colid_to_paramid_map->Release();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::FTranslate
+//
+//	@doc:
+//		Translate the given plan into a PlannedStmt built in the plan memory
+//		context. Return false if the plan is not supported.
+//
+//---------------------------------------------------------------------------
+BOOL
+CTranslatorExprToPlStmt::FTranslate(CExpression *pexprPlan,
+									CColRefArray *colref_array,
+									CMDNameArray *pdrgpmdname)
+{
+	GPOS_ASSERT(NULL != pexprPlan);
+	GPOS_ASSERT(NULL != colref_array);
+	GPOS_ASSERT(NULL != pdrgpmdname);
+	GPOS_ASSERT(NULL == m_planned_stmt);
+
+	if (!IsSupported(pexprPlan, pdrgpmdname))
+	{
+		return false;
+	}
+
+	MemoryContext old_cxt = MemoryContextSwitchTo(m_plan_cxt);
+
+	GPOS_TRY
+	{
+		CDXLTranslateContext output_context(m_mp, false, m_query,
+											m_colid_to_paramid_map);
+		Plan *plan = TranslateExpr(pexprPlan, colref_array, true /*fRemap*/,
+								   &output_context);
+
+		// the output columns have the names the query gives them
+		GPOS_ASSERT(pdrgpmdname->Size() ==
+					(ULONG) gpdb::ListLength(plan->targetlist));
+		ULONG ul = 0;
+		ListCell *lc = NULL;
+		ForEach(lc, plan->targetlist)
+		{
+			TargetEntry *target_entry = (TargetEntry *) lfirst(lc);
+			target_entry->resname =
+				CTranslatorUtils::CreateMultiByteCharStringFromWCString(
+					(*pdrgpmdname)[ul]->GetMDName()->GetBuffer());
+			ul++;
+		}
+
+		m_planned_stmt = AssemblePlannedStmt(plan);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		MemoryContextSwitchTo(old_cxt);
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	MemoryContextSwitchTo(old_cxt);
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::IsSupported
+//
+//	@doc:
+//		Check whether the given plan can be translated directly: a gather
+//		motion to the master on top of table scans and their union alls.
+//		Anything else is translated through DXL.
+//
+//---------------------------------------------------------------------------
+BOOL
+CTranslatorExprToPlStmt::IsSupported(CExpression *pexpr,
+									 CMDNameArray *pdrgpmdname)
+{
+	if (COperator::EopPhysicalMotionGather != pexpr->Pop()->Eopid())
+	{
+		return false;
+	}
+
+	CPhysicalMotionGather *popGather =
+		CPhysicalMotionGather::PopConvert(pexpr->Pop());
+	if (!popGather->FOnMaster() || popGather->FOrderPreserving() ||
+		CUtils::FDuplicateHazardMotion(pexpr))
+	{
+		return false;
+	}
+
+	// direct dispatch is only computed for DXL plans
+	if (0 !=
+		COptCtxt::PoctxtFromTLS()->GetDirectDispatchableFilters()->Size())
+	{
+		return false;
+	}
+
+	const ULONG length = pdrgpmdname->Size();
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		if (IsUnknownName((*pdrgpmdname)[ul]->GetMDName()))
+		{
+			return false;
+		}
+	}
+
+	return IsSupportedChild((*pexpr)[0]);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::IsSupportedChild
+//
+//	@doc:
+//		Check whether the given operator below the root can be translated
+//		directly
+//
+//---------------------------------------------------------------------------
+BOOL
+CTranslatorExprToPlStmt::IsSupportedChild(CExpression *pexpr)
+{
+	CDistributionSpec::EDistributionType edt =
+		CDrvdPropPlan::Pdpplan(pexpr->PdpDerive())->Pds()->Edt();
+	if (CDistributionSpec::EdtHashed != edt &&
+		CDistributionSpec::EdtRandom != edt)
+	{
+		return false;
+	}
+
+	CColRefSetIter crsi(*pexpr->Prpp()->PcrsRequired());
+	while (crsi.Advance())
+	{
+		if (IsUnknownName(crsi.Pcr()->Name().Pstr()))
+		{
+			return false;
+		}
+	}
+
+	switch (pexpr->Pop()->Eopid())
+	{
+		case COperator::EopPhysicalTableScan:
+			return !CPhysicalTableScan::PopConvert(pexpr->Pop())
+						->Ptabdesc()
+						->IsPartitioned();
+
+		case COperator::EopPhysicalSerialUnionAll:
+		{
+			const ULONG arity = pexpr->Arity();
+			for (ULONG ul = 0; ul < arity; ul++)
+			{
+				if (!IsSupportedChild((*pexpr)[ul]))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		default:
+			return false;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::IsUnknownName
+//
+//	@doc:
+//		Check whether the given column name is the one ORCA uses for names it
+//		cannot interpret in the locale of the database. The DXL translation
+//		looks the original names up in the query.
+//
+//---------------------------------------------------------------------------
+BOOL
+CTranslatorExprToPlStmt::IsUnknownName(const CWStringConst *str)
+{
+	CWStringConst str_unknown(GPOS_WSZ_LIT("UNKNOWN"));
+	return str->Equals(&str_unknown);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::PdrgpcrOrdered
+//
+//	@doc:
+//		Columns of the given set, with the columns of the given array first
+//		and the remaining ones in the order of the set, as in the project
+//		lists of the DXL translation
+//
+//---------------------------------------------------------------------------
+CColRefArray *
+CTranslatorExprToPlStmt::PdrgpcrOrdered(CColRefSet *pcrs,
+										CColRefArray *colref_array)
+{
+	CColRefArray *pdrgpcr = GPOS_NEW(m_mp) CColRefArray(m_mp);
+	CColRefSet *pcrsIncluded = GPOS_NEW(m_mp) CColRefSet(m_mp);
+
+	if (NULL != colref_array)
+	{
+		const ULONG length = colref_array->Size();
+		for (ULONG ul = 0; ul < length; ul++)
+		{
+			CColRef *colref = (*colref_array)[ul];
+			pdrgpcr->Append(colref);
+			pcrsIncluded->Include(colref);
+		}
+	}
+
+	CColRefSetIter crsi(*pcrs);
+	while (crsi.Advance())
+	{
+		CColRef *colref = crsi.Pcr();
+		if (!pcrsIncluded->FMember(colref))
+		{
+			pdrgpcr->Append(colref);
+			pcrsIncluded->Include(colref);
+		}
+	}
+	pcrsIncluded->Release();
+
+	return pdrgpcr;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::PdrgpcrMerge
+//
+//	@doc:
+//		Columns of the given order followed by the required columns not in
+//		the order yet
+//
+//---------------------------------------------------------------------------
+CColRefArray *
+CTranslatorExprToPlStmt::PdrgpcrMerge(CColRefArray *pdrgpcrOrder,
+									  CColRefArray *pdrgpcrRequired)
+{
+	CColRefArray *pdrgpcrMerge = GPOS_NEW(m_mp) CColRefArray(m_mp);
+	CColRefSet *pcrsIncluded = GPOS_NEW(m_mp) CColRefSet(m_mp);
+
+	if (NULL != pdrgpcrOrder)
+	{
+		pdrgpcrMerge->AppendArray(pdrgpcrOrder);
+		pcrsIncluded->Include(pdrgpcrOrder);
+	}
+
+	const ULONG length = pdrgpcrRequired->Size();
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		CColRef *colref = (*pdrgpcrRequired)[ul];
+		if (!pcrsIncluded->FMember(colref))
+		{
+			pdrgpcrMerge->Append(colref);
+			pcrsIncluded->Include(colref);
+		}
+	}
+	pcrsIncluded->Release();
+
+	return pdrgpcrMerge;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::PdrgpcrRequired
+//
+//	@doc:
+//		Required columns of the given node if it is remapped, NULL otherwise.
+//		Table scans are never remapped on their own.
+//
+//---------------------------------------------------------------------------
+CColRefArray *
+CTranslatorExprToPlStmt::PdrgpcrRequired(CExpression *pexpr, BOOL fRemap)
+{
+	if (!fRemap || COperator::EopPhysicalTableScan == pexpr->Pop()->Eopid())
+	{
+		return NULL;
+	}
+
+	return pexpr->Prpp()->PcrsRequired()->Pdrgpcr(m_mp);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::PdrgpcrProjList
+//
+//	@doc:
+//		Columns in the project list of the given node, before any result node
+//		is added on top of it
+//
+//---------------------------------------------------------------------------
+CColRefArray *
+CTranslatorExprToPlStmt::PdrgpcrProjList(CExpression *pexpr,
+										 CColRefArray *colref_array)
+{
+	switch (pexpr->Pop()->Eopid())
+	{
+		case COperator::EopPhysicalTableScan:
+			return PdrgpcrOrdered(pexpr->Prpp()->PcrsRequired(), colref_array);
+
+		case COperator::EopPhysicalSerialUnionAll:
+		{
+			// the append node keeps the order of its output columns
+			CColRefArray *pdrgpcrOutputAll =
+				CPhysicalUnionAll::PopConvert(pexpr->Pop())->PdrgpcrOutput();
+			CColRefSet *reqdCols = pexpr->Prpp()->PcrsRequired();
+
+			CColRefArray *requiredOutput = GPOS_NEW(m_mp) CColRefArray(m_mp);
+			const ULONG num_total_cols = pdrgpcrOutputAll->Size();
+			for (ULONG c = 0; c < num_total_cols; c++)
+			{
+				if (reqdCols->FMember((*pdrgpcrOutputAll)[c]))
+				{
+					requiredOutput->Append((*pdrgpcrOutputAll)[c]);
+				}
+			}
+
+			CColRefArray *pdrgpcr = PdrgpcrOrdered(reqdCols, requiredOutput);
+			requiredOutput->Release();
+
+			return pdrgpcr;
+		}
+
+		case COperator::EopPhysicalMotionGather:
+		{
+			// the motion sends the columns of its child
+			CExpression *pexprChild = (*pexpr)[0];
+			CColRefArray *pdrgpcrChild =
+				PdrgpcrProjList(pexprChild, colref_array);
+			CColRefArray *pdrgpcrRequired =
+				PdrgpcrRequired(pexprChild, true /*fRemap*/);
+			if (NULL != pdrgpcrRequired)
+			{
+				CColRefArray *pdrgpcrRemap =
+					PdrgpcrRemap(pdrgpcrChild, pdrgpcrRequired, colref_array);
+				pdrgpcrRequired->Release();
+				if (NULL != pdrgpcrRemap)
+				{
+					pdrgpcrChild->Release();
+					pdrgpcrChild = pdrgpcrRemap;
+				}
+			}
+
+			return pdrgpcrChild;
+		}
+
+		default:
+			GPOS_RAISE(gpopt::ExmaGPOPT, gpopt::ExmiUnsupportedOp,
+					   pexpr->Pop()->SzId());
+			return NULL;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::PdrgpcrRemap
+//
+//	@doc:
+//		Columns of the result node to add on top of a node with the given
+//		project list, so that it produces the required columns in the given
+//		order. NULL if the project list already does.
+//
+//---------------------------------------------------------------------------
+CColRefArray *
+CTranslatorExprToPlStmt::PdrgpcrRemap(CColRefArray *pdrgpcrProjList,
+									  CColRefArray *pdrgpcrRequired,
+									  CColRefArray *pdrgpcrOrder)
+{
+	CColRefArray *pdrgpcrOrderedReqdCols =
+		PdrgpcrMerge(pdrgpcrOrder, pdrgpcrRequired);
+	BOOL fMatch = pdrgpcrOrderedReqdCols->Equals(pdrgpcrProjList);
+	pdrgpcrOrderedReqdCols->Release();
+
+	if (fMatch)
+	{
+		return NULL;
+	}
+
+	CColRefSet *pcrsOutput = GPOS_NEW(m_mp) CColRefSet(m_mp);
+	pcrsOutput->Include(pdrgpcrRequired);
+	CColRefArray *pdrgpcrRemap = PdrgpcrOrdered(pcrsOutput, pdrgpcrOrder);
+	pcrsOutput->Release();
+
+	return pdrgpcrRemap;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::TranslateExpr
+//
+//	@doc:
+//		Translate the given node producing the given columns, remapping its
+//		output columns to the required ones if asked to
+//
+//---------------------------------------------------------------------------
+Plan *
+CTranslatorExprToPlStmt::TranslateExpr(CExpression *pexpr,
+									   CColRefArray *colref_array, BOOL fRemap,
+									   CDXLTranslateContext *output_context)
+{
+	CColRefArray *pdrgpcrRequired = PdrgpcrRequired(pexpr, fRemap);
+	Plan *plan = TranslateExprRemapped(pexpr, colref_array, pdrgpcrRequired,
+									   colref_array, output_context);
+	CRefCount::SafeRelease(pdrgpcrRequired);
+
+	return plan;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::TranslateExprRemapped
+//
+//	@doc:
+//		Translate the given node, adding a result node on top of it if its
+//		project list does not have the required columns in the given order.
+//		The result node is numbered before its child, as in the translation
+//		of a DXL result node.
+//
+//---------------------------------------------------------------------------
+Plan *
+CTranslatorExprToPlStmt::TranslateExprRemapped(
+	CExpression *pexpr, CColRefArray *colref_array,
+	CColRefArray *pdrgpcrRequired, CColRefArray *pdrgpcrOrder,
+	CDXLTranslateContext *output_context)
+{
+	CColRefArray *pdrgpcrProjList = PdrgpcrProjList(pexpr, colref_array);
+	CColRefArray *pdrgpcrRemap = NULL;
+	if (NULL != pdrgpcrRequired)
+	{
+		pdrgpcrRemap =
+			PdrgpcrRemap(pdrgpcrProjList, pdrgpcrRequired, pdrgpcrOrder);
+	}
+
+	if (NULL == pdrgpcrRemap)
+	{
+		Plan *plan = TranslateNode(pexpr, colref_array, pdrgpcrProjList,
+								   output_context);
+		pdrgpcrProjList->Release();
+
+		return plan;
+	}
+
+	Result *result = MakeNode(Result);
+
+	Plan *plan = &(result->plan);
+	plan->plan_node_id = m_dxl_to_plstmt_context.GetNextPlanId();
+	TranslatePlanCosts(pexpr, plan);
+
+	CDXLTranslateContext child_context(m_mp, false, m_query,
+									   m_colid_to_paramid_map);
+	Plan *child_plan =
+		TranslateNode(pexpr, colref_array, pdrgpcrProjList, &child_context);
+
+	plan->lefttree = child_plan;
+	plan->nMotionNodes = child_plan->nMotionNodes;
+	plan->targetlist = TranslateTargetListFromChild(
+		pdrgpcrRemap, &child_context, output_context);
+	plan->qual = NIL;
+	result->resconstantqual = NULL;
+
+	AddFeedbackKey(pexpr, plan);
+
+	pdrgpcrRemap->Release();
+	pdrgpcrProjList->Release();
+
+	return (Plan *) result;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::TranslateNode
+//
+//	@doc:
+//		Translate the given node with the given project list
+//
+//---------------------------------------------------------------------------
+Plan *
+CTranslatorExprToPlStmt::TranslateNode(CExpression *pexpr,
+									   CColRefArray *colref_array,
+									   CColRefArray *pdrgpcrProjList,
+									   CDXLTranslateContext *output_context)
+{
+	Plan *plan = NULL;
+
+	switch (pexpr->Pop()->Eopid())
+	{
+		case COperator::EopPhysicalTableScan:
+			plan = TranslateTblScan(pexpr, pdrgpcrProjList, output_context);
+			break;
+
+		case COperator::EopPhysicalSerialUnionAll:
+			plan = TranslateUnionAll(pexpr, pdrgpcrProjList, output_context);
+			break;
+
+		case COperator::EopPhysicalMotionGather:
+			plan = TranslateGatherMotion(pexpr, colref_array, pdrgpcrProjList,
+										 output_context);
+			break;
+
+		default:
+			GPOS_RAISE(gpopt::ExmaGPOPT, gpopt::ExmiUnsupportedOp,
+					   pexpr->Pop()->SzId());
+	}
+
+	AddFeedbackKey(pexpr, plan);
+
+	return plan;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::TranslateTblScan
+//
+//	@doc:
+//		Translate a table scan into a SeqScan node, adding its range table
+//		entry
+//
+//---------------------------------------------------------------------------
+Plan *
+CTranslatorExprToPlStmt::TranslateTblScan(CExpression *pexprTblScan,
+										  CColRefArray *pdrgpcrProjList,
+										  CDXLTranslateContext *output_context)
+{
+	CPhysicalTableScan *popTblScan =
+		CPhysicalTableScan::PopConvert(pexprTblScan->Pop());
+	const CTableDescriptor *ptabdesc = popTblScan->Ptabdesc();
+	CColRefArray *pdrgpcrOutput = popTblScan->PdrgpcrOutput();
+
+	const IMDRelation *md_rel = m_md_accessor->RetrieveRel(ptabdesc->MDId());
+	const ULONG num_of_non_sys_cols =
+		CTranslatorUtils::GetNumNonSystemColumns(md_rel);
+
+	// we will add the new range table entry as the last element of the range table
+	Index index =
+		gpdb::ListLength(m_dxl_to_plstmt_context.GetRTableEntriesList()) + 1;
+
+	Oid oid = CMDIdGPDB::CastMdid(ptabdesc->MDId())->Oid();
+	GPOS_ASSERT(InvalidOid != oid);
+
+	RangeTblEntry *rte = MakeNode(RangeTblEntry);
+	rte->rtekind = RTE_RELATION;
+	rte->relid = oid;
+	rte->checkAsUser = ptabdesc->GetExecuteAsUserId();
+	rte->requiredPerms |= ACL_SELECT;
+
+	Alias *alias = MakeNode(Alias);
+	alias->colnames = NIL;
+	alias->aliasname = CTranslatorUtils::CreateMultiByteCharStringFromWCString(
+		ptabdesc->Name().Pstr()->GetBuffer());
+
+	// name the columns the plan uses, and the dropped and unused columns
+	// between them with empty names, as GPDB requires
+	INT last_attno = 0;
+	const ULONG num_cols = ptabdesc->ColumnCount();
+	for (ULONG ul = 0; ul < num_cols; ul++)
+	{
+		const CColumnDescriptor *pcd = ptabdesc->Pcoldesc(ul);
+		INT attno = pcd->AttrNum();
+		if (CColRef::EUsed != (*pdrgpcrOutput)[ul]->GetUsage() || 0 > attno)
+		{
+			continue;
+		}
+
+		for (INT dropped_col_attno = last_attno + 1; dropped_col_attno < attno;
+			 dropped_col_attno++)
+		{
+			alias->colnames = gpdb::LAppend(
+				alias->colnames, gpdb::MakeStringValue(PStrDup("")));
+		}
+
+		CHAR *col_name_char_array =
+			CTranslatorUtils::CreateMultiByteCharStringFromWCString(
+				pcd->Name().Pstr()->GetBuffer());
+		alias->colnames = gpdb::LAppend(
+			alias->colnames, gpdb::MakeStringValue(col_name_char_array));
+		last_attno = attno;
+	}
+
+	// if there are any dropped columns at the end, add those too
+	for (ULONG ul = last_attno + 1; ul <= num_of_non_sys_cols; ul++)
+	{
+		alias->colnames = gpdb::LAppend(alias->colnames,
+										gpdb::MakeStringValue(PStrDup("")));
+	}
+
+	rte->eref = alias;
+	m_dxl_to_plstmt_context.AddRTE(rte);
+
+	SeqScan *seq_scan = MakeNode(SeqScan);
+	seq_scan->scanrelid = index;
+
+	Plan *plan = &(seq_scan->plan);
+	plan->plan_node_id = m_dxl_to_plstmt_context.GetNextPlanId();
+	plan->nMotionNodes = 0;
+	TranslatePlanCosts(pexprTblScan, plan);
+
+	CColRefSet *pcrsOutput = pexprTblScan->DeriveOutputColumns();
+	const ULONG length = pdrgpcrProjList->Size();
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		CColRef *colref = (*pdrgpcrProjList)[ul];
+		if (!pcrsOutput->FMember(colref))
+		{
+			GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXL2PlStmtAttributeNotFound,
+					   colref->Id());
+		}
+
+		AttrNumber attno =
+			(AttrNumber) CColRefTable::PcrConvert(colref)->AttrNum();
+		Var *var = gpdb::MakeVar(
+			index, attno, CMDIdGPDB::CastMdid(colref->RetrieveType()->MDId())->Oid(),
+			colref->TypeModifier(),
+			0  // varlevelsup
+		);
+
+		TargetEntry *target_entry = MakeNode(TargetEntry);
+		target_entry->expr = (Expr *) var;
+		target_entry->resname =
+			CTranslatorUtils::CreateMultiByteCharStringFromWCString(
+				colref->Name().Pstr()->GetBuffer());
+		target_entry->resno = (AttrNumber)(ul + 1);
+		target_entry->resorigtbl = oid;
+		target_entry->resorigcol = attno;
+
+		output_context->InsertMapping(colref->Id(), target_entry);
+		plan->targetlist = gpdb::LAppend(plan->targetlist, target_entry);
+	}
+	plan->qual = NIL;
+
+	return (Plan *) seq_scan;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::TranslateUnionAll
+//
+//	@doc:
+//		Translate a serial union all into an Append node. Children whose
+//		columns are not in the order the append node needs are remapped.
+//
+//---------------------------------------------------------------------------
+Plan *
+CTranslatorExprToPlStmt::TranslateUnionAll(CExpression *pexprUnionAll,
+										   CColRefArray *pdrgpcrProjList,
+										   CDXLTranslateContext *output_context)
+{
+	CPhysicalUnionAll *popUnionAll =
+		CPhysicalUnionAll::PopConvert(pexprUnionAll->Pop());
+	CColRefArray *pdrgpcrOutputAll = popUnionAll->PdrgpcrOutput();
+	CColRefSet *reqdCols = pexprUnionAll->Prpp()->PcrsRequired();
+
+	Append *append = MakeNode(Append);
+
+	Plan *plan = &(append->plan);
+	plan->plan_node_id = m_dxl_to_plstmt_context.GetNextPlanId();
+	TranslatePlanCosts(pexprUnionAll, plan);
+	plan->nMotionNodes = 0;
+	append->appendplans = NIL;
+
+	// compute a list of indexes of output columns that are actually required
+	CColRefArray *reqd_col_array = GPOS_NEW(m_mp) CColRefArray(m_mp);
+	const ULONG num_total_cols = pdrgpcrOutputAll->Size();
+	for (ULONG c = 0; c < num_total_cols; c++)
+	{
+		if (reqdCols->FMember((*pdrgpcrOutputAll)[c]))
+		{
+			reqd_col_array->Append((*pdrgpcrOutputAll)[c]);
+		}
+	}
+	ULongPtrArray *reqd_col_positions =
+		pdrgpcrOutputAll->IndexesOfSubsequence(reqd_col_array);
+	reqd_col_array->Release();
+	GPOS_ASSERT(NULL != reqd_col_positions);
+
+	// translate children
+	CColRef2dArray *pdrgpdrgpcrInput = popUnionAll->PdrgpdrgpcrInput();
+	CDXLTranslateContext child_context(m_mp, false, m_query,
+									   m_colid_to_paramid_map);
+	const ULONG arity = pexprUnionAll->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		CColRefArray *requiredInput =
+			(*pdrgpdrgpcrInput)[ul]->CreateReducedArray(reqd_col_positions);
+
+		Plan *child_plan = TranslateExprRemapped(
+			(*pexprUnionAll)[ul], requiredInput, requiredInput, requiredInput,
+			&child_context);
+
+		append->appendplans = gpdb::LAppend(append->appendplans, child_plan);
+		plan->nMotionNodes += child_plan->nMotionNodes;
+		requiredInput->Release();
+	}
+	reqd_col_positions->Release();
+
+	plan->targetlist = NIL;
+	const ULONG length = pdrgpcrProjList->Size();
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		CColRef *colref = (*pdrgpcrProjList)[ul];
+		AttrNumber attno = (AttrNumber)(ul + 1);
+
+		Var *var = gpdb::MakeVar(
+			OUTER_VAR, attno,
+			CMDIdGPDB::CastMdid(colref->RetrieveType()->MDId())->Oid(),
+			colref->TypeModifier(),
+			0  // varlevelsup
+		);
+
+		TargetEntry *target_entry = MakeNode(TargetEntry);
+		target_entry->expr = (Expr *) var;
+		target_entry->resname =
+			CTranslatorUtils::CreateMultiByteCharStringFromWCString(
+				colref->Name().Pstr()->GetBuffer());
+		target_entry->resno = attno;
+
+		output_context->InsertMapping(colref->Id(), target_entry);
+		plan->targetlist = gpdb::LAppend(plan->targetlist, target_entry);
+	}
+	plan->qual = NIL;
+
+	return (Plan *) append;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::TranslateGatherMotion
+//
+//	@doc:
+//		Translate a gather motion to the master into a Motion node
+//
+//---------------------------------------------------------------------------
+Plan *
+CTranslatorExprToPlStmt::TranslateGatherMotion(
+	CExpression *pexprMotion, CColRefArray *colref_array,
+	CColRefArray *pdrgpcrProjList, CDXLTranslateContext *output_context)
+{
+	Motion *motion = MakeNode(Motion);
+
+	Plan *plan = &(motion->plan);
+	plan->plan_node_id = m_dxl_to_plstmt_context.GetNextPlanId();
+	TranslatePlanCosts(pexprMotion, plan);
+
+	CDXLTranslateContext child_context(m_mp, false, m_query,
+									   m_colid_to_paramid_map);
+	Plan *child_plan = TranslateExpr((*pexprMotion)[0], colref_array,
+									 true /*fRemap*/, &child_context);
+
+	plan->targetlist = TranslateTargetListFromChild(
+		pdrgpcrProjList, &child_context, output_context);
+	plan->qual = NIL;
+
+	// not a sorting motion
+	motion->sendSorted = false;
+	motion->numSortCols = 0;
+	motion->sortColIdx = NULL;
+	motion->sortOperators = NULL;
+	motion->nullsFirst = NULL;
+
+	// the child is distributed across all segments, so its flow is the
+	// all-segment one
+	Flow *flow = MakeNode(Flow);
+	flow->flotype = FLOW_UNDEFINED;
+	flow->numsegments = 1;
+	child_plan->flow = flow;
+
+	motion->motionID = m_dxl_to_plstmt_context.GetNextMotionId();
+	plan->lefttree = child_plan;
+	plan->nMotionNodes = child_plan->nMotionNodes + 1;
+	motion->motionType = MOTIONTYPE_FIXED;
+	motion->isBroadcast = false;
+
+	return (Plan *) motion;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::TranslateTargetListFromChild
+//
+//	@doc:
+//		Translate the given columns of a child into the target list of its
+//		parent, keeping the origin of the columns
+//
+//---------------------------------------------------------------------------
+List *
+CTranslatorExprToPlStmt::TranslateTargetListFromChild(
+	CColRefArray *pdrgpcrProjList, const CDXLTranslateContext *child_context,
+	CDXLTranslateContext *output_context)
+{
+	List *target_list = NIL;
+
+	const ULONG length = pdrgpcrProjList->Size();
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		CColRef *colref = (*pdrgpcrProjList)[ul];
+		const TargetEntry *child_target_entry =
+			child_context->GetTargetEntry(colref->Id());
+		if (NULL == child_target_entry)
+		{
+			GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXL2PlStmtAttributeNotFound,
+					   colref->Id());
+		}
+
+		Var *var = gpdb::MakeVar(
+			OUTER_VAR, child_target_entry->resno,
+			CMDIdGPDB::CastMdid(colref->RetrieveType()->MDId())->Oid(),
+			colref->TypeModifier(),
+			0  // varlevelsup
+		);
+		if (IsA(child_target_entry->expr, Var))
+		{
+			// keep the original varno and attno of the column
+			Var *child_var = (Var *) child_target_entry->expr;
+			var->varnoold = child_var->varnoold;
+			var->varoattno = child_var->varoattno;
+		}
+
+		TargetEntry *target_entry = MakeNode(TargetEntry);
+		target_entry->expr = (Expr *) var;
+		target_entry->resname =
+			CTranslatorUtils::CreateMultiByteCharStringFromWCString(
+				colref->Name().Pstr()->GetBuffer());
+		target_entry->resno = (AttrNumber)(ul + 1);
+		target_entry->resorigtbl = child_target_entry->resorigtbl;
+		target_entry->resorigcol = child_target_entry->resorigcol;
+
+		output_context->InsertMapping(colref->Id(), target_entry);
+		target_list = gpdb::LAppend(target_list, target_entry);
+	}
+
+	return target_list;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::TranslatePlanCosts
+//
+//	@doc:
+//		Translate the costs of the given node, computed as for the physical
+//		properties of a DXL node
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorExprToPlStmt::TranslatePlanCosts(CExpression *pexpr, Plan *plan)
+{
+	const IStatistics *stats = pexpr->Pstats();
+	CDistributionSpec::EDistributionType edt =
+		pexpr->GetDrvdPropPlan()->Pds()->Edt();
+
+	CDouble rows = CStatistics::DefaultRelationRows;
+	CDouble width = CStatistics::DefaultColumnWidth;
+	if (NULL != stats)
+	{
+		rows = stats->Rows();
+
+		ULongPtrArray *colids = GPOS_NEW(m_mp) ULongPtrArray(m_mp);
+		pexpr->Prpp()->PcrsRequired()->ExtractColIds(m_mp, colids);
+		width = stats->Width(colids);
+		colids->Release();
+	}
+
+	if (CDistributionSpec::EdtStrictReplicated == edt ||
+		CDistributionSpec::EdtTaintedReplicated == edt)
+	{
+		// if distribution is replicated, multiply number of rows by number of segments
+		rows = rows * COptCtxt::PoctxtFromTLS()->GetCostModel()->UlHosts();
+	}
+
+	plan->startup_cost = 0;
+	plan->total_cost = CostFromDouble(pexpr->Cost().Get());
+	plan->plan_rows = CostFromDouble(rows.Get());
+	plan->plan_width = (INT)(LINT) width.Get();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::CostFromDouble
+//
+//	@doc:
+//		Round a cost the way it is rounded when printed into a DXL plan, so
+//		that both translations produce the same costs
+//
+//---------------------------------------------------------------------------
+Cost
+CTranslatorExprToPlStmt::CostFromDouble(DOUBLE value)
+{
+	CWStringDynamic str(m_mp);
+	str.AppendFormat(GPOS_WSZ_LIT("%f"), value);
+	CHAR *sz = CTranslatorUtils::CreateMultiByteCharStringFromWCString(
+		str.GetBuffer());
+
+	return gpos::clib::Strtod(sz);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::AddFeedbackKey
+//
+//	@doc:
+//		Remember the cardinality feedback key of the group of the given node,
+//		so that the executor can report the number of rows the node produced.
+//		Motions and replicated nodes produce a different number of rows than
+//		their group.
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorExprToPlStmt::AddFeedbackKey(CExpression *pexpr, Plan *plan)
+{
+	CDistributionSpec::EDistributionType edt =
+		pexpr->GetDrvdPropPlan()->Pds()->Edt();
+
+	ULLONG feedback_key = 0;
+	if (COptCtxt::PoctxtFromTLS()
+			->GetOptimizerConfig()
+			->GetStatsConf()
+			->FCardinalityFeedback() &&
+		NULL != pexpr->Pgexpr() && !CUtils::FPhysicalMotion(pexpr->Pop()) &&
+		CDistributionSpec::EdtStrictReplicated != edt &&
+		CDistributionSpec::EdtTaintedReplicated != edt &&
+		pexpr->Pgexpr()->Pgroup()->FFeedbackKey(&feedback_key) &&
+		0 != feedback_key)
+	{
+		m_dxl_to_plstmt_context.AddFeedbackKey(plan->plan_node_id,
+											   feedback_key);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToPlStmt::AssemblePlannedStmt
+//
+//	@doc:
+//		Assemble the planned statement of the given plan. A direct plan is a
+//		query without subplans and params.
+//
+//---------------------------------------------------------------------------
+PlannedStmt *
+CTranslatorExprToPlStmt::AssemblePlannedStmt(Plan *plan)
+{
+	// collect oids from rtable
+	List *oids_list = NIL;
+
+	ListCell *lc_rte = NULL;
+	ForEach(lc_rte, m_dxl_to_plstmt_context.GetRTableEntriesList())
+	{
+		RangeTblEntry *pRTE = (RangeTblEntry *) lfirst(lc_rte);
+
+		if (pRTE->rtekind == RTE_RELATION)
+		{
+			oids_list = gpdb::LAppendOid(oids_list, pRTE->relid);
+		}
+	}
+
+	PlannedStmt *planned_stmt = MakeNode(PlannedStmt);
+	planned_stmt->planGen = PLANGEN_OPTIMIZER;
+
+	planned_stmt->rtable = m_dxl_to_plstmt_context.GetRTableEntriesList();
+	planned_stmt->subplans = m_dxl_to_plstmt_context.GetSubplanEntriesList();
+	planned_stmt->planTree = plan;
+
+	planned_stmt->queryPartOids =
+		m_dxl_to_plstmt_context.GetPartitionedTablesList();
+	planned_stmt->canSetTag = m_can_set_tag;
+	planned_stmt->relationOids = oids_list;
+	planned_stmt->numSelectorsPerScanId =
+		m_dxl_to_plstmt_context.GetNumPartitionSelectorsList();
+	planned_stmt->feedbackKeys = m_dxl_to_plstmt_context.GetFeedbackKeysList();
+	planned_stmt->feedbackFingerprints =
+		m_dxl_to_plstmt_context.GetFeedbackFingerprintsList();
+
+	plan->nMotionNodes = m_dxl_to_plstmt_context.GetCurrentMotionId() - 1;
+	planned_stmt->nMotionNodes =
+		m_dxl_to_plstmt_context.GetCurrentMotionId() - 1;
+
+	planned_stmt->commandType = CMD_SELECT;
+
+	GPOS_ASSERT(plan->nMotionNodes >= 0);
+	if (0 == plan->nMotionNodes)
+	{
+		plan->dispatch = DISPATCH_SEQUENTIAL;
+	}
+	else
+	{
+		plan->dispatch = DISPATCH_PARALLEL;
+	}
+
+	planned_stmt->resultRelations = NIL;
+	planned_stmt->intoPolicy = m_dxl_to_plstmt_context.GetDistributionPolicy();
+
+	if (1 != m_dxl_to_plstmt_context.GetCurrentMotionId())
+	{
+		planned_stmt->nInitPlans = m_dxl_to_plstmt_context.GetCurrentParamId();
+		plan->nInitPlans = m_dxl_to_plstmt_context.GetCurrentParamId();
+	}
+	planned_stmt->nParamExec = m_dxl_to_plstmt_context.GetCurrentParamId();
+
+	planned_stmt->transientPlan = gpdb::MDCacheInTransientState();
+
+	return planned_stmt;
+}
+
+// EOF
@@ -21,6 +21,7 @@ extern "C" {
 #include "catalog/pg_exttable.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_statistic.h"
+#include "catalog/pg_statistic_multicol.h"
 #include "cdb/cdbhash.h"
 #include "cdb/cdbpartition.h"
 #include "utils/array.h"
@@ -49,6 +50,7 @@ extern "C" {
 #include "naucrates/dxl/xml/dxltokens.h"
 #include "naucrates/exception.h"
 #include "naucrates/md/CDXLColStats.h"
+#include "naucrates/md/CDXLMultiColStats.h"
 #include "naucrates/md/CDXLRelStats.h"
 #include "naucrates/md/CMDArrayCoerceCastGPDB.h"
 #include "naucrates/md/CMDCastGPDB.h"
@@ -156,6 +158,10 @@ CTranslatorRelcacheToDXL::RetrieveObject(CMemoryPool *mp,
 			md_obj = RetrieveCheckConstraints(mp, md_accessor, mdid);
 			break;
 
+		case IMDId::EmdidMultiColStats:
+			md_obj = RetrieveMultiColStats(mp, mdid);
+			break;
+
 		default:
 			break;
 	}
@@ -738,8 +744,22 @@ CTranslatorRelcacheToDXL::RetrieveRelColumns(
 	IMDRelation::Erelstoragetype rel_storage_type)
 {
 	CMDColumnArray *mdcol_array = GPOS_NEW(mp) CMDColumnArray(mp);
+	const ULONG num_atts = (ULONG) rel->rd_att->natts;
+
+	ULONG *col_lens = GPOS_NEW_ARRAY(mp, ULONG, num_atts);
+	DOUBLE *compressed_widths = GPOS_NEW_ARRAY(mp, DOUBLE, num_atts);
+	for (ULONG ul = 0; ul < num_atts; ul++)
+	{
+		col_lens[ul] = RetrieveColumnWidth(mp, rel, ul);
+		compressed_widths[ul] = -1.0;
+	}
+
+	if (IMDRelation::ErelstorageAppendOnlyCols == rel_storage_type)
+	{
+		EstimateCompressedColumnWidths(rel, col_lens, compressed_widths);
+	}
 
-	for (ULONG ul = 0; ul < (ULONG) rel->rd_att->natts; ul++)
+	for (ULONG ul = 0; ul < num_atts; ul++)
 	{
 		Form_pg_attribute att = rel->rd_att->attrs[ul];
 		CMDName *md_colname =
@@ -754,58 +774,20 @@ CTranslatorRelcacheToDXL::RetrieveRelColumns(
 				mp, md_accessor, rel->rd_att, att->attnum);
 		}
 
-		ULONG col_len = gpos::ulong_max;
 		CMDIdGPDB *mdid_col =
 			GPOS_NEW(mp) CMDIdGPDB(IMDId::EmdidGeneral, att->atttypid);
-		HeapTuple stats_tup = gpdb::GetAttStats(rel->rd_id, ul + 1);
-
-		// Column width priority:
-		// 1. If there is average width kept in the stats for that column, pick that value.
-		// 2. If not, if it is a fixed length text type, pick the size of it. E.g if it is
-		//    varchar(10), assign 10 as the column length.
-		// 3. Else if it not dropped and a fixed length type such as int4, assign the fixed
-		//    length.
-		// 4. Otherwise, assign it to default column width which is 8.
-		if (HeapTupleIsValid(stats_tup))
-		{
-			Form_pg_statistic form_pg_stats =
-				(Form_pg_statistic) GETSTRUCT(stats_tup);
-
-			// column width
-			col_len = form_pg_stats->stawidth;
-			gpdb::FreeHeapTuple(stats_tup);
-		}
-		else if ((mdid_col->Equals(&CMDIdGPDB::m_mdid_bpchar) ||
-				  mdid_col->Equals(&CMDIdGPDB::m_mdid_varchar)) &&
-				 (VARHDRSZ < att->atttypmod))
-		{
-			col_len = (ULONG) att->atttypmod - VARHDRSZ;
-		}
-		else
-		{
-			DOUBLE width = CStatistics::DefaultColumnWidth.Get();
-			col_len = (ULONG) width;
-
-			if (!att->attisdropped)
-			{
-				IMDType *md_type =
-					CTranslatorRelcacheToDXL::RetrieveType(mp, mdid_col);
-				if (md_type->IsFixedLength())
-				{
-					col_len = md_type->Length();
-				}
-				md_type->Release();
-			}
-		}
-
-		CMDColumn *md_col = GPOS_NEW(mp)
-			CMDColumn(md_colname, att->attnum, mdid_col, att->atttypmod,
-					  !att->attnotnull, att->attisdropped,
-					  dxl_default_col_val /* default value */, col_len);
+		CMDColumn *md_col = GPOS_NEW(mp) CMDColumn(
+			md_colname, att->attnum, mdid_col, att->atttypmod,
+			!att->attnotnull, att->attisdropped,
+			dxl_default_col_val /* default value */, col_lens[ul],
+			CDouble(compressed_widths[ul]));
 
 		mdcol_array->Append(md_col);
 	}
 
+	GPOS_DELETE_ARRAY(col_lens);
+	GPOS_DELETE_ARRAY(compressed_widths);
+
 	// add system columns
 	if (RelHasSystemColumns(rel->rd_rel->relkind))
 	{
@@ -818,6 +800,116 @@ CTranslatorRelcacheToDXL::RetrieveRelColumns(
 	return mdcol_array;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::RetrieveColumnWidth
+//
+//	@doc:
+//		Return the average width of the column at the given position
+//
+//---------------------------------------------------------------------------
+ULONG
+CTranslatorRelcacheToDXL::RetrieveColumnWidth(CMemoryPool *mp, Relation rel,
+											  ULONG attno_idx)
+{
+	Form_pg_attribute att = rel->rd_att->attrs[attno_idx];
+	ULONG col_len = gpos::ulong_max;
+	CMDIdGPDB *mdid_col =
+		GPOS_NEW(mp) CMDIdGPDB(IMDId::EmdidGeneral, att->atttypid);
+	HeapTuple stats_tup = gpdb::GetAttStats(rel->rd_id, attno_idx + 1);
+
+	// Column width priority:
+	// 1. If there is average width kept in the stats for that column, pick that value.
+	// 2. If not, if it is a fixed length text type, pick the size of it. E.g if it is
+	//    varchar(10), assign 10 as the column length.
+	// 3. Else if it not dropped and a fixed length type such as int4, assign the fixed
+	//    length.
+	// 4. Otherwise, assign it to default column width which is 8.
+	if (HeapTupleIsValid(stats_tup))
+	{
+		Form_pg_statistic form_pg_stats =
+			(Form_pg_statistic) GETSTRUCT(stats_tup);
+
+		// column width
+		col_len = form_pg_stats->stawidth;
+		gpdb::FreeHeapTuple(stats_tup);
+	}
+	else if ((mdid_col->Equals(&CMDIdGPDB::m_mdid_bpchar) ||
+			  mdid_col->Equals(&CMDIdGPDB::m_mdid_varchar)) &&
+			 (VARHDRSZ < att->atttypmod))
+	{
+		col_len = (ULONG) att->atttypmod - VARHDRSZ;
+	}
+	else
+	{
+		DOUBLE width = CStatistics::DefaultColumnWidth.Get();
+		col_len = (ULONG) width;
+
+		if (!att->attisdropped)
+		{
+			IMDType *md_type =
+				CTranslatorRelcacheToDXL::RetrieveType(mp, mdid_col);
+			if (md_type->IsFixedLength())
+			{
+				col_len = md_type->Length();
+			}
+			md_type->Release();
+		}
+	}
+
+	mdid_col->Release();
+
+	return col_len;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::EstimateCompressedColumnWidths
+//
+//	@doc:
+//		Estimate the average on-disk width of each column of a column-oriented
+//		table. The sizes of the per-column segment files are only known on the
+//		segments, so the measured size of the table on disk per row
+//		(relpages * BLCKSZ / reltuples) is split over the columns in
+//		proportion to their average widths. The widths are left unknown when
+//		the table has not been analyzed.
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorRelcacheToDXL::EstimateCompressedColumnWidths(
+	Relation rel, const ULONG *col_lens, DOUBLE *compressed_widths)
+{
+	if (0 >= rel->rd_rel->relpages || 0 >= rel->rd_rel->reltuples)
+	{
+		return;
+	}
+
+	const ULONG num_atts = (ULONG) rel->rd_att->natts;
+	DOUBLE total_width = 0.0;
+	for (ULONG ul = 0; ul < num_atts; ul++)
+	{
+		if (!rel->rd_att->attrs[ul]->attisdropped)
+		{
+			total_width += col_lens[ul];
+		}
+	}
+
+	if (0.0 >= total_width)
+	{
+		return;
+	}
+
+	DOUBLE row_width =
+		((DOUBLE) rel->rd_rel->relpages * BLCKSZ) / rel->rd_rel->reltuples;
+	for (ULONG ul = 0; ul < num_atts; ul++)
+	{
+		if (!rel->rd_att->attrs[ul]->attisdropped)
+		{
+			compressed_widths[ul] = row_width * col_lens[ul] / total_width;
+		}
+	}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTranslatorRelcacheToDXL::GetDefaultColumnValue
@@ -2342,6 +2434,80 @@ CTranslatorRelcacheToDXL::RetrieveRelStats(CMemoryPool *mp, IMDId *mdid)
 	return dxl_rel_stats;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorRelcacheToDXL::RetrieveMultiColStats
+//
+//	@doc:
+//		Retrieve the statistics on groups of columns of a relation, as
+//		collected by ANALYZE in pg_statistic_multicol
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CTranslatorRelcacheToDXL::RetrieveMultiColStats(CMemoryPool *mp, IMDId *mdid)
+{
+	OID rel_oid = CMDIdGPDB::CastMdid(mdid)->Oid();
+
+	Relation rel = gpdb::GetRelation(rel_oid);
+	if (NULL == rel)
+	{
+		GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound,
+				   mdid->GetBuffer());
+	}
+
+	CMDName *mdname = NULL;
+	SMultiColStatArray *stats = GPOS_NEW(mp) SMultiColStatArray(mp);
+
+	GPOS_TRY
+	{
+		CWStringDynamic *relname_str =
+			CDXLUtils::CreateDynamicStringFromCharArray(
+				mp, NameStr(rel->rd_rel->relname));
+		mdname = GPOS_NEW(mp) CMDName(mp, relname_str);
+		// CMDName ctor created a copy of the string
+		GPOS_DELETE(relname_str);
+
+		List *stat_tuples = gpdb::GetMultiColStats(rel_oid);
+		ListCell *lc = NULL;
+		ForEach(lc, stat_tuples)
+		{
+			HeapTuple tuple = (HeapTuple) lfirst(lc);
+			Form_pg_statistic_multicol form =
+				(Form_pg_statistic_multicol) GETSTRUCT(tuple);
+
+			ULongPtrArray *keys = GPOS_NEW(mp) ULongPtrArray(mp);
+			for (int i = 0; i < form->stakeys.dim1; i++)
+			{
+				keys->Append(GPOS_NEW(mp) ULONG(form->stakeys.values[i]));
+			}
+
+			// a negative number of distinct combinations is a multiplier
+			// for the number of rows of the relation
+			CDouble ndistinct(form->standistinct);
+			if (0 > form->standistinct)
+			{
+				ndistinct = CDouble(-form->standistinct *
+									std::max(rel->rd_rel->reltuples, 1.0f));
+			}
+
+			stats->Append(GPOS_NEW(mp) SMultiColStat(
+				keys, ndistinct, CDouble(form->stadependency)));
+		}
+		gpdb::ListFreeDeep(stat_tuples);
+
+		gpdb::CloseRelation(rel);
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		gpdb::CloseRelation(rel);
+		GPOS_RETHROW(ex);
+	}
+	GPOS_CATCH_END;
+
+	mdid->AddRef();
+	return GPOS_NEW(mp) CDXLMultiColStats(mp, mdid, mdname, stats);
+}
+
 // Retrieve column statistics from relcache
 // If all statistics are missing, create dummy statistics
 // Also, if the statistics are broken, create dummy statistics
@@ -84,6 +84,13 @@ CMemoryPoolPalloc::TotalAllocatedSize() const
 	return MemoryContextGetCurrentSpace(m_cxt);
 }
 
+// Highest total allocated size over the lifetime of the pool
+ULLONG
+CMemoryPoolPalloc::PeakAllocatedSize() const
+{
+	return MemoryContextGetPeakSpace(m_cxt);
+}
+
 // get user requested size of array allocation. Note: this is ONLY called for arrays
 ULONG
 CMemoryPoolPalloc::UserSizeOfAlloc(const void *ptr)
@@ -26,6 +26,7 @@
 #include "gpopt/translate/CTranslatorDXLToExpr.h"
 #include "gpopt/translate/CTranslatorDXLToPlStmt.h"
 #include "gpopt/translate/CTranslatorExprToDXL.h"
+#include "gpopt/translate/CTranslatorExprToPlStmt.h"
 #include "gpopt/translate/CTranslatorQueryToDXL.h"
 #include "gpopt/translate/CTranslatorRelcacheToDXL.h"
 #include "gpopt/translate/CTranslatorUtils.h"
@@ -33,12 +34,16 @@
 #include "gpopt/utils/gpdbdefs.h"
 
 #include "cdb/cdbvars.h"
+#include "utils/cardfeedback.h"
 #include "utils/fmgroids.h"
 #include "utils/guc.h"
 #undef setstate
 
+#include <sys/stat.h>
+
 #include "gpos/_api.h"
 #include "gpos/common/CAutoP.h"
+#include "gpos/error/CAutoTrace.h"
 #include "gpos/io/COstreamFile.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/memory/CAutoMemoryPool.h"
@@ -88,6 +93,20 @@ using namespace gpdbcost;
 // default id for the source system
 const CSystemId default_sysid(IMDId::EmdidGeneral, GPOS_WSZ_STR_LENGTH("GPDB"));
 
+// the cost profile last loaded by LoadCostModelParams, reused until
+// optimizer_cost_profile_path or the file changes
+static struct
+{
+	bool valid;
+	bool loaded;  // false if the profile could not be loaded
+	char path[MAXPGPATH];
+	time_t mtime;
+	off_t size;
+	double values[CCostModelParamsGPDB::EcpSentinel];
+	double lower_bounds[CCostModelParamsGPDB::EcpSentinel];
+	double upper_bounds[CCostModelParamsGPDB::EcpSentinel];
+} cost_profile_cache;
+
 
 //---------------------------------------------------------------------------
 //	@function:
@@ -356,6 +375,199 @@ COptTasks::LoadSearchStrategy(CMemoryPool *mp, char *path)
 	return search_strategy_arr;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::LoadCostModelParams
+//
+//	@doc:
+//		Load cost model parameters from the cost profile in the given file;
+//		return NULL if no profile is configured or it cannot be loaded.
+//		The file is only parsed again when the path, or the modification
+//		time or size of the file, changed since the previous query.
+//
+//---------------------------------------------------------------------------
+CCostModelParamsGPDB *
+COptTasks::LoadCostModelParams(CMemoryPool *mp, char *path)
+{
+	CCostModelParamsGPDB *cost_model_params = NULL;
+	CParseHandlerDXL *dxl_parse_handler = NULL;
+
+	if (NULL == path || '\0' == path[0])
+	{
+		return NULL;
+	}
+
+	// a missing file is cached too, until it is created
+	struct stat st;
+	if (0 != stat(path, &st))
+	{
+		st.st_mtime = 0;
+		st.st_size = 0;
+	}
+
+	if (cost_profile_cache.valid && 0 == strcmp(cost_profile_cache.path, path) &&
+		cost_profile_cache.mtime == st.st_mtime &&
+		cost_profile_cache.size == st.st_size)
+	{
+		if (!cost_profile_cache.loaded)
+		{
+			return NULL;
+		}
+
+		cost_model_params = GPOS_NEW(mp) CCostModelParamsGPDB(mp);
+		for (ULONG ul = 0; ul < CCostModelParamsGPDB::EcpSentinel; ul++)
+		{
+			cost_model_params->SetParam(ul, cost_profile_cache.values[ul],
+										cost_profile_cache.lower_bounds[ul],
+										cost_profile_cache.upper_bounds[ul]);
+		}
+		return cost_model_params;
+	}
+
+	GPOS_TRY
+	{
+		dxl_parse_handler =
+			CDXLUtils::GetParseHandlerForDXLFile(mp, path, NULL);
+		if (NULL != dxl_parse_handler)
+		{
+			cost_model_params = dynamic_cast<CCostModelParamsGPDB *>(
+				dxl_parse_handler->GetCostModelParams());
+		}
+
+		if (NULL != cost_model_params)
+		{
+			elog(DEBUG2, "\n[OPT]: Using cost profile in (%s)", path);
+			cost_model_params->AddRef();
+		}
+		else
+		{
+			elog(WARNING, "cost profile \"%s\" has no cost parameters", path);
+		}
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		if (GPOS_MATCH_EX(ex, gpdxl::ExmaGPDB, gpdxl::ExmiGPDBError))
+		{
+			GPOS_RETHROW(ex);
+		}
+		elog(WARNING,
+			 "could not load cost profile \"%s\", using default cost model parameters",
+			 path);
+		GPOS_RESET_EX;
+	}
+	GPOS_CATCH_END;
+
+	GPOS_DELETE(dxl_parse_handler);
+
+	cost_profile_cache.valid = (strlen(path) < MAXPGPATH);
+	if (cost_profile_cache.valid)
+	{
+		strcpy(cost_profile_cache.path, path);
+		cost_profile_cache.mtime = st.st_mtime;
+		cost_profile_cache.size = st.st_size;
+		cost_profile_cache.loaded = (NULL != cost_model_params);
+		for (ULONG ul = 0;
+			 cost_profile_cache.loaded && ul < CCostModelParamsGPDB::EcpSentinel;
+			 ul++)
+		{
+			ICostModelParams::SCostParam *cost_param =
+				cost_model_params->PcpLookup(ul);
+			cost_profile_cache.values[ul] = cost_param->Get().Get();
+			cost_profile_cache.lower_bounds[ul] =
+				cost_param->GetLowerBoundVal().Get();
+			cost_profile_cache.upper_bounds[ul] =
+				cost_param->GetUpperBoundVal().Get();
+		}
+	}
+
+	return cost_model_params;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::EstimateMemoryIntensiveOperators
+//
+//	@doc:
+//		Estimate the number of memory-intensive operators (hash joins, hash
+//		aggregates, sorts and window functions) in a plan for the given
+//		query, counting one potential hash join for every join input beyond
+//		the first one
+//
+//---------------------------------------------------------------------------
+ULONG
+COptTasks::EstimateMemoryIntensiveOperators(Query *query)
+{
+	GPOS_ASSERT(NULL != query);
+
+	ULONG num_operators = 0;
+	ULONG num_join_inputs = 0;
+	ULONG rt_index = 0;
+
+	ListCell *lc = NULL;
+	ForEach(lc, query->rtable)
+	{
+		RangeTblEntry *rte = (RangeTblEntry *) lfirst(lc);
+		rt_index++;
+
+		// the target relation of a DML is not a join input
+		if (rt_index == (ULONG) query->resultRelation)
+		{
+			continue;
+		}
+
+		switch (rte->rtekind)
+		{
+			case RTE_SUBQUERY:
+				num_operators +=
+					EstimateMemoryIntensiveOperators(rte->subquery);
+				num_join_inputs++;
+				break;
+
+			case RTE_RELATION:
+			case RTE_FUNCTION:
+			case RTE_TABLEFUNCTION:
+			case RTE_VALUES:
+			case RTE_CTE:
+				num_join_inputs++;
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	ForEach(lc, query->cteList)
+	{
+		CommonTableExpr *cte = (CommonTableExpr *) lfirst(lc);
+		num_operators +=
+			EstimateMemoryIntensiveOperators((Query *) cte->ctequery);
+	}
+
+	if (1 < num_join_inputs)
+	{
+		num_operators += num_join_inputs - 1;
+	}
+
+	if (query->hasAggs || NIL != query->groupClause)
+	{
+		num_operators++;
+	}
+
+	if (NIL != query->distinctClause)
+	{
+		num_operators++;
+	}
+
+	if (NIL != query->sortClause)
+	{
+		num_operators++;
+	}
+
+	num_operators += gpdb::ListLength(query->windowClause);
+
+	return num_operators;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptTasks::CreateOptimizerConfig
@@ -365,7 +577,8 @@ COptTasks::LoadSearchStrategy(CMemoryPool *mp, char *path)
 //
 //---------------------------------------------------------------------------
 COptimizerConfig *
-COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model)
+COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model,
+								 Query *query)
 {
 	// get chosen plan number, cost threshold
 	ULLONG plan_id = (ULLONG) optimizer_plan_id;
@@ -387,13 +600,33 @@ COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model)
 		(ULONG) optimizer_push_group_by_below_setop_threshold;
 	ULONG xform_bind_threshold = (ULONG) optimizer_xform_bind_threshold;
 	ULONG skew_factor = (ULONG) optimizer_skew_factor;
+	ULONG max_derived_stats_buckets =
+		(ULONG) optimizer_max_derived_histogram_buckets;
+
+	// memory budget shared by the memory-intensive operators of the query,
+	// used to judge whether they spill; without it, the cost model falls
+	// back to its fixed spilling threshold
+	ULONG query_memory_kb = 0;
+	if (optimizer_cost_memory_quota)
+	{
+		query_memory_kb = (ULONG) std::min(gpdb::GetQueryMemoryKB(),
+										   (uint64) gpos::ulong_max);
+	}
+	ULONG memory_intensive_operators = EstimateMemoryIntensiveOperators(query);
+
+	CStatisticsConfig *stats_conf = GPOS_NEW(mp)
+		CStatisticsConfig(mp, damping_factor_filter, damping_factor_join,
+						  damping_factor_groupby, MAX_STATS_BUCKETS,
+						  max_derived_stats_buckets);
+	if (optimizer_cardinality_feedback)
+	{
+		LoadCardinalityFeedback(stats_conf);
+	}
 
 	return GPOS_NEW(mp) COptimizerConfig(
 		GPOS_NEW(mp)
 			CEnumeratorConfig(mp, plan_id, num_samples, cost_threshold),
-		GPOS_NEW(mp)
-			CStatisticsConfig(mp, damping_factor_filter, damping_factor_join,
-							  damping_factor_groupby, MAX_STATS_BUCKETS),
+		stats_conf,
 		GPOS_NEW(mp) CCTEConfig(cte_inlining_cutoff), cost_model,
 		GPOS_NEW(mp)
 			CHint(join_arity_for_associativity_commutativity,
@@ -402,10 +635,44 @@ COptTasks::CreateOptimizerConfig(CMemoryPool *mp, ICostModel *cost_model)
 				  false, /* don't create Assert nodes for constraints, we'll
 								      * enforce them ourselves in the executor */
 				  push_group_by_below_setop_threshold, xform_bind_threshold,
-				  skew_factor),
+				  skew_factor, query_memory_kb, memory_intensive_operators),
 		GPOS_NEW(mp) CWindowOids(OID(F_WINDOW_ROW_NUMBER), OID(F_WINDOW_RANK)));
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptTasks::LoadCardinalityFeedback
+//
+//	@doc:
+//		Enable cardinality feedback in the given statistics configuration and
+//		load the row counts observed while executing earlier plans
+//
+//---------------------------------------------------------------------------
+void
+COptTasks::LoadCardinalityFeedback(CStatisticsConfig *stats_conf)
+{
+	int num_observations = 0;
+	CardFeedbackObservation *observations =
+		gpdb::CardFeedbackSnapshot(&num_observations);
+	if (NULL == observations)
+	{
+		// the store is disabled, nothing will be recorded either
+		return;
+	}
+
+	stats_conf->EnableCardinalityFeedback();
+	for (int i = 0; i < num_observations; i++)
+	{
+		// the store splits ORCA's 64-bit key into the key and the
+		// fingerprint
+		ULLONG key = ((ULLONG) observations[i].key << 32) |
+					 observations[i].fingerprint;
+		stats_conf->AddCardinalityFeedback(key,
+										   CDouble(observations[i].rows));
+	}
+	gpdb::GPDBFree(observations);
+}
+
 //---------------------------------------------------------------------------
 //		@function:
 //			COptTasks::SetCostModelParams
@@ -457,7 +724,9 @@ COptTasks::SetCostModelParams(ICostModel *cost_model)
 ICostModel *
 COptTasks::GetCostModel(CMemoryPool *mp, ULONG num_segments)
 {
-	ICostModel *cost_model = GPOS_NEW(mp) CCostModelGPDB(mp, num_segments);
+	ICostModel *cost_model = GPOS_NEW(mp) CCostModelGPDB(
+		mp, num_segments,
+		LoadCostModelParams(mp, optimizer_cost_profile_path));
 
 	SetCostModelParams(cost_model);
 
@@ -485,6 +754,25 @@ COptTasks::OptimizeTask(void *ptr)
 	AUTO_MEM_POOL(amp);
 	CMemoryPool *mp = amp.Pmp();
 
+	// The Query-to-DXL translation and the optimization allocate from pools
+	// of their own, so that the memory of each phase is known. The pools
+	// outlive the MD accessor, which may keep metadata ids of either phase,
+	// and the error handling below, which releases the plan.
+	AUTO_MEM_POOL(amp_translation);
+	AUTO_MEM_POOL(amp_optimization);
+	CMemoryPool *translation_mp = amp_translation.Pmp();
+	CMemoryPool *optimization_mp = amp_optimization.Pmp();
+
+	// The plan is generated in a memory pool and a memory context of its
+	// own, and only its copy outlives this phase.
+	AUTO_MEM_POOL(amp_plan);
+	MemoryContext plan_cxt = NULL;
+
+	// Snapshot the generation of the shared metadata cache tier. This has to
+	// happen before checking for invalidations below, so that metadata
+	// shared by other sessions is never older than our own catalog view.
+	ULLONG shared_mdcache_generation = gpdb::MDSharedCacheBeginQuery();
+
 	// Does the metadatacache need to be reset?
 	//
 	// On the first call, before the cache has been initialized, we
@@ -525,6 +813,9 @@ COptTasks::OptimizeTask(void *ptr)
 	IMdIdArray *col_stats = NULL;
 	MdidHashSet *rel_stats = NULL;
 
+	// memory used by each phase, reported with the optimization statistics
+	ULLONG plan_generation_mem = 0;
+
 	GPOS_TRY
 	{
 		// set trace flags
@@ -534,8 +825,8 @@ COptTasks::OptimizeTask(void *ptr)
 					  &disabled_trace_flags);
 
 		// set up relcache MD provider
-		CMDProviderRelcache *relcache_provider =
-			GPOS_NEW(mp) CMDProviderRelcache(mp);
+		CMDProviderRelcache *relcache_provider = GPOS_NEW(mp)
+			CMDProviderRelcache(mp, shared_mdcache_generation);
 
 		{
 			// scope for MD accessor
@@ -551,14 +842,15 @@ COptTasks::OptimizeTask(void *ptr)
 
 			CAutoP<CTranslatorQueryToDXL> query_to_dxl_translator;
 			query_to_dxl_translator = CTranslatorQueryToDXL::QueryToDXLInstance(
-				mp, &mda, (Query *) opt_ctxt->m_query);
+				translation_mp, &mda, (Query *) opt_ctxt->m_query);
 
 			ICostModel *cost_model = GetCostModel(mp, num_segments_for_costing);
 			COptimizerConfig *optimizer_config =
-				CreateOptimizerConfig(mp, cost_model);
-			CConstExprEvaluatorProxy expr_eval_proxy(mp, &mda);
-			IConstExprEvaluator *expr_evaluator =
-				GPOS_NEW(mp) CConstExprEvaluatorDXL(mp, &mda, &expr_eval_proxy);
+				CreateOptimizerConfig(mp, cost_model,
+									  (Query *) opt_ctxt->m_query);
+			CConstExprEvaluatorProxy expr_eval_proxy(optimization_mp, &mda);
+			IConstExprEvaluator *expr_evaluator = GPOS_NEW(optimization_mp)
+				CConstExprEvaluatorDXL(optimization_mp, &mda, &expr_eval_proxy);
 
 			CDXLNode *query_dxl =
 				query_to_dxl_translator->TranslateQueryToDXL();
@@ -573,17 +865,42 @@ COptTasks::OptimizeTask(void *ptr)
 				(!optimizer_enable_motions_masteronly_queries &&
 				 !query_to_dxl_translator->HasDistributedTables());
 			// See NoteDistributionPolicyOpclasses() in src/backend/gpopt/translate/CTranslatorQueryToDXL.cpp
+			DistributionHashOpsKind distribution_hashops =
+				query_to_dxl_translator->GetDistributionHashOpsKind();
 			BOOL use_legacy_opfamilies =
-				(query_to_dxl_translator->GetDistributionHashOpsKind() ==
-				 DistrUseLegacyHashOps);
+				(distribution_hashops == DistrUseLegacyHashOps);
 			CAutoTraceFlag atf1(EopttraceDisableMotions, is_master_only);
 			CAutoTraceFlag atf2(EopttraceUseLegacyOpfamilies,
 								use_legacy_opfamilies);
 
+			// Simple plans can be translated straight into a PlannedStmt
+			// while the optimizer still has them, when the plan DXL is not
+			// asked for. The optimizer returns no plan DXL then.
+			CAutoP<CTranslatorExprToPlStmt> expr_to_plan_stmt_translator;
+			if (optimizer_enable_direct_plan_translation &&
+				opt_ctxt->m_should_generate_plan_stmt &&
+				!opt_ctxt->m_should_serialize_plan_dxl)
+			{
+				plan_cxt = gpdb::GPDBTempAllocSetContextCreate(
+					"GPORCA plan generation");
+				expr_to_plan_stmt_translator = GPOS_NEW(amp_plan.Pmp())
+					CTranslatorExprToPlStmt(
+						amp_plan.Pmp(), &mda, plan_cxt, opt_ctxt->m_query,
+						opt_ctxt->m_query->canSetTag, distribution_hashops);
+			}
+
 			plan_dxl = COptimizer::PdxlnOptimize(
-				mp, &mda, query_dxl, query_output_dxlnode_array,
+				optimization_mp, &mda, query_dxl, query_output_dxlnode_array,
 				cte_dxlnode_array, expr_evaluator, num_segments, gp_session_id,
-				gp_command_count, search_strategy_arr, optimizer_config);
+				gp_command_count, search_strategy_arr, optimizer_config,
+				NULL /*szMinidumpFileName*/,
+				expr_to_plan_stmt_translator.Value());
+
+			// the input of the optimizer is not needed anymore; release it
+			// before generating the plan, so that its memory can be reused
+			expr_evaluator->Release();
+			query_dxl->Release();
+			GPOS_DELETE(query_to_dxl_translator.Reset());
 
 			if (opt_ctxt->m_should_serialize_plan_dxl)
 			{
@@ -602,16 +919,72 @@ COptTasks::OptimizeTask(void *ptr)
 			// translate DXL->PlStmt only when needed
 			if (opt_ctxt->m_should_generate_plan_stmt)
 			{
-				// always use opt_ctxt->m_query->can_set_tag as the query_to_dxl_translator->Pquery() is a mutated Query object
-				// that may not have the correct can_set_tag
+				PlannedStmt *plan_stmt = NULL;
+				if (NULL == plan_dxl)
+				{
+					// the plan was translated directly
+					plan_stmt = expr_to_plan_stmt_translator->GetPlannedStmt();
+				}
+				else
+				{
+					if (NULL == plan_cxt)
+					{
+						plan_cxt = gpdb::GPDBTempAllocSetContextCreate(
+							"GPORCA plan generation");
+					}
+					MemoryContext old_cxt = MemoryContextSwitchTo(plan_cxt);
+
+					GPOS_TRY
+					{
+						// always use opt_ctxt->m_query->can_set_tag as the query_to_dxl_translator->Pquery() is a mutated Query object
+						// that may not have the correct can_set_tag
+						plan_stmt = ConvertToPlanStmtFromDXL(
+							amp_plan.Pmp(), &mda, opt_ctxt->m_query, plan_dxl,
+							opt_ctxt->m_query->canSetTag, distribution_hashops);
+					}
+					GPOS_CATCH_EX(ex)
+					{
+						MemoryContextSwitchTo(old_cxt);
+						GPOS_RETHROW(ex);
+					}
+					GPOS_CATCH_END;
+
+					MemoryContextSwitchTo(old_cxt);
+				}
+
 				opt_ctxt->m_plan_stmt =
-					(PlannedStmt *) gpdb::CopyObject(ConvertToPlanStmtFromDXL(
-						mp, &mda, opt_ctxt->m_query, plan_dxl,
-						opt_ctxt->m_query->canSetTag,
-						query_to_dxl_translator->GetDistributionHashOpsKind()));
+					(PlannedStmt *) gpdb::CopyObject(plan_stmt);
+
+				plan_generation_mem =
+					amp_plan.Pmp()->PeakAllocatedSize() +
+					gpdb::GPDBMemoryContextGetPeakSpace(plan_cxt);
+				gpdb::GPDBMemoryContextDelete(plan_cxt);
+				plan_cxt = NULL;
+			}
+
+			if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+			{
+				// peak memory of the pool of each phase, and of the pool of
+				// what all phases share: metadata, configuration and trace
+				// flags
+				CAutoTrace at(mp);
+				at.Os() << "[OPT]: Memory (KB): shared "
+						<< mp->PeakAllocatedSize() / 1024
+						<< ", Query-to-DXL translation "
+						<< translation_mp->PeakAllocatedSize() / 1024
+						<< ", optimization "
+						<< optimization_mp->PeakAllocatedSize() / 1024
+						<< ", plan generation " << plan_generation_mem / 1024;
 			}
 
 			CStatisticsConfig *stats_conf = optimizer_config->GetStatsConf();
+			if (stats_conf->FCardinalityFeedback())
+			{
+				elog(DEBUG1,
+					 "GPORCA used cardinality feedback in %u group(s)",
+					 stats_conf->UlFeedbackGroups());
+			}
+
 			col_stats = GPOS_NEW(mp) IMdIdArray(mp);
 			stats_conf->CollectMissingStatsColumns(col_stats);
 
@@ -621,14 +994,16 @@ COptTasks::OptimizeTask(void *ptr)
 			rel_stats->Release();
 			col_stats->Release();
 
-			expr_evaluator->Release();
-			query_dxl->Release();
 			optimizer_config->Release();
-			plan_dxl->Release();
+			CRefCount::SafeRelease(plan_dxl);
 		}
 	}
 	GPOS_CATCH_EX(ex)
 	{
+		if (NULL != plan_cxt)
+		{
+			gpdb::GPDBMemoryContextDelete(plan_cxt);
+		}
 		ResetTraceflags(enabled_trace_flags, disabled_trace_flags);
 		CRefCount::SafeRelease(rel_stats);
 		CRefCount::SafeRelease(col_stats);
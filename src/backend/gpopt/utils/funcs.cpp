@@ -19,12 +19,14 @@ extern "C" {
 #include "postgres.h"
 
 #include "fmgr.h"
+#include "funcapi.h"
 #include "utils/builtins.h"
 }
 
 #include "gpos/_api.h"
 
 #include "gpopt/gpdbwrappers.h"
+#include "gpopt/mdcache/CMDCache.h"
 #include "gpopt/utils/COptTasks.h"
 #include "gpopt/utils/funcs.h"
 
@@ -116,3 +118,76 @@ LibraryVersion()
 	PG_RETURN_TEXT_P(result);
 }
 }
+
+//---------------------------------------------------------------------------
+//	@function:
+//		MDCacheStats
+//
+//	@doc:
+//		Returns one row per metadata object type with the number of entries,
+//		bytes, hits, inserts and evictions of the metadata cache of this
+//		session. An insert is counted whenever an object fetched from the
+//		catalog is added to the cache.
+//
+//---------------------------------------------------------------------------
+extern "C" {
+Datum MDCacheStats(PG_FUNCTION_ARGS)
+{
+	static const char *rgszMDType[] = {
+		"relation",	   "index",		   "function",		   "aggregate",
+		"operator",	   "type",		   "trigger",		   "check_constraint",
+		"relation_stats", "column_stats", "cast_function", "scalar_comparison",
+		"multicolumn_stats"};
+	GPOS_CPL_ASSERT(IMDCacheObject::EmdtSentinel ==
+					GPOS_ARRAY_SIZE(rgszMDType));
+
+	FuncCallContext *funcctx;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		funcctx = SRF_FIRSTCALL_INIT();
+
+		MemoryContext oldcontext =
+			MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		TupleDesc tupdesc = CreateTemplateTupleDesc(6, false);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 1, "mdtype", TEXTOID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 2, "entries", INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 3, "bytes", INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 4, "hits", INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 5, "inserts", INT8OID, -1, 0);
+		TupleDescInitEntry(tupdesc, (AttrNumber) 6, "evictions", INT8OID, -1,
+						   0);
+
+		funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+		funcctx->max_calls = IMDCacheObject::EmdtSentinel;
+
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+
+	if (funcctx->call_cntr < funcctx->max_calls)
+	{
+		ULONG mdtype = (ULONG) funcctx->call_cntr;
+		SCacheClassStats stats =
+			CMDCache::GetStats((IMDCacheObject::Emdtype) mdtype);
+
+		Datum values[6];
+		bool nulls[6] = {false, false, false, false, false, false};
+
+		values[0] = CStringGetTextDatum(rgszMDType[mdtype]);
+		values[1] = Int64GetDatum((int64) stats.m_entries);
+		values[2] = Int64GetDatum((int64) stats.m_bytes);
+		values[3] = Int64GetDatum((int64) stats.m_hits);
+		values[4] = Int64GetDatum((int64) stats.m_inserts);
+		values[5] = Int64GetDatum((int64) stats.m_evictions);
+
+		HeapTuple tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+
+		SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+	}
+
+	SRF_RETURN_DONE(funcctx);
+}
+}
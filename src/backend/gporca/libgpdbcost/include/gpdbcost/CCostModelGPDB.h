@@ -18,7 +18,9 @@
 #include "gpopt/cost/CCost.h"
 #include "gpopt/cost/ICostModel.h"
 #include "gpopt/cost/ICostModelParams.h"
+#include "gpopt/engine/CHint.h"
 #include "gpopt/operators/COperator.h"
+#include "gpopt/operators/CPhysicalScan.h"
 
 
 namespace gpdbcost
@@ -244,6 +246,35 @@ public:
 	// return number of rows per host
 	virtual CDouble DRowsPerHost(CDouble dRowsTotal) const;
 
+	// memory available to each memory-intensive operator on a segment, in
+	// bytes, or 0 if the hint does not carry a memory budget
+	static CDouble DOperatorMemoryQuota(const CHint *phint);
+
+	// bytes per row read by a scan; only column-oriented tables are read
+	// column by column, other tables are costed by the given default width
+	static CDouble DScanWidth(CPhysicalScan *popScan,
+							  const CColRefSet *pcrsRequired,
+							  CDouble dDefaultWidth);
+
+	// cost of writing the input of a sort to disk and reading it back, if
+	// it does not fit in the memory quota
+	static CDouble DSortSpillCost(CDouble dMemoryQuota, CDouble dRows,
+								  CDouble dWidth,
+								  CDouble dSpillTupWidthCostUnit);
+
+	// cost of writing the input tuples of the hash agg groups that do not
+	// fit in the memory quota to disk and reading them back
+	static CDouble DHashAggSpillCost(CDouble dMemoryQuota,
+									 CDouble dGroupState, CDouble dInputRows,
+									 CDouble dInputWidth,
+									 CDouble dSpillTupWidthCostUnit);
+
+	// check if the hash table built from the inner side of a hash join
+	// spills to disk
+	static BOOL FHashJoinSpills(CDouble dMemoryQuota,
+								CDouble dHJSpillingMemThreshold,
+								CDouble dInnerSize);
+
 	// return cost model parameters
 	virtual ICostModelParams *
 	GetCostModelParams() const
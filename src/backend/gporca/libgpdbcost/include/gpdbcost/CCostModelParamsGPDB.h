@@ -106,6 +106,8 @@ public:
 
 		EcpScalarFuncCost,	// cost of scalar func
 
+		EcpSpillTupWidthCostUnit,  // cost of spilling a byte of operator state to a workfile and reading it back
+
 		EcpSentinel
 	};
 
@@ -279,6 +281,9 @@ private:
 	// default value of compute scalar func cost
 	static const CDouble DScalarFuncCost;
 
+	// default value of the cost of spilling a byte of operator state
+	static const CDouble DSpillTupWidthCostUnitVal;
+
 	// private copy ctor
 	CCostModelParamsGPDB(CCostModelParamsGPDB &);
 
@@ -14,6 +14,7 @@
 #include <limits>
 
 #include "gpopt/base/CColRefSetIter.h"
+#include "gpopt/base/CColRefTable.h"
 #include "gpopt/base/COrderSpec.h"
 #include "gpopt/base/CWindowFrame.h"
 #include "gpopt/engine/CHint.h"
@@ -150,6 +151,110 @@ CCostModelGPDB::DRowsPerHost(CDouble dRowsTotal) const
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelGPDB::DOperatorMemoryQuota
+//
+//	@doc:
+//		Memory available to each memory-intensive operator on a segment,
+//		in bytes. The executor splits the query memory among the
+//		memory-intensive operators of the plan, so we divide the budget by
+//		the number of such operators expected for the query.
+//		Returns 0 if the hint does not carry a memory budget.
+//
+//---------------------------------------------------------------------------
+CDouble
+CCostModelGPDB::DOperatorMemoryQuota(const CHint *phint)
+{
+	GPOS_ASSERT(NULL != phint);
+
+	const ULONG ulQueryMemoryKB = phint->UlQueryMemoryKB();
+	if (0 == ulQueryMemoryKB)
+	{
+		return CDouble(0.0);
+	}
+
+	const ULONG ulOperators =
+		std::max(phint->UlMemoryIntensiveOperators(), (ULONG) 1);
+
+	return CDouble(ulQueryMemoryKB * 1024.0 / ulOperators);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelGPDB::DSortSpillCost
+//
+//	@doc:
+//		If the input does not fit in the memory quota, the sort writes
+//		sorted runs to disk and reads them back to merge them. Returns 0 if
+//		the input fits, or if the quota is unknown.
+//
+//---------------------------------------------------------------------------
+CDouble
+CCostModelGPDB::DSortSpillCost(CDouble dMemoryQuota, CDouble dRows,
+							   CDouble dWidth, CDouble dSpillTupWidthCostUnit)
+{
+	if (0.0 == dMemoryQuota || dRows * dWidth <= dMemoryQuota)
+	{
+		return CDouble(0.0);
+	}
+
+	return dRows * dWidth * dSpillTupWidthCostUnit;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelGPDB::DHashAggSpillCost
+//
+//	@doc:
+//		If the group state does not fit in the memory quota, the input
+//		tuples of the groups that do not fit are written to disk and read
+//		back to aggregate them in later batches. Returns 0 if the group
+//		state fits, or if the quota is unknown.
+//
+//---------------------------------------------------------------------------
+CDouble
+CCostModelGPDB::DHashAggSpillCost(CDouble dMemoryQuota, CDouble dGroupState,
+								  CDouble dInputRows, CDouble dInputWidth,
+								  CDouble dSpillTupWidthCostUnit)
+{
+	if (0.0 == dMemoryQuota || dGroupState <= dMemoryQuota)
+	{
+		return CDouble(0.0);
+	}
+
+	const CDouble dSpillFraction = CDouble(1.0) - dMemoryQuota / dGroupState;
+
+	return dInputRows * dInputWidth * dSpillFraction * dSpillTupWidthCostUnit;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelGPDB::FHashJoinSpills
+//
+//	@doc:
+//		The hash table spills if the inner tuples exceed the memory quota of
+//		the join, when the query memory budget is known; otherwise a fixed
+//		spilling threshold is used
+//
+//---------------------------------------------------------------------------
+BOOL
+CCostModelGPDB::FHashJoinSpills(CDouble dMemoryQuota,
+								CDouble dHJSpillingMemThreshold,
+								CDouble dInnerSize)
+{
+	if (0.0 == dMemoryQuota)
+	{
+		return dInnerSize > dHJSpillingMemThreshold;
+	}
+
+	return dInnerSize > dMemoryQuota;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CCostModelGPDB::~CCostModelGPDB
@@ -337,6 +442,80 @@ CCostModelGPDB::FUnary(COperator::EOperatorId op_id)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelGPDB::DScanWidth
+//
+//	@doc:
+//		Bytes per row read by a scan. A scan of a column-oriented table
+//		only reads the columns required from it, at their compressed
+//		on-disk width; a scan that does not require any column still reads
+//		the narrowest one. Scans of other tables, and of column-oriented
+//		tables whose compressed sizes were not provided by the relcache,
+//		are costed by the given default width.
+//
+//---------------------------------------------------------------------------
+CDouble
+CCostModelGPDB::DScanWidth(CPhysicalScan *popScan,
+						   const CColRefSet *pcrsRequired,
+						   CDouble dDefaultWidth)
+{
+	GPOS_ASSERT(NULL != popScan);
+
+	CTableDescriptor *ptabdesc = popScan->Ptabdesc();
+	if (IMDRelation::ErelstorageAppendOnlyCols !=
+			ptabdesc->RetrieveRelStorageType() ||
+		NULL == pcrsRequired)
+	{
+		return dDefaultWidth;
+	}
+
+	const IMDRelation *pmdrel =
+		COptCtxt::PoctxtFromTLS()->Pmda()->RetrieveRel(ptabdesc->MDId());
+	CColRefArray *pdrgpcrOutput = popScan->PdrgpcrOutput();
+
+	CDouble dWidth(0.0);
+	CDouble dMinWidth(0.0);
+	BOOL fFirst = true;
+	const ULONG size = pdrgpcrOutput->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		CColRefTable *colref = CColRefTable::PcrConvert((*pdrgpcrOutput)[ul]);
+		if (colref->IsSystemCol())
+		{
+			continue;
+		}
+
+		const IMDColumn *pmdcol =
+			pmdrel->GetMdCol(pmdrel->GetPosFromAttno(colref->AttrNum()));
+		const CDouble dColWidth = pmdcol->CompressedWidth();
+		if (0.0 > dColWidth)
+		{
+			// the relcache did not provide compressed sizes
+			return dDefaultWidth;
+		}
+
+		if (fFirst || dColWidth < dMinWidth)
+		{
+			dMinWidth = dColWidth;
+			fFirst = false;
+		}
+
+		if (pcrsRequired->FMember(colref))
+		{
+			dWidth = dWidth + dColWidth;
+		}
+	}
+
+	if (0.0 == dWidth)
+	{
+		return dMinWidth;
+	}
+
+	return dWidth;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CCostModelGPDB::CostChildren
@@ -754,11 +933,24 @@ CCostModelGPDB::CostSort(CMemoryPool *mp, CExpressionHandle &exprhdl,
 		pcmgpdb->GetCostModelParams()
 			->PcpLookup(CCostModelParamsGPDB::EcpSortTupWidthCostUnit)
 			->Get();
+	const CDouble dSpillTupWidthCostUnit =
+		pcmgpdb->GetCostModelParams()
+			->PcpLookup(CCostModelParamsGPDB::EcpSpillTupWidthCostUnit)
+			->Get();
 	GPOS_ASSERT(0 < dSortTupWidthCost);
+	GPOS_ASSERT(0 < dSpillTupWidthCostUnit);
 
 	// sort cost is correlated with the number of rows and width of input tuples. We use n*log(n) for sorting complexity.
 	CCost costLocal =
 		CCost(num_rebinds * (rows * rows.Log2() * width * dSortTupWidthCost));
+
+	// sorts that do not fit in the operator's memory quota spill
+	const CDouble dMemoryQuota = DOperatorMemoryQuota(
+		COptCtxt::PoctxtFromTLS()->GetOptimizerConfig()->GetHint());
+	costLocal =
+		costLocal + CCost(num_rebinds * DSortSpillCost(dMemoryQuota, rows,
+													   width,
+													   dSpillTupWidthCostUnit));
 	CCost costChild =
 		CostChildren(mp, exprhdl, pci, pcmgpdb->GetCostModelParams());
 
@@ -887,9 +1079,14 @@ CCostModelGPDB::CostHashAgg(CMemoryPool *mp, CExpressionHandle &exprhdl,
 		pcmgpdb->GetCostModelParams()
 			->PcpLookup(CCostModelParamsGPDB::EcpHashAggOutputTupWidthCostUnit)
 			->Get();
+	const CDouble dSpillTupWidthCostUnit =
+		pcmgpdb->GetCostModelParams()
+			->PcpLookup(CCostModelParamsGPDB::EcpSpillTupWidthCostUnit)
+			->Get();
 	GPOS_ASSERT(0 < dHashAggInputTupColumnCostUnit);
 	GPOS_ASSERT(0 < dHashAggInputTupWidthCostUnit);
 	GPOS_ASSERT(0 < dHashAggOutputTupWidthCostUnit);
+	GPOS_ASSERT(0 < dSpillTupWidthCostUnit);
 
 	// hashAgg cost contains three parts: build hash table, aggregate tuples, and output tuples.
 	// 1. build hash table is correlated with the number of rows and width of input tuples and the number of columns used.
@@ -901,6 +1098,22 @@ CCostModelGPDB::CostHashAgg(CMemoryPool *mp, CExpressionHandle &exprhdl,
 			   num_rows_outer * ulGrpCols * pci->Width() *
 				   dHashAggInputTupWidthCostUnit +
 			   rows * pci->Width() * dHashAggOutputTupWidthCostUnit));
+
+	// group state that does not fit in the operator's memory quota spills;
+	// a local agg that may stream partial results to the global agg does
+	// not spill
+	if (!(COperator::EgbaggtypeLocal == popAgg->Egbaggtype() &&
+		  popAgg->FGeneratesDuplicates()))
+	{
+		const CDouble dMemoryQuota = DOperatorMemoryQuota(
+			COptCtxt::PoctxtFromTLS()->GetOptimizerConfig()->GetHint());
+		costLocal =
+			costLocal +
+			CCost(pci->NumRebinds() *
+				  DHashAggSpillCost(dMemoryQuota, pci->Rows() * pci->Width(),
+									num_rows_outer, pci->GetWidth()[0],
+									dSpillTupWidthCostUnit));
+	}
 	CCost costChild =
 		CostChildren(mp, exprhdl, pci, pcmgpdb->GetCostModelParams());
 
@@ -1007,13 +1220,14 @@ CCostModelGPDB::CostHashJoin(CMemoryPool *mp, CExpressionHandle &exprhdl,
 	CColRefSet *pcrsUsed = pexprJoinCond->DeriveUsedColumns();
 	const ULONG ulColsUsed = pcrsUsed->Size();
 
-	// TODO 2014-03-14
-	// currently, we hard coded a spilling memory threshold for judging whether hash join spills or not
-	// In the future, we should calculate it based on the number of memory-intensive operators and statement memory available
+	const CDouble dMemoryQuota = DOperatorMemoryQuota(
+		COptCtxt::PoctxtFromTLS()->GetOptimizerConfig()->GetHint());
+
 	CCost costLocal(0);
 
 	// inner tuples fit in memory
-	if (dRowsInner * dWidthInner <= dHJSpillingMemThreshold)
+	if (!FHashJoinSpills(dMemoryQuota, dHJSpillingMemThreshold,
+						 dRowsInner * dWidthInner))
 	{
 		// hash join cost contains four parts:
 		// 1. build hash table with inner tuples. This part is correlated with rows and width of
@@ -1637,7 +1851,8 @@ CCostModelGPDB::CostIndexScan(CMemoryPool *,  // mp
 				COperator::EopPhysicalDynamicIndexScan == op_id);
 
 	const CDouble dTableWidth =
-		CPhysicalScan::PopConvert(pop)->PstatsBaseTable()->Width();
+		DScanWidth(CPhysicalScan::PopConvert(pop), pci->PcrsRequired(),
+				   CPhysicalScan::PopConvert(pop)->PstatsBaseTable()->Width());
 
 	const CDouble dIndexFilterCostUnit =
 		pcmgpdb->GetCostModelParams()
@@ -1777,7 +1992,10 @@ CCostModelGPDB::CostBitmapTableScan(CMemoryPool *mp, CExpressionHandle &exprhdl,
 	pcrsLocalUsed->Exclude(outerRefs);
 
 	const DOUBLE rows = pci->Rows();
-	const DOUBLE width = pci->Width();
+	const DOUBLE width =
+		DScanWidth(CPhysicalScan::PopConvert(exprhdl.Pop()),
+				   pci->PcrsRequired(), pci->Width())
+			.Get();
 	CDouble dInitRebind =
 		pcmgpdb->GetCostModelParams()
 			->PcpLookup(CCostModelParamsGPDB::EcpBitmapScanRebindCost)
@@ -2034,6 +2252,9 @@ CCostModelGPDB::CostScan(CMemoryPool *,	 // mp
 			->Get();
 	const CDouble dTableWidth =
 		CPhysicalScan::PopConvert(pop)->PstatsBaseTable()->Width();
+	const CDouble dScanWidth =
+		DScanWidth(CPhysicalScan::PopConvert(pop), pci->PcrsRequired(),
+				   dTableWidth);
 
 	// Get total rows for each host to scan
 	const CDouble dTableScanCostUnit =
@@ -2049,12 +2270,13 @@ CCostModelGPDB::CostScan(CMemoryPool *,	 // mp
 		case COperator::EopPhysicalExternalScan:
 		case COperator::EopPhysicalMultiExternalScan:
 			// table scan cost considers only retrieving tuple cost,
-			// since we scan the entire table here, the cost is correlated with table rows and table width,
+			// since we scan the entire table here, the cost is correlated with table rows and the
+			// width of the data read, which is the table width unless the table is column-oriented,
 			// since Scan's parent operator may be a filter that will be pushed into Scan node in GPDB plan,
 			// we add Scan output tuple cost in the parent operator and not here
 			return CCost(
 				pci->NumRebinds() *
-				(dInitScan + pci->Rows() * dTableWidth * dTableScanCostUnit));
+				(dInitScan + pci->Rows() * dScanWidth * dTableScanCostUnit));
 		default:
 			GPOS_ASSERT(!"invalid index scan");
 			return CCost(0);
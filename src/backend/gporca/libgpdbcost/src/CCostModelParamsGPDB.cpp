@@ -186,6 +186,9 @@ const CDouble CCostModelParamsGPDB::DPenalizeHJSkewUpperLimit(10.0);
 // default scalar func cost
 const CDouble CCostModelParamsGPDB::DScalarFuncCost(1.0e-04);
 
+// cost of writing a byte of operator state to a workfile and reading it back
+const CDouble CCostModelParamsGPDB::DSpillTupWidthCostUnitVal(2.40e-06);
+
 #define GPOPT_COSTPARAM_NAME_MAX_LENGTH 80
 
 // parameter names in the same order of param enumeration
@@ -240,8 +243,12 @@ const CHAR rgszCostParamNames[CCostModelParamsGPDB::EcpSentinel]
 								 "BitmapIOSmallerNDV",
 								 "BitmapPageCostLargerNDV",
 								 "BitmapPageCostSmallerNDV",
+								 "BitmapPageCost",
 								 "BitmapNDVThreshold",
+								 "BitmapScanRebindCost",
+								 "PenalizeHJSkewUpperLimit",
 								 "ScalarFuncCostUnit",
+								 "SpillTupWidthCostUnit",
 };
 
 //---------------------------------------------------------------------------
@@ -436,6 +443,9 @@ CCostModelParamsGPDB::CCostModelParamsGPDB(CMemoryPool *mp) : m_mp(mp)
 	m_rgpcp[EcpScalarFuncCost] =
 		GPOS_NEW(mp) SCostParam(EcpScalarFuncCost, DScalarFuncCost,
 								DScalarFuncCost - 0.0, DScalarFuncCost + 0.0);
+	m_rgpcp[EcpSpillTupWidthCostUnit] = GPOS_NEW(mp) SCostParam(
+		EcpSpillTupWidthCostUnit, DSpillTupWidthCostUnitVal,
+		DSpillTupWidthCostUnitVal - 0.0, DSpillTupWidthCostUnitVal + 0.0);
 }
 
 
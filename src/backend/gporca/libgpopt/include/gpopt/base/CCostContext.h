@@ -224,6 +224,9 @@ public:
 	// derive properties of the plan carried by cost context
 	void DerivePlanProps(CMemoryPool *mp);
 
+	// set the cost computed for an equivalent context
+	void ReuseCost(CCost cost);
+
 	// set cost context state
 	void
 	SetState(EState estNewState)
@@ -298,6 +301,12 @@ public:
 		return HashValue(*pcc);
 	}
 
+	// rows of the busiest host of a hashed distribution, given the NDV of
+	// the distribution columns and the frequency of their most common value,
+	// or 0 if it is not considered
+	static CDouble DRowsPerHostHashed(CDouble rows, CDouble dNDVs,
+									  CDouble dMaxFreq, ULONG ulHosts);
+
 	// debug print
 	virtual IOstream &OsPrint(IOstream &os) const;
 
@@ -20,6 +20,11 @@
 #include "gpopt/base/IComparator.h"
 #include "gpopt/mdcache/CMDAccessor.h"
 
+namespace gpnaucrates
+{
+class CJoinStatsCache;
+}
+
 namespace gpopt
 {
 using namespace gpos;
@@ -30,6 +35,8 @@ class COptimizerConfig;
 class ICostModel;
 class IConstExprEvaluator;
 
+using gpnaucrates::CJoinStatsCache;
+
 //---------------------------------------------------------------------------
 //	@class:
 //		COptCtxt
@@ -101,6 +108,21 @@ private:
 	// does this plan have a direct dispatchable filter
 	CExpressionArray *m_direct_dispatchable_filters;
 
+	// statistics derived for inner joins
+	CJoinStatsCache *m_join_stats_cache;
+
+	// number of histograms derived for joins and unions
+	ULONG m_derived_histograms;
+
+	// number of buckets of derived histograms, before compaction
+	ULLONG m_derived_histogram_buckets;
+
+	// number of buckets removed from derived histograms by compaction
+	ULLONG m_compacted_histogram_buckets;
+
+	// time spent compacting derived histograms, in microseconds
+	ULLONG m_histogram_compaction_us;
+
 public:
 	// ctor
 	COptCtxt(CMemoryPool *mp, CColumnFactory *col_factory,
@@ -227,6 +249,26 @@ public:
 		return m_pceeval;
 	}
 
+	// join statistics cache
+	CJoinStatsCache *
+	PJoinStatsCache() const
+	{
+		return m_join_stats_cache;
+	}
+
+	// record a histogram derived for a join or union
+	void
+	RecordDerivedHistogram(ULONG num_buckets, ULONG num_compacted_buckets,
+						   ULONG compaction_us)
+	{
+		GPOS_ASSERT(num_compacted_buckets <= num_buckets);
+
+		m_derived_histograms++;
+		m_derived_histogram_buckets += num_buckets;
+		m_compacted_histogram_buckets += num_buckets - num_compacted_buckets;
+		m_histogram_compaction_us += compaction_us;
+	}
+
 	// comparator
 	const IComparator *
 	Pcomp()
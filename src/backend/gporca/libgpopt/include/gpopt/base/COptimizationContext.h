@@ -336,6 +336,19 @@ public:
 	static BOOL FEqualContextIds(COptimizationContextArray *pdrgpocFst,
 								 COptimizationContextArray *pdrgpocSnd);
 
+	// equality function for hash maps keyed by arrays of contexts
+	static BOOL
+	FEqualContextIdArrays(const COptimizationContextArray *pdrgpocFst,
+						  const COptimizationContextArray *pdrgpocSnd)
+	{
+		return FEqualContextIds(
+			const_cast<COptimizationContextArray *>(pdrgpocFst),
+			const_cast<COptimizationContextArray *>(pdrgpocSnd));
+	}
+
+	// hash function for hash maps keyed by arrays of contexts
+	static ULONG UlHashContextIds(const COptimizationContextArray *pdrgpoc);
+
 	// compute required properties to CTE producer based on plan properties of CTE consumer
 	static CReqdPropPlan *PrppCTEProducer(CMemoryPool *mp,
 										  COptimizationContext *poc,
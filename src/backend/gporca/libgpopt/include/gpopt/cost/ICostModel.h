@@ -30,6 +30,7 @@ namespace gpopt
 {
 // fwd declarations
 class CExpressionHandle;
+class CColRefSet;
 
 using namespace gpos;
 using namespace gpmd;
@@ -130,6 +131,9 @@ public:
 		// width estimate of root
 		DOUBLE m_width;
 
+		// columns required from root, not owned
+		const CColRefSet *m_pcrsRequired;
+
 		// number of rebinds of root
 		DOUBLE m_num_rebinds;
 
@@ -155,6 +159,7 @@ public:
 			  m_pcstats(pcstats),
 			  m_rows(0),
 			  m_width(0),
+			  m_pcrsRequired(NULL),
 			  m_num_rebinds(GPOPT_DEFAULT_REBINDS),
 			  m_pdRowsChildren(NULL),
 			  m_pdWidthChildren(NULL),
@@ -235,6 +240,20 @@ public:
 			m_width = width;
 		}
 
+		// required columns accessor
+		const CColRefSet *
+		PcrsRequired() const
+		{
+			return m_pcrsRequired;
+		}
+
+		// required columns setter
+		void
+		SetRequiredColumns(const CColRefSet *pcrsRequired)
+		{
+			m_pcrsRequired = pcrsRequired;
+		}
+
 		// rebinds accessor
 		DOUBLE
 		NumRebinds() const
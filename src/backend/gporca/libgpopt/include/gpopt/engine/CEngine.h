@@ -374,6 +374,13 @@ public:
 		m_pmemo->ResetTreeMap();
 	}
 
+	// number of cost contexts whose cost was reused from an equivalent context
+	ULONG
+	UlReusedCosts()
+	{
+		return m_pmemo->UlReusedCosts();
+	}
+
 	// check if parent group expression can optimize child group expression
 	BOOL FOptimizeChild(CGroupExpression *pgexprParent,
 						CGroupExpression *pgexprChild,
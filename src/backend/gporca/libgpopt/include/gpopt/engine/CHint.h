@@ -20,6 +20,8 @@
 #define PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD ULONG(10)
 #define XFORM_BIND_THRESHOLD ULONG(0)
 #define SKEW_FACTOR ULONG(0)
+#define QUERY_MEMORY_KB ULONG(0)
+#define MEMORY_INTENSIVE_OPERATORS ULONG(0)
 
 
 namespace gpopt
@@ -55,13 +57,18 @@ private:
 	CHint(const CHint &);
 	ULONG m_ulSkewFactor;
 
+	ULONG m_ulQueryMemoryKB;
+
+	ULONG m_ulMemoryIntensiveOperators;
+
 public:
 	// ctor
 	CHint(ULONG join_arity_for_associativity_commutativity,
 		  ULONG array_expansion_threshold, ULONG ulJoinOrderDPLimit,
 		  ULONG broadcast_threshold, BOOL enforce_constraint_on_dml,
 		  ULONG push_group_by_below_setop_threshold, ULONG xform_bind_threshold,
-		  ULONG skew_factor)
+		  ULONG skew_factor, ULONG query_memory_kb,
+		  ULONG memory_intensive_operators)
 		: m_ulJoinArityForAssociativityCommutativity(
 			  join_arity_for_associativity_commutativity),
 		  m_ulArrayExpansionThreshold(array_expansion_threshold),
@@ -71,7 +78,9 @@ public:
 		  m_ulPushGroupByBelowSetopThreshold(
 			  push_group_by_below_setop_threshold),
 		  m_ulXform_bind_threshold(xform_bind_threshold),
-		  m_ulSkewFactor(skew_factor)
+		  m_ulSkewFactor(skew_factor),
+		  m_ulQueryMemoryKB(query_memory_kb),
+		  m_ulMemoryIntensiveOperators(memory_intensive_operators)
 	{
 	}
 
@@ -143,6 +152,22 @@ public:
 		return m_ulSkewFactor;
 	}
 
+	// Memory available to the operators of the query on each segment, in KB,
+	// as granted by statement_mem or the resource group; 0 if unknown
+	ULONG
+	UlQueryMemoryKB() const
+	{
+		return m_ulQueryMemoryKB;
+	}
+
+	// Expected number of memory-intensive operators (hash joins, hash aggs,
+	// sorts, ...) that share the query memory; 0 if unknown
+	ULONG
+	UlMemoryIntensiveOperators() const
+	{
+		return m_ulMemoryIntensiveOperators;
+	}
+
 	// generate default hint configurations, which disables sort during insert on
 	// append only row-oriented partitioned tables by default
 	static CHint *
@@ -156,7 +181,9 @@ public:
 			true,								 /* enforce_constraint_on_dml */
 			PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD, /* push_group_by_below_setop_threshold */
 			XFORM_BIND_THRESHOLD,				 /* xform_bind_threshold */
-			SKEW_FACTOR							 /* skew_factor */
+			SKEW_FACTOR,						 /* skew_factor */
+			QUERY_MEMORY_KB,					 /* query_memory_kb */
+			MEMORY_INTENSIVE_OPERATORS			 /* memory_intensive_operators */
 		);
 	}
 
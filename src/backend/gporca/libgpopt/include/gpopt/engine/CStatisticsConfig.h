@@ -13,6 +13,7 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CDouble.h"
+#include "gpos/common/CHashMap.h"
 #include "gpos/common/CRefCount.h"
 #include "gpos/memory/CMemoryPool.h"
 
@@ -26,6 +27,13 @@ namespace gpopt
 using namespace gpos;
 using namespace gpmd;
 
+// hash map from cardinality feedback key to the observed number of rows;
+// the map compares the whole 64-bit key, so colliding hashes do not match
+typedef CHashMap<ULLONG, CDouble, gpos::HashValue<ULLONG>,
+				 gpos::Equals<ULLONG>, CleanupDelete<ULLONG>,
+				 CleanupDelete<CDouble> >
+	UllongToFeedbackRowsMap;
+
 //---------------------------------------------------------------------------
 //	@class:
 //		CStatisticsConfig
@@ -53,14 +61,29 @@ private:
 	// See CHistogram::MakeUnionAllHistogramNormalize/MakeUnionHistogramNormalize
 	ULONG m_max_stats_buckets;
 
+	// max buckets of a histogram derived for a join or union, 0 if unbounded
+	// See CHistogram::CompactBuckets
+	ULONG m_max_derived_stats_buckets;
+
 	// hash set of md ids for columns with missing statistics
 	MdidHashSet *m_phsmdidcolinfo;
 
+	// are plan nodes tagged with their cardinality feedback keys?
+	BOOL m_cardinality_feedback;
+
+	// number of rows observed when executing earlier plans, by the
+	// cardinality feedback key of the group that produced them
+	UllongToFeedbackRowsMap *m_feedback_rows;
+
+	// number of groups whose statistics were corrected by feedback
+	ULONG m_num_feedback_groups;
+
 public:
 	// ctor
 	CStatisticsConfig(CMemoryPool *mp, CDouble damping_factor_filter,
 					  CDouble damping_factor_join,
-					  CDouble damping_factor_groupby, ULONG max_stats_buckets);
+					  CDouble damping_factor_groupby, ULONG max_stats_buckets,
+					  ULONG max_derived_stats_buckets);
 
 	// dtor
 	~CStatisticsConfig();
@@ -93,6 +116,47 @@ public:
 		return m_max_stats_buckets;
 	}
 
+	// max buckets of a derived histogram
+	ULONG
+	UlMaxDerivedStatsBuckets() const
+	{
+		return m_max_derived_stats_buckets;
+	}
+
+	// tag plan nodes with their cardinality feedback keys
+	void
+	EnableCardinalityFeedback()
+	{
+		m_cardinality_feedback = true;
+	}
+
+	// are plan nodes tagged with their cardinality feedback keys?
+	BOOL
+	FCardinalityFeedback() const
+	{
+		return m_cardinality_feedback;
+	}
+
+	// add the number of rows observed for a cardinality feedback key
+	void AddCardinalityFeedback(ULLONG key, CDouble rows);
+
+	// number of rows observed for a cardinality feedback key, NULL if none
+	const CDouble *PdCardinalityFeedback(ULLONG key) const;
+
+	// record that the statistics of a group were corrected by feedback
+	void
+	IncrementFeedbackGroups()
+	{
+		m_num_feedback_groups++;
+	}
+
+	// number of groups whose statistics were corrected by feedback
+	ULONG
+	UlFeedbackGroups() const
+	{
+		return m_num_feedback_groups;
+	}
+
 	// add the information about the column with the missing statistics
 	void AddMissingStatsColumn(CMDIdColStats *pmdidCol);
 
@@ -106,7 +170,7 @@ public:
 		return GPOS_NEW(mp) CStatisticsConfig(
 			mp, 0.75 /* damping_factor_filter */,
 			0.01 /* damping_factor_join */, 0.75 /* damping_factor_groupby */,
-			MAX_STATS_BUCKETS);
+			MAX_STATS_BUCKETS, 0 /* max_derived_stats_buckets */);
 	}
 
 
@@ -19,8 +19,10 @@
 #define GPOPT_CConstExprEvaluatorDXL_H
 
 #include "gpos/base.h"
+#include "gpos/common/CHashMap.h"
 
 #include "gpopt/base/CColRef.h"
+#include "gpopt/base/CUtils.h"
 #include "gpopt/eval/IConstExprEvaluator.h"
 #include "gpopt/translate/CTranslatorDXLToExpr.h"
 #include "gpopt/translate/CTranslatorExprToDXL.h"
@@ -46,13 +48,34 @@ class IConstDXLNodeEvaluator;
 //	@doc:
 //		Constant expression evaluator implementation that delegates to a DXL evaluator
 //
+//		Results are memoized for the lifetime of the evaluator, which is one
+//		query, so structurally identical expressions are only evaluated once
+//
 //---------------------------------------------------------------------------
 class CConstExprEvaluatorDXL : public IConstExprEvaluator
 {
 private:
+	// map of evaluated expressions to their results
+	typedef CHashMap<CExpression, CExpression, CExpression::HashValue,
+					 CUtils::Equals, CleanupRelease<CExpression>,
+					 CleanupRelease<CExpression> >
+		ExprToResultMap;
+
+	// memory pool
+	CMemoryPool *m_mp;
+
 	// evaluates expressions represented as DXL, not owned
 	IConstDXLNodeEvaluator *m_pconstdxleval;
 
+	// results of previously evaluated expressions
+	ExprToResultMap *m_phmexprresult;
+
+	// number of expressions sent to the DXL evaluator
+	ULONG m_ulEvaluations;
+
+	// number of expressions answered from previous results
+	ULONG m_ulCacheHits;
+
 	// translates CExpression's to DXL which can then be sent to the evaluator
 	CTranslatorExprToDXL m_trexpr2dxl;
 
@@ -76,6 +99,20 @@ public:
 
 	// Returns true iff the evaluator can evaluate expressions
 	virtual BOOL FCanEvalExpressions();
+
+	// number of expressions sent to the DXL evaluator
+	ULONG
+	UlEvaluations() const
+	{
+		return m_ulEvaluations;
+	}
+
+	// number of expressions answered from previous results
+	ULONG
+	UlCacheHits() const
+	{
+		return m_ulCacheHits;
+	}
 };
 }  // namespace gpopt
 
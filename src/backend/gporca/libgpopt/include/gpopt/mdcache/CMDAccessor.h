@@ -47,6 +47,7 @@ class IMDProvider;
 class CMDProviderGeneric;
 class IMDColStats;
 class IMDRelStats;
+class IMDMultiColStats;
 class CDXLBucket;
 class IMDCast;
 class IMDScCmp;
@@ -354,6 +355,9 @@ public:
 	// retrieve a relation stats object from the cache
 	const IMDRelStats *Pmdrelstats(IMDId *mdid);
 
+	// retrieve the statistics on groups of columns of a relation
+	const IMDMultiColStats *RetrieveMultiColStats(IMDId *rel_mdid);
+
 	// retrieve a cast object from the cache
 	const IMDCast *Pmdcast(IMDId *mdid_src, IMDId *mdid_dest);
 
@@ -44,6 +44,12 @@ private:
 	// the maximum size of the cache
 	static ULLONG m_ullCacheQuota;
 
+	// counters of cache instances destroyed by Reset/Shutdown, per mdtype
+	static SCacheClassStats m_rgstatsRetired[CCACHE_MAX_ENTRY_CLASSES];
+
+	// number of times the cache was reset
+	static ULLONG m_ullResetCounter;
+
 	// private ctor
 	CMDCache(){};
 
@@ -76,6 +82,13 @@ public:
 	// get the number of times we evicted entries from this cache
 	static ULLONG ULLGetCacheEvictionCounter();
 
+	// get the number of times the cache was reset
+	static ULLONG ULLGetCacheResetCounter();
+
+	// get the statistics of the cached objects of the given type; hits,
+	// inserts and evictions are cumulative across cache resets
+	static SCacheClassStats GetStats(IMDCacheObject::Emdtype mdtype);
+
 	// reset global instance
 	static void Reset();
 
@@ -333,6 +333,11 @@ public:
 	// helper to compute skew estimate based on given stats and distribution spec
 	static CDouble GetSkew(IStatistics *stats, CDistributionSpec *pds);
 
+	// helper to compute the frequency of the most frequent value of the
+	// distribution key based on given stats and distribution spec
+	static CDouble GetMaxValueFrequency(IStatistics *stats,
+										CDistributionSpec *pds);
+
 	// type of operator
 	virtual BOOL
 	FPhysical() const
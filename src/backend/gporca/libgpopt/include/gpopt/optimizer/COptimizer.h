@@ -15,6 +15,7 @@
 
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/search/CSearchStage.h"
+#include "gpopt/translate/IPlanTranslator.h"
 #include "naucrates/dxl/operators/CDXLNode.h"
 
 namespace gpdxl
@@ -97,7 +98,9 @@ public:
 		CSearchStageArray *search_stage_array,	// search strategy
 		COptimizerConfig *optimizer_config,		// optimizer configurations
 		const CHAR *szMinidumpFileName =
-			NULL  // name of minidump file to be created
+			NULL,  // name of minidump file to be created
+		IPlanTranslator *plan_translator =
+			NULL  // translator of the plan bypassing DXL, if any
 	);
 };	// class COptimizer
 }  // namespace gpopt
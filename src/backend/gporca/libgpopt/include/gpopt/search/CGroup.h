@@ -241,6 +241,21 @@ private:
 	// does the group have any CTE consumer
 	BOOL m_fCTEConsumer;
 
+	// has the cardinality feedback key of the group been derived?
+	BOOL m_fFeedbackKeyDerived;
+
+	// does the group have a cardinality feedback key?
+	BOOL m_fFeedbackKeyValid;
+
+	// hash of the base relations the group is computed from
+	ULLONG m_ullFeedbackRels;
+
+	// hash of the predicates and aggregations applied to the base relations
+	ULLONG m_ullFeedbackPreds;
+
+	// were the group's stats corrected by cardinality feedback?
+	BOOL m_fUsedFeedback;
+
 	// exploration job queue
 	CJobQueue m_jqExploration;
 
@@ -327,6 +342,16 @@ private:
 	// initialize and return empty stats for this group
 	IStatistics *PstatsInitEmpty(CMemoryPool *pmpGlobal);
 
+	// derive the components of the cardinality feedback key of the group
+	BOOL FDeriveFeedbackKey(ULLONG *pullRels, ULLONG *pullPreds);
+
+	// hash of a column for cardinality feedback keys
+	static ULLONG UllFeedbackHashColRef(const CColRef *colref);
+
+	// hash of a scalar expression for cardinality feedback keys, which
+	// does not depend on the order of conjuncts and disjuncts
+	static ULLONG UllFeedbackHashScalar(CExpression *pexpr);
+
 	// find the group expression having the best stats promise
 	CGroupExpression *PgexprBestPromise(CMemoryPool *pmpLocal,
 										CMemoryPool *pmpGlobal,
@@ -431,6 +456,9 @@ public:
 		return m_ulGExprs;
 	}
 
+	// number of cost contexts of the group whose cost was reused
+	ULONG UlReusedCosts();
+
 	// optimization contexts hash table accessor
 	ShtOC &
 	Sht()
@@ -598,6 +626,20 @@ public:
 							   CExpressionHandle &exprhdl,
 							   CGroupExpression *pgexpr);
 
+	// cardinality feedback key of the group; false if the group has none
+	BOOL FFeedbackKey(ULLONG *pullKey);
+
+	// correct the given stats of the group by the number of rows observed
+	// when executing earlier plans, if any
+	IStatistics *PstatsApplyFeedback(CMemoryPool *mp, IStatistics *stats);
+
+	// were the group's stats corrected by cardinality feedback?
+	BOOL
+	FUsedFeedback() const
+	{
+		return m_fUsedFeedback;
+	}
+
 	// compute cost lower bound for the plan satisfying given required properties
 	CCost CostLowerBound(CMemoryPool *mp, CReqdPropPlan *prppInput);
 
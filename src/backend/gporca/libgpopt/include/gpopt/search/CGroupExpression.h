@@ -93,6 +93,46 @@ private:
 					 CleanupDelete<CCost> >
 		PartialPlanToCostMap;
 
+	// cost of a plan computed from given child contexts
+	struct SChildContextsCost
+	{
+		// columns required from the plan
+		CColRefSet *m_pcrsRequired;
+
+		// best costs of the child contexts the cost was computed from; the
+		// best plan of a child context may change in later search stages
+		CCostArray *m_pdrgpcostChildren;
+
+		// cost of the plan
+		CCost m_cost;
+
+		// ctor
+		SChildContextsCost(CColRefSet *pcrsRequired,
+						   CCostArray *pdrgpcostChildren, CCost cost)
+			: m_pcrsRequired(pcrsRequired),
+			  m_pdrgpcostChildren(pdrgpcostChildren),
+			  m_cost(cost)
+		{
+			GPOS_ASSERT(NULL != pcrsRequired);
+			GPOS_ASSERT(NULL != pdrgpcostChildren);
+		}
+
+		// dtor
+		~SChildContextsCost()
+		{
+			m_pcrsRequired->Release();
+			m_pdrgpcostChildren->Release();
+		}
+	};
+
+	// map of child contexts to the cost of the plans computed from them
+	typedef CHashMap<COptimizationContextArray, SChildContextsCost,
+					 COptimizationContext::UlHashContextIds,
+					 COptimizationContext::FEqualContextIdArrays,
+					 CleanupRelease<COptimizationContextArray>,
+					 CleanupDelete<SChildContextsCost> >
+		ChildContextsToCostMap;
+
 
 	// expression id
 	ULONG m_id;
@@ -132,6 +172,13 @@ private:
 	// map of partial plans to their cost lower bound
 	PartialPlanToCostMap *m_ppartialplancostmap;
 
+	// map of child contexts to the cost of the plans computed from them
+	ChildContextsToCostMap *m_pchildctxtcostmap;
+
+	// number of cost contexts whose cost was reused from an equivalent
+	// context instead of being computed
+	ULONG m_ulReusedCosts;
+
 	// circular dependency state
 	ECircularDependency m_ecirculardependency;
 
@@ -159,6 +206,17 @@ private:
 	// costing scheme
 	CCost CostCompute(CMemoryPool *mp, CCostContext *pcc) const;
 
+	// best costs of the child contexts of the given cost context
+	static CCostArray *PdrgpcostChildren(CMemoryPool *mp, CCostContext *pcc);
+
+	// check if two arrays of child costs are equal
+	static BOOL FEqualCosts(const CCostArray *pdrgpcostFst,
+							const CCostArray *pdrgpcostSnd);
+
+	// set the cost of the given context, reusing the cost of an equivalent
+	// context if there is one
+	void SetContextCost(CMemoryPool *mp, CCostContext *pcc);
+
 	// set optimization level of group expression
 	void SetOptimizationLevel();
 
@@ -190,7 +248,9 @@ private:
 		  m_fIntermediate(false),
 		  m_estate(estUnexplored),
 		  m_eol(EolLow),
-		  m_ppartialplancostmap(NULL){};
+		  m_ppartialplancostmap(NULL),
+		  m_pchildctxtcostmap(NULL),
+		  m_ulReusedCosts(0){};
 
 
 public:
@@ -389,6 +449,13 @@ public:
 		return m_pdrgpgroup;
 	}
 
+	// number of cost contexts whose cost was reused
+	ULONG
+	UlReusedCosts() const
+	{
+		return m_ulReusedCosts;
+	}
+
 	// lookup cost context in hash table
 	CCostContext *PccLookup(COptimizationContext *poc, ULONG ulOptReq);
 
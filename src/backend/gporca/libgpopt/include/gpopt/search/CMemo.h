@@ -127,6 +127,9 @@ public:
 	// return number of duplicate groups
 	ULONG UlDuplicateGroups();
 
+	// return number of cost contexts whose cost was reused
+	ULONG UlReusedCosts();
+
 	// mark groups as duplicates
 	void MarkDuplicates(CGroup *pgroupFst, CGroup *pgroupSnd);
 
@@ -176,6 +179,10 @@ public:
 	// get group by id
 	CGroup *Pgroup(ULONG id);
 
+	// print the ids of the groups whose stats were corrected by
+	// cardinality feedback
+	IOstream &OsPrintFeedbackGroups(IOstream &os) const;
+
 };	// class CMemo
 
 }  // namespace gpopt
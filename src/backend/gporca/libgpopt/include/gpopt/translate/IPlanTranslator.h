@@ -0,0 +1,55 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		IPlanTranslator.h
+//
+//	@doc:
+//		Interface for translating the plan found by the optimizer directly
+//		into the plan of the host system, without building a DXL plan
+//---------------------------------------------------------------------------
+
+#ifndef GPOPT_IPlanTranslator_H
+#define GPOPT_IPlanTranslator_H
+
+#include "gpos/base.h"
+
+#include "gpopt/base/CColRef.h"
+#include "naucrates/md/CMDName.h"
+
+namespace gpopt
+{
+using namespace gpos;
+using namespace gpmd;
+
+class CExpression;	// forward declaration
+
+//---------------------------------------------------------------------------
+//	@class:
+//		IPlanTranslator
+//
+//	@doc:
+//		Translator of a physical expression tree, called by the optimizer
+//		while the optimization context of the plan is still alive
+//
+//---------------------------------------------------------------------------
+class IPlanTranslator
+{
+public:
+	// dtor
+	virtual ~IPlanTranslator()
+	{
+	}
+
+	// translate the given plan producing the given output columns; return
+	// false if the plan is not supported, in which case the optimizer
+	// translates it into DXL instead
+	virtual BOOL FTranslate(CExpression *pexprPlan, CColRefArray *colref_array,
+							CMDNameArray *pdrgpmdname) = 0;
+};
+}  // namespace gpopt
+
+#endif	// !GPOPT_IPlanTranslator_H
+
+// EOF
@@ -24,6 +24,7 @@
 #include "gpopt/cost/ICostModel.h"
 #include "gpopt/exception.h"
 #include "gpopt/operators/CExpressionHandle.h"
+#include "gpopt/operators/CPhysical.h"
 #include "gpopt/operators/CPhysicalAgg.h"
 #include "gpopt/operators/CPhysicalDynamicIndexScan.h"
 #include "gpopt/operators/CPhysicalDynamicTableScan.h"
@@ -243,6 +244,24 @@ CCostContext::DerivePlanProps(CMemoryPool *mp)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostContext::ReuseCost
+//
+//	@doc:
+//		Set the cost computed for another context of the same group
+//		expression with the same child contexts, instead of computing it
+//
+//---------------------------------------------------------------------------
+void
+CCostContext::ReuseCost(CCost cost)
+{
+	// the stats are still needed by the costing of parent contexts
+	DeriveStats();
+	SetCost(cost);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CCostContext::operator ==
@@ -599,6 +618,7 @@ CCostContext::CostCompute(CMemoryPool *mp, CCostArray *pdrgpcostChildren)
 
 	DOUBLE width = m_pstats->Width(mp, m_poc->Prpp()->PcrsRequired()).Get();
 	ci.SetWidth(width);
+	ci.SetRequiredColumns(m_poc->Prpp()->PcrsRequired());
 
 	DOUBLE num_rebinds = m_pstats->NumRebinds().Get();
 	ci.SetRebinds(num_rebinds);
@@ -693,20 +713,57 @@ CCostContext::DRowsPerHost() const
 												 pdrgpul, NULL /*keys*/);
 		pdrgpul->Release();
 
-		if (dNDVs < ulHosts)
+		CDouble dMaxFreq(0.0);
+		if (GPOS_FTRACE(EopttracePenalizeMCVSkew))
 		{
-			// estimated number of distinct values of distribution columns is smaller than number of hosts.
-			// We assume data is distributed across a subset of hosts in this case. This results in a larger
-			// number of rows per host compared to the uniform case, allowing us to capture data skew in
-			// cost computation
-			return CDouble(rows / dNDVs.Get());
+			dMaxFreq = CPhysical::GetMaxValueFrequency(Pstats(), pds);
 		}
+
+		return DRowsPerHostHashed(CDouble(rows), dNDVs, dMaxFreq, ulHosts);
 	}
 
 	return CDouble(rows / ulHosts);
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostContext::DRowsPerHostHashed
+//
+//	@doc:
+//		Return the number of rows of the busiest host of a hashed
+//		distribution
+//
+//---------------------------------------------------------------------------
+CDouble
+CCostContext::DRowsPerHostHashed(CDouble rows, CDouble dNDVs, CDouble dMaxFreq,
+								 ULONG ulHosts)
+{
+	CDouble dRowsPerHost = rows / ulHosts;
+	if (dNDVs < ulHosts)
+	{
+		// estimated number of distinct values of distribution columns is smaller than number of hosts.
+		// We assume data is distributed across a subset of hosts in this case. This results in a larger
+		// number of rows per host compared to the uniform case, allowing us to capture data skew in
+		// cost computation
+		dRowsPerHost = rows / dNDVs;
+	}
+
+	// the host that receives the most common value of the distribution
+	// columns also receives its share of the remaining rows; if that
+	// value alone outweighs the share of a host, this host is the
+	// bottleneck, and its rows are used for costing
+	if (1.0 < dMaxFreq * ulHosts)
+	{
+		CDouble dRowsBusiestHost =
+			rows * (dMaxFreq + (CDouble(1.0) - dMaxFreq) / ulHosts);
+		dRowsPerHost = std::max(dRowsPerHost, dRowsBusiestHost);
+	}
+
+	return dRowsPerHost;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CCostContext::OsPrint
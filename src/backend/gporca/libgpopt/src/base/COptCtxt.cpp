@@ -13,12 +13,14 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CAutoP.h"
+#include "gpos/error/CAutoTrace.h"
 
 #include "gpopt/base/CColRefSet.h"
 #include "gpopt/base/CDefaultComparator.h"
 #include "gpopt/cost/ICostModel.h"
 #include "gpopt/eval/IConstExprEvaluator.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
+#include "naucrates/statistics/CJoinStatsCache.h"
 #include "naucrates/traceflags/traceflags.h"
 
 using namespace gpopt;
@@ -50,7 +52,12 @@ COptCtxt::COptCtxt(CMemoryPool *mp, CColumnFactory *col_factory,
 	  m_fDMLQuery(false),
 	  m_has_master_only_tables(false),
 	  m_has_volatile_func(false),
-	  m_has_replicated_tables(false)
+	  m_has_replicated_tables(false),
+	  m_join_stats_cache(NULL),
+	  m_derived_histograms(0),
+	  m_derived_histogram_buckets(0),
+	  m_compacted_histogram_buckets(0),
+	  m_histogram_compaction_us(0)
 {
 	GPOS_ASSERT(NULL != mp);
 	GPOS_ASSERT(NULL != col_factory);
@@ -63,6 +70,7 @@ COptCtxt::COptCtxt(CMemoryPool *mp, CColumnFactory *col_factory,
 	m_pcteinfo = GPOS_NEW(m_mp) CCTEInfo(m_mp);
 	m_cost_model = optimizer_config->GetCostModel();
 	m_direct_dispatchable_filters = GPOS_NEW(mp) CExpressionArray(mp);
+	m_join_stats_cache = GPOS_NEW(mp) CJoinStatsCache(mp);
 }
 
 
@@ -77,6 +85,17 @@ COptCtxt::COptCtxt(CMemoryPool *mp, CColumnFactory *col_factory,
 //---------------------------------------------------------------------------
 COptCtxt::~COptCtxt()
 {
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	{
+		CAutoTrace at(m_mp);
+		at.Os() << "[OPT]: Derived histograms: " << m_derived_histograms
+				<< ", buckets: " << m_derived_histogram_buckets
+				<< ", buckets removed by compaction: "
+				<< m_compacted_histogram_buckets
+				<< ", compaction time: " << m_histogram_compaction_us << "us";
+	}
+
+	GPOS_DELETE(m_join_stats_cache);
 	GPOS_DELETE(m_pcf);
 	GPOS_DELETE(m_pcomp);
 	m_pceeval->Release();
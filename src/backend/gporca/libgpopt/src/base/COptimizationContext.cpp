@@ -230,6 +230,31 @@ COptimizationContext::FEqualContextIds(COptimizationContextArray *pdrgpocFst,
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationContext::UlHashContextIds
+//
+//	@doc:
+//		Hash an array of optimization contexts based on context ids
+//
+//---------------------------------------------------------------------------
+ULONG
+COptimizationContext::UlHashContextIds(const COptimizationContextArray *pdrgpoc)
+{
+	GPOS_ASSERT(NULL != pdrgpoc);
+
+	ULONG ulHash = 0;
+	const ULONG ulCtxts = pdrgpoc->Size();
+	for (ULONG ul = 0; ul < ulCtxts; ul++)
+	{
+		ULONG id = (*pdrgpoc)[ul]->Id();
+		ulHash = gpos::CombineHashes(ulHash, gpos::HashValue<ULONG>(&id));
+	}
+
+	return ulHash;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptimizationContext::FOptimizeMotion
@@ -1516,6 +1516,16 @@ CEngine::FinalizeImplementation()
 		(void) OsPrintMemoryConsumption(
 			at.Os(), "Memory consumption after implementation ");
 	}
+
+	CStatisticsConfig *stats_config =
+		COptCtxt::PoctxtFromTLS()->GetOptimizerConfig()->GetStatsConf();
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics) &&
+		0 < stats_config->UlFeedbackGroups())
+	{
+		CAutoTrace at(m_mp);
+		at.Os() << "[OPT]: Groups using cardinality feedback:";
+		(void) m_pmemo->OsPrintFeedbackGroups(at.Os());
+	}
 }
 
 //---------------------------------------------------------------------------
@@ -1643,6 +1653,7 @@ CEngine::ProcessTraceFlags()
 				<< (ULONG)(m_pmemo->UlpGroups()) << " groups"
 				<< ", " << m_pmemo->UlDuplicateGroups() << " duplicate groups"
 				<< ", " << m_pmemo->UlGrpExprs() << " group expressions"
+				<< ", " << m_pmemo->UlReusedCosts() << " reused costs"
 				<< ", " << m_xforms->Size() << " activated xforms]";
 
 		at.Os() << std::endl
@@ -33,13 +33,18 @@ CStatisticsConfig::CStatisticsConfig(CMemoryPool *mp,
 									 CDouble damping_factor_filter,
 									 CDouble damping_factor_join,
 									 CDouble damping_factor_groupby,
-									 ULONG max_stats_buckets)
+									 ULONG max_stats_buckets,
+									 ULONG max_derived_stats_buckets)
 	: m_mp(mp),
 	  m_damping_factor_filter(damping_factor_filter),
 	  m_damping_factor_join(damping_factor_join),
 	  m_damping_factor_groupby(damping_factor_groupby),
 	  m_max_stats_buckets(max_stats_buckets),
-	  m_phsmdidcolinfo(NULL)
+	  m_max_derived_stats_buckets(max_derived_stats_buckets),
+	  m_phsmdidcolinfo(NULL),
+	  m_cardinality_feedback(false),
+	  m_feedback_rows(NULL),
+	  m_num_feedback_groups(0)
 {
 	GPOS_ASSERT(CDouble(0.0) < damping_factor_filter);
 	GPOS_ASSERT(CDouble(0.0) <= damping_factor_join);
@@ -48,6 +53,7 @@ CStatisticsConfig::CStatisticsConfig(CMemoryPool *mp,
 
 	//m_phmmdidcolinfo = New(m_mp) HMMDIdMissingstatscol(m_mp);
 	m_phsmdidcolinfo = GPOS_NEW(m_mp) MdidHashSet(m_mp);
+	m_feedback_rows = GPOS_NEW(m_mp) UllongToFeedbackRowsMap(m_mp);
 }
 
 
@@ -63,6 +69,46 @@ CStatisticsConfig::CStatisticsConfig(CMemoryPool *mp,
 CStatisticsConfig::~CStatisticsConfig()
 {
 	m_phsmdidcolinfo->Release();
+	m_feedback_rows->Release();
+}
+
+//---------------------------------------------------------------------------
+//      @function:
+//              CStatisticsConfig::AddCardinalityFeedback
+//
+//      @doc:
+//              Add the number of rows observed for a cardinality feedback key
+//
+//---------------------------------------------------------------------------
+void
+CStatisticsConfig::AddCardinalityFeedback(ULLONG key, CDouble rows)
+{
+	GPOS_ASSERT(CDouble(0.0) <= rows);
+
+	ULLONG *pkey = GPOS_NEW(m_mp) ULLONG(key);
+	CDouble *prows = GPOS_NEW(m_mp) CDouble(rows);
+	if (!m_feedback_rows->Insert(pkey, prows))
+	{
+		// keep the first observation of the key
+		GPOS_DELETE(pkey);
+		GPOS_DELETE(prows);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//      @function:
+//              CStatisticsConfig::PdCardinalityFeedback
+//
+//      @doc:
+//              Number of rows observed for a cardinality feedback key, NULL
+//              if the key was not observed
+//
+//---------------------------------------------------------------------------
+const CDouble *
+CStatisticsConfig::PdCardinalityFeedback(ULLONG key) const
+{
+	return m_feedback_rows->Find(&key);
 }
 
 //---------------------------------------------------------------------------
@@ -17,6 +17,8 @@
 
 #include "gpopt/eval/CConstExprEvaluatorDXL.h"
 
+#include "gpos/error/CAutoTrace.h"
+
 #include "gpopt/base/CDrvdPropScalar.h"
 #include "gpopt/eval/IConstDXLNodeEvaluator.h"
 #include "gpopt/exception.h"
@@ -40,11 +42,16 @@ using namespace gpos;
 CConstExprEvaluatorDXL::CConstExprEvaluatorDXL(
 	CMemoryPool *mp, CMDAccessor *md_accessor,
 	IConstDXLNodeEvaluator *pconstdxleval)
-	: m_pconstdxleval(pconstdxleval),
+	: m_mp(mp),
+	  m_pconstdxleval(pconstdxleval),
+	  m_phmexprresult(NULL),
+	  m_ulEvaluations(0),
+	  m_ulCacheHits(0),
 	  m_trexpr2dxl(mp, md_accessor, NULL /*pdrgpiSegments*/,
 				   false /*fInitColumnFactory*/),
 	  m_trdxl2expr(mp, md_accessor, false /*fInitColumnFactory*/)
 {
+	m_phmexprresult = GPOS_NEW(mp) ExprToResultMap(mp);
 }
 
 //---------------------------------------------------------------------------
@@ -57,6 +64,15 @@ CConstExprEvaluatorDXL::CConstExprEvaluatorDXL(
 //---------------------------------------------------------------------------
 CConstExprEvaluatorDXL::~CConstExprEvaluatorDXL()
 {
+	m_phmexprresult->Release();
+
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	{
+		CAutoTrace at(m_mp);
+		at.Os() << "[OPT]: Constant expression evaluations: "
+				<< m_ulEvaluations << ", cache hits: " << m_ulCacheHits
+				<< std::endl;
+	}
 }
 
 //---------------------------------------------------------------------------
@@ -77,14 +93,37 @@ CConstExprEvaluatorDXL::PexprEval(CExpression *pexpr)
 	{
 		GPOS_RAISE(gpopt::ExmaGPOPT, gpopt::ExmiEvalUnsupportedScalarExpr);
 	}
+
+	CExpression *pexprResult = m_phmexprresult->Find(pexpr);
+	if (NULL != pexprResult)
+	{
+		m_ulCacheHits++;
+		pexprResult->AddRef();
+
+		return pexprResult;
+	}
+
 	CDXLNode *pdxlnExpr = m_trexpr2dxl.PdxlnScalar(pexpr);
 	CDXLNode *pdxlnResult = m_pconstdxleval->EvaluateExpr(pdxlnExpr);
+	m_ulEvaluations++;
 
 	GPOS_ASSERT(EdxloptypeScalar ==
 				pdxlnResult->GetOperator()->GetDXLOperatorType());
 
-	CExpression *pexprResult =
+	pexprResult =
 		m_trdxl2expr.PexprTranslateScalar(pdxlnResult, NULL /*colref_array*/);
+
+	// the given expression may have been allocated from a short-lived memory
+	// pool, so the cache key is translated back from its DXL instead
+	CExpression *pexprKey =
+		m_trdxl2expr.PexprTranslateScalar(pdxlnExpr, NULL /*colref_array*/);
+	pexprResult->AddRef();
+	if (!m_phmexprresult->Insert(pexprKey, pexprResult))
+	{
+		pexprKey->Release();
+		pexprResult->Release();
+	}
+
 	pdxlnResult->Release();
 	pdxlnExpr->Release();
 
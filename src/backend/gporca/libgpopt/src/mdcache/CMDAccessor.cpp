@@ -37,6 +37,7 @@
 #include "naucrates/md/IMDColStats.h"
 #include "naucrates/md/IMDFunction.h"
 #include "naucrates/md/IMDIndex.h"
+#include "naucrates/md/IMDMultiColStats.h"
 #include "naucrates/md/IMDProvider.h"
 #include "naucrates/md/IMDRelStats.h"
 #include "naucrates/md/IMDRelation.h"
@@ -511,12 +512,10 @@ CMDAccessor::GetImdObj(IMDId *mdid, IMDCacheObject::Emdtype mdtype)
 		IMDCacheObject *pmdobjNew = a_pmdcacc->Val();
 		if (NULL == pmdobjNew)
 		{
-			// object not found in MD cache: retrieve it from MD provider
+			// object not found in MD cache: retrieve it from MD provider;
+			// the fetch time is also used as the rebuild cost of the cache entry
 			CTimerUser timerFetch;
-			if (fPrintOptStats)
-			{
-				timerFetch.Restart();
-			}
+			timerFetch.Restart();
 			CAutoP<CWStringBase> a_pstr;
 			a_pstr = pmdp->GetMDObjDXLStr(m_mp, this, mdid, mdtype);
 
@@ -533,11 +532,11 @@ CMDAccessor::GetImdObj(IMDId *mdid, IMDCacheObject::Emdtype mdtype)
 				mp, a_pstr.Value(), NULL /* XSD path */);
 			GPOS_ASSERT(NULL != pmdobjNew);
 
+			ULONG ulFetchUS = timerFetch.ElapsedUS();
 			if (fPrintOptStats)
 			{
 				// add fetch time in msec
-				CDouble dFetch(timerFetch.ElapsedUS() /
-							   CDouble(GPOS_USEC_IN_MSEC));
+				CDouble dFetch(ulFetchUS / CDouble(GPOS_USEC_IN_MSEC));
 				m_dFetchTime = CDouble(m_dFetchTime.Get() + dFetch.Get());
 			}
 
@@ -561,7 +560,8 @@ CMDAccessor::GetImdObj(IMDId *mdid, IMDCacheObject::Emdtype mdtype)
 #ifdef GPOS_DEBUG
 				IMDCacheObject *pmdobjInserted =
 #endif
-					a_pmdcacc->Insert(a_pmdkeyCache.Value(), pmdobjNew);
+					a_pmdcacc->Insert(a_pmdkeyCache.Value(), pmdobjNew,
+									  pmdobjNew->MDType(), ulFetchUS);
 
 				GPOS_ASSERT(NULL != pmdobjInserted);
 
@@ -918,6 +918,34 @@ CMDAccessor::Pmdrelstats(IMDId *mdid)
 	return dynamic_cast<const IMDRelStats *>(pmdobj);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::RetrieveMultiColStats
+//
+//	@doc:
+//		Retrieves the statistics on groups of columns of the given relation
+//		from the md cache; relations without such statistics have an object
+//		without any groups
+//
+//---------------------------------------------------------------------------
+const IMDMultiColStats *
+CMDAccessor::RetrieveMultiColStats(IMDId *rel_mdid)
+{
+	CAutoRef<IMDId> mdid;
+	mdid = GPOS_NEW(m_mp) CMDIdGPDB(IMDId::EmdidMultiColStats,
+									CMDIdGPDB::CastMdid(rel_mdid)->Oid());
+
+	const IMDCacheObject *pmdobj =
+		GetImdObj(mdid.Value(), IMDCacheObject::EmdtMultiColStats);
+	if (IMDCacheObject::EmdtMultiColStats != pmdobj->MDType())
+	{
+		GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound,
+				   mdid->GetBuffer());
+	}
+
+	return dynamic_cast<const IMDMultiColStats *>(pmdobj);
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDAccessor::Pmdcast
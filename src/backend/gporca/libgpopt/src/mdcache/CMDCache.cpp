@@ -24,6 +24,15 @@ CMDAccessor::MDCache *CMDCache::m_pcache = NULL;
 // maximum size of the cache
 ULLONG CMDCache::m_ullCacheQuota = UNLIMITED_CACHE_QUOTA;
 
+// counters of destroyed cache instances
+SCacheClassStats CMDCache::m_rgstatsRetired[CCACHE_MAX_ENTRY_CLASSES];
+
+// number of cache resets
+ULLONG CMDCache::m_ullResetCounter = 0;
+
+// every mdtype needs its own statistics slot in the cache
+GPOS_CPL_ASSERT(IMDCacheObject::EmdtSentinel <= CCACHE_MAX_ENTRY_CLASSES);
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDCache::Init
@@ -54,6 +63,18 @@ CMDCache::Init()
 void
 CMDCache::Shutdown()
 {
+	if (NULL != m_pcache)
+	{
+		// keep the cumulative counters of the cache being destroyed
+		for (ULONG ul = 0; ul < CCACHE_MAX_ENTRY_CLASSES; ul++)
+		{
+			SCacheClassStats stats = m_pcache->GetClassStats(ul);
+			m_rgstatsRetired[ul].m_hits += stats.m_hits;
+			m_rgstatsRetired[ul].m_inserts += stats.m_inserts;
+			m_rgstatsRetired[ul].m_evictions += stats.m_evictions;
+		}
+	}
+
 	GPOS_DELETE(m_pcache);
 	m_pcache = NULL;
 }
@@ -109,6 +130,49 @@ CMDCache::ULLGetCacheEvictionCounter()
 	return m_pcache->GetEvictionCounter();
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::ULLGetCacheResetCounter
+//
+//	@doc:
+// 		Get the number of times the cache was reset
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDCache::ULLGetCacheResetCounter()
+{
+	return m_ullResetCounter;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDCache::GetStats
+//
+//	@doc:
+// 		Get the statistics of the cached objects of the given type. The
+//		number of entries and bytes refer to the current cache, while hits,
+//		inserts and evictions also include the caches destroyed by earlier
+//		resets
+//
+//---------------------------------------------------------------------------
+SCacheClassStats
+CMDCache::GetStats(IMDCacheObject::Emdtype mdtype)
+{
+	GPOS_ASSERT(CCACHE_MAX_ENTRY_CLASSES > (ULONG) mdtype);
+
+	SCacheClassStats stats;
+	if (NULL != m_pcache)
+	{
+		stats = m_pcache->GetClassStats(mdtype);
+	}
+
+	stats.m_hits += m_rgstatsRetired[mdtype].m_hits;
+	stats.m_inserts += m_rgstatsRetired[mdtype].m_inserts;
+	stats.m_evictions += m_rgstatsRetired[mdtype].m_evictions;
+
+	return stats;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDCache::Reset
@@ -127,6 +191,8 @@ CMDCache::Reset()
 
 	Shutdown();
 	Init();
+
+	m_ullResetCounter++;
 }
 
 // EOF
@@ -399,6 +399,13 @@ CExpressionHandle::DeriveRootStats(IStatisticsArray *stats_ctxt)
 	{
 		// otherwise, derive stats using root operator
 		pstatsRoot = popLogical->PstatsDerive(m_mp, *this, stats_ctxt);
+
+		if (NULL != m_pgexpr)
+		{
+			// correct the stats by the rows of earlier executions
+			pstatsRoot =
+				m_pgexpr->Pgroup()->PstatsApplyFeedback(m_mp, pstatsRoot);
+		}
 	}
 	GPOS_ASSERT(NULL != pstatsRoot);
 
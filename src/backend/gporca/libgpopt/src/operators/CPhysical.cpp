@@ -1198,6 +1198,48 @@ CPhysical::GetSkew(IStatistics *stats, CDistributionSpec *pds)
 	return CDouble(dSkew);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CPhysical::GetMaxValueFrequency
+//
+//	@doc:
+//		Helper to compute the frequency of the most frequent value of the
+//		hash key of given distribution spec. A key value is never more
+//		frequent than the values of any of its columns, so the smallest
+//		most common value frequency of the key columns is used; 0 is
+//		returned if no key column has statistics
+//
+//---------------------------------------------------------------------------
+CDouble
+CPhysical::GetMaxValueFrequency(IStatistics *stats, CDistributionSpec *pds)
+{
+	CDouble dMaxFreq = 0.0;
+	if (CDistributionSpec::EdtHashed == pds->Edt())
+	{
+		CDistributionSpecHashed *pdshashed =
+			CDistributionSpecHashed::PdsConvert(pds);
+		const CExpressionArray *pdrgpexpr = pdshashed->Pdrgpexpr();
+		const ULONG size = pdrgpexpr->Size();
+		for (ULONG ul = 0; ul < size; ul++)
+		{
+			CExpression *pexpr = (*pdrgpexpr)[ul];
+			if (COperator::EopScalarIdent == pexpr->Pop()->Eopid())
+			{
+				CScalarIdent *popScId = CScalarIdent::PopConvert(pexpr->Pop());
+				ULONG colid = popScId->Pcr()->Id();
+				CDouble dMaxFreqCol = stats->GetMaxValueFrequency(colid);
+				if (0.0 < dMaxFreqCol &&
+					(0.0 == dMaxFreq || dMaxFreqCol < dMaxFreq))
+				{
+					dMaxFreq = dMaxFreqCol;
+				}
+			}
+		}
+	}
+
+	return dMaxFreq;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CPhysical::FChildrenHaveCompatibleDistributions
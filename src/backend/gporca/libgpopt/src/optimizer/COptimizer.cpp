@@ -224,6 +224,10 @@ COptimizer::PrintQueryOrPlan(CMemoryPool *mp, CExpression *pexpr,
 //		the function is oblivious of trace flags setting/resetting which
 //		must happen at the caller side if needed
 //
+//		If a plan translator is given and it supports the plan, the plan is
+//		not translated into DXL and NULL is returned. Minidumps always get
+//		the DXL plan.
+//
 //---------------------------------------------------------------------------
 CDXLNode *
 COptimizer::PdxlnOptimize(
@@ -233,7 +237,8 @@ COptimizer::PdxlnOptimize(
 	ULONG ulHosts,	// actual number of data nodes in the system
 	ULONG ulSessionId, ULONG ulCmdId, CSearchStageArray *search_stage_array,
 	COptimizerConfig *optimizer_config,
-	const CHAR *szMinidumpFileName	// name of minidump file to be created
+	const CHAR *szMinidumpFileName,	 // name of minidump file to be created
+	IPlanTranslator *plan_translator  // translator of the plan, if any
 )
 {
 	GPOS_ASSERT(NULL != md_accessor);
@@ -317,9 +322,17 @@ COptimizer::PdxlnOptimize(
 			CExpression *pexprPlan = PexprOptimize(mp, pqc, search_stage_array);
 			GPOS_CHECK_ABORT;
 
-			// translate plan into DXL
-			pdxlnPlan = CreateDXLNode(mp, md_accessor, pexprPlan,
-									  pqc->PdrgPcr(), pdrgpmdname, ulHosts);
+			// translate plan into DXL, unless the caller translates it
+			// directly
+			BOOL fTranslated =
+				NULL != plan_translator && !fMinidump &&
+				plan_translator->FTranslate(pexprPlan, pqc->PdrgPcr(),
+											pdrgpmdname);
+			if (!fTranslated)
+			{
+				pdxlnPlan = CreateDXLNode(mp, md_accessor, pexprPlan,
+										  pqc->PdrgPcr(), pdrgpmdname, ulHosts);
+			}
 			GPOS_CHECK_ABORT;
 
 			if (fMinidump)
@@ -153,6 +153,12 @@ COptimizerConfig::Serialize(CMemoryPool *mp, CXMLSerializer *xml_serializer,
 	xml_serializer->AddAttribute(
 		CDXLTokens::GetDXLTokenStr(EdxltokenMaxStatsBuckets),
 		m_stats_conf->UlMaxStatsBuckets());
+	if (0 != m_stats_conf->UlMaxDerivedStatsBuckets())
+	{
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenMaxDerivedStatsBuckets),
+			m_stats_conf->UlMaxDerivedStatsBuckets());
+	}
 	xml_serializer->CloseElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenStatisticsConfig));
@@ -210,6 +216,12 @@ COptimizerConfig::Serialize(CMemoryPool *mp, CXMLSerializer *xml_serializer,
 	xml_serializer->AddAttribute(
 		CDXLTokens::GetDXLTokenStr(gpdxl::EdxltokenSkewFactor),
 		m_hint->UlSkewFactor());
+	xml_serializer->AddAttribute(
+		CDXLTokens::GetDXLTokenStr(EdxltokenQueryMemoryKB),
+		m_hint->UlQueryMemoryKB());
+	xml_serializer->AddAttribute(
+		CDXLTokens::GetDXLTokenStr(EdxltokenMemoryIntensiveOperators),
+		m_hint->UlMemoryIntensiveOperators());
 	xml_serializer->CloseElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenHint));
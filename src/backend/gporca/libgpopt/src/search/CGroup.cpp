@@ -20,15 +20,30 @@
 #include "gpopt/base/CDrvdProp.h"
 #include "gpopt/base/CDrvdPropCtxtPlan.h"
 #include "gpopt/base/CDrvdPropCtxtRelational.h"
+#include "gpopt/base/CDrvdPropScalar.h"
+#include "gpopt/base/COptCtxt.h"
 #include "gpopt/base/COptimizationContext.h"
 #include "gpopt/exception.h"
+#include "gpopt/base/CColRefTable.h"
+#include "gpopt/base/CUtils.h"
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CLogicalCTEConsumer.h"
 #include "gpopt/operators/CLogicalCTEProducer.h"
+#include "gpopt/operators/CLogicalDynamicGet.h"
+#include "gpopt/operators/CLogicalGbAgg.h"
+#include "gpopt/operators/CLogicalGet.h"
 #include "gpopt/operators/CLogicalInnerJoin.h"
 #include "gpopt/operators/COperator.h"
+#include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/operators/CPhysicalMotionGather.h"
+#include "gpopt/operators/CScalarBoolOp.h"
+#include "gpopt/operators/CScalarCmp.h"
+#include "gpopt/operators/CScalarConst.h"
+#include "gpopt/operators/CScalarFunc.h"
+#include "gpopt/operators/CScalarIdent.h"
+#include "gpopt/operators/CScalarOp.h"
 #include "gpopt/operators/CScalarSubquery.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
 #include "gpopt/search/CGroupProxy.h"
 #include "gpopt/search/CJobGroup.h"
 #include "naucrates/statistics/CStatistics.h"
@@ -172,7 +187,12 @@ CGroup::CGroup(CMemoryPool *mp, BOOL fScalar)
 	  m_eolMax(EolLow),
 	  m_fHasNewLogicalOperators(false),
 	  m_ulCTEProducerId(gpos::ulong_max),
-	  m_fCTEConsumer(false)
+	  m_fCTEConsumer(false),
+	  m_fFeedbackKeyDerived(false),
+	  m_fFeedbackKeyValid(false),
+	  m_ullFeedbackRels(0),
+	  m_ullFeedbackPreds(0),
+	  m_fUsedFeedback(false)
 {
 	GPOS_ASSERT(NULL != mp);
 
@@ -693,6 +713,30 @@ CGroup::PgexprAnyCTEConsumer()
 	return NULL;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::UlReusedCosts
+//
+//	@doc:
+//		Return the number of cost contexts of the group expressions whose
+//		cost was reused from an equivalent context
+//
+//---------------------------------------------------------------------------
+ULONG
+CGroup::UlReusedCosts()
+{
+	ULONG ulReused = 0;
+	CGroupExpression *pgexpr = m_listGExprs.First();
+	while (NULL != pgexpr)
+	{
+		ulReused += pgexpr->UlReusedCosts();
+		pgexpr = m_listGExprs.Next(pgexpr);
+	}
+
+	return ulReused;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CGroup::PgexprFirst
@@ -2010,6 +2054,7 @@ CGroup::PstatsCompute(COptimizationContext *poc, CExpressionHandle &exprhdl,
 	stats = CLogical::PopConvert(pgexpr->Pop())
 				->PstatsDerive(m_mp, exprhdl, poc->Pdrgpstat());
 	GPOS_ASSERT(NULL != stats);
+	stats = PstatsApplyFeedback(m_mp, stats);
 
 	// add computed stats to local map
 	poc->AddRef();
@@ -2023,6 +2068,397 @@ CGroup::PstatsCompute(COptimizationContext *poc, CExpressionHandle &exprhdl,
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CombineFeedbackHashes
+//
+//	@doc:
+//		Combine two 64-bit hashes of cardinality feedback keys; every bit of
+//		the result depends on every bit of the inputs
+//
+//---------------------------------------------------------------------------
+static ULLONG
+CombineFeedbackHashes(ULLONG hash1, ULLONG hash2)
+{
+	ULLONG hash = hash1 ^ (hash2 + (ULLONG) 0x9e3779b97f4a7c15 +
+						   (hash1 << 6) + (hash1 >> 2));
+
+	// 64-bit finalizer of MurmurHash3
+	hash ^= hash >> 33;
+	hash *= (ULLONG) 0xff51afd7ed558ccd;
+	hash ^= hash >> 33;
+	hash *= (ULLONG) 0xc4ceb9fe1a85ec53;
+	hash ^= hash >> 33;
+
+	return hash;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::FFeedbackKey
+//
+//	@doc:
+//		Cardinality feedback key of the group, which identifies it across
+//		queries and executions by the set of base relations and the set of
+//		predicates and aggregations it is computed from. The executor
+//		records the rows produced by the plan nodes of the group under this
+//		key. Groups with outer references, or computed by operators other
+//		than gets, selects, joins, projects and aggregates, have no key.
+//		Neither have scans of partitioned tables, since the rows they
+//		produce depend on the partitions eliminated at run time.
+//
+//		The high half of the key locates the observation in the feedback
+//		store, the low half is a fingerprint checked on lookup.
+//
+//---------------------------------------------------------------------------
+BOOL
+CGroup::FFeedbackKey(ULLONG *pullKey)
+{
+	GPOS_ASSERT(NULL != pullKey);
+
+	ULLONG ullRels = 0;
+	ULLONG ullPreds = 0;
+	if (FScalar() || !FDeriveFeedbackKey(&ullRels, &ullPreds))
+	{
+		return false;
+	}
+
+	CGroupExpression *pgexpr = NULL;
+	{
+		CGroupProxy gp(this);
+		pgexpr = gp.PgexprFirst();
+	}
+
+	COperator *pop = pgexpr->Pop();
+	if (COperator::EopLogicalDynamicGet == pop->Eopid() ||
+		(COperator::EopLogicalGet == pop->Eopid() &&
+		 CLogicalGet::PopConvert(pop)->Ptabdesc()->IsPartitioned()))
+	{
+		return false;
+	}
+
+	// zero is reserved for plan nodes without a key
+	*pullKey = CombineFeedbackHashes(ullRels, ullPreds);
+	if (0 == (*pullKey >> 32))
+	{
+		*pullKey |= ((ULLONG) 1) << 32;
+	}
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::FDeriveFeedbackKey
+//
+//	@doc:
+//		Derive the components of the cardinality feedback key from the first
+//		logical group expression. Relations and predicates are combined by
+//		addition so that all the join orders of a set of relations, and a
+//		predicate applied by a select or by a join, lead to the same key.
+//
+//---------------------------------------------------------------------------
+BOOL
+CGroup::FDeriveFeedbackKey(ULLONG *pullRels, ULLONG *pullPreds)
+{
+	GPOS_ASSERT(!FScalar());
+
+	if (m_fFeedbackKeyDerived)
+	{
+		*pullRels = m_ullFeedbackRels;
+		*pullPreds = m_ullFeedbackPreds;
+		return m_fFeedbackKeyValid;
+	}
+	m_fFeedbackKeyDerived = true;
+
+	CGroupExpression *pgexpr = NULL;
+	{
+		CGroupProxy gp(this);
+		pgexpr = gp.PgexprFirst();
+	}
+
+	if (NULL == pgexpr || !pgexpr->Pop()->FLogical() ||
+		0 < CDrvdPropRelational::GetRelationalProperties(Pdp())
+				->GetOuterReferences()
+				->Size())
+	{
+		return false;
+	}
+
+	COperator *pop = pgexpr->Pop();
+	ULLONG ullRels = 0;
+	ULLONG ullPreds = 0;
+	switch (pop->Eopid())
+	{
+		case COperator::EopLogicalGet:
+			ullRels = CombineFeedbackHashes(
+				pop->Eopid(),
+				CLogicalGet::PopConvert(pop)->Ptabdesc()->MDId()->HashValue());
+			break;
+
+		case COperator::EopLogicalDynamicGet:
+			ullRels = CombineFeedbackHashes(pop->Eopid(),
+											CLogicalDynamicGet::PopConvert(pop)
+												->Ptabdesc()
+												->MDId()
+												->HashValue());
+			break;
+
+		case COperator::EopLogicalSelect:
+		case COperator::EopLogicalProject:
+		case COperator::EopLogicalGbAgg:
+		case COperator::EopLogicalInnerJoin:
+		case COperator::EopLogicalNAryJoin:
+		case COperator::EopLogicalLeftOuterJoin:
+		case COperator::EopLogicalLeftSemiJoin:
+		case COperator::EopLogicalLeftAntiSemiJoin:
+		case COperator::EopLogicalLeftAntiSemiJoinNotIn:
+		{
+			const BOOL fInner = COperator::EopLogicalSelect == pop->Eopid() ||
+								COperator::EopLogicalInnerJoin == pop->Eopid() ||
+								COperator::EopLogicalNAryJoin == pop->Eopid();
+			const ULONG arity = pgexpr->Arity();
+			for (ULONG ul = 0; ul < arity; ul++)
+			{
+				CGroup *pgroupChild = (*pgexpr)[ul];
+				if (!pgroupChild->FScalar())
+				{
+					ULLONG ullChildRels = 0;
+					ULLONG ullChildPreds = 0;
+					if (!pgroupChild->FDeriveFeedbackKey(&ullChildRels,
+														 &ullChildPreds))
+					{
+						return false;
+					}
+					ullRels += ullChildRels;
+					ullPreds += ullChildPreds;
+					continue;
+				}
+
+				if (COperator::EopLogicalProject == pop->Eopid() ||
+					COperator::EopLogicalGbAgg == pop->Eopid())
+				{
+					// project lists do not change the rows, unless they
+					// call set-returning functions
+					if (CDrvdPropScalar::GetDrvdScalarProps(
+							pgroupChild->Pdp())
+							->HasNonScalarFunction())
+					{
+						return false;
+					}
+					continue;
+				}
+
+				CExpression *pexprScalar = pgroupChild->PexprScalarRep();
+				if (NULL == pexprScalar)
+				{
+					return false;
+				}
+
+				// the predicates of inner joins and selects are keyed by
+				// conjunct, the ones of other joins by the join type too
+				ULLONG ullHash = 0;
+				if (fInner && CPredicateUtils::FAnd(pexprScalar))
+				{
+					const ULONG ulConjuncts = pexprScalar->Arity();
+					for (ULONG ulConj = 0; ulConj < ulConjuncts; ulConj++)
+					{
+						ullHash +=
+							UllFeedbackHashScalar((*pexprScalar)[ulConj]);
+					}
+				}
+				else if (!CUtils::FScalarConstTrue(pexprScalar))
+				{
+					ullHash = UllFeedbackHashScalar(pexprScalar);
+				}
+
+				if (!fInner)
+				{
+					ullHash = CombineFeedbackHashes(pop->Eopid(), ullHash);
+				}
+				ullPreds += ullHash;
+			}
+
+			if (COperator::EopLogicalGbAgg == pop->Eopid())
+			{
+				CLogicalGbAgg *popAgg = CLogicalGbAgg::PopConvert(pop);
+				ULLONG ullGrpCols = 0;
+				const CColRefArray *pdrgpcr = popAgg->Pdrgpcr();
+				for (ULONG ul = 0; ul < pdrgpcr->Size(); ul++)
+				{
+					ullGrpCols += UllFeedbackHashColRef((*pdrgpcr)[ul]);
+				}
+				ullPreds = CombineFeedbackHashes(
+					ullPreds,
+					CombineFeedbackHashes(
+						CombineFeedbackHashes(pop->Eopid(),
+											  popAgg->Egbaggtype()),
+						ullGrpCols));
+			}
+			break;
+		}
+
+		default:
+			return false;
+	}
+
+	m_fFeedbackKeyValid = true;
+	m_ullFeedbackRels = ullRels;
+	m_ullFeedbackPreds = ullPreds;
+	*pullRels = ullRels;
+	*pullPreds = ullPreds;
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::UllFeedbackHashColRef
+//
+//	@doc:
+//		Hash of a column for cardinality feedback keys; table columns are
+//		identified by their table and attribute number
+//
+//---------------------------------------------------------------------------
+ULLONG
+CGroup::UllFeedbackHashColRef(const CColRef *colref)
+{
+	if (CColRef::EcrtTable == colref->Ecrt() && NULL != colref->GetMdidTable())
+	{
+		const CColRefTable *colref_table =
+			CColRefTable::PcrConvert(const_cast<CColRef *>(colref));
+		return CombineFeedbackHashes(colref->GetMdidTable()->HashValue(),
+									 (ULONG) colref_table->AttrNum());
+	}
+
+	return CombineFeedbackHashes(colref->Ecrt(), colref->Id());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::UllFeedbackHashScalar
+//
+//	@doc:
+//		Hash of a scalar expression for cardinality feedback keys, built from
+//		the columns, constants and operator ids in the expression
+//
+//---------------------------------------------------------------------------
+ULLONG
+CGroup::UllFeedbackHashScalar(CExpression *pexpr)
+{
+	COperator *pop = pexpr->Pop();
+	ULLONG ullHash = pop->Eopid();
+	switch (pop->Eopid())
+	{
+		case COperator::EopScalarIdent:
+			ullHash = CombineFeedbackHashes(
+				ullHash,
+				UllFeedbackHashColRef(CScalarIdent::PopConvert(pop)->Pcr()));
+			break;
+
+		case COperator::EopScalarConst:
+		{
+			IDatum *datum = CScalarConst::PopConvert(pop)->GetDatum();
+			ullHash = CombineFeedbackHashes(
+				CombineFeedbackHashes(ullHash, datum->MDId()->HashValue()),
+				datum->HashValue());
+			break;
+		}
+
+		case COperator::EopScalarCmp:
+			ullHash = CombineFeedbackHashes(
+				ullHash, CScalarCmp::PopConvert(pop)->MdIdOp()->HashValue());
+			break;
+
+		case COperator::EopScalarOp:
+			ullHash = CombineFeedbackHashes(
+				ullHash, CScalarOp::PopConvert(pop)->MdIdOp()->HashValue());
+			break;
+
+		case COperator::EopScalarFunc:
+			ullHash = CombineFeedbackHashes(
+				ullHash, CScalarFunc::PopConvert(pop)->FuncMdId()->HashValue());
+			break;
+
+		default:
+			break;
+	}
+
+	const BOOL fBoolOp = COperator::EopScalarBoolOp == pop->Eopid();
+	if (fBoolOp)
+	{
+		ullHash = CombineFeedbackHashes(
+			ullHash, CScalarBoolOp::PopConvert(pop)->Eboolop());
+	}
+
+	ULLONG ullChildren = 0;
+	const ULONG arity = pexpr->Arity();
+	for (ULONG ul = 0; ul < arity; ul++)
+	{
+		ULLONG ullChild = UllFeedbackHashScalar((*pexpr)[ul]);
+		if (fBoolOp)
+		{
+			ullChildren += ullChild;
+		}
+		else
+		{
+			ullChildren = CombineFeedbackHashes(ullChildren, ullChild);
+		}
+	}
+
+	return CombineFeedbackHashes(ullHash, ullChildren);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::PstatsApplyFeedback
+//
+//	@doc:
+//		Scale the given stats of the group to the number of rows observed
+//		when executing earlier plans, if any; takes ownership of the given
+//		stats
+//
+//---------------------------------------------------------------------------
+IStatistics *
+CGroup::PstatsApplyFeedback(CMemoryPool *mp, IStatistics *stats)
+{
+	GPOS_ASSERT(NULL != stats);
+
+	CStatisticsConfig *stats_config =
+		COptCtxt::PoctxtFromTLS()->GetOptimizerConfig()->GetStatsConf();
+	ULLONG ullKey = 0;
+	if (!stats_config->FCardinalityFeedback() || !FFeedbackKey(&ullKey))
+	{
+		return stats;
+	}
+
+	const CDouble *pdRows = stats_config->PdCardinalityFeedback(ullKey);
+	if (NULL == pdRows)
+	{
+		return stats;
+	}
+
+	CDouble rows = std::max(CStatistics::MinRows.Get(), pdRows->Get());
+	CDouble factor =
+		rows / std::max(CStatistics::MinRows.Get(), stats->Rows().Get());
+	IStatistics *pstatsScaled = stats->ScaleStats(mp, factor);
+	stats->Release();
+
+	if (!m_fUsedFeedback)
+	{
+		m_fUsedFeedback = true;
+		stats_config->IncrementFeedbackGroups();
+	}
+
+	return pstatsScaled;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CGroup::OsPrint
@@ -63,6 +63,8 @@ CGroupExpression::CGroupExpression(CMemoryPool *mp, COperator *pop,
 	  m_estate(estUnexplored),
 	  m_eol(EolLow),
 	  m_ppartialplancostmap(NULL),
+	  m_pchildctxtcostmap(NULL),
+	  m_ulReusedCosts(0),
 	  m_ecirculardependency(ecdDefault)
 {
 	GPOS_ASSERT(NULL != pop);
@@ -80,6 +82,7 @@ CGroupExpression::CGroupExpression(CMemoryPool *mp, COperator *pop,
 	}
 
 	m_ppartialplancostmap = GPOS_NEW(mp) PartialPlanToCostMap(mp);
+	m_pchildctxtcostmap = GPOS_NEW(mp) ChildContextsToCostMap(mp);
 
 	// initialize cost contexts hash table
 	m_sht.Init(mp, GPOPT_COSTCTXT_HT_BUCKETS, GPOS_OFFSET(CCostContext, m_link),
@@ -108,6 +111,7 @@ CGroupExpression::~CGroupExpression()
 
 		CRefCount::SafeRelease(m_pdrgpgroupSorted);
 		m_ppartialplancostmap->Release();
+		m_pchildctxtcostmap->Release();
 	}
 }
 
@@ -457,8 +461,7 @@ CGroupExpression::PccComputeCost(
 		fValid = pcc->IsValid(mp);
 		if (fValid)
 		{
-			CCost cost = CostCompute(mp, pcc);
-			pcc->SetCost(cost);
+			SetContextCost(mp, pcc);
 		}
 		GPOS_ASSERT_IMP(COptCtxt::FAllEnforcersEnabled(),
 						fValid && "Cost context carries an invalid plan");
@@ -559,18 +562,17 @@ CGroupExpression::ResetState()
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CGroupExpression::CostCompute
+//		CGroupExpression::PdrgpcostChildren
 //
 //	@doc:
-//		Costing scheme.
+//		Best costs of the child contexts of the given cost context
 //
 //---------------------------------------------------------------------------
-CCost
-CGroupExpression::CostCompute(CMemoryPool *mp, CCostContext *pcc) const
+CCostArray *
+CGroupExpression::PdrgpcostChildren(CMemoryPool *mp, CCostContext *pcc)
 {
 	GPOS_ASSERT(NULL != pcc);
 
-	// prepare cost array
 	COptimizationContextArray *pdrgpoc = pcc->Pdrgpoc();
 	CCostArray *pdrgpcostChildren = GPOS_NEW(mp) CCostArray(mp);
 	const ULONG length = pdrgpoc->Size();
@@ -581,6 +583,59 @@ CGroupExpression::CostCompute(CMemoryPool *mp, CCostContext *pcc) const
 									  CCost(pocChild->PccBest()->Cost()));
 	}
 
+	return pdrgpcostChildren;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroupExpression::FEqualCosts
+//
+//	@doc:
+//		Check if two arrays of child costs are equal
+//
+//---------------------------------------------------------------------------
+BOOL
+CGroupExpression::FEqualCosts(const CCostArray *pdrgpcostFst,
+							  const CCostArray *pdrgpcostSnd)
+{
+	GPOS_ASSERT(NULL != pdrgpcostFst);
+	GPOS_ASSERT(NULL != pdrgpcostSnd);
+
+	const ULONG length = pdrgpcostFst->Size();
+	if (length != pdrgpcostSnd->Size())
+	{
+		return false;
+	}
+
+	for (ULONG ul = 0; ul < length; ul++)
+	{
+		// exact comparison, a reused cost must equal the recomputed one
+		if ((*pdrgpcostFst)[ul]->Get() != (*pdrgpcostSnd)[ul]->Get())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroupExpression::CostCompute
+//
+//	@doc:
+//		Costing scheme.
+//
+//---------------------------------------------------------------------------
+CCost
+CGroupExpression::CostCompute(CMemoryPool *mp, CCostContext *pcc) const
+{
+	GPOS_ASSERT(NULL != pcc);
+
+	// prepare cost array
+	CCostArray *pdrgpcostChildren = PdrgpcostChildren(mp, pcc);
 	CCost cost = pcc->CostCompute(mp, pdrgpcostChildren);
 	pdrgpcostChildren->Release();
 
@@ -588,6 +643,73 @@ CGroupExpression::CostCompute(CMemoryPool *mp, CCostContext *pcc) const
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroupExpression::SetContextCost
+//
+//	@doc:
+//		Compute and set the cost of the given context, unless an earlier
+//		context of the group expression was created from the same child
+//		contexts while they had the same best costs. Different optimization
+//		requests often collapse to the same child contexts, e.g. hash join
+//		redistribution requests that end up with identical specs; the plans
+//		they carry are the same and are costed once.
+//
+//---------------------------------------------------------------------------
+void
+CGroupExpression::SetContextCost(CMemoryPool *mp, CCostContext *pcc)
+{
+	GPOS_ASSERT(NULL != pcc);
+
+	COptimizationContextArray *pdrgpoc = pcc->Pdrgpoc();
+	CColRefSet *pcrsRequired = pcc->Poc()->Prpp()->PcrsRequired();
+
+	// stats affected by partition selection depend on the required
+	// properties, and so does the cost computed from them
+	if (NULL == pdrgpoc || pcc->FNeedsNewStats())
+	{
+		pcc->SetCost(CostCompute(mp, pcc));
+		return;
+	}
+
+	CCostArray *pdrgpcostChildren = PdrgpcostChildren(mp, pcc);
+	SChildContextsCost *pcost = m_pchildctxtcostmap->Find(pdrgpoc);
+	if (NULL != pcost && pcrsRequired->Equals(pcost->m_pcrsRequired) &&
+		FEqualCosts(pdrgpcostChildren, pcost->m_pdrgpcostChildren))
+	{
+		m_ulReusedCosts++;
+		pcc->ReuseCost(pcost->m_cost);
+		GPOS_ASSERT(pcost->m_cost.Get() ==
+						pcc->CostCompute(mp, pdrgpcostChildren).Get() &&
+					"Reused cost differs from the computed cost");
+		pdrgpcostChildren->Release();
+		return;
+	}
+
+	CCost cost = pcc->CostCompute(mp, pdrgpcostChildren);
+	pcc->SetCost(cost);
+	if (NULL == pcost)
+	{
+		pdrgpoc->AddRef();
+		pcrsRequired->AddRef();
+		(void) m_pchildctxtcostmap->Insert(
+			pdrgpoc, GPOS_NEW(mp) SChildContextsCost(pcrsRequired,
+													 pdrgpcostChildren, cost));
+	}
+	else if (pcrsRequired->Equals(pcost->m_pcrsRequired))
+	{
+		// a child context found a better plan since the cost was computed
+		pcost->m_pdrgpcostChildren->Release();
+		pcost->m_pdrgpcostChildren = pdrgpcostChildren;
+		pcost->m_cost = cost;
+	}
+	else
+	{
+		pdrgpcostChildren->Release();
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CGroupExpression::FTransitioned
@@ -425,6 +425,32 @@ CMemo::Pgroup(ULONG id)
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::OsPrintFeedbackGroups
+//
+//	@doc:
+//		Print the ids of the groups whose stats were corrected by
+//		cardinality feedback
+//
+//---------------------------------------------------------------------------
+IOstream &
+CMemo::OsPrintFeedbackGroups(IOstream &os) const
+{
+	CGroup *pgroup = m_listGroups.PtFirst();
+	while (NULL != pgroup)
+	{
+		if (pgroup->FUsedFeedback())
+		{
+			os << " " << pgroup->Id();
+		}
+		pgroup = m_listGroups.Next(pgroup);
+	}
+
+	return os;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemo::MarkDuplicates
@@ -785,6 +811,30 @@ CMemo::UlDuplicateGroups()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::UlReusedCosts
+//
+//	@doc:
+//		Return number of cost contexts whose cost was reused from an
+//		equivalent context
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemo::UlReusedCosts()
+{
+	ULONG ulReused = 0;
+	CGroup *pgroup = m_listGroups.PtFirst();
+	while (NULL != pgroup)
+	{
+		ulReused += pgroup->UlReusedCosts();
+		pgroup = m_listGroups.Next(pgroup);
+	}
+
+	return ulReused;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemo::UlGrpExprs
@@ -32,6 +32,8 @@
 #include "gpopt/operators/CPhysicalIndexOnlyScan.h"
 #include "gpopt/operators/CPhysicalMotionRandom.h"
 #include "gpopt/operators/CPredicateUtils.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/search/CGroupExpression.h"
 #include "gpopt/translate/CTranslatorDXLToExpr.h"
 #include "gpopt/translate/CTranslatorExprToDXLUtils.h"
 #include "naucrates/base/CDatumBoolGPDB.h"
@@ -7683,6 +7685,24 @@ CTranslatorExprToDXL::GetProperties(const CExpression *pexpr)
 	CDXLPhysicalProperties *dxl_properties =
 		GPOS_NEW(m_mp) CDXLPhysicalProperties(cost);
 
+	// tag the node with the cardinality feedback key of its group, so that
+	// the executor can record the rows it produces. Motions and replicated
+	// nodes produce a different number of rows than their group.
+	ULLONG feedback_key = 0;
+	if (COptCtxt::PoctxtFromTLS()
+			->GetOptimizerConfig()
+			->GetStatsConf()
+			->FCardinalityFeedback() &&
+		NULL != pexpr->Pgexpr() && !CUtils::FPhysicalMotion(pexpr->Pop()) &&
+		CDistributionSpec::EdtStrictReplicated !=
+			pexpr->GetDrvdPropPlan()->Pds()->Edt() &&
+		CDistributionSpec::EdtTaintedReplicated !=
+			pexpr->GetDrvdPropPlan()->Pds()->Edt() &&
+		pexpr->Pgexpr()->Pgroup()->FFeedbackKey(&feedback_key))
+	{
+		dxl_properties->SetFeedbackKey(feedback_key);
+	}
+
 	return dxl_properties;
 }
 
@@ -40,6 +40,13 @@
 // eligible to delete
 #define EXPECTED_REF_COUNT_FOR_DELETE 1
 
+// no. of entry classes the cache keeps statistics for
+#define CCACHE_MAX_ENTRY_CLASSES 16
+
+// upper bound of an entry's gclock counter, as a multiple of the
+// initial gclock counter of the cache
+#define CCACHE_GCLOCK_MAX_WEIGHT 4
+
 using namespace gpos;
 
 namespace gpos
@@ -48,6 +55,38 @@ namespace gpos
 template <class T, class K>
 class CCacheAccessor;
 
+//---------------------------------------------------------------------------
+//	@struct:
+//		SCacheClassStats
+//
+//	@doc:
+//		Statistics of the cache entries belonging to one entry class
+//
+//---------------------------------------------------------------------------
+struct SCacheClassStats
+{
+	// number of lookups that found an entry
+	ULLONG m_hits;
+
+	// number of entries inserted, i.e. objects built after a failed lookup
+	ULLONG m_inserts;
+
+	// number of entries evicted to stay within the cache quota
+	ULLONG m_evictions;
+
+	// number of entries currently in the cache
+	ULLONG m_entries;
+
+	// total size in bytes of the entries currently in the cache
+	ULLONG m_bytes;
+
+	// ctor
+	SCacheClassStats()
+		: m_hits(0), m_inserts(0), m_evictions(0), m_entries(0), m_bytes(0)
+	{
+	}
+};
+
 //---------------------------------------------------------------------------
 //	@class:
 //		CCache
@@ -64,7 +103,13 @@ class CCacheAccessor;
 //		objects.
 //
 //		Cache can only be accessed through the CCacheAccessor friend class.
-//		The current implementation has a fixed gclock based eviction policy.
+//		The current implementation has a gclock based eviction policy. Every
+//		access resets the gclock counter of an entry to its weight, which is
+//		derived from the cost of rebuilding the entry per byte it occupies,
+//		relative to the average of the cache. Large objects that are cheap to
+//		rebuild are therefore evicted before small, expensive ones. Entries
+//		inserted without a rebuild cost get the initial gclock counter of the
+//		cache.
 //
 //---------------------------------------------------------------------------
 template <class T, class K>
@@ -109,6 +154,14 @@ private:
 	// number of times cache entries were evicted
 	ULLONG m_eviction_counter;
 
+	// total rebuild cost and size of all entries inserted with a known
+	// rebuild cost; used to compute the average rebuild cost per byte
+	ULLONG m_total_rebuild_cost;
+	ULLONG m_total_costed_size;
+
+	// statistics per entry class
+	SCacheClassStats m_class_stats[CCACHE_MAX_ENTRY_CLASSES];
+
 	// if the gclock hand was already advanced and therefore can serve the next entry
 	BOOL m_clock_hand_advanced;
 
@@ -124,6 +177,74 @@ private:
 	// the clock hand for gclock eviction policy
 	CCacheHashtableIter *m_clock_hand;
 
+	// returns the statistics slot of the given entry class
+	SCacheClassStats &
+	ClassStats(ULONG entry_class)
+	{
+		GPOS_ASSERT(entry_class < CCACHE_MAX_ENTRY_CLASSES);
+
+		if (CCACHE_MAX_ENTRY_CLASSES <= entry_class)
+		{
+			entry_class = CCACHE_MAX_ENTRY_CLASSES - 1;
+		}
+
+		return m_class_stats[entry_class];
+	}
+
+	// computes the gclock weight of a new entry from its rebuild cost per
+	// byte, relative to the average rebuild cost per byte of the cache
+	ULONG
+	ComputeGClockWeight(ULLONG rebuild_cost, ULLONG size)
+	{
+		ULONG weight = m_gclock_init_counter;
+
+		if (0 != rebuild_cost && 0 != size && 0 != m_total_costed_size &&
+			0 != m_total_rebuild_cost)
+		{
+			double avg_cost_per_byte =
+				static_cast<double>(m_total_rebuild_cost) /
+				static_cast<double>(m_total_costed_size);
+			double cost_per_byte = static_cast<double>(rebuild_cost) /
+								   static_cast<double>(size);
+			double scaled = static_cast<double>(m_gclock_init_counter) *
+								cost_per_byte / avg_cost_per_byte +
+							0.5;
+			ULONG max_weight = m_gclock_init_counter * CCACHE_GCLOCK_MAX_WEIGHT;
+
+			if (scaled < 1.0)
+			{
+				weight = 1;
+			}
+			else if (scaled > static_cast<double>(max_weight))
+			{
+				weight = max_weight;
+			}
+			else
+			{
+				weight = static_cast<ULONG>(scaled);
+			}
+		}
+
+		if (0 != rebuild_cost)
+		{
+			m_total_rebuild_cost += rebuild_cost;
+			m_total_costed_size += size;
+		}
+
+		return weight;
+	}
+
+	// accounts for an entry leaving the cache
+	void
+	RemoveEntrySize(CCacheHashTableEntry *entry)
+	{
+		SCacheClassStats &stats = ClassStats(entry->GetEntryClass());
+
+		m_cache_size -= entry->GetSize();
+		stats.m_bytes -= entry->GetSize();
+		stats.m_entries--;
+	}
+
 	// inserts a new object
 	CCacheHashTableEntry *
 	InsertEntry(CCacheHashTableEntry *entry)
@@ -188,15 +309,24 @@ private:
 		CCacheHashTableEntry *found = NULL;
 		if (!m_unique || (m_unique && NULL == (found = acc.Find())))
 		{
+			ULLONG size = entry->Pmp()->TotalAllocatedSize();
+			SCacheClassStats &stats = ClassStats(entry->GetEntryClass());
+
+			entry->SetSize(size);
+			entry->SetGClockInitCounter(
+				ComputeGClockWeight(entry->GetRebuildCost(), size));
 			acc.Insert(entry);
-			m_cache_size += entry->Pmp()->TotalAllocatedSize();
+			m_cache_size += size;
+			stats.m_inserts++;
+			stats.m_entries++;
+			stats.m_bytes += size;
 		}
 		else
 		{
 			ret = found;
 		}
 
-		ret->SetGClockCounter(m_gclock_init_counter);
+		ret->SetGClockCounter(ret->GetGClockInitCounter());
 		ret->IncRefCount();
 
 		return ret;
@@ -217,7 +347,8 @@ private:
 
 		if (NULL != entry)
 		{
-			entry->SetGClockCounter(m_gclock_init_counter);
+			ClassStats(entry->GetEntryClass()).m_hits++;
+			entry->SetGClockCounter(entry->GetGClockInitCounter());
 			// increase ref count, since CCacheHashtableAccessor points to the obj
 			// ref count will be decreased when CCacheHashtableAccessor will be destroyed
 			entry->IncRefCount();
@@ -251,6 +382,7 @@ private:
 			{
 				// remove entry from hash table
 				acc.Remove(entry);
+				RemoveEntrySize(entry);
 				deleted = true;
 			}
 		}
@@ -308,8 +440,12 @@ private:
 
 			// retryCount indicates the number of times we want to circle around the buckets.
 			// depending on our previous cursor position (e.g., may be at the very last bucket)
-			// we may end up circling 1 less time than the retry count
-			for (ULONG retry_count = 0; retry_count < m_gclock_init_counter + 1;
+			// we may end up circling 1 less time than the retry count. Entries
+			// can be weighted up to CCACHE_GCLOCK_MAX_WEIGHT times the initial
+			// counter, so that many passes are needed to age them out
+			ULONG max_retries =
+				m_gclock_init_counter * CCACHE_GCLOCK_MAX_WEIGHT + 1;
+			for (ULONG retry_count = 0; retry_count < max_retries;
 				 retry_count++)
 			{
 				total_freed = EvictEntriesOnePass(total_freed, num_to_free);
@@ -400,9 +536,9 @@ private:
 							// successfully removing an entry automatically advances the iterator, so don't call Advance()
 							m_clock_hand_advanced = true;
 
-							ULLONG num_freed =
-								entry->Pmp()->TotalAllocatedSize();
-							m_cache_size -= num_freed;
+							ULLONG num_freed = entry->GetSize();
+							RemoveEntrySize(entry);
+							ClassStats(entry->GetEntryClass()).m_evictions++;
 							total_freed += num_freed;
 						}
 					}
@@ -435,6 +571,8 @@ public:
 		  m_gclock_init_counter(g_clock_init_counter),
 		  m_eviction_factor((float) 0.1),
 		  m_eviction_counter(0),
+		  m_total_rebuild_cost(0),
+		  m_total_costed_size(0),
 		  m_clock_hand_advanced(false),
 		  m_hash_func(hash_func),
 		  m_equal_func(equal_func)
@@ -514,6 +652,13 @@ public:
 		return m_eviction_factor;
 	}
 
+	// return the statistics of the given entry class
+	SCacheClassStats
+	GetClassStats(ULONG entry_class)
+	{
+		return ClassStats(entry_class);
+	}
+
 };	//  CCache
 
 // invalid key
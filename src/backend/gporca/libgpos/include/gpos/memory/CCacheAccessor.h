@@ -83,9 +83,11 @@ public:
 	// (void *) key/value data types; the actual types are defined
 	// as template parameters in the child class CCacheAccessor
 
-	// inserts a new object into the cache
+	// inserts a new object into the cache; the entry class is used for
+	// per-class statistics, and the rebuild cost (if known) to weigh the
+	// entry during eviction
 	T
-	Insert(K key, T val)
+	Insert(K key, T val, ULONG entry_class = 0, ULLONG rebuild_cost = 0)
 	{
 		GPOS_ASSERT(NULL != m_mp);
 
@@ -94,7 +96,8 @@ public:
 		GPOS_ASSERT(NULL == m_entry && "Accessor already holds an entry");
 
 		CCacheEntry<T, K> *entry = GPOS_NEW(m_cache->m_mp)
-			CCacheEntry<T, K>(m_mp, key, val, m_cache->m_gclock_init_counter);
+			CCacheEntry<T, K>(m_mp, key, val, m_cache->m_gclock_init_counter,
+							  entry_class, rebuild_cost);
 
 		CCacheEntry<T, K> *ret = m_cache->InsertEntry(entry);
 
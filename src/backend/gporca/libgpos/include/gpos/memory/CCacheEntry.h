@@ -92,13 +92,30 @@ private:
 	// counter drops to 0 and the entry is not pinned
 	ULONG m_g_clock_counter;
 
+	// value the gclock counter is reset to whenever the entry is accessed
+	ULONG m_g_clock_init_counter;
+
+	// class of the cached object, used for per-class statistics
+	ULONG m_entry_class;
+
+	// cost of rebuilding the object if it gets evicted; 0 if unknown
+	ULLONG m_rebuild_cost;
+
+	// size of the entry in bytes, as accounted in the cache size
+	ULLONG m_size;
+
 public:
 	// ctor
-	CCacheEntry(CMemoryPool *mp, K key, T val, ULONG g_clock_counter)
+	CCacheEntry(CMemoryPool *mp, K key, T val, ULONG g_clock_counter,
+				ULONG entry_class = 0, ULLONG rebuild_cost = 0)
 		: m_mp(mp),
 		  m_val(val),
 		  m_deleted(false),
 		  m_g_clock_counter(g_clock_counter),
+		  m_g_clock_init_counter(g_clock_counter),
+		  m_entry_class(entry_class),
+		  m_rebuild_cost(rebuild_cost),
+		  m_size(0),
 		  m_key(key)
 	{
 		// CCache entry has the ownership now. So ideally any time ref count can't go lesser than 1.
@@ -190,6 +207,48 @@ public:
 		return m_g_clock_counter;
 	}
 
+	// sets the value the gclock counter is reset to upon access
+	void
+	SetGClockInitCounter(ULONG g_clock_init_counter)
+	{
+		m_g_clock_init_counter = g_clock_init_counter;
+	}
+
+	// returns the value the gclock counter is reset to upon access
+	ULONG
+	GetGClockInitCounter() const
+	{
+		return m_g_clock_init_counter;
+	}
+
+	// returns the class of the cached object
+	ULONG
+	GetEntryClass() const
+	{
+		return m_entry_class;
+	}
+
+	// returns the cost of rebuilding the cached object
+	ULLONG
+	GetRebuildCost() const
+	{
+		return m_rebuild_cost;
+	}
+
+	// sets the size of the entry
+	void
+	SetSize(ULLONG size)
+	{
+		m_size = size;
+	}
+
+	// returns the size of the entry
+	ULLONG
+	GetSize() const
+	{
+		return m_size;
+	}
+
 	// the following data members are public because they
 	// need to be used by GPOS_OFFSET macro for list construction
 
@@ -38,6 +38,9 @@ private:
 
 	ULLONG m_live_obj_total_size;
 
+	// high watermark of m_live_obj_total_size
+	ULLONG m_live_obj_total_size_peak;
+
 	// private copy ctor
 	CMemoryPoolStatistics(CMemoryPoolStatistics &);
 
@@ -49,7 +52,8 @@ public:
 		  m_num_free(0),
 		  m_num_live_obj(0),
 		  m_live_obj_user_size(0),
-		  m_live_obj_total_size(0)
+		  m_live_obj_total_size(0),
+		  m_live_obj_total_size_peak(0)
 	{
 	}
 
@@ -109,6 +113,10 @@ public:
 		++m_num_live_obj;
 		m_live_obj_user_size += user_data_size;
 		m_live_obj_total_size += total_data_size;
+		if (m_live_obj_total_size > m_live_obj_total_size_peak)
+		{
+			m_live_obj_total_size_peak = m_live_obj_total_size;
+		}
 	}
 
 	// record a successful free call (of a valid, non-NULL pointer)
@@ -135,6 +143,13 @@ public:
 		return m_live_obj_total_size;
 	}
 
+	// return the highest total allocated size seen so far
+	virtual ULLONG
+	PeakAllocatedSize() const
+	{
+		return m_live_obj_total_size_peak;
+	}
+
 };	// class CMemoryPoolStatistics
 }  // namespace gpos
 
@@ -68,7 +68,8 @@ private:
 
 	// inserts one SSimpleObject with key and value set to ulKey
 	static ULLONG InsertOneElement(CCache<SSimpleObject *, ULONG *> *pCache,
-								   ULONG ulKey);
+								   ULONG ulKey, ULONG ulEntryClass = 0,
+								   ULLONG ullRebuildCost = 0);
 
 	// inserts as many SSimpleObjects as needed (starting with the key ulKeyStart and
 	// sequentially generating the successive keys) to consume cache quota.
@@ -154,6 +155,7 @@ public:
 	static GPOS_RESULT EresUnittest_Basic();
 	static GPOS_RESULT EresUnittest_Refcount();
 	static GPOS_RESULT EresUnittest_Eviction();
+	static GPOS_RESULT EresUnittest_WeightedEviction();
 	static GPOS_RESULT EresUnittest_DeepObject();
 	static GPOS_RESULT EresUnittest_Iteration();
 	static GPOS_RESULT EresUnittest_IterativeDeletion();
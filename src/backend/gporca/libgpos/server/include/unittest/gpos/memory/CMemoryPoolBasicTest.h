@@ -31,6 +31,7 @@ private:
 
 	static GPOS_RESULT EresNewDelete();
 	static GPOS_RESULT EresThrowingCtor();
+	static GPOS_RESULT EresPeakSize();
 #ifdef GPOS_DEBUG
 	static GPOS_RESULT EresLeak();
 	static GPOS_RESULT EresLeakByException();
@@ -45,6 +45,7 @@ CCacheTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Basic),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Refcount),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Eviction),
+		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_WeightedEviction),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_Iteration),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_DeepObject),
 		GPOS_UNITTEST_FUNC(CCacheTest::EresUnittest_IterativeDeletion)};
@@ -378,7 +379,8 @@ CCacheTest::EresUnittest_Refcount()
 //---------------------------------------------------------------------------
 ULLONG
 CCacheTest::InsertOneElement(CCache<SSimpleObject *, ULONG *> *pCache,
-							 ULONG ulKey)
+							 ULONG ulKey, ULONG ulEntryClass,
+							 ULLONG ullRebuildCost)
 {
 	ULLONG ulTotalAllocatedSize = 0;
 	SSimpleObject *pso = NULL;
@@ -386,7 +388,7 @@ CCacheTest::InsertOneElement(CCache<SSimpleObject *, ULONG *> *pCache,
 		CSimpleObjectCacheAccessor ca(pCache);
 		CMemoryPool *mp = ca.Pmp();
 		pso = GPOS_NEW(mp) SSimpleObject(ulKey, ulKey);
-		ca.Insert(&(pso->m_ulKey), pso);
+		ca.Insert(&(pso->m_ulKey), pso, ulEntryClass, ullRebuildCost);
 		GPOS_ASSERT(
 			3 == pso->RefCount() &&
 			"Expected pso, cacheentry and cacheaccessor to have ownership");
@@ -644,6 +646,87 @@ CCacheTest::EresUnittest_Eviction()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CCacheTest::EresUnittest_WeightedEviction
+//
+//	@doc:
+//		Test that entries that are expensive to rebuild outlive cheap ones
+//		during eviction, and that per-class statistics are maintained
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCacheTest::EresUnittest_WeightedEviction()
+{
+	const ULONG ulExpensiveClass = 1;
+	const ULONG ulCheapClass = 2;
+	const ULONG ulNewClass = 3;
+
+	CAutoP<CCache<SSimpleObject *, ULONG *> > apCache;
+	apCache = CCacheFactory::CreateCache<SSimpleObject *, ULONG *>(
+		fUnique, 20480, SSimpleObject::UlMyHash, SSimpleObject::FMyEqual);
+
+	CCache<SSimpleObject *, ULONG *> *pCache = apCache.Value();
+
+	// fill half the cache with expensive entries and half with cheap ones
+	ULLONG ullOneElemSize =
+		InsertOneElement(pCache, 0, ulExpensiveClass, 100000);
+	ULONG ulCapacity = (ULONG)(pCache->GetCacheQuota() / ullOneElemSize);
+	ULONG ulHalf = ulCapacity / 2;
+	for (ULONG ul = 1; ul < ulHalf; ul++)
+	{
+		InsertOneElement(pCache, ul, ulExpensiveClass, 100000);
+	}
+	for (ULONG ul = ulHalf; ul < 2 * ulHalf; ul++)
+	{
+		InsertOneElement(pCache, ul, ulCheapClass, 1);
+	}
+
+	GPOS_ASSERT(0 == pCache->GetEvictionCounter());
+
+	// insert another quarter of the cache without a rebuild cost; the
+	// evictions this triggers must only hit the cheap entries
+	for (ULONG ul = 2 * ulHalf; ul < 2 * ulHalf + ulCapacity / 4 + 1; ul++)
+	{
+		InsertOneElement(pCache, ul, ulNewClass);
+	}
+
+	GPOS_ASSERT(0 < pCache->GetEvictionCounter());
+
+	for (ULONG ulKey = 0; ulKey < ulHalf; ulKey++)
+	{
+		CSimpleObjectCacheAccessor ca(pCache);
+		ca.Lookup(&ulKey);
+
+		SSimpleObject *pso = ca.Val();
+		GPOS_ASSERT(NULL != pso && "Expensive entry was evicted");
+
+		if (NULL != pso)
+		{
+			// release object since there is no customer to release it after lookup and before CCache's cleanup
+			pso->Release();
+		}
+	}
+
+	SCacheClassStats statsExpensive = pCache->GetClassStats(ulExpensiveClass);
+	SCacheClassStats statsCheap = pCache->GetClassStats(ulCheapClass);
+	SCacheClassStats statsNew = pCache->GetClassStats(ulNewClass);
+
+	GPOS_ASSERT(ulHalf == statsExpensive.m_inserts);
+	GPOS_ASSERT(ulHalf == statsExpensive.m_entries);
+	GPOS_ASSERT(ulHalf == statsExpensive.m_hits);
+	GPOS_ASSERT(0 == statsExpensive.m_evictions);
+	GPOS_ASSERT(0 < statsCheap.m_evictions);
+	GPOS_ASSERT(statsCheap.m_inserts ==
+				statsCheap.m_entries + statsCheap.m_evictions);
+	GPOS_ASSERT(statsExpensive.m_bytes + statsCheap.m_bytes +
+					statsNew.m_bytes ==
+				pCache->TotalAllocatedSize());
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CCacheTest::EresInsertDuplicates
@@ -108,7 +108,7 @@ CMemoryPoolBasicTest::EresUnittest_TestTracker()
 GPOS_RESULT
 CMemoryPoolBasicTest::EresTestType()
 {
-	if (GPOS_OK != EresNewDelete() ||
+	if (GPOS_OK != EresNewDelete() || GPOS_OK != EresPeakSize() ||
 		GPOS_OK != EresTestExpectedError(EresThrowingCtor, CException::ExmiOOM)
 
 #ifdef GPOS_DEBUG
@@ -212,6 +212,40 @@ CMemoryPoolBasicTest::EresNewDelete()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresPeakSize
+//
+//	@doc:
+//		Test that the peak allocated size survives freeing
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresPeakSize()
+{
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc);
+	CMemoryPool *mp = amp.Pmp();
+
+	ULLONG ullInitialSize = mp->TotalAllocatedSize();
+
+	BYTE *pbLarge = GPOS_NEW_ARRAY(mp, BYTE, 4096);
+	ULLONG ullLargeSize = mp->TotalAllocatedSize();
+	GPOS_DELETE_ARRAY(pbLarge);
+
+	BYTE *pbSmall = GPOS_NEW_ARRAY(mp, BYTE, 16);
+	ULLONG ullSmallSize = mp->TotalAllocatedSize();
+	ULLONG ullPeakSize = mp->PeakAllocatedSize();
+	GPOS_DELETE_ARRAY(pbSmall);
+
+	if (ullLargeSize <= ullInitialSize || ullSmallSize >= ullLargeSize ||
+		ullPeakSize != ullLargeSize || mp->PeakAllocatedSize() != ullPeakSize)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPoolBasicTest::EresThrowingCtor
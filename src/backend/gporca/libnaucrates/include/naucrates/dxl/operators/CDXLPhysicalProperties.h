@@ -35,6 +35,10 @@ private:
 	// cost estimate
 	CDXLOperatorCost *m_operator_cost_dxl;
 
+	// cardinality feedback key of the memo group that produced the node,
+	// 0 if none; used when translating to a plan and not serialized
+	ULLONG m_feedback_key;
+
 	// private copy ctor
 	CDXLPhysicalProperties(const CDXLPhysicalProperties &);
 
@@ -52,6 +56,19 @@ public:
 	// the cost estimates for the operator node
 	CDXLOperatorCost *GetDXLOperatorCost() const;
 
+	// cardinality feedback key of the node
+	ULLONG
+	GetFeedbackKey() const
+	{
+		return m_feedback_key;
+	}
+
+	void
+	SetFeedbackKey(ULLONG feedback_key)
+	{
+		m_feedback_key = feedback_key;
+	}
+
 	virtual Edxlproperty
 	GetDXLPropertyType() const
 	{
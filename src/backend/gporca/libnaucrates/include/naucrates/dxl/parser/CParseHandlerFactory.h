@@ -172,6 +172,11 @@ private:
 		CMemoryPool *mp, CParseHandlerManager *parse_handler_mgr,
 		CParseHandlerBase *parse_handler_root);
 
+	// construct a parse handler for statistics on groups of columns
+	static CParseHandlerBase *CreateMultiColStatsParseHandler(
+		CMemoryPool *mp, CParseHandlerManager *parse_handler_mgr,
+		CParseHandlerBase *parse_handler_root);
+
 	// construct a column stats bucket parse handler
 	static CParseHandlerBase *CreateColStatsBucketParseHandler(
 		CMemoryPool *mp, CParseHandlerManager *parse_handler_mgr,
@@ -61,6 +61,9 @@ private:
 	// width of the column
 	ULONG m_width;
 
+	// average on-disk bytes per row of the column
+	CDouble m_compressed_width;
+
 	// private copy ctor
 	CParseHandlerMetadataColumn(const CParseHandlerMetadataColumn &);
 
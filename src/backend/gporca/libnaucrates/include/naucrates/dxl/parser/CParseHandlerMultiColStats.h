@@ -0,0 +1,76 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CParseHandlerMultiColStats.h
+//
+//	@doc:
+//		SAX parse handler class for parsing statistics on groups of columns
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CParseHandlerMultiColStats_H
+#define GPDXL_CParseHandlerMultiColStats_H
+
+#include "gpos/base.h"
+
+#include "naucrates/dxl/parser/CParseHandlerMetadataObject.h"
+#include "naucrates/md/CDXLMultiColStats.h"
+
+namespace gpdxl
+{
+using namespace gpos;
+using namespace gpmd;
+using namespace gpnaucrates;
+
+XERCES_CPP_NAMESPACE_USE
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CParseHandlerMultiColStats
+//
+//	@doc:
+//		Parse handler for statistics on groups of columns of a relation
+//
+//---------------------------------------------------------------------------
+class CParseHandlerMultiColStats : public CParseHandlerMetadataObject
+{
+private:
+	// metadata id of the object
+	IMDId *m_mdid;
+
+	// relation name
+	CMDName *m_mdname;
+
+	// statistics of the groups of columns parsed so far
+	SMultiColStatArray *m_stats;
+
+	// private copy ctor
+	CParseHandlerMultiColStats(const CParseHandlerMultiColStats &);
+
+	// process the start of an element
+	void StartElement(
+		const XMLCh *const element_uri,			// URI of element's namespace
+		const XMLCh *const element_local_name,	// local part of element's name
+		const XMLCh *const element_qname,		// element's qname
+		const Attributes &attr					// element's attributes
+	);
+
+	// process the end of an element
+	void EndElement(
+		const XMLCh *const element_uri,			// URI of element's namespace
+		const XMLCh *const element_local_name,	// local part of element's name
+		const XMLCh *const element_qname		// element's qname
+	);
+
+public:
+	// ctor
+	CParseHandlerMultiColStats(CMemoryPool *mp,
+							   CParseHandlerManager *parse_handler_mgr,
+							   CParseHandlerBase *parse_handler_root);
+};
+}  // namespace gpdxl
+
+#endif	// !GPDXL_CParseHandlerMultiColStats_H
+
+// EOF
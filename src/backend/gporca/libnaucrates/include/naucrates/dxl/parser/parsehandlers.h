@@ -89,6 +89,7 @@
 #include "naucrates/dxl/parser/CParseHandlerMetadataColumn.h"
 #include "naucrates/dxl/parser/CParseHandlerMetadataColumns.h"
 #include "naucrates/dxl/parser/CParseHandlerMetadataIdList.h"
+#include "naucrates/dxl/parser/CParseHandlerMultiColStats.h"
 #include "naucrates/dxl/parser/CParseHandlerNLJIndexParam.h"
 #include "naucrates/dxl/parser/CParseHandlerNLJIndexParamList.h"
 #include "naucrates/dxl/parser/CParseHandlerNLJoin.h"
@@ -66,7 +66,10 @@ enum Edxltoken
 	EdxltokenPushGroupByBelowSetopThreshold,
 	EdxltokenXformBindThreshold,
 	EdxltokenSkewFactor,
+	EdxltokenQueryMemoryKB,
+	EdxltokenMemoryIntensiveOperators,
 	EdxltokenMaxStatsBuckets,
+	EdxltokenMaxDerivedStatsBuckets,
 	EdxltokenWindowOids,
 	EdxltokenOidRowNumber,
 	EdxltokenOidRank,
@@ -348,6 +351,7 @@ enum Edxltoken
 	EdxltokenAttno,
 	EdxltokenColDropped,
 	EdxltokenColWidth,
+	EdxltokenColCompressedWidth,
 	EdxltokenColNullFreq,
 	EdxltokenColNdvRemain,
 	EdxltokenColFreqRemain,
@@ -456,6 +460,10 @@ enum Edxltoken
 	EdxltokenRelationMdid,
 	EdxltokenRelationStats,
 	EdxltokenColumnStats,
+	EdxltokenMultiColStats,
+	EdxltokenMultiColStat,
+	EdxltokenMultiColStatNDistinct,
+	EdxltokenMultiColStatDependency,
 	EdxltokenColumnStatsBucket,
 	EdxltokenEmptyRelation,
 	EdxltokenIsNull,
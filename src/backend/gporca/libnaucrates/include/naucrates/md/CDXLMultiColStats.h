@@ -0,0 +1,166 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLMultiColStats.h
+//
+//	@doc:
+//		Class representing statistics on groups of columns of a relation
+//---------------------------------------------------------------------------
+
+#ifndef GPMD_CDXLMultiColStats_H
+#define GPMD_CDXLMultiColStats_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CDynamicPtrArray.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/md/CMDName.h"
+#include "naucrates/md/IMDMultiColStats.h"
+
+namespace gpdxl
+{
+class CXMLSerializer;
+}
+
+namespace gpmd
+{
+using namespace gpos;
+using namespace gpdxl;
+
+// statistics on one group of columns
+struct SMultiColStat
+{
+	// attribute numbers of the columns
+	ULongPtrArray *m_keys;
+
+	// number of distinct value combinations
+	CDouble m_ndistinct;
+
+	// degree of the dependency of the last column on the others
+	CDouble m_dependency;
+
+	// ctor
+	SMultiColStat(ULongPtrArray *keys, CDouble ndistinct, CDouble dependency)
+		: m_keys(keys), m_ndistinct(ndistinct), m_dependency(dependency)
+	{
+		GPOS_ASSERT(NULL != keys);
+	}
+
+	// dtor
+	~SMultiColStat()
+	{
+		m_keys->Release();
+	}
+};
+
+typedef CDynamicPtrArray<SMultiColStat, CleanupDelete> SMultiColStatArray;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CDXLMultiColStats
+//
+//	@doc:
+//		Class representing statistics on groups of columns of a relation.
+//		The metadata id is the oid of the relation with the multi-column
+//		statistics mdid type.
+//
+//---------------------------------------------------------------------------
+class CDXLMultiColStats : public IMDMultiColStats
+{
+private:
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// metadata id of the object
+	IMDId *m_mdid;
+
+	// relation name
+	CMDName *m_mdname;
+
+	// statistics of the groups of columns
+	SMultiColStatArray *m_stats;
+
+	// DXL string for object
+	CWStringDynamic *m_dxl_str;
+
+	// private copy ctor
+	CDXLMultiColStats(const CDXLMultiColStats &);
+
+public:
+	// ctor
+	CDXLMultiColStats(CMemoryPool *mp, IMDId *mdid, CMDName *mdname,
+					  SMultiColStatArray *stats);
+
+	// dtor
+	virtual ~CDXLMultiColStats();
+
+	// the metadata id
+	virtual IMDId *
+	MDId() const
+	{
+		return m_mdid;
+	}
+
+	// relation name
+	virtual CMDName
+	Mdname() const
+	{
+		return *m_mdname;
+	}
+
+	// DXL string representation of cache object
+	virtual const CWStringDynamic *
+	GetStrRepr() const
+	{
+		return m_dxl_str;
+	}
+
+	// number of groups of columns
+	virtual ULONG
+	Size() const
+	{
+		return m_stats->Size();
+	}
+
+	// attribute numbers of the columns of the given group
+	virtual const ULongPtrArray *
+	GetKeys(ULONG pos) const
+	{
+		return (*m_stats)[pos]->m_keys;
+	}
+
+	// number of distinct value combinations of the given group
+	virtual CDouble
+	GetNDistinct(ULONG pos) const
+	{
+		return (*m_stats)[pos]->m_ndistinct;
+	}
+
+	// degree of the dependency of the last column of the given group
+	virtual CDouble
+	GetDependency(ULONG pos) const
+	{
+		return (*m_stats)[pos]->m_dependency;
+	}
+
+	// serialize the statistics in DXL format given a serializer object
+	virtual void Serialize(gpdxl::CXMLSerializer *) const;
+
+#ifdef GPOS_DEBUG
+	// debug print of the statistics
+	virtual void DebugPrint(IOstream &os) const;
+#endif
+
+	// statistics object without any groups of columns
+	static CDXLMultiColStats *CreateDXLDummyMultiColStats(CMemoryPool *mp,
+														  IMDId *mdid);
+};
+
+}  // namespace gpmd
+
+#endif	// !GPMD_CDXLMultiColStats_H
+
+// EOF
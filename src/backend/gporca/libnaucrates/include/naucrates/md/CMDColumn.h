@@ -60,6 +60,9 @@ private:
 	// length of the column
 	ULONG m_length;
 
+	// average on-disk bytes per row, negative if unknown
+	CDouble m_compressed_width;
+
 	// default value expression
 	gpdxl::CDXLNode *m_dxl_default_val;
 
@@ -71,7 +74,8 @@ public:
 	CMDColumn(CMDName *mdname, INT attrnum, IMDId *mdid_type, INT type_modifier,
 			  BOOL is_nullable, BOOL is_dropped,
 			  gpdxl::CDXLNode *dxl_dafault_value,
-			  ULONG length = gpos::ulong_max);
+			  ULONG length = gpos::ulong_max,
+			  CDouble compressed_width = CDouble(-1.0));
 
 	// dtor
 	virtual ~CMDColumn();
@@ -101,6 +105,13 @@ public:
 		return m_length;
 	}
 
+	// average on-disk bytes per row of the column
+	virtual CDouble
+	CompressedWidth() const
+	{
+		return m_compressed_width;
+	}
+
 	// is the column nullable
 	virtual BOOL IsNullable() const;
 
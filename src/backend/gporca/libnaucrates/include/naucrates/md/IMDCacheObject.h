@@ -73,6 +73,7 @@ public:
 		EmdtColStats,
 		EmdtCastFunc,
 		EmdtScCmp,
+		EmdtMultiColStats,
 		EmdtSentinel
 	};
 
@@ -15,6 +15,7 @@
 #define GPMD_IMDColumn_H
 
 #include "gpos/base.h"
+#include "gpos/common/CDouble.h"
 
 #include "naucrates/dxl/gpdb_types.h"
 #include "naucrates/md/IMDId.h"
@@ -60,6 +61,10 @@ public:
 	// length of the column
 	virtual ULONG Length() const = 0;
 
+	// average number of bytes a row of the column occupies on disk, for
+	// column-oriented tables; negative if unknown
+	virtual CDouble CompressedWidth() const = 0;
+
 #ifdef GPOS_DEBUG
 	// debug print of the column
 	virtual void DebugPrint(IOstream &os) const = 0;
@@ -76,6 +76,7 @@ public:
 		EmdidRel = 6,
 		EmdidInd = 7,
 		EmdidCheckConstraint = 8,
+		EmdidMultiColStats = 9,
 		EmdidSentinel
 	};
 
@@ -0,0 +1,64 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		IMDMultiColStats.h
+//
+//	@doc:
+//		Interface for statistics on groups of columns of a relation
+//---------------------------------------------------------------------------
+
+#ifndef GPMD_IMDMultiColStats_H
+#define GPMD_IMDMultiColStats_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CDynamicPtrArray.h"
+
+#include "naucrates/md/IMDCacheObject.h"
+
+namespace gpmd
+{
+using namespace gpos;
+using namespace gpdxl;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		IMDMultiColStats
+//
+//	@doc:
+//		Interface for statistics on groups of columns of a relation. For
+//		each group, the number of distinct value combinations and the degree
+//		to which the last column of the group is functionally determined by
+//		the other columns are available.
+//
+//---------------------------------------------------------------------------
+class IMDMultiColStats : public IMDCacheObject
+{
+public:
+	// object type
+	virtual Emdtype
+	MDType() const
+	{
+		return EmdtMultiColStats;
+	}
+
+	// number of groups of columns
+	virtual ULONG Size() const = 0;
+
+	// attribute numbers of the columns of the given group
+	virtual const ULongPtrArray *GetKeys(ULONG pos) const = 0;
+
+	// number of distinct value combinations of the given group
+	virtual CDouble GetNDistinct(ULONG pos) const = 0;
+
+	// fraction of rows in which the last column of the given group is
+	// determined by the values of the other columns
+	virtual CDouble GetDependency(ULONG pos) const = 0;
+};
+}  // namespace gpmd
+
+#endif	// !GPMD_IMDMultiColStats_H
+
+// EOF
@@ -53,6 +53,13 @@ private:
 		CHistogram *hist_before, CDouble *last_scale_factor,
 		ULONG *target_last_colid);
 
+	// count the distinct points of an IN list that fall in each bucket
+	static void CountPointsPerBucket(CMemoryPool *mp, CPointArray *points,
+									 const CBucketArray *buckets,
+									 ULONG *bucket_ndvs,
+									 ULONG *num_distinct_points,
+									 ULONG *ndv_remain);
+
 	// create a new histogram after applying a pred op ANY(ARRAY[...]) filter
 	static CHistogram *MakeHistArrayCmpAnyFilter(CMemoryPool *mp,
 												 CStatsPredArrayCmp *pred_stats,
@@ -82,7 +89,22 @@ private:
 	// check if the column is a new column for statistic calculation
 	static BOOL IsNewStatsColumn(ULONG colid, ULONG last_colid);
 
+	// position of a not yet combined equality predicate on the given column
+	// of the given table instance, or gpos::ulong_max
+	static ULONG FindUncombinedEqCol(IMDId **rel_mdids,
+									 const ULONG *source_ids,
+									 const INT *attnos, const BOOL *combined,
+									 ULONG size, IMDId *rel_mdid,
+									 ULONG source_id, INT attno);
+
 public:
+	// combine the scale factors of equality predicates on columns that
+	// ANALYZE found to be functionally dependent
+	static CDoubleArray *ApplyDependencies(CMemoryPool *mp,
+										   CDoubleArray *scale_factors,
+										   ULongPtrArray *scale_factor_colids,
+										   CBitSet *eq_colids);
+
 	// filter
 	static CStatistics *MakeStatsFilter(CMemoryPool *mp,
 										const CStatistics *input_stats,
@@ -164,6 +164,10 @@ private:
 	static CBucketArray *CombineBuckets(CMemoryPool *mp, CBucketArray *buckets,
 										ULONG desired_num_buckets);
 
+	// merge buckets of a derived histogram that has grown past the
+	// configured maximum number of buckets
+	void CompactBuckets();
+
 	// check if we can compute NDVRemain for JOIN histogram for the given input histograms
 	static BOOL CanComputeJoinNDVRemain(const CHistogram *histogram1,
 										const CHistogram *histogram2);
@@ -357,6 +361,9 @@ public:
 	// total number of distinct values
 	CDouble GetNumDistinct() const;
 
+	// frequency of the most frequent value, relative to the total frequency
+	CDouble GetMaxValueFrequency() const;
+
 	// is histogram well formed
 	BOOL IsValid() const;
 
@@ -0,0 +1,161 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CJoinStatsCache.h
+//
+//	@doc:
+//		Per-optimization cache of inner join statistics
+//---------------------------------------------------------------------------
+#ifndef GPNAUCRATES_CJoinStatsCache_H
+#define GPNAUCRATES_CJoinStatsCache_H
+
+#include "gpos/base.h"
+#include "gpos/common/CBitSet.h"
+#include "gpos/common/CHashMap.h"
+#include "gpos/common/CRefCount.h"
+
+#include "gpopt/operators/CExpression.h"
+#include "naucrates/statistics/IStatistics.h"
+
+namespace gpnaucrates
+{
+using namespace gpos;
+using namespace gpopt;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CJoinStatsCache
+//
+//	@doc:
+//		Cache of statistics derived for inner joins, shared by all join
+//		alternatives considered during one optimization.
+//
+//		Every statistics object that is the input of a join is either the
+//		output of a cached join, or an atom that is given a new id the first
+//		time it is seen. The result of an inner join is determined by the
+//		set of atoms it joins and by the set of join conjuncts applied
+//		anywhere in the join tree, so commutative and associative variants
+//		of the same join map to the same cache entry.
+//
+//---------------------------------------------------------------------------
+class CJoinStatsCache
+{
+public:
+	// derivation signature of a statistics object
+	class CSignature : public CRefCount
+	{
+	private:
+		// ids of the atoms joined
+		CBitSet *m_atoms;
+
+		// join conjuncts applied, without duplicates
+		CExpressionArray *m_conjuncts;
+
+		// was the join scale factor computed from histogram buckets
+		BOOL m_scale_factor_from_buckets;
+
+		// private copy ctor
+		CSignature(const CSignature &);
+
+	public:
+		// ctor
+		CSignature(CBitSet *atoms, CExpressionArray *conjuncts,
+				   BOOL scale_factor_from_buckets);
+
+		// dtor
+		virtual ~CSignature();
+
+		// add the atoms and conjuncts of the given signature
+		void Include(const CSignature *signature);
+
+		// add a join conjunct
+		void AddConjunct(CExpression *conjunct);
+
+		// hash function
+		static ULONG HashValue(const CSignature *signature);
+
+		// equality function
+		static BOOL Equals(const CSignature *first, const CSignature *second);
+	};
+
+private:
+	// map of statistics objects to the signatures they were derived under
+	typedef CHashMap<IStatistics, CSignature, HashPtr<IStatistics>,
+					 EqualPtr<IStatistics>, CleanupRelease<IStatistics>,
+					 CleanupRelease<CSignature> >
+		StatsToSignatureMap;
+
+	// map of signatures to the derived join statistics
+	typedef CHashMap<CSignature, IStatistics, CSignature::HashValue,
+					 CSignature::Equals, CleanupRelease<CSignature>,
+					 CleanupRelease<IStatistics> >
+		SignatureToStatsMap;
+
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// signatures of known statistics objects, these are kept alive so
+	// that their addresses are not reused
+	StatsToSignatureMap *m_stats_to_signature;
+
+	// cached join statistics
+	SignatureToStatsMap *m_signature_to_stats;
+
+	// id of the next atom
+	ULONG m_next_atom_id;
+
+	// number of lookups
+	ULONG m_lookups;
+
+	// number of lookups answered from the cache
+	ULONG m_hits;
+
+	// private copy ctor
+	CJoinStatsCache(const CJoinStatsCache &);
+
+	// signature of the given join input, registering it as an atom if needed
+	CSignature *PsignatureInput(IStatistics *stats);
+
+public:
+	// ctor
+	explicit CJoinStatsCache(CMemoryPool *mp);
+
+	// dtor
+	~CJoinStatsCache();
+
+	// can joins with the given operator be cached
+	static BOOL FCacheable(COperator *pop);
+
+	// look up the statistics of joining the given inputs under the given
+	// predicate; on a miss, NULL is returned along with the signature to
+	// insert the derived statistics under
+	IStatistics *PstatsLookup(IStatisticsArray *statistics_array,
+							  CExpression *join_pred_expr,
+							  CSignature **signature);
+
+	// cache the statistics derived for the given signature; consumes the
+	// signature
+	void Insert(CSignature *signature, IStatistics *stats);
+
+	// number of lookups
+	ULONG
+	UlLookups() const
+	{
+		return m_lookups;
+	}
+
+	// number of cache hits
+	ULONG
+	UlHits() const
+	{
+		return m_hits;
+	}
+
+};	// class CJoinStatsCache
+}  // namespace gpnaucrates
+
+#endif	// !GPNAUCRATES_CJoinStatsCache_H
+
+// EOF
@@ -127,6 +127,11 @@ private:
 		CMemoryPool *mp, const CStatisticsConfig *stats_config,
 		CStatistics *input_stats, const ULongPtrArray *src_grouping_cols);
 
+	// position of a grouping column with the given attribute number that is
+	// not yet part of a combination, or gpos::ulong_max
+	static ULONG FindUncombinedGrpCol(const INT *attnos, const BOOL *combined,
+									  ULONG num_cols, INT attno);
+
 	// check to see if any one of the grouping columns has been capped
 	static BOOL CappedGrpColExists(const CStatistics *stats,
 								   const ULongPtrArray *grouping_columns);
@@ -136,6 +141,13 @@ private:
 						  const ULongPtrArray *grouping_columns);
 
 public:
+	// replace the NDVs of grouping columns of a table that have statistics
+	// on their combination by the NDV of the combination, scaled to the
+	// given number of input rows
+	static CDoubleArray *CombineNdvsWithMultiColStats(
+		CMemoryPool *mp, CDouble input_rows,
+		const ULongPtrArray *src_grouping_cols, CDoubleArray *ndvs);
+
 	// get the next data point for generating new bucket boundary
 	static CPoint *NextPoint(CMemoryPool *mp, CMDAccessor *md_accessor,
 							 CPoint *point);
@@ -258,6 +258,13 @@ enum EOptTraceFlag
 
 	// Use experimental cost model
 	EopttraceExperimentalCostModel = 104009,
+
+	// Cost hashed distributions by the rows of the host that receives the
+	// most common value of the distribution columns
+	EopttracePenalizeMCVSkew = 104010,
+
+	// Do not use the statistics on groups of columns collected by ANALYZE
+	EopttraceDisableMultiColStats = 104011,
 	///////////////////////////////////////////////////////
 	/////////// constant expression evaluator flags ///////
 	///////////////////////////////////////////////////////
@@ -4,14 +4,74 @@
 #include "naucrates/dxl/CCostModelConfigSerializer.h"
 
 #include "gpos/common/CAutoRef.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/memory/CAutoMemoryPool.h"
 
 #include "gpdbcost/CCostModelParamsGPDB.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 #include "naucrates/dxl/xml/dxltokens.h"
 
 using namespace gpdxl;
+using gpos::CAutoMemoryPool;
 using gpos::CAutoRef;
 
+// length of the buffer for a serialized double value
+#define GPOS_DOUBLE_SERIALIZE_LENGTH 512
+
+// format a double value into the given buffer
+static void
+FormatDouble(CHAR *buffer, SIZE_T size, const CHAR *format, ...)
+{
+	VA_LIST va_args;
+	VA_START(va_args, format);
+	clib::Vsnprintf(buffer, size, format, va_args);
+	VA_END(va_args);
+}
+
+// add a double attribute; values that do not survive the fixed point format
+// of CDouble, e.g. the small unit costs of a cost profile, are serialized
+// with full precision
+static void
+AddDoubleAttribute(CXMLSerializer &xml_serializer, Edxltoken token,
+				   CDouble value)
+{
+	CHAR buffer[GPOS_DOUBLE_SERIALIZE_LENGTH];
+	FormatDouble(buffer, GPOS_ARRAY_SIZE(buffer), "%f", value.Get());
+	if (clib::Strtod(buffer) == value.Get())
+	{
+		xml_serializer.AddAttribute(CDXLTokens::GetDXLTokenStr(token), value);
+		return;
+	}
+
+	FormatDouble(buffer, GPOS_ARRAY_SIZE(buffer), "%.17g", value.Get());
+	xml_serializer.AddAttribute(CDXLTokens::GetDXLTokenStr(token), buffer);
+}
+
+void
+CCostModelConfigSerializer::SerializeCostParam(CXMLSerializer &xml_serializer,
+											   ULONG id) const
+{
+	ICostModelParams *cost_model_params = m_cost_model->GetCostModelParams();
+	ICostModelParams::SCostParam *cost_param =
+		cost_model_params->PcpLookup(id);
+
+	xml_serializer.OpenElement(
+		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+		CDXLTokens::GetDXLTokenStr(EdxltokenCostParam));
+
+	xml_serializer.AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenName),
+								cost_model_params->SzNameLookup(id));
+	AddDoubleAttribute(xml_serializer, EdxltokenValue, cost_param->Get());
+	AddDoubleAttribute(xml_serializer, EdxltokenCostParamLowerBound,
+					   cost_param->GetLowerBoundVal());
+	AddDoubleAttribute(xml_serializer, EdxltokenCostParamUpperBound,
+					   cost_param->GetUpperBoundVal());
+
+	xml_serializer.CloseElement(
+		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+		CDXLTokens::GetDXLTokenStr(EdxltokenCostParam));
+}
+
 void
 CCostModelConfigSerializer::Serialize(CXMLSerializer &xml_serializer) const
 {
@@ -29,32 +89,22 @@ CCostModelConfigSerializer::Serialize(CXMLSerializer &xml_serializer) const
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
 		CDXLTokens::GetDXLTokenStr(EdxltokenCostParams));
 
-	xml_serializer.OpenElement(
-		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
-		CDXLTokens::GetDXLTokenStr(EdxltokenCostParam));
+	// the NLJ factor is always serialized, other parameters only if they
+	// differ from their defaults, e.g. when loaded from a cost profile
+	CAutoMemoryPool amp;
+	CAutoRef<CCostModelParamsGPDB> default_params(
+		GPOS_NEW(amp.Pmp()) CCostModelParamsGPDB(amp.Pmp()));
+	ICostModelParams *cost_model_params = m_cost_model->GetCostModelParams();
 
-	xml_serializer.AddAttribute(
-		CDXLTokens::GetDXLTokenStr(EdxltokenName),
-		m_cost_model->GetCostModelParams()->SzNameLookup(
-			CCostModelParamsGPDB::EcpNLJFactor));
-	xml_serializer.AddAttribute(
-		CDXLTokens::GetDXLTokenStr(EdxltokenValue),
-		m_cost_model->GetCostModelParams()
-			->PcpLookup(CCostModelParamsGPDB::EcpNLJFactor)
-			->Get());
-	xml_serializer.AddAttribute(
-		CDXLTokens::GetDXLTokenStr(EdxltokenCostParamLowerBound),
-		m_cost_model->GetCostModelParams()
-			->PcpLookup(CCostModelParamsGPDB::EcpNLJFactor)
-			->GetLowerBoundVal());
-	xml_serializer.AddAttribute(
-		CDXLTokens::GetDXLTokenStr(EdxltokenCostParamUpperBound),
-		m_cost_model->GetCostModelParams()
-			->PcpLookup(CCostModelParamsGPDB::EcpNLJFactor)
-			->GetUpperBoundVal());
-	xml_serializer.CloseElement(
-		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
-		CDXLTokens::GetDXLTokenStr(EdxltokenCostParam));
+	for (ULONG ul = 0; ul < CCostModelParamsGPDB::EcpSentinel; ul++)
+	{
+		if (CCostModelParamsGPDB::EcpNLJFactor == ul ||
+			!cost_model_params->PcpLookup(ul)->Equals(
+				default_params->PcpLookup(ul)))
+		{
+			SerializeCostParam(xml_serializer, ul);
+		}
+	}
 
 	xml_serializer.CloseElement(
 		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
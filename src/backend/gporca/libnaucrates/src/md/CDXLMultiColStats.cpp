@@ -0,0 +1,132 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CDXLMultiColStats.cpp
+//
+//	@doc:
+//		Implementation of the class representing statistics on groups of
+//		columns of a relation in DXL
+//---------------------------------------------------------------------------
+
+#include "naucrates/md/CDXLMultiColStats.h"
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/string/CWStringDynamic.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
+
+using namespace gpdxl;
+using namespace gpmd;
+
+// ctor
+CDXLMultiColStats::CDXLMultiColStats(CMemoryPool *mp, IMDId *mdid,
+									 CMDName *mdname,
+									 SMultiColStatArray *stats)
+	: m_mp(mp), m_mdid(mdid), m_mdname(mdname), m_stats(stats)
+{
+	GPOS_ASSERT(mdid->IsValid());
+	GPOS_ASSERT(NULL != stats);
+
+	m_dxl_str = CDXLUtils::SerializeMDObj(
+		m_mp, this, false /*fSerializeHeader*/, false /*indentation*/);
+}
+
+// dtor
+CDXLMultiColStats::~CDXLMultiColStats()
+{
+	GPOS_DELETE(m_mdname);
+	GPOS_DELETE(m_dxl_str);
+	m_stats->Release();
+	m_mdid->Release();
+}
+
+// serialize the statistics in DXL format
+void
+CDXLMultiColStats::Serialize(CXMLSerializer *xml_serializer) const
+{
+	xml_serializer->OpenElement(
+		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+		CDXLTokens::GetDXLTokenStr(EdxltokenMultiColStats));
+
+	m_mdid->Serialize(xml_serializer,
+					  CDXLTokens::GetDXLTokenStr(EdxltokenMdid));
+	xml_serializer->AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenName),
+								 m_mdname->GetMDName());
+
+	const ULONG size = m_stats->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		SMultiColStat *stat = (*m_stats)[ul];
+
+		xml_serializer->OpenElement(
+			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+			CDXLTokens::GetDXLTokenStr(EdxltokenMultiColStat));
+
+		CWStringDynamic *keys_str = CDXLUtils::Serialize(m_mp, stat->m_keys);
+		xml_serializer->AddAttribute(CDXLTokens::GetDXLTokenStr(EdxltokenKeys),
+									 keys_str);
+		GPOS_DELETE(keys_str);
+
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenMultiColStatNDistinct),
+			stat->m_ndistinct);
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenMultiColStatDependency),
+			stat->m_dependency);
+
+		xml_serializer->CloseElement(
+			CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+			CDXLTokens::GetDXLTokenStr(EdxltokenMultiColStat));
+	}
+
+	xml_serializer->CloseElement(
+		CDXLTokens::GetDXLTokenStr(EdxltokenNamespacePrefix),
+		CDXLTokens::GetDXLTokenStr(EdxltokenMultiColStats));
+
+	GPOS_CHECK_ABORT;
+}
+
+#ifdef GPOS_DEBUG
+// debug print of the statistics
+void
+CDXLMultiColStats::DebugPrint(IOstream &os) const
+{
+	os << "Multi-column statistics id: ";
+	MDId()->OsPrint(os);
+	os << std::endl;
+
+	os << "Relation name: " << (Mdname()).GetMDName()->GetBuffer()
+	   << std::endl;
+
+	const ULONG size = Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		const ULongPtrArray *keys = GetKeys(ul);
+		os << "Keys: (";
+		for (ULONG ulKey = 0; ulKey < keys->Size(); ulKey++)
+		{
+			os << (0 == ulKey ? "" : ", ") << *(*keys)[ulKey];
+		}
+		os << "), NDistinct: " << GetNDistinct(ul)
+		   << ", Dependency: " << GetDependency(ul) << std::endl;
+	}
+}
+#endif	// GPOS_DEBUG
+
+// statistics object without any groups of columns, for relations that have
+// no multi-column statistics
+CDXLMultiColStats *
+CDXLMultiColStats::CreateDXLDummyMultiColStats(CMemoryPool *mp, IMDId *mdid)
+{
+	CAutoP<CWStringDynamic> str;
+	str = GPOS_NEW(mp) CWStringDynamic(mp, mdid->GetBuffer());
+	CMDName *mdname = GPOS_NEW(mp) CMDName(mp, str.Value());
+
+	return GPOS_NEW(mp) CDXLMultiColStats(mp, mdid, mdname,
+										  GPOS_NEW(mp) SMultiColStatArray(mp));
+}
+
+// EOF
@@ -29,7 +29,8 @@ using namespace gpmd;
 //---------------------------------------------------------------------------
 CMDColumn::CMDColumn(CMDName *mdname, INT attrnum, IMDId *mdid_type,
 					 INT type_modifier, BOOL is_nullable, BOOL is_dropped,
-					 CDXLNode *dxl_dafault_value, ULONG length)
+					 CDXLNode *dxl_dafault_value, ULONG length,
+					 CDouble compressed_width)
 	: m_mdname(mdname),
 	  m_attno(attrnum),
 	  m_mdid_type(mdid_type),
@@ -37,6 +38,7 @@ CMDColumn::CMDColumn(CMDName *mdname, INT attrnum, IMDId *mdid_type,
 	  m_is_nullable(is_nullable),
 	  m_is_dropped(is_dropped),
 	  m_length(length),
+	  m_compressed_width(compressed_width),
 	  m_dxl_default_val(dxl_dafault_value)
 {
 }
@@ -169,6 +171,13 @@ CMDColumn::Serialize(CXMLSerializer *xml_serializer) const
 			CDXLTokens::GetDXLTokenStr(EdxltokenColWidth), m_length);
 	}
 
+	if (0.0 <= m_compressed_width)
+	{
+		xml_serializer->AddAttribute(
+			CDXLTokens::GetDXLTokenStr(EdxltokenColCompressedWidth),
+			m_compressed_width);
+	}
+
 	if (m_is_dropped)
 	{
 		xml_serializer->AddAttribute(
@@ -23,6 +23,7 @@
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/exception.h"
 #include "naucrates/md/CDXLColStats.h"
+#include "naucrates/md/CDXLMultiColStats.h"
 #include "naucrates/md/CDXLRelStats.h"
 #include "naucrates/md/CMDTypeBoolGPDB.h"
 #include "naucrates/md/CMDTypeInt4GPDB.h"
@@ -159,8 +160,8 @@ CMDProviderMemory::GetMDObjDXLStr(CMemoryPool *mp,
 
 	if (NULL == pstrObj)
 	{
-		// Relstats and colstats are special as they may not
-		// exist in the metadata file. Provider must return dummy objects
+		// Relstats, colstats and multi-column stats are special as they may
+		// not exist in the metadata file. Provider must return dummy objects
 		// in this case.
 		switch (mdid->MdidType())
 		{
@@ -191,6 +192,17 @@ CMDProviderMemory::GetMDObjDXLStr(CMemoryPool *mp,
 					false /*findent*/);
 				break;
 			}
+			case IMDId::EmdidMultiColStats:
+			{
+				mdid->AddRef();
+				CAutoRef<CDXLMultiColStats> a_pdxlmulticolstats;
+				a_pdxlmulticolstats =
+					CDXLMultiColStats::CreateDXLDummyMultiColStats(mp, mdid);
+				a_pstrResult = CDXLUtils::SerializeMDObj(
+					mp, a_pdxlmulticolstats.Value(), true /*fSerializeHeaders*/,
+					false /*findent*/);
+				break;
+			}
 			default:
 			{
 				GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDCacheEntryNotFound,
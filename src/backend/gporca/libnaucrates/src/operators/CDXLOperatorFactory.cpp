@@ -2236,6 +2236,7 @@ CDXLOperatorFactory::MakeMdIdFromStr(CDXLMemoryManager *dxl_memory_manager,
 		case IMDId::EmdidRel:
 		case IMDId::EmdidInd:
 		case IMDId::EmdidCheckConstraint:
+		case IMDId::EmdidMultiColStats:
 			mdid = GetGPDBMdId(dxl_memory_manager, remaining_tokens,
 							   target_attr, target_elem, typ);
 			break;
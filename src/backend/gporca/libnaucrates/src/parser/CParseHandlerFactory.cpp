@@ -77,6 +77,7 @@ CParseHandlerFactory::Init(CMemoryPool *mp)
 		{EdxltokenCheckConstraint, &CreateMDChkConstraintParseHandler},
 		{EdxltokenRelationStats, &CreateRelStatsParseHandler},
 		{EdxltokenColumnStats, &CreateColStatsParseHandler},
+		{EdxltokenMultiColStats, &CreateMultiColStatsParseHandler},
 		{EdxltokenMetadataIdList, &CreateMDIdListParseHandler},
 		{EdxltokenIndexInfoList, &CreateMDIndexInfoListParseHandler},
 		{EdxltokenMetadataColumns, &CreateMDColsParseHandler},
@@ -501,6 +502,16 @@ CParseHandlerFactory::CreateRelStatsParseHandler(
 		CParseHandlerRelStats(mp, parse_handler_mgr, parse_handler_root);
 }
 
+// creates a parse handler for parsing statistics on groups of columns
+CParseHandlerBase *
+CParseHandlerFactory::CreateMultiColStatsParseHandler(
+	CMemoryPool *mp, CParseHandlerManager *parse_handler_mgr,
+	CParseHandlerBase *parse_handler_root)
+{
+	return GPOS_NEW(mp)
+		CParseHandlerMultiColStats(mp, parse_handler_mgr, parse_handler_root);
+}
+
 // creates a parse handler for parsing column stats
 CParseHandlerBase *
 CParseHandlerFactory::CreateColStatsParseHandler(
@@ -112,11 +112,20 @@ CParseHandlerHint::StartElement(const XMLCh *const,	 //element_uri,
 	ULONG skew_factor = CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
 		m_parse_handler_mgr->GetDXLMemoryManager(), attrs, EdxltokenSkewFactor,
 		EdxltokenHint, true, SKEW_FACTOR);
+	ULONG query_memory_kb = CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
+		m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+		EdxltokenQueryMemoryKB, EdxltokenHint, true, QUERY_MEMORY_KB);
+	ULONG memory_intensive_operators =
+		CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
+			m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+			EdxltokenMemoryIntensiveOperators, EdxltokenHint, true,
+			MEMORY_INTENSIVE_OPERATORS);
 
 	m_hint = GPOS_NEW(m_mp) CHint(
 		join_arity_for_associativity_commutativity, array_expansion_threshold,
 		join_order_dp_threshold, broadcast_threshold, enforce_constraint_on_dml,
-		push_group_by_below_setop_threshold, xform_bind_threshold, skew_factor);
+		push_group_by_below_setop_threshold, xform_bind_threshold, skew_factor,
+		query_memory_kb, memory_intensive_operators);
 }
 
 //---------------------------------------------------------------------------
@@ -39,7 +39,8 @@ CParseHandlerMetadataColumn::CParseHandlerMetadataColumn(
 	  m_mdname(NULL),
 	  m_mdid_type(NULL),
 	  m_dxl_default_val(NULL),
-	  m_width(gpos::ulong_max)
+	  m_width(gpos::ulong_max),
+	  m_compressed_width(-1.0)
 {
 }
 
@@ -121,6 +122,17 @@ CParseHandlerMetadataColumn::StartElement(const XMLCh *const,  // element_uri,
 			EdxltokenColWidth, EdxltokenColDescr);
 	}
 
+	// parse optional compressed width
+	const XMLCh *compressed_width_xml =
+		attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenColCompressedWidth));
+
+	if (NULL != compressed_width_xml)
+	{
+		m_compressed_width = CDXLOperatorFactory::ConvertAttrValueToDouble(
+			m_parse_handler_mgr->GetDXLMemoryManager(), compressed_width_xml,
+			EdxltokenColCompressedWidth, EdxltokenMetadataColumn);
+	}
+
 	m_is_dropped = false;
 	const XMLCh *xmlszDropped =
 		attrs.getValue(CDXLTokens::XmlstrToken(EdxltokenColDropped));
@@ -181,7 +193,8 @@ CParseHandlerMetadataColumn::EndElement(const XMLCh *const,	 // element_uri,
 
 	m_mdcol = GPOS_NEW(m_mp)
 		CMDColumn(m_mdname, m_attno, m_mdid_type, m_type_modifier,
-				  m_is_nullable, m_is_dropped, m_dxl_default_val, m_width);
+				  m_is_nullable, m_is_dropped, m_dxl_default_val, m_width,
+				  m_compressed_width);
 
 	// deactivate handler
 	m_parse_handler_mgr->DeactivateHandler();
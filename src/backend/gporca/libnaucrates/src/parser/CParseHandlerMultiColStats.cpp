@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CParseHandlerMultiColStats.cpp
+//
+//	@doc:
+//		Implementation of the SAX parse handler class for parsing statistics
+//		on groups of columns of a relation
+//---------------------------------------------------------------------------
+
+#include "naucrates/dxl/parser/CParseHandlerMultiColStats.h"
+
+#include "naucrates/dxl/operators/CDXLOperatorFactory.h"
+#include "naucrates/dxl/parser/CParseHandlerFactory.h"
+#include "naucrates/dxl/parser/CParseHandlerManager.h"
+
+using namespace gpdxl;
+using namespace gpmd;
+using namespace gpnaucrates;
+
+XERCES_CPP_NAMESPACE_USE
+
+// ctor
+CParseHandlerMultiColStats::CParseHandlerMultiColStats(
+	CMemoryPool *mp, CParseHandlerManager *parse_handler_mgr,
+	CParseHandlerBase *parse_handler_root)
+	: CParseHandlerMetadataObject(mp, parse_handler_mgr, parse_handler_root),
+	  m_mdid(NULL),
+	  m_mdname(NULL),
+	  m_stats(NULL)
+{
+}
+
+// invoked by Xerces to process an opening tag
+void
+CParseHandlerMultiColStats::StartElement(const XMLCh *const,  // element_uri,
+										 const XMLCh *const element_local_name,
+										 const XMLCh *const,  // element_qname,
+										 const Attributes &attrs)
+{
+	if (0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenMultiColStats),
+				 element_local_name))
+	{
+		GPOS_ASSERT(NULL == m_stats);
+
+		m_mdid = CDXLOperatorFactory::ExtractConvertAttrValueToMdId(
+			m_parse_handler_mgr->GetDXLMemoryManager(), attrs, EdxltokenMdid,
+			EdxltokenMultiColStats);
+
+		const XMLCh *xml_str_name = CDXLOperatorFactory::ExtractAttrValue(
+			attrs, EdxltokenName, EdxltokenMultiColStats);
+		CWStringDynamic *str_name = CDXLUtils::CreateDynamicStringFromXMLChArray(
+			m_parse_handler_mgr->GetDXLMemoryManager(), xml_str_name);
+
+		// create a copy of the string in the CMDName constructor
+		m_mdname = GPOS_NEW(m_mp) CMDName(m_mp, str_name);
+		GPOS_DELETE(str_name);
+
+		m_stats = GPOS_NEW(m_mp) SMultiColStatArray(m_mp);
+	}
+	else if (0 == XMLString::compareString(
+					  CDXLTokens::XmlstrToken(EdxltokenMultiColStat),
+					  element_local_name))
+	{
+		GPOS_ASSERT(NULL != m_stats);
+
+		const XMLCh *xml_str_keys = CDXLOperatorFactory::ExtractAttrValue(
+			attrs, EdxltokenKeys, EdxltokenMultiColStat);
+		ULongPtrArray *keys = CDXLOperatorFactory::ExtractIntsToUlongArray(
+			m_parse_handler_mgr->GetDXLMemoryManager(), xml_str_keys,
+			EdxltokenKeys, EdxltokenMultiColStat);
+
+		CDouble ndistinct = CDXLOperatorFactory::ExtractConvertAttrValueToDouble(
+			m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+			EdxltokenMultiColStatNDistinct, EdxltokenMultiColStat);
+
+		CDouble dependency =
+			CDXLOperatorFactory::ExtractConvertAttrValueToDouble(
+				m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+				EdxltokenMultiColStatDependency, EdxltokenMultiColStat);
+
+		m_stats->Append(GPOS_NEW(m_mp)
+							SMultiColStat(keys, ndistinct, dependency));
+	}
+	else
+	{
+		CWStringDynamic *str = CDXLUtils::CreateDynamicStringFromXMLChArray(
+			m_parse_handler_mgr->GetDXLMemoryManager(), element_local_name);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag,
+				   str->GetBuffer());
+	}
+}
+
+// invoked by Xerces to process a closing tag
+void
+CParseHandlerMultiColStats::EndElement(const XMLCh *const,	// element_uri,
+									   const XMLCh *const element_local_name,
+									   const XMLCh *const  // element_qname
+)
+{
+	if (0 == XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenMultiColStat),
+				 element_local_name))
+	{
+		return;
+	}
+
+	if (0 != XMLString::compareString(
+				 CDXLTokens::XmlstrToken(EdxltokenMultiColStats),
+				 element_local_name))
+	{
+		CWStringDynamic *str = CDXLUtils::CreateDynamicStringFromXMLChArray(
+			m_parse_handler_mgr->GetDXLMemoryManager(), element_local_name);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag,
+				   str->GetBuffer());
+	}
+
+	m_imd_obj =
+		GPOS_NEW(m_mp) CDXLMultiColStats(m_mp, m_mdid, m_mdname, m_stats);
+
+	// deactivate handler
+	m_parse_handler_mgr->DeactivateHandler();
+}
+
+// EOF
@@ -94,10 +94,15 @@ CParseHandlerStatisticsConfig::StartElement(
 		CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
 			m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
 			EdxltokenMaxStatsBuckets, EdxltokenStatisticsConfig);
+	ULONG max_derived_stats_buckets =
+		CDXLOperatorFactory::ExtractConvertAttrValueToUlong(
+			m_parse_handler_mgr->GetDXLMemoryManager(), attrs,
+			EdxltokenMaxDerivedStatsBuckets, EdxltokenStatisticsConfig,
+			true /* is_optional */, 0 /* default_value */);
 
-	m_stats_conf = GPOS_NEW(m_mp)
-		CStatisticsConfig(m_mp, damping_factor_filter, damping_factor_join,
-						  damping_factor_groupby, max_stats_buckets);
+	m_stats_conf = GPOS_NEW(m_mp) CStatisticsConfig(
+		m_mp, damping_factor_filter, damping_factor_join,
+		damping_factor_groupby, max_stats_buckets, max_derived_stats_buckets);
 }
 
 //---------------------------------------------------------------------------
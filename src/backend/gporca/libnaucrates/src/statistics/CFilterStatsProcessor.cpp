@@ -11,10 +11,14 @@
 
 #include "naucrates/statistics/CFilterStatsProcessor.h"
 
+#include "gpopt/base/CColRefTable.h"
+#include "gpopt/base/COptCtxt.h"
+#include "gpopt/mdcache/CMDAccessor.h"
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/operators/CScalarCmp.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
+#include "naucrates/md/IMDMultiColStats.h"
 #include "naucrates/statistics/CBucket.h"
 #include "naucrates/statistics/CJoinStatsProcessor.h"
 #include "naucrates/statistics/CScaleFactorUtils.h"
@@ -315,6 +319,10 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 	CBitSet *filter_colids = GPOS_NEW(mp) CBitSet(mp);
 	CDoubleArray *scale_factors = GPOS_NEW(mp) CDoubleArray(mp);
 
+	// column of each scaling factor, and columns with an equality predicate
+	ULongPtrArray *scale_factor_colids = GPOS_NEW(mp) ULongPtrArray(mp);
+	CBitSet *eq_colids = GPOS_NEW(mp) CBitSet(mp);
+
 	// create copy of the original hash map of colid -> histogram
 	UlongToHistogramMap *result_histograms =
 		CStatisticsUtils::CopyHistHashMap(mp, input_histograms);
@@ -342,6 +350,7 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 				CStatsPredUnsupported::ConvertPredStats(child_pred_stats);
 			scale_factors->Append(
 				GPOS_NEW(mp) CDouble(unsupported_pred_stats->ScaleFactor()));
+			scale_factor_colids->Append(GPOS_NEW(mp) ULONG(gpos::ulong_max));
 
 			continue;
 		}
@@ -351,12 +360,21 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 		if (IsNewStatsColumn(colid, last_colid))
 		{
 			scale_factors->Append(GPOS_NEW(mp) CDouble(last_scale_factor));
+			scale_factor_colids->Append(GPOS_NEW(mp) ULONG(last_colid));
 			last_scale_factor = CDouble(1.0);
 		}
 
 		if (CStatsPred::EsptDisj != child_pred_stats->GetPredStatsType())
 		{
 			GPOS_ASSERT(gpos::ulong_max != colid);
+			if (CStatsPred::EsptPoint == child_pred_stats->GetPredStatsType() &&
+				CStatsPred::EstatscmptEq ==
+					CStatsPredPoint::ConvertPredStats(child_pred_stats)
+						->GetCmpType())
+			{
+				(void) eq_colids->ExchangeSet(colid);
+			}
+
 			hist_before = result_histograms->Find(&colid)->CopyHistogram();
 			GPOS_ASSERT(NULL != hist_before);
 
@@ -441,15 +459,22 @@ CFilterStatsProcessor::MakeHistHashMapConjFilter(
 
 	// scaling factor of the last predicate
 	scale_factors->Append(GPOS_NEW(mp) CDouble(last_scale_factor));
+	scale_factor_colids->Append(GPOS_NEW(mp) ULONG(last_colid));
 
 	GPOS_ASSERT(NULL != scale_factors);
-	CScaleFactorUtils::SortScalingFactor(scale_factors, true /* fDescending */);
+	CDoubleArray *dependent_scale_factors =
+		ApplyDependencies(mp, scale_factors, scale_factor_colids, eq_colids);
+	CScaleFactorUtils::SortScalingFactor(dependent_scale_factors,
+										 true /* fDescending */);
 
 	*scale_factor = CScaleFactorUtils::CalcScaleFactorCumulativeConj(
-		stats_config, scale_factors);
+		stats_config, dependent_scale_factors);
 
 	// clean up
+	dependent_scale_factors->Release();
 	scale_factors->Release();
+	scale_factor_colids->Release();
+	eq_colids->Release();
 	filter_colids->Release();
 
 	return result_histograms;
@@ -767,41 +792,227 @@ CFilterStatsProcessor::MakeHistLikeFilter(CStatsPredLike *pred_stats,
 	return result_histogram;
 }
 
-// create a new histograms after applying the ArrayCmp filter
-CHistogram *
-CFilterStatsProcessor::MakeHistArrayCmpAnyFilter(CMemoryPool *mp,
-												 CStatsPredArrayCmp *pred_stats,
-												 CBitSet *filter_colids,
-												 CHistogram *base_histogram,
-												 CDouble *last_scale_factor,
-												 ULONG *target_last_colid)
+// LINT mapping of datums, compared as in IDatum::StatsAreEqual and
+// IDatum::StatsAreLessThan
+struct SLintMapping
 {
-	GPOS_ASSERT(NULL != pred_stats);
-	GPOS_ASSERT(NULL != filter_colids);
-	GPOS_ASSERT(NULL != base_histogram);
-	GPOS_ASSERT(pred_stats->GetCmpType() == CStatsPred::EstatscmptEq);
+	typedef LINT Value;
 
-	// Evaluate statistics for "select * from foo where a in (...)" as
-	// "select * from foo join (values (...)) x(a) on foo.a=x.a"
-	// as long as the list is deduplicated
-	//
-	// General algorithm:
-	// 1. Construct a histogram with the same bucket boundaries as present in the
-	//    base_histogram.
-	//    This is better than using a singleton bucket per point, because it that
-	//    case, the frequency of each bucket is so small, it is often less than
-	//    CStatistics::Epsilon, and may be considered as 0, leading to
-	//    cardinality misestimation. Using the same buckets as base_histogram
-	//    also aids in joining histogram later.
-	// 2. Compute the normalized frequency for each bucket based on the number of points (NDV)
-	//    present within each bucket boundary. NB: the points must be de-duplicated
-	//    beforehand to prevent double counting.
-	// 3. Join this "dummy_histogram" with the base_histogram to determine the buckets
-	//    from base_histogram that should be selected.
-	// 4. Compute and adjust the resultant scale factor for the filter.
+	static BOOL
+	IsMappable(const IDatum *datum)
+	{
+		return datum->IsDatumMappableToLINT();
+	}
+
+	static LINT
+	Map(const IDatum *datum)
+	{
+		return datum->GetLINTMapping();
+	}
+
+	static BOOL
+	Equals(LINT left, LINT right)
+	{
+		return left == right;
+	}
+
+	static BOOL
+	IsLessThan(LINT left, LINT right)
+	{
+		return left < right;
+	}
+
+	static INT
+	Compare(const void *left, const void *right)
+	{
+		LINT left_value = *(const LINT *) left;
+		LINT right_value = *(const LINT *) right;
+		return (left_value > right_value) - (left_value < right_value);
+	}
+};
+
+// double mapping of datums that are not mapped to LINT, compared as in
+// IDatum::StatsAreEqual and IDatum::StatsAreLessThan
+struct SDoubleMapping
+{
+	typedef DOUBLE Value;
+
+	static BOOL
+	IsMappable(const IDatum *datum)
+	{
+		return !datum->IsDatumMappableToLINT() &&
+			   datum->IsDatumMappableToDouble();
+	}
+
+	static DOUBLE
+	Map(const IDatum *datum)
+	{
+		return datum->GetDoubleMapping().Get();
+	}
+
+	static BOOL
+	Equals(DOUBLE left, DOUBLE right)
+	{
+		return (CDouble(left) - CDouble(right)).Absolute() <=
+			   CStatistics::Epsilon;
+	}
+
+	static BOOL
+	IsLessThan(DOUBLE left, DOUBLE right)
+	{
+		return CDouble(right) - CDouble(left) > CStatistics::Epsilon;
+	}
+
+	static INT
+	Compare(const void *left, const void *right)
+	{
+		DOUBLE left_value = *(const DOUBLE *) left;
+		DOUBLE right_value = *(const DOUBLE *) right;
+		return (left_value > right_value) - (left_value < right_value);
+	}
+};
+
+// Count the distinct points of an IN list that fall in each bucket, like
+// CFilterStatsProcessor::CountPointsPerBucket, but on the mapped values of
+// the points and bucket bounds instead of their datums. Returns false,
+// without counting, if any of them is not of the bucket type or cannot be
+// mapped.
+template <class Mapping>
+static BOOL
+FCountMappedPointsPerBucket(CMemoryPool *mp, const CPointArray *points,
+							const CBucketArray *buckets, ULONG *bucket_ndvs,
+							ULONG *num_distinct_points, ULONG *ndv_remain)
+{
+	typedef typename Mapping::Value Value;
+
+	const ULONG num_buckets = buckets->Size();
+	const ULONG num_points = points->Size();
+	if (0 == num_buckets || 0 == num_points)
+	{
+		return false;
+	}
+
+	const IMDId *mdid = (*buckets)[0]->GetLowerBound()->GetDatum()->MDId();
+	Value *lower_bounds = GPOS_NEW_ARRAY(mp, Value, num_buckets);
+	Value *upper_bounds = GPOS_NEW_ARRAY(mp, Value, num_buckets);
+	Value *values = GPOS_NEW_ARRAY(mp, Value, num_points);
+
+	BOOL is_mappable = true;
+	for (ULONG ul = 0; is_mappable && ul < num_buckets; ul++)
+	{
+		const IDatum *lower = (*buckets)[ul]->GetLowerBound()->GetDatum();
+		const IDatum *upper = (*buckets)[ul]->GetUpperBound()->GetDatum();
+		is_mappable = mdid->Equals(lower->MDId()) &&
+					  mdid->Equals(upper->MDId()) &&
+					  Mapping::IsMappable(lower) && Mapping::IsMappable(upper);
+		if (is_mappable)
+		{
+			lower_bounds[ul] = Mapping::Map(lower);
+			upper_bounds[ul] = Mapping::Map(upper);
+		}
+	}
+
+	ULONG num_values = 0;
+	for (ULONG ul = 0; is_mappable && ul < num_points; ul++)
+	{
+		const IDatum *datum = (*points)[ul]->GetDatum();
+		if (datum->IsNull())
+		{
+			continue;
+		}
+		is_mappable =
+			mdid->Equals(datum->MDId()) && Mapping::IsMappable(datum);
+		if (is_mappable)
+		{
+			values[num_values++] = Mapping::Map(datum);
+		}
+	}
+
+	if (is_mappable)
+	{
+		// sort and de-duplicate the mapped values
+		clib::Qsort(values, num_values, sizeof(Value), Mapping::Compare);
+		ULONG num_distinct = 0;
+		for (ULONG ul = 0; ul < num_values; ul++)
+		{
+			if (0 == num_distinct ||
+				!Mapping::Equals(values[num_distinct - 1], values[ul]))
+			{
+				values[num_distinct++] = values[ul];
+			}
+		}
+
+		// merge the values with the buckets, see CBucket::IsBefore,
+		// CBucket::IsAfter and CBucket::Contains
+		ULONG point_iter = 0;
+		for (ULONG ul = 0; ul < num_buckets; ul++)
+		{
+			const CBucket *bucket = (*buckets)[ul];
+			const BOOL is_lower_closed = bucket->IsLowerClosed();
+			const BOOL is_upper_closed = bucket->IsUpperClosed();
+			const Value lower = lower_bounds[ul];
+			const Value upper = upper_bounds[ul];
+			const BOOL is_singleton = Mapping::Equals(lower, upper);
+			bucket_ndvs[ul] = 0;
+
+			while (point_iter < num_distinct &&
+				   (Mapping::IsLessThan(values[point_iter], lower) ||
+					(!is_lower_closed &&
+					 Mapping::Equals(lower, values[point_iter]))))
+			{
+				(*ndv_remain)++;
+				point_iter++;
+			}
 
+			while (point_iter < num_distinct)
+			{
+				const Value value = values[point_iter];
+				BOOL contains = false;
+				if (is_singleton)
+				{
+					contains = Mapping::Equals(lower, value);
+				}
+				else
+				{
+					contains =
+						(is_lower_closed && Mapping::Equals(lower, value)) ||
+						(is_upper_closed && Mapping::Equals(upper, value)) ||
+						(Mapping::IsLessThan(lower, value) &&
+						 Mapping::IsLessThan(value, upper));
+				}
+
+				if (!contains)
+				{
+					break;
+				}
+
+				bucket_ndvs[ul]++;
+				point_iter++;
+			}
+		}
+
+		*ndv_remain += num_distinct - point_iter;
+		*num_distinct_points = num_distinct;
+	}
+
+	GPOS_DELETE_ARRAY(lower_bounds);
+	GPOS_DELETE_ARRAY(upper_bounds);
+	GPOS_DELETE_ARRAY(values);
+
+	return is_mappable;
+}
+
+// count the distinct points of an IN list that fall in each bucket, and
+// the points that fall in none of them
+void
+CFilterStatsProcessor::CountPointsPerBucket(CMemoryPool *mp,
+											CPointArray *points,
+											const CBucketArray *buckets,
+											ULONG *bucket_ndvs,
+											ULONG *num_distinct_points,
+											ULONG *ndv_remain)
+{
 	// First, de-duplicate the constants in the array list
-	CPointArray *points = pred_stats->GetPoints();
 	if (points->Size() > 1)
 	{
 		points->Sort(&CUtils::CPointCmp);
@@ -827,27 +1038,18 @@ CFilterStatsProcessor::MakeHistArrayCmpAnyFilter(CMemoryPool *mp,
 		deduped_points->Append(point);
 		prev_datum = datum;
 	}
-	CDouble dummy_rows(deduped_points->Size());
 
-	// Create buckets for the result histogram using the same bucket boundaries
-	// as in the base histogram.
-	CBucketArray *dummy_histogram_buckets =
-		CHistogram::DeepCopyHistogramBuckets(mp, base_histogram->GetBuckets());
 	ULONG point_iter = 0;
-	ULONG ndv_remain = 0;
-	for (ULONG bucket_iter = 0; bucket_iter < dummy_histogram_buckets->Size();
-		 ++bucket_iter)
+	for (ULONG bucket_iter = 0; bucket_iter < buckets->Size(); ++bucket_iter)
 	{
-		CBucket *bucket = (*dummy_histogram_buckets)[bucket_iter];
-		bucket->SetFrequency(CDouble(0.0));
-		bucket->SetDistinct(CDouble(0.0));
-		ULONG ndv = 0;
+		CBucket *bucket = (*buckets)[bucket_iter];
+		bucket_ndvs[bucket_iter] = 0;
 
 		// ignore datums that are before the bucket, add it to ndv_remain
 		while (point_iter < deduped_points->Size() &&
 			   bucket->IsBefore((*deduped_points)[point_iter]))
 		{
-			ndv_remain++;
+			(*ndv_remain)++;
 			point_iter++;
 		}
 		// if the point is after the bucket, move to the next bucket
@@ -861,20 +1063,94 @@ CFilterStatsProcessor::MakeHistArrayCmpAnyFilter(CMemoryPool *mp,
 		while (point_iter < deduped_points->Size() &&
 			   bucket->Contains((*deduped_points)[point_iter]))
 		{
-			ndv++;
+			bucket_ndvs[bucket_iter]++;
 			point_iter++;
 		}
-
-		// set frequency based on matched points
-		bucket->SetFrequency(CDouble(ndv) / dummy_rows);
-		bucket->SetDistinct(CDouble(ndv));
 	}
 
 	// if we have gone through all the buckets, and there are still points, add them to ndv_remain
-	if (point_iter < deduped_points->Size())
+	*ndv_remain += deduped_points->Size() - point_iter;
+	*num_distinct_points = deduped_points->Size();
+
+	deduped_points->Release();
+}
+
+// create a new histograms after applying the ArrayCmp filter
+CHistogram *
+CFilterStatsProcessor::MakeHistArrayCmpAnyFilter(CMemoryPool *mp,
+												 CStatsPredArrayCmp *pred_stats,
+												 CBitSet *filter_colids,
+												 CHistogram *base_histogram,
+												 CDouble *last_scale_factor,
+												 ULONG *target_last_colid)
+{
+	GPOS_ASSERT(NULL != pred_stats);
+	GPOS_ASSERT(NULL != filter_colids);
+	GPOS_ASSERT(NULL != base_histogram);
+	GPOS_ASSERT(pred_stats->GetCmpType() == CStatsPred::EstatscmptEq);
+
+	// Evaluate statistics for "select * from foo where a in (...)" as
+	// "select * from foo join (values (...)) x(a) on foo.a=x.a"
+	// as long as the list is deduplicated
+	//
+	// General algorithm:
+	// 1. Construct a histogram with the same bucket boundaries as present in the
+	//    base_histogram.
+	//    This is better than using a singleton bucket per point, because it that
+	//    case, the frequency of each bucket is so small, it is often less than
+	//    CStatistics::Epsilon, and may be considered as 0, leading to
+	//    cardinality misestimation. Using the same buckets as base_histogram
+	//    also aids in joining histogram later.
+	// 2. Compute the normalized frequency for each bucket based on the number of points (NDV)
+	//    present within each bucket boundary. NB: the points must be de-duplicated
+	//    beforehand to prevent double counting.
+	// 3. Join this "dummy_histogram" with the base_histogram to determine the buckets
+	//    from base_histogram that should be selected.
+	// 4. Compute and adjust the resultant scale factor for the filter.
+
+	// Count the points in each bucket of the base histogram. IN lists can
+	// have tens of thousands of constants, so when the constants and bucket
+	// bounds are mapped to LINT or double, sort and merge those values
+	// instead of the datums.
+	CPointArray *points = pred_stats->GetPoints();
+	const CBucketArray *base_buckets = base_histogram->GetBuckets();
+	const ULONG num_buckets = base_buckets->Size();
+	ULONG *bucket_ndvs = GPOS_NEW_ARRAY(mp, ULONG, num_buckets);
+	ULONG num_distinct_points = 0;
+	ULONG ndv_remain = 0;
+
+	if (!FCountMappedPointsPerBucket<SLintMapping>(
+			mp, points, base_buckets, bucket_ndvs, &num_distinct_points,
+			&ndv_remain) &&
+		!FCountMappedPointsPerBucket<SDoubleMapping>(
+			mp, points, base_buckets, bucket_ndvs, &num_distinct_points,
+			&ndv_remain))
 	{
-		ndv_remain += deduped_points->Size() - point_iter;
+		CountPointsPerBucket(mp, points, base_buckets, bucket_ndvs,
+							 &num_distinct_points, &ndv_remain);
 	}
+	CDouble dummy_rows(num_distinct_points);
+
+	// Create buckets for the result histogram using the same bucket boundaries
+	// as in the base histogram, with frequency based on the matched points
+	CBucketArray *dummy_histogram_buckets = GPOS_NEW(mp) CBucketArray(mp);
+	for (ULONG ul = 0; ul < num_buckets; ++ul)
+	{
+		CBucket *bucket = (*base_buckets)[ul];
+		CDouble ndv(bucket_ndvs[ul]);
+		CDouble frequency(0.0);
+		if (0 < bucket_ndvs[ul])
+		{
+			frequency = ndv / dummy_rows;
+		}
+
+		bucket->GetLowerBound()->AddRef();
+		bucket->GetUpperBound()->AddRef();
+		dummy_histogram_buckets->Append(GPOS_NEW(mp) CBucket(
+			bucket->GetLowerBound(), bucket->GetUpperBound(),
+			bucket->IsLowerClosed(), bucket->IsUpperClosed(), frequency, ndv));
+	}
+	GPOS_DELETE_ARRAY(bucket_ndvs);
 
 	CDouble freq_remain(0.0);
 	if (ndv_remain != 0)
@@ -886,8 +1162,7 @@ CFilterStatsProcessor::MakeHistArrayCmpAnyFilter(CMemoryPool *mp,
 				   CDouble(0.0) /* null_freq */,
 				   CDouble(ndv_remain) /* distinct_remain */, freq_remain);
 	// dummy histogram should already be normalized since each bucket's frequency
-	// is already adjusted by a scale factor of 1/dummy_rows to avoid unnecessarily
-	// deep-copying the histogram buckets
+	// is already adjusted by a scale factor of 1/dummy_rows
 	GPOS_ASSERT(dummy_histogram->IsValid() &&
 				dummy_histogram->GetNumDistinct() - dummy_rows <
 					CStatistics::Epsilon);
@@ -913,7 +1188,6 @@ CFilterStatsProcessor::MakeHistArrayCmpAnyFilter(CMemoryPool *mp,
 
 	// clean up
 	GPOS_DELETE(dummy_histogram);
-	deduped_points->Release();
 
 	return result_histogram;
 }
@@ -925,4 +1199,188 @@ CFilterStatsProcessor::IsNewStatsColumn(ULONG colid, ULONG last_colid)
 	return (gpos::ulong_max == colid || colid != last_colid);
 }
 
+// Combine the scaling factors of equality predicates on the columns of a
+// group for which ANALYZE collected the degree d to which the last column is
+// determined by the others. The selectivity of the group is
+// s_lead * (d + (1 - d) * s_last) instead of the product of the selectivities
+// of its columns, where s_lead is the selectivity of the leading columns.
+// Larger groups are used first, and each predicate is part of at most one
+// group. The columns of a group must come from the same instance of the
+// table: in a self-join, the columns of the two instances are not
+// correlated.
+CDoubleArray *
+CFilterStatsProcessor::ApplyDependencies(CMemoryPool *mp,
+										 CDoubleArray *scale_factors,
+										 ULongPtrArray *scale_factor_colids,
+										 CBitSet *eq_colids)
+{
+	GPOS_ASSERT(scale_factors->Size() == scale_factor_colids->Size());
+
+	scale_factors->AddRef();
+	if (2 > eq_colids->Size() || GPOS_FTRACE(EopttraceDisableMultiColStats))
+	{
+		return scale_factors;
+	}
+
+	CColumnFactory *col_factory = COptCtxt::PoctxtFromTLS()->Pcf();
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+
+	// table, table instance and attribute number of the columns of the
+	// equality predicates
+	const ULONG size = scale_factors->Size();
+	IMDId **rel_mdids = GPOS_NEW_ARRAY(mp, IMDId *, size);
+	ULONG *source_ids = GPOS_NEW_ARRAY(mp, ULONG, size);
+	INT *attnos = GPOS_NEW_ARRAY(mp, INT, size);
+	BOOL *combined = GPOS_NEW_ARRAY(mp, BOOL, size);
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		rel_mdids[ul] = NULL;
+		source_ids[ul] = gpos::ulong_max;
+		attnos[ul] = 0;
+		combined[ul] = false;
+
+		ULONG colid = *(*scale_factor_colids)[ul];
+		if (gpos::ulong_max == colid || !eq_colids->Get(colid))
+		{
+			continue;
+		}
+
+		CColRef *colref = col_factory->LookupColRef(colid);
+		if (NULL == colref || CColRef::EcrtTable != colref->Ecrt())
+		{
+			continue;
+		}
+
+		IMDId *rel_mdid = colref->GetMdidTable();
+		if (NULL != rel_mdid && (IMDId::EmdidGeneral == rel_mdid->MdidType() ||
+								 IMDId::EmdidRel == rel_mdid->MdidType()))
+		{
+			rel_mdids[ul] = rel_mdid;
+			source_ids[ul] = CColRefTable::PcrConvert(colref)->UlSourceOpId();
+			attnos[ul] = CColRefTable::PcrConvert(colref)->AttrNum();
+		}
+	}
+
+	CDoubleArray *result = GPOS_NEW(mp) CDoubleArray(mp);
+	for (ULONG ulRel = 0; ulRel < size; ulRel++)
+	{
+		IMDId *rel_mdid = rel_mdids[ulRel];
+		const ULONG source_id = source_ids[ulRel];
+		BOOL seen = (NULL == rel_mdid);
+		for (ULONG ul = 0; !seen && ul < ulRel; ul++)
+		{
+			seen = (NULL != rel_mdids[ul] && source_id == source_ids[ul] &&
+					rel_mdid->Equals(rel_mdids[ul]));
+		}
+		if (seen)
+		{
+			// no predicate or table instance already processed
+			continue;
+		}
+
+		const IMDMultiColStats *multicol_stats =
+			md_accessor->RetrieveMultiColStats(rel_mdid);
+		const ULONG num_groups = multicol_stats->Size();
+		while (true)
+		{
+			ULONG best_group = gpos::ulong_max;
+			ULONG best_size = 0;
+			for (ULONG ulGroup = 0; ulGroup < num_groups; ulGroup++)
+			{
+				const ULongPtrArray *keys = multicol_stats->GetKeys(ulGroup);
+				BOOL covered = (keys->Size() > best_size);
+				for (ULONG ulKey = 0; covered && ulKey < keys->Size(); ulKey++)
+				{
+					covered =
+						gpos::ulong_max !=
+						FindUncombinedEqCol(rel_mdids, source_ids, attnos,
+											combined, size, rel_mdid, source_id,
+											(INT) * (*keys)[ulKey]);
+				}
+
+				if (covered)
+				{
+					best_group = ulGroup;
+					best_size = keys->Size();
+				}
+			}
+
+			if (gpos::ulong_max == best_group)
+			{
+				break;
+			}
+
+			const ULongPtrArray *keys = multicol_stats->GetKeys(best_group);
+			CDouble lead_selectivity(1.0);
+			CDouble last_selectivity(1.0);
+			for (ULONG ulKey = 0; ulKey < keys->Size(); ulKey++)
+			{
+				ULONG pos =
+					FindUncombinedEqCol(rel_mdids, source_ids, attnos, combined,
+										size, rel_mdid, source_id,
+										(INT) * (*keys)[ulKey]);
+				combined[pos] = true;
+
+				CDouble selectivity = CDouble(1.0) / *(*scale_factors)[pos];
+				if (ulKey + 1 < keys->Size())
+				{
+					lead_selectivity = lead_selectivity * selectivity;
+				}
+				else
+				{
+					last_selectivity = selectivity;
+				}
+			}
+
+			CDouble dependency = std::min(
+				1.0, std::max(0.0, multicol_stats->GetDependency(best_group)
+									   .Get()));
+			CDouble selectivity =
+				lead_selectivity *
+				(dependency + (CDouble(1.0) - dependency) * last_selectivity);
+			result->Append(GPOS_NEW(mp) CDouble(
+				CDouble(1.0) / std::max(selectivity.Get(),
+										CStatistics::Epsilon.Get())));
+		}
+	}
+
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		if (!combined[ul])
+		{
+			result->Append(GPOS_NEW(mp) CDouble(*(*scale_factors)[ul]));
+		}
+	}
+
+	GPOS_DELETE_ARRAY(rel_mdids);
+	GPOS_DELETE_ARRAY(source_ids);
+	GPOS_DELETE_ARRAY(attnos);
+	GPOS_DELETE_ARRAY(combined);
+	scale_factors->Release();
+
+	return result;
+}
+
+// position of a not yet combined equality predicate on the given column of
+// the given table instance, or gpos::ulong_max
+ULONG
+CFilterStatsProcessor::FindUncombinedEqCol(IMDId **rel_mdids,
+										   const ULONG *source_ids,
+										   const INT *attnos,
+										   const BOOL *combined, ULONG size,
+										   IMDId *rel_mdid, ULONG source_id,
+										   INT attno)
+{
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		if (!combined[ul] && NULL != rel_mdids[ul] && attno == attnos[ul] &&
+			source_id == source_ids[ul] && rel_mdid->Equals(rel_mdids[ul]))
+		{
+			return ul;
+		}
+	}
+
+	return gpos::ulong_max;
+}
+
 // EOF
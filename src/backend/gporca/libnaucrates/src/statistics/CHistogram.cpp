@@ -12,6 +12,7 @@
 
 #include "naucrates/statistics/CHistogram.h"
 
+#include "gpos/common/CWallClock.h"
 #include "gpos/common/syslibwrapper.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
@@ -493,6 +494,43 @@ CHistogram::GetNumDistinct() const
 	return distinct + distinct_null + m_distinct_remaining;
 }
 
+// frequency of the most frequent value, relative to the total frequency;
+// values within a bucket are assumed to be equally frequent, and NULLs
+// count as a single value
+CDouble
+CHistogram::GetMaxValueFrequency() const
+{
+	CDouble max_freq(0.0);
+	const ULONG num_of_buckets = m_histogram_buckets->Size();
+	for (ULONG bucket_index = 0; bucket_index < num_of_buckets; bucket_index++)
+	{
+		CBucket *bucket = (*m_histogram_buckets)[bucket_index];
+		CDouble value_freq = bucket->GetFrequency() /
+							 std::max(bucket->GetNumDistinct(), CDouble(1.0));
+		max_freq = std::max(max_freq, value_freq);
+	}
+
+	if (CStatistics::Epsilon < m_null_freq)
+	{
+		max_freq = std::max(max_freq, m_null_freq);
+	}
+
+	if (CStatistics::Epsilon < m_freq_remaining)
+	{
+		CDouble value_freq =
+			m_freq_remaining / std::max(m_distinct_remaining, CDouble(1.0));
+		max_freq = std::max(max_freq, value_freq);
+	}
+
+	CDouble total_freq = GetFrequency();
+	if (total_freq <= CStatistics::Epsilon)
+	{
+		return CDouble(0.0);
+	}
+
+	return max_freq / total_freq;
+}
+
 // cap the total number of distinct values (NDVs) in buckets to the number of rows
 // creates new histogram of buckets, as this modifies individual buckets in the array
 void
@@ -711,6 +749,8 @@ CHistogram::MakeJoinHistogramNormalize(CStatsPred::EStatsCmpType stats_cmp_type,
 	*scale_factor =
 		std::min((*scale_factor).Get(), cartesian_product_num_rows.Get());
 
+	result_histogram->CompactBuckets();
+
 	GPOS_ASSERT(result_histogram->IsValid());
 	return result_histogram;
 }
@@ -1525,6 +1565,7 @@ CHistogram::MakeUnionAllHistogramNormalize(CDouble rows,
 		CHistogram(m_mp, result_buckets, true /*is_well_defined*/,
 				   new_null_freq, distinct_remaining, freq_remaining);
 	(void) result_histogram->NormalizeHistogram();
+	result_histogram->CompactBuckets();
 	GPOS_ASSERT(result_histogram->IsValid());
 
 	new_buckets->Release();
@@ -1749,12 +1790,45 @@ CHistogram::CombineBuckets(CMemoryPool *mp, CBucketArray *buckets,
 				CDouble(0.0) + CStatistics::Epsilon);
 #endif
 
-	GPOS_ASSERT(result_buckets->Size() == desired_num_buckets);
+	// only buckets that share a boundary are merged, so there may be fewer
+	// candidates than needed
+	GPOS_ASSERT(result_buckets->Size() >= desired_num_buckets);
 	indexes_to_merge->Release();
 	boundary_factors->Release();
 	return result_buckets;
 }
 
+// Each join or union splits buckets at the boundaries of both inputs, so
+// without a bound the histograms derived for deep join trees keep growing.
+// Merge the buckets that carry the least information, as CombineBuckets
+// does, which keeps the total frequency and NDV of the histogram.
+void
+CHistogram::CompactBuckets()
+{
+	COptCtxt *poctxt = COptCtxt::PoctxtFromTLS();
+	const ULONG max_num_buckets = poctxt->GetOptimizerConfig()
+									  ->GetStatsConf()
+									  ->UlMaxDerivedStatsBuckets();
+	const ULONG num_buckets = GetNumBuckets();
+
+	if (0 == max_num_buckets || num_buckets <= max_num_buckets)
+	{
+		poctxt->RecordDerivedHistogram(num_buckets, num_buckets,
+									   0 /* compaction_us */);
+		return;
+	}
+
+	CWallClock clock;
+	CBucketArray *compacted_buckets =
+		CombineBuckets(m_mp, m_histogram_buckets, max_num_buckets);
+	m_histogram_buckets->Release();
+	m_histogram_buckets = compacted_buckets;
+	m_skew_was_measured = false;
+
+	poctxt->RecordDerivedHistogram(num_buckets, GetNumBuckets(),
+								   clock.ElapsedUS());
+}
+
 // cleanup residual buckets
 void
 CHistogram::CleanupResidualBucket(CBucket *bucket,
@@ -1944,6 +2018,7 @@ CHistogram::MakeUnionHistogramNormalize(CDouble rows,
 		m_mp, result_buckets, true /* is_well_defined */, null_freq,
 		num_NDV_remain, NDV_remain_freq, false /* is_col_stats_missing */
 	);
+	result_histogram->CompactBuckets();
 
 	// clean up
 	num_tuples_per_bucket->Release();
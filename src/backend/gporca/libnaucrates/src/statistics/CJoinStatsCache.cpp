@@ -0,0 +1,239 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CJoinStatsCache.cpp
+//
+//	@doc:
+//		Per-optimization cache of inner join statistics
+//---------------------------------------------------------------------------
+
+#include "naucrates/statistics/CJoinStatsCache.h"
+
+#include "gpos/error/CAutoTrace.h"
+
+#include "gpopt/base/CUtils.h"
+#include "gpopt/operators/CLogicalNAryJoin.h"
+#include "gpopt/operators/CPredicateUtils.h"
+#include "naucrates/statistics/CJoinStatsProcessor.h"
+#include "naucrates/traceflags/traceflags.h"
+
+using namespace gpnaucrates;
+
+// ctor
+CJoinStatsCache::CSignature::CSignature(CBitSet *atoms,
+										CExpressionArray *conjuncts,
+										BOOL scale_factor_from_buckets)
+	: m_atoms(atoms),
+	  m_conjuncts(conjuncts),
+	  m_scale_factor_from_buckets(scale_factor_from_buckets)
+{
+	GPOS_ASSERT(NULL != atoms);
+	GPOS_ASSERT(NULL != conjuncts);
+}
+
+// dtor
+CJoinStatsCache::CSignature::~CSignature()
+{
+	m_atoms->Release();
+	m_conjuncts->Release();
+}
+
+// add the atoms and conjuncts of the given signature
+void
+CJoinStatsCache::CSignature::Include(const CSignature *signature)
+{
+	m_atoms->Union(signature->m_atoms);
+
+	const ULONG size = signature->m_conjuncts->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		AddConjunct((*signature->m_conjuncts)[ul]);
+	}
+}
+
+// add a join conjunct, unless it is already there
+void
+CJoinStatsCache::CSignature::AddConjunct(CExpression *conjunct)
+{
+	if (CUtils::FScalarConstTrue(conjunct) ||
+		CUtils::FEqualAny(conjunct, m_conjuncts))
+	{
+		return;
+	}
+
+	conjunct->AddRef();
+	m_conjuncts->Append(conjunct);
+}
+
+// hash function; conjuncts are combined independently of their order
+ULONG
+CJoinStatsCache::CSignature::HashValue(const CSignature *signature)
+{
+	ULONG conjuncts_hash = 0;
+	const ULONG size = signature->m_conjuncts->Size();
+	for (ULONG ul = 0; ul < size; ul++)
+	{
+		conjuncts_hash += CExpression::HashValue((*signature->m_conjuncts)[ul]);
+	}
+
+	return gpos::CombineHashes(
+		gpos::CombineHashes(signature->m_atoms->HashValue(), conjuncts_hash),
+		gpos::HashValue<BOOL>(&signature->m_scale_factor_from_buckets));
+}
+
+// equality function; conjunct arrays have no duplicates, so containment
+// and equal sizes mean they hold the same set of conjuncts
+BOOL
+CJoinStatsCache::CSignature::Equals(const CSignature *first,
+									const CSignature *second)
+{
+	return first->m_scale_factor_from_buckets ==
+			   second->m_scale_factor_from_buckets &&
+		   first->m_atoms->Equals(second->m_atoms) &&
+		   first->m_conjuncts->Size() == second->m_conjuncts->Size() &&
+		   CUtils::Contains(first->m_conjuncts, second->m_conjuncts);
+}
+
+// ctor
+CJoinStatsCache::CJoinStatsCache(CMemoryPool *mp)
+	: m_mp(mp),
+	  m_stats_to_signature(NULL),
+	  m_signature_to_stats(NULL),
+	  m_next_atom_id(0),
+	  m_lookups(0),
+	  m_hits(0)
+{
+	m_stats_to_signature = GPOS_NEW(mp) StatsToSignatureMap(mp);
+	m_signature_to_stats = GPOS_NEW(mp) SignatureToStatsMap(mp);
+}
+
+// dtor
+CJoinStatsCache::~CJoinStatsCache()
+{
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	{
+		CAutoTrace at(m_mp);
+		at.Os() << "[OPT]: Join statistics lookups: " << m_lookups
+				<< ", cache hits: " << m_hits;
+	}
+
+	m_signature_to_stats->Release();
+	m_stats_to_signature->Release();
+}
+
+// only inner joins can be combined in any order
+BOOL
+CJoinStatsCache::FCacheable(COperator *pop)
+{
+	switch (pop->Eopid())
+	{
+		case COperator::EopLogicalInnerJoin:
+			return true;
+
+		case COperator::EopLogicalNAryJoin:
+			return NULL ==
+				   CLogicalNAryJoin::PopConvert(pop)->GetLojChildPredIndexes();
+
+		default:
+			return false;
+	}
+}
+
+// signature of the given join input, registering it as an atom if needed
+CJoinStatsCache::CSignature *
+CJoinStatsCache::PsignatureInput(IStatistics *stats)
+{
+	CSignature *signature = m_stats_to_signature->Find(stats);
+	if (NULL == signature)
+	{
+		CBitSet *atoms = GPOS_NEW(m_mp) CBitSet(m_mp);
+		atoms->ExchangeSet(m_next_atom_id++);
+		signature = GPOS_NEW(m_mp)
+			CSignature(atoms, GPOS_NEW(m_mp) CExpressionArray(m_mp),
+					   CJoinStatsProcessor::
+						   ComputeScaleFactorFromHistogramBuckets());
+
+		stats->AddRef();
+		BOOL fInserted GPOS_ASSERTS_ONLY =
+			m_stats_to_signature->Insert(stats, signature);
+		GPOS_ASSERT(fInserted);
+	}
+
+	return signature;
+}
+
+// look up the statistics of joining the given inputs under the given predicate
+IStatistics *
+CJoinStatsCache::PstatsLookup(IStatisticsArray *statistics_array,
+							  CExpression *join_pred_expr,
+							  CSignature **signature)
+{
+	GPOS_ASSERT(NULL != statistics_array);
+	GPOS_ASSERT(NULL != join_pred_expr);
+	GPOS_ASSERT(NULL != signature);
+
+	CSignature *join_signature = GPOS_NEW(m_mp)
+		CSignature(GPOS_NEW(m_mp) CBitSet(m_mp),
+				   GPOS_NEW(m_mp) CExpressionArray(m_mp),
+				   CJoinStatsProcessor::ComputeScaleFactorFromHistogramBuckets());
+
+	const ULONG num_stats = statistics_array->Size();
+	for (ULONG ul = 0; ul < num_stats; ul++)
+	{
+		join_signature->Include(PsignatureInput((*statistics_array)[ul]));
+	}
+
+	CExpressionArray *conjuncts =
+		CPredicateUtils::PdrgpexprConjuncts(m_mp, join_pred_expr);
+	const ULONG num_conjuncts = conjuncts->Size();
+	for (ULONG ul = 0; ul < num_conjuncts; ul++)
+	{
+		join_signature->AddConjunct((*conjuncts)[ul]);
+	}
+	conjuncts->Release();
+
+	m_lookups++;
+	IStatistics *stats = m_signature_to_stats->Find(join_signature);
+	if (NULL != stats)
+	{
+		m_hits++;
+		join_signature->Release();
+		stats->AddRef();
+
+		*signature = NULL;
+		return stats;
+	}
+
+	*signature = join_signature;
+	return NULL;
+}
+
+// cache the statistics derived for the given signature
+void
+CJoinStatsCache::Insert(CSignature *signature, IStatistics *stats)
+{
+	GPOS_ASSERT(NULL != signature);
+	GPOS_ASSERT(NULL != stats);
+
+	// remember how the statistics were derived, for joins that use them
+	// as an input
+	if (NULL == m_stats_to_signature->Find(stats))
+	{
+		stats->AddRef();
+		signature->AddRef();
+		BOOL fInserted GPOS_ASSERTS_ONLY =
+			m_stats_to_signature->Insert(stats, signature);
+		GPOS_ASSERT(fInserted);
+	}
+
+	stats->AddRef();
+	if (!m_signature_to_stats->Insert(signature, stats))
+	{
+		signature->Release();
+		stats->Release();
+	}
+}
+
+// EOF
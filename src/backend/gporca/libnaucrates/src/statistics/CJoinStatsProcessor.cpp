@@ -17,6 +17,7 @@
 #include "gpopt/operators/CScalarNAryJoinPredList.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
 #include "naucrates/statistics/CFilterStatsProcessor.h"
+#include "naucrates/statistics/CJoinStatsCache.h"
 #include "naucrates/statistics/CLeftAntiSemiJoinStatsProcessor.h"
 #include "naucrates/statistics/CScaleFactorUtils.h"
 #include "naucrates/statistics/CStatisticsUtils.h"
@@ -570,9 +571,29 @@ CJoinStatsProcessor::DeriveJoinStats(CMemoryPool *mp,
 				COperator::EopLogicalRightOuterJoin == op_id);
 #endif
 
-	// derive stats based on local join condition
-	IStatistics *join_stats = CJoinStatsProcessor::CalcAllJoinStats(
-		mp, statistics_array, local_expr, exprhdl.Pop());
+	// derive stats based on local join condition, unless the same inner
+	// join has already been derived for another join alternative
+	IStatistics *join_stats = NULL;
+	CJoinStatsCache::CSignature *signature = NULL;
+	CJoinStatsCache *join_stats_cache =
+		COptCtxt::PoctxtFromTLS()->PJoinStatsCache();
+	if (!exprhdl.HasOuterRefs() &&
+		CJoinStatsCache::FCacheable(exprhdl.Pop()))
+	{
+		join_stats = join_stats_cache->PstatsLookup(statistics_array,
+													local_expr, &signature);
+	}
+
+	if (NULL == join_stats)
+	{
+		join_stats = CJoinStatsProcessor::CalcAllJoinStats(
+			mp, statistics_array, local_expr, exprhdl.Pop());
+
+		if (NULL != signature)
+		{
+			join_stats_cache->Insert(signature, join_stats);
+		}
+	}
 
 	if (exprhdl.HasOuterRefs() && 0 < stats_ctxt->Size())
 	{
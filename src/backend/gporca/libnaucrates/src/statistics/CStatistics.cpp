@@ -201,6 +201,20 @@ CStatistics::GetSkew(ULONG colid) const
 	return histogram->GetSkew();
 }
 
+// return the frequency of the most frequent value of the given column,
+// or 0 if the column has no histogram
+CDouble
+CStatistics::GetMaxValueFrequency(ULONG colid) const
+{
+	CHistogram *histogram = m_colid_histogram_mapping->Find(&colid);
+	if (NULL == histogram)
+	{
+		return CDouble(0.0);
+	}
+
+	return histogram->GetMaxValueFrequency();
+}
+
 // return total width in bytes
 CDouble
 CStatistics::Width() const
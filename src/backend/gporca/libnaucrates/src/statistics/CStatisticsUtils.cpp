@@ -31,6 +31,9 @@
 #include "naucrates/base/IDatumInt8.h"
 #include "naucrates/base/IDatumOid.h"
 #include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/IMDMultiColStats.h"
+#include "naucrates/md/IMDRelStats.h"
 #include "naucrates/md/IMDScalarOp.h"
 #include "naucrates/md/IMDType.h"
 #include "naucrates/md/IMDTypeInt2.h"
@@ -1498,8 +1501,11 @@ CStatisticsUtils::MaxNumGroupsForGivenSrcGprCols(
 	CColRef *first_colref = col_factory->LookupColRef(*(*src_grouping_cols)[0]);
 	CDouble upper_bound_ndvs = input_stats->GetColUpperBoundNDVs(first_colref);
 
-	CDoubleArray *ndvs = GPOS_NEW(mp) CDoubleArray(mp);
-	AddNdvForAllGrpCols(mp, input_stats, src_grouping_cols, ndvs);
+	CDoubleArray *col_ndvs = GPOS_NEW(mp) CDoubleArray(mp);
+	AddNdvForAllGrpCols(mp, input_stats, src_grouping_cols, col_ndvs);
+	CDoubleArray *ndvs = CombineNdvsWithMultiColStats(
+		mp, input_rows, src_grouping_cols, col_ndvs);
+	col_ndvs->Release();
 
 	// take the minimum of (a) the estimated number of groups from the columns of this source,
 	// (b) input rows, and (c) cardinality upper bound for the given source in the
@@ -1518,6 +1524,191 @@ CStatisticsUtils::MaxNumGroupsForGivenSrcGprCols(
 	return groups;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::CombineNdvsWithMultiColStats
+//
+//	@doc:
+//		Return the NDVs to use for the given grouping columns of a table.
+//		When ANALYZE collected the number of distinct combinations of a
+//		group of these columns, the NDVs of the columns of the group are
+//		replaced by a single NDV for the whole group, instead of assuming
+//		that the columns are independent. Larger groups are used first, and
+//		each grouping column is part of at most one group. Only columns of
+//		the same instance of the table as the first grouping column are
+//		combined: the columns of another instance, e.g. in a self-join, are
+//		not correlated with them.
+//
+//		ANALYZE counted the combinations in the whole table. When the input
+//		has fewer rows than the table, e.g. after a filter, the count is
+//		scaled down by the fraction of the rows that remain, and it is then
+//		bounded by the NDVs of the columns, which the filter has already
+//		scaled.
+//
+//---------------------------------------------------------------------------
+CDoubleArray *
+CStatisticsUtils::CombineNdvsWithMultiColStats(
+	CMemoryPool *mp, CDouble input_rows, const ULongPtrArray *src_grouping_cols,
+	CDoubleArray *ndvs)
+{
+	GPOS_ASSERT(NULL != src_grouping_cols);
+	GPOS_ASSERT(NULL != ndvs);
+	GPOS_ASSERT(src_grouping_cols->Size() == ndvs->Size());
+
+	const ULONG num_cols = src_grouping_cols->Size();
+	ndvs->AddRef();
+	if (2 > num_cols || GPOS_FTRACE(EopttraceDisableMultiColStats))
+	{
+		return ndvs;
+	}
+
+	CColumnFactory *col_factory = COptCtxt::PoctxtFromTLS()->Pcf();
+	CColRef *first_colref = col_factory->LookupColRef(*(*src_grouping_cols)[0]);
+	IMDId *rel_mdid = first_colref->GetMdidTable();
+	if (CColRef::EcrtTable != first_colref->Ecrt() || NULL == rel_mdid ||
+		(IMDId::EmdidGeneral != rel_mdid->MdidType() &&
+		 IMDId::EmdidRel != rel_mdid->MdidType()))
+	{
+		return ndvs;
+	}
+	const ULONG source_id =
+		CColRefTable::PcrConvert(first_colref)->UlSourceOpId();
+
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+	const IMDMultiColStats *multicol_stats =
+		md_accessor->RetrieveMultiColStats(rel_mdid);
+	const ULONG num_groups = multicol_stats->Size();
+	if (0 == num_groups)
+	{
+		return ndvs;
+	}
+	ndvs->Release();
+
+	// fraction of the rows of the table in the input
+	rel_mdid->AddRef();
+	CMDIdRelStats *rel_stats_mdid =
+		GPOS_NEW(mp) CMDIdRelStats(CMDIdGPDB::CastMdid(rel_mdid));
+	const IMDRelStats *rel_stats = md_accessor->Pmdrelstats(rel_stats_mdid);
+	rel_stats_mdid->Release();
+
+	CDouble input_fraction(1.0);
+	if (!rel_stats->IsEmpty() && input_rows < rel_stats->Rows())
+	{
+		input_fraction = input_rows / rel_stats->Rows();
+	}
+
+	// attribute numbers of the grouping columns, 0 for columns that are
+	// not from the same instance of the table
+	INT *attnos = GPOS_NEW_ARRAY(mp, INT, num_cols);
+	BOOL *combined = GPOS_NEW_ARRAY(mp, BOOL, num_cols);
+	for (ULONG ul = 0; ul < num_cols; ul++)
+	{
+		CColRef *colref = col_factory->LookupColRef(*(*src_grouping_cols)[ul]);
+		attnos[ul] = 0;
+		combined[ul] = false;
+		if (CColRef::EcrtTable == colref->Ecrt() &&
+			NULL != colref->GetMdidTable() &&
+			rel_mdid->Equals(colref->GetMdidTable()) &&
+			source_id == CColRefTable::PcrConvert(colref)->UlSourceOpId())
+		{
+			attnos[ul] = CColRefTable::PcrConvert(colref)->AttrNum();
+		}
+	}
+
+	CDoubleArray *result = GPOS_NEW(mp) CDoubleArray(mp);
+	while (true)
+	{
+		// find the largest group whose columns are all grouping columns
+		// that are not yet part of another group
+		ULONG best_group = gpos::ulong_max;
+		ULONG best_size = 0;
+		for (ULONG ulGroup = 0; ulGroup < num_groups; ulGroup++)
+		{
+			const ULongPtrArray *keys = multicol_stats->GetKeys(ulGroup);
+			if (keys->Size() <= best_size)
+			{
+				continue;
+			}
+
+			BOOL covered = true;
+			for (ULONG ulKey = 0; covered && ulKey < keys->Size(); ulKey++)
+			{
+				covered = gpos::ulong_max !=
+						  FindUncombinedGrpCol(attnos, combined, num_cols,
+											   (INT) * (*keys)[ulKey]);
+			}
+
+			if (covered)
+			{
+				best_group = ulGroup;
+				best_size = keys->Size();
+			}
+		}
+
+		if (gpos::ulong_max == best_group)
+		{
+			break;
+		}
+
+		const ULongPtrArray *keys = multicol_stats->GetKeys(best_group);
+		CDouble ndv_product(1.0);
+		CDouble ndv_max(1.0);
+		for (ULONG ulKey = 0; ulKey < keys->Size(); ulKey++)
+		{
+			ULONG pos = FindUncombinedGrpCol(attnos, combined, num_cols,
+											 (INT) * (*keys)[ulKey]);
+			combined[pos] = true;
+			ndv_product = ndv_product * *(*ndvs)[pos];
+			ndv_max = std::max(ndv_max, *(*ndvs)[pos]);
+		}
+
+		// the group cannot have fewer combinations than its column with the
+		// most distinct values, nor more than if its columns were independent
+		CDouble group_ndv = std::max(
+			ndv_max,
+			std::min(ndv_product,
+					 multicol_stats->GetNDistinct(best_group) * input_fraction));
+		result->Append(GPOS_NEW(mp) CDouble(group_ndv));
+	}
+
+	for (ULONG ul = 0; ul < num_cols; ul++)
+	{
+		if (!combined[ul])
+		{
+			result->Append(GPOS_NEW(mp) CDouble(*(*ndvs)[ul]));
+		}
+	}
+
+	GPOS_DELETE_ARRAY(attnos);
+	GPOS_DELETE_ARRAY(combined);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatisticsUtils::FindUncombinedGrpCol
+//
+//	@doc:
+//		Return the position of a grouping column with the given attribute
+//		number that is not yet part of a group, or gpos::ulong_max
+//
+//---------------------------------------------------------------------------
+ULONG
+CStatisticsUtils::FindUncombinedGrpCol(const INT *attnos, const BOOL *combined,
+									   ULONG num_cols, INT attno)
+{
+	for (ULONG ul = 0; ul < num_cols; ul++)
+	{
+		if (!combined[ul] && 0 != attnos[ul] && attno == attnos[ul])
+		{
+			return ul;
+		}
+	}
+
+	return gpos::ulong_max;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CStatisticsUtils::Groups
@@ -68,6 +68,7 @@ CDXLTokens::Init(CMemoryPool *mp)
 		{EdxltokenDampingFactorJoin, GPOS_WSZ_LIT("DampingFactorJoin")},
 		{EdxltokenDampingFactorGroupBy, GPOS_WSZ_LIT("DampingFactorGroupBy")},
 		{EdxltokenMaxStatsBuckets, GPOS_WSZ_LIT("MaxStatsBuckets")},
+		{EdxltokenMaxDerivedStatsBuckets, GPOS_WSZ_LIT("MaxDerivedStatsBuckets")},
 		{EdxltokenCTEConfig, GPOS_WSZ_LIT("CTEConfig")},
 		{EdxltokenCTEInliningCutoff, GPOS_WSZ_LIT("CTEInliningCutoff")},
 		{EdxltokenCostModelConfig, GPOS_WSZ_LIT("CostModelConfig")},
@@ -87,6 +88,9 @@ CDXLTokens::Init(CMemoryPool *mp)
 		 GPOS_WSZ_LIT("PushGroupByBelowSetopThreshold")},
 		{EdxltokenXformBindThreshold, GPOS_WSZ_LIT("XformBindThreshold")},
 		{EdxltokenSkewFactor, GPOS_WSZ_LIT("SkewFactor")},
+		{EdxltokenQueryMemoryKB, GPOS_WSZ_LIT("QueryMemoryKB")},
+		{EdxltokenMemoryIntensiveOperators,
+		 GPOS_WSZ_LIT("MemoryIntensiveOperators")},
 		{EdxltokenWindowOids, GPOS_WSZ_LIT("WindowOids")},
 		{EdxltokenOidRowNumber, GPOS_WSZ_LIT("RowNumber")},
 		{EdxltokenOidRank, GPOS_WSZ_LIT("Rank")},
@@ -397,6 +401,7 @@ CDXLTokens::Init(CMemoryPool *mp)
 		{EdxltokenAttno, GPOS_WSZ_LIT("Attno")},
 		{EdxltokenColDropped, GPOS_WSZ_LIT("IsDropped")},
 		{EdxltokenColWidth, GPOS_WSZ_LIT("ColWidth")},
+		{EdxltokenColCompressedWidth, GPOS_WSZ_LIT("CompressedWidth")},
 		{EdxltokenColNullFreq, GPOS_WSZ_LIT("NullFreq")},
 		{EdxltokenColNdvRemain, GPOS_WSZ_LIT("NdvRemain")},
 		{EdxltokenColFreqRemain, GPOS_WSZ_LIT("FreqRemain")},
@@ -503,6 +508,10 @@ CDXLTokens::Init(CMemoryPool *mp)
 		{EdxltokenRelationMdid, GPOS_WSZ_LIT("RelationMdid")},
 		{EdxltokenRelationStats, GPOS_WSZ_LIT("RelationStatistics")},
 		{EdxltokenColumnStats, GPOS_WSZ_LIT("ColumnStatistics")},
+		{EdxltokenMultiColStats, GPOS_WSZ_LIT("MultiColumnStatistics")},
+		{EdxltokenMultiColStat, GPOS_WSZ_LIT("MultiColumnStatistic")},
+		{EdxltokenMultiColStatNDistinct, GPOS_WSZ_LIT("NDistinct")},
+		{EdxltokenMultiColStatDependency, GPOS_WSZ_LIT("Dependency")},
 		{EdxltokenColumnStatsBucket, GPOS_WSZ_LIT("StatsBucket")},
 		{EdxltokenEmptyRelation, GPOS_WSZ_LIT("EmptyRelation")},
 
@@ -0,0 +1,501 @@
+#!/usr/bin/env python
+
+# Optimizer cost model calibration
+#
+# This program runs a workload with EXPLAIN ANALYZE and fits the unit cost
+# parameters of the GPORCA cost model (see CCostModelParamsGPDB) to the
+# execution times observed on the cluster it runs on.
+#
+# GPORCA costs a plan node as a sum of terms, each the product of a unit cost
+# parameter and a quantity derived from the rows and widths of the node and
+# its inputs, e.g. a hash join pays HJHashTableWidthCostUnit for every byte
+# of its inner side. For every plan node, these quantities are computed from
+# the actual rows of the node and its children, and the time spent in the
+# node itself (its time minus the time of its children) is recorded. A least
+# squares fit over all nodes then finds, for every parameter separately, the
+# time per unit of its quantity. Parameters whose quantities always appear
+# together, e.g. the hash table and hashing terms of a hash join, cannot be
+# told apart by the fit; a ridge term pulls every parameter towards its base
+# value, so that such parameters keep their relative values and parameters
+# with few samples move less.
+#
+# The fitted times are converted back into cost units with the time per unit
+# of cost fitted over the total costs of all nodes, so that the overall cost
+# level stays the same. Parameters that are slower on this cluster than the
+# cost model expects get more expensive, and faster ones get cheaper. The
+# bitmap scan and spilling parameters depend on quantities that EXPLAIN
+# does not show, and are not fitted.
+#
+# The result is a cost profile, a DXL file that can be loaded through the
+# optimizer_cost_profile_path server configuration parameter. Calibration
+# can be repeated with the profile of a previous run as the base profile,
+# which is then used to plan the workload and refined further.
+#
+# Run this program with the -h or --help option to see argument syntax
+
+import argparse
+import json
+import math
+import os
+import re
+import sys
+
+try:
+    from gppylib.db import dbconn
+except ImportError, e:
+    sys.exit('ERROR: Cannot import modules.  Please check that you have sourced greenplum_path.sh.  Detail: ' + str(e))
+
+# constants
+# -----------------------------------------------------------------------------
+
+_help = """
+Calibrate the GPORCA cost model. Runs the statements in the given SQL files with EXPLAIN ANALYZE,
+fits the unit cost parameters of the cost model to the observed execution times, and prints
+a cost profile that can be loaded through the optimizer_cost_profile_path parameter.
+"""
+
+# built-in values of the fitted parameters, see CCostModelParamsGPDB.cpp
+DEFAULT_COST_PARAMS = {
+    "TableScanCostUnit": 5.50e-07,
+    "IndexBlockCostUnit": 1.27e-06,
+    "IndexFilterCostUnit": 1.65e-04,
+    "IndexScanTupCostUnit": 3.66e-06,
+    "BitmapIOLargerNDV": 0.0082,
+    "BitmapIOSmallerNDV": 0.2138,
+    "BitmapPageCostLargerNDV": 83.1651,
+    "BitmapPageCostSmallerNDV": 204.3810,
+    "BitmapPageCost": 10.0,
+    "FilterColCostUnit": 3.29e-05,
+    "OutputTupCostUnit": 1.86e-06,
+    "GatherSendCostUnit": 4.58e-06,
+    "GatherRecvCostUnit": 2.20e-06,
+    "RedistributeSendCostUnit": 2.33e-06,
+    "RedistributeRecvCostUnit": 8.0e-07,
+    "BroadcastSendCostUnit": 4.965e-05,
+    "BroadcastRecvCostUnit": 1.35e-06,
+    "JoinFeedingTupColumnCostUnit": 8.69e-05,
+    "JoinFeedingTupWidthCostUnit": 6.09e-07,
+    "JoinOutputTupCostUnit": 3.50e-06,
+    "HJHashTableColumnCostUnit": 5.0e-05,
+    "HJHashTableWidthCostUnit": 3.0e-06,
+    "HJHashingTupWidthCostUnit": 1.97e-05,
+    "HJFeedingTupColumnSpillingCostUnit": 1.97e-04,
+    "HJFeedingTupWidthSpillingCostUnit": 3.0e-06,
+    "HJHashingTupWidthSpillingCostUnit": 2.30e-05,
+    "HashAggInputTupColumnCostUnit": 1.20e-04,
+    "HashAggInputTupWidthCostUnit": 1.12e-07,
+    "HashAggOutputTupWidthCostUnit": 5.61e-07,
+    "SortTupWidthCostUnit": 5.67e-06,
+    "MaterializeCostUnit": 4.68e-06,
+}
+
+# the parameters that are fitted, in the order of the columns of the fit
+FITTED_PARAMS = [
+    "TableScanCostUnit",
+    "IndexScanTupCostUnit",
+    "FilterColCostUnit",
+    "OutputTupCostUnit",
+    "GatherSendCostUnit",
+    "GatherRecvCostUnit",
+    "RedistributeSendCostUnit",
+    "RedistributeRecvCostUnit",
+    "BroadcastSendCostUnit",
+    "BroadcastRecvCostUnit",
+    "JoinFeedingTupColumnCostUnit",
+    "JoinFeedingTupWidthCostUnit",
+    "JoinOutputTupCostUnit",
+    "HJHashTableColumnCostUnit",
+    "HJHashTableWidthCostUnit",
+    "HJHashingTupWidthCostUnit",
+    "HashAggInputTupColumnCostUnit",
+    "HashAggInputTupWidthCostUnit",
+    "HashAggOutputTupWidthCostUnit",
+    "SortTupWidthCostUnit",
+    "MaterializeCostUnit",
+]
+
+DXL_NAMESPACE = "http://greenplum.com/dxl/2010/12/"
+
+# global variables
+# -----------------------------------------------------------------------------
+
+glob_verbose = False
+glob_log_file = None
+
+
+# deal with command line arguments
+# -----------------------------------------------------------------------------
+
+def parseargs():
+    parser = argparse.ArgumentParser(description=_help, version='1.0')
+
+    parser.add_argument("workload", metavar="FILE", nargs="+",
+                        help="SQL files with the statements of the workload, separated by semicolons")
+    parser.add_argument("--runs", type=int, default=3,
+                        help="Number of times to run each statement, the fastest run of each plan node is used "
+                             "(default is 3)")
+    parser.add_argument("--minSamples", type=int, default=10,
+                        help="Minimum number of plan nodes needed to fit a parameter (default is 10)")
+    parser.add_argument("--ridge", type=float, default=0.1,
+                        help="Weight of the base value of a parameter relative to its samples in the fit "
+                             "(default is 0.1)")
+    parser.add_argument("--maxFactor", type=float, default=100.0,
+                        help="Largest factor by which a parameter may be scaled up or down (default is 100)")
+    parser.add_argument("--baseProfile", default="",
+                        help="Cost profile to plan the workload with, and to refine (default is the built-in "
+                             "parameters)")
+    parser.add_argument("--output", default="",
+                        help="File to write the cost profile to (default is stdout)")
+    parser.add_argument("--verbose", action="store_true",
+                        help="Print more verbose output")
+    parser.add_argument("--logFile", default="",
+                        help="Log diagnostic output to a file")
+    parser.add_argument("--host", default="",
+                        help="Host to connect to (default is localhost or $PGHOST, if set).")
+    parser.add_argument("--port", type=int, default="0",
+                        help="Port on the host to connect to (default is 0 or $PGPORT, if set)")
+    parser.add_argument("--dbName", default="",
+                        help="Database name to connect to")
+
+    args = parser.parse_args()
+    return args, parser
+
+
+def log_output(str):
+    if glob_verbose:
+        sys.stderr.write(str + "\n")
+    if glob_log_file != None:
+        glob_log_file.write(str + "\n")
+
+
+# SQL related methods
+# -----------------------------------------------------------------------------
+
+def connect(host, port_num, db_name):
+    try:
+        dburl = dbconn.DbURL(hostname=host, port=port_num, dbname=db_name)
+        conn = dbconn.connect(dburl, encoding="UTF8")
+    except Exception as e:
+        sys.exit("Exception during connect: %s" % e)
+
+    return conn
+
+
+def read_workload(file_names):
+    statements = []
+    for file_name in file_names:
+        with open(file_name) as f:
+            text = re.sub(r"--[^\n]*", "", f.read())
+        for stmt in text.split(";"):
+            stmt = stmt.strip()
+            if stmt != "":
+                statements.append(stmt)
+    return statements
+
+
+def explain_analyze(conn, stmt):
+    try:
+        log_output("Executing query: %s" % stmt)
+        curs = dbconn.execSQL(conn, "EXPLAIN (ANALYZE, FORMAT JSON) " + stmt)
+        plan_text = "".join(row[0] for row in curs.fetchall())
+        conn.commit()
+    except Exception as e:
+        sys.stderr.write("Error executing query: %s; Reason: %s\n" % (stmt, e))
+        dbconn.execSQL(conn, "abort")
+        return None
+
+    explain = json.loads(plan_text)[0]
+    if not explain.get("Optimizer", "").endswith("(GPORCA)"):
+        log_output("Skipping query planned by the Postgres query optimizer: %s" % stmt)
+        return None
+
+    return explain["Plan"]
+
+
+# plan analysis
+# -----------------------------------------------------------------------------
+
+def node_time(node):
+    return node.get("Actual Total Time", 0.0) * node.get("Actual Loops", 0.0)
+
+
+def node_rows(node):
+    return node.get("Actual Rows", node.get("Plan Rows", 0.0))
+
+
+def node_width(node):
+    return node.get("Plan Width", 0.0)
+
+
+# number of distinct columns referenced in the given expressions
+def count_columns(exprs):
+    columns = set()
+    for expr in exprs:
+        expr = re.sub(r"'(?:[^']|'')*'", "", expr)
+        for match in re.finditer(r"(?:\b[A-Za-z_][A-Za-z0-9_$]*\.)?\b([A-Za-z_][A-Za-z0-9_$]*)\b(?!\s*\()", expr):
+            if match.group(0).upper() not in ("AND", "OR", "NOT", "IS", "NULL", "TRUE", "FALSE"):
+                columns.add(match.group(0))
+    return max(len(columns), 1)
+
+
+def as_list(value):
+    if value is None:
+        return []
+    if isinstance(value, list):
+        return value
+    return [value]
+
+
+# quantities that GPORCA multiplies with each parameter to cost the node
+# itself, per loop, see CCostModelGPDB; the hash join includes its Hash node
+def cost_terms(node):
+    node_type = node["Node Type"]
+    children = node.get("Plans", [])
+    rows = node_rows(node)
+    width = node_width(node)
+    terms = {}
+
+    if re.match(r"^(Seq Scan|Dynamic Seq Scan|Append-only Scan|Append-only Columnar Scan|"
+                r"Table Scan|Dynamic Table Scan)$", node_type):
+        terms["TableScanCostUnit"] = rows * width
+    elif re.match(r"^(Dynamic )?Index (Only )?Scan$", node_type):
+        terms["IndexScanTupCostUnit"] = rows * width
+    elif node_type == "Result" and children:
+        terms["FilterColCostUnit"] = node_rows(children[0]) * count_columns(as_list(node.get("Filter")))
+        terms["OutputTupCostUnit"] = rows * width
+    elif re.match(r"^(Explicit )?(Gather|Redistribute|Broadcast) Motion$", node_type) and children:
+        kind = re.sub(r"^(Explicit )?(\w+) Motion$", r"\2", node_type)
+        terms[kind + "SendCostUnit"] = node_rows(children[0]) * node_width(children[0])
+        terms[kind + "RecvCostUnit"] = rows * width
+    elif node_type == "Hash Join" and len(children) == 2:
+        outer = children[0]
+        inner = children[1]
+        if inner["Node Type"] == "Hash" and inner.get("Plans"):
+            inner = inner["Plans"][0]
+        columns = count_columns(as_list(node.get("Hash Cond")))
+        terms["HJHashTableColumnCostUnit"] = node_rows(inner) * columns
+        terms["HJHashTableWidthCostUnit"] = node_rows(inner) * node_width(inner)
+        terms["HJHashingTupWidthCostUnit"] = node_rows(inner) * node_width(inner)
+        terms["JoinFeedingTupColumnCostUnit"] = node_rows(outer) * columns
+        terms["JoinFeedingTupWidthCostUnit"] = node_rows(outer) * node_width(outer)
+        terms["JoinOutputTupCostUnit"] = rows * width
+    elif node_type in ("Nested Loop", "Merge Join") and children:
+        outer = children[0]
+        columns = count_columns(as_list(node.get("Join Filter")) + as_list(node.get("Merge Cond")))
+        terms["JoinFeedingTupColumnCostUnit"] = node_rows(outer) * columns
+        terms["JoinFeedingTupWidthCostUnit"] = node_rows(outer) * node_width(outer)
+        terms["JoinOutputTupCostUnit"] = rows * width
+    elif node_type == "Aggregate" and node.get("Strategy") == "Hashed" and children:
+        input_rows = node_rows(children[0])
+        columns = max(len(as_list(node.get("Group Key"))), 1)
+        terms["HashAggInputTupColumnCostUnit"] = input_rows * columns
+        terms["HashAggInputTupWidthCostUnit"] = input_rows * columns * width
+        terms["HashAggOutputTupWidthCostUnit"] = rows * width
+    elif node_type == "Sort":
+        terms["SortTupWidthCostUnit"] = rows * math.log(max(rows, 2.0), 2) * width
+    elif node_type == "Materialize":
+        terms["MaterializeCostUnit"] = rows * width
+
+    return terms
+
+
+# collect (terms, cost, time) of the nodes of a plan, indexed by the position
+# of the node in the plan, so that runs of the same plan can be matched up
+def collect_nodes(node, nodes, path="0"):
+    children = node.get("Plans", [])
+    cost = node["Total Cost"] - sum(child["Total Cost"] for child in children)
+    time = node_time(node) - sum(node_time(child) for child in children)
+
+    # GPORCA costs the building of the hash table as part of the hash join,
+    # the Hash node carries the cost of its child
+    if node["Node Type"] == "Hash Join":
+        for child in children:
+            if child["Node Type"] == "Hash":
+                time += node_time(child)
+                time -= sum(node_time(grandchild) for grandchild in child.get("Plans", []))
+                cost -= sum(grandchild["Total Cost"] for grandchild in child.get("Plans", []))
+                cost += child["Total Cost"]
+
+    loops = node.get("Actual Loops", 0.0)
+    if node["Node Type"] != "Hash" and loops > 0:
+        terms = dict((param, value * loops) for (param, value) in cost_terms(node).items())
+        nodes[path] = (terms, max(cost, 0.0), max(time, 0.0))
+
+    for (i, child) in enumerate(children):
+        collect_nodes(child, nodes, "%s.%d" % (path, i))
+
+
+def run_workload(conn, statements, runs):
+    samples = []
+    for stmt in statements:
+        best = None
+        for run in range(runs):
+            plan = explain_analyze(conn, stmt)
+            if plan is None:
+                break
+            nodes = {}
+            collect_nodes(plan, nodes)
+            if best is None or sorted(best.keys()) != sorted(nodes.keys()):
+                best = nodes
+            else:
+                for (path, sample) in nodes.items():
+                    if sample[2] < best[path][2]:
+                        best[path] = sample
+        if best is not None:
+            samples.extend(best.values())
+    return samples
+
+
+# least squares fit of time = k * cost, through the origin
+def fit(samples):
+    sum_cost_time = sum(cost * time for (terms, cost, time) in samples)
+    sum_cost_cost = sum(cost * cost for (terms, cost, time) in samples)
+    if sum_cost_cost <= 0.0:
+        return None
+    return sum_cost_time / sum_cost_cost
+
+
+# solve the linear system a x = b by Gaussian elimination with partial
+# pivoting, a is symmetric positive definite here
+def solve(a, b):
+    n = len(b)
+    m = [list(a[i]) + [b[i]] for i in range(n)]
+    for col in range(n):
+        pivot = max(range(col, n), key=lambda row: abs(m[row][col]))
+        m[col], m[pivot] = m[pivot], m[col]
+        if m[col][col] == 0.0:
+            return None
+        for row in range(col + 1, n):
+            factor = m[row][col] / m[col][col]
+            for k in range(col, n + 1):
+                m[row][k] -= factor * m[col][k]
+    x = [0.0] * n
+    for row in range(n - 1, -1, -1):
+        x[row] = (m[row][n] - sum(m[row][k] * x[k] for k in range(row + 1, n))) / m[row][row]
+    return x
+
+
+# Fit time = sum of x_p * term_p over the nodes, with one unknown x_p per
+# parameter, the time per unit of its quantity. The ridge term adds
+# ridge * (sum of term_p^2) * (x_p - prior_p)^2 to the squared error, where
+# prior_p is the time per unit the base profile implies.
+def fit_profile(samples, base_params, min_samples, max_factor, ridge):
+    k_all = fit([s for s in samples if s[1] > 0.0])
+    if k_all is None or k_all <= 0.0:
+        sys.exit("ERROR: The workload did not produce any plan nodes to fit the cost model with")
+    log_output("Time per unit of cost, all nodes: %g msec (%d nodes)" % (k_all, len(samples)))
+
+    counts = dict((param, 0) for param in FITTED_PARAMS)
+    for (terms, cost, time) in samples:
+        for (param, value) in terms.items():
+            if value > 0.0:
+                counts[param] += 1
+    params_fit = [p for p in FITTED_PARAMS if counts[p] >= min_samples]
+    for param in FITTED_PARAMS:
+        if counts[param] < min_samples:
+            log_output("%s: %d nodes, not enough to fit" % (param, counts[param]))
+    if not params_fit:
+        return {}
+
+    n = len(params_fit)
+    ata = [[0.0] * n for i in range(n)]
+    atb = [0.0] * n
+    for (terms, cost, time) in samples:
+        row = [terms.get(param, 0.0) for param in params_fit]
+        if not any(row):
+            continue
+        for i in range(n):
+            if row[i] == 0.0:
+                continue
+            atb[i] += row[i] * time
+            for j in range(n):
+                ata[i][j] += row[i] * row[j]
+
+    prior = [base_params[param] * k_all for param in params_fit]
+    for i in range(n):
+        weight = ridge * ata[i][i]
+        ata[i][i] += weight
+        atb[i] += weight * prior[i]
+
+    x = solve(ata, atb)
+    if x is None:
+        sys.exit("ERROR: The cost terms of the workload do not determine the parameters")
+
+    params = {}
+    for (i, param) in enumerate(params_fit):
+        factor = min(max(x[i] / prior[i], 1.0 / max_factor), max_factor)
+        log_output("%s: %d nodes, time per unit %g msec, factor %g" % (param, counts[param], x[i], factor))
+        params[param] = base_params[param] * factor
+
+    return params
+
+
+# cost profiles
+# -----------------------------------------------------------------------------
+
+def read_profile(file_name):
+    params = dict(DEFAULT_COST_PARAMS)
+    with open(file_name) as f:
+        for match in re.finditer(r'<dxl:CostParam\s+Name="([^"]+)"\s+Value="([^"]+)"', f.read()):
+            params[match.group(1)] = float(match.group(2))
+    return params
+
+
+def write_profile(out, base_params, params):
+    # keep the parameters of the base profile that were not fitted again
+    profile = dict((name, value) for (name, value) in base_params.items()
+                   if name not in DEFAULT_COST_PARAMS or value != DEFAULT_COST_PARAMS[name])
+    profile.update(params)
+
+    out.write('<?xml version="1.0" encoding="UTF-8"?>\n')
+    out.write('<dxl:DXLMessage xmlns:dxl="%s">\n' % DXL_NAMESPACE)
+    out.write('  <dxl:CostParams>\n')
+    for name in sorted(profile.keys()):
+        value = "%.6e" % profile[name]
+        out.write('    <dxl:CostParam Name="%s" Value="%s" LowerBound="%s" UpperBound="%s"/>\n' %
+                  (name, value, value, value))
+    out.write('  </dxl:CostParams>\n')
+    out.write('</dxl:DXLMessage>\n')
+
+
+def main():
+    global glob_verbose
+    global glob_log_file
+
+    args, parser = parseargs()
+    if args.logFile != "":
+        glob_log_file = open(args.logFile, "wt", 1)
+    if args.verbose:
+        glob_verbose = True
+
+    statements = read_workload(args.workload)
+    base_params = dict(DEFAULT_COST_PARAMS)
+
+    log_output("Connecting to host %s on port %d, database %s" % (args.host, args.port, args.dbName))
+    conn = connect(args.host, args.port, args.dbName)
+    dbconn.execSQL(conn, "SET optimizer TO on")
+    if args.baseProfile != "":
+        base_params = read_profile(args.baseProfile)
+        dbconn.execSQL(conn, "SET optimizer_cost_profile_path TO '%s'" %
+                       os.path.abspath(args.baseProfile).replace("'", "''"))
+    else:
+        dbconn.execSQL(conn, "SET optimizer_cost_profile_path TO ''")
+    conn.commit()
+
+    samples = run_workload(conn, statements, max(args.runs, 1))
+    conn.close()
+
+    params = fit_profile(samples, base_params, args.minSamples, args.maxFactor, args.ridge)
+
+    if args.output != "":
+        with open(args.output, "wt") as out:
+            write_profile(out, base_params, params)
+    else:
+        write_profile(sys.stdout, base_params, params)
+
+    if glob_log_file != None:
+        glob_log_file.close()
+
+
+if __name__ == "__main__":
+    main()
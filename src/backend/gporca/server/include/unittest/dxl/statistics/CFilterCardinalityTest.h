@@ -127,6 +127,12 @@ private:
 
 	static CStatsPred *PstatspredArrayCmpAnyDuplicate(CMemoryPool *mp);
 
+	static CStatsPred *PstatspredArrayCmpAnyNulls(CMemoryPool *mp);
+
+	static CStatsPred *PstatspredArrayCmpAnyNumeric(CMemoryPool *mp);
+
+	static CStatsPred *PstatspredArrayCmpAnyMixedTypes(CMemoryPool *mp);
+
 
 	// conjunctive predicates
 	static CStatsPred *PstatspredConj(CMemoryPool *mp);
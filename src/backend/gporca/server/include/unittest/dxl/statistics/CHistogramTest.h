@@ -46,11 +46,17 @@ public:
 	// skew basic tests
 	static GPOS_RESULT EresUnittest_Skew();
 
+	// most common value frequency tests
+	static GPOS_RESULT EresUnittest_MaxValueFrequency();
+
 	// merge basic tests
 	static GPOS_RESULT EresUnittest_MergeUnion();
 
 	// merge union test with double values differing by less than epsilon
 	static GPOS_RESULT EresUnittest_MergeUnionDoubleLessThanEpsilon();
+
+	// compaction of derived histograms
+	static GPOS_RESULT EresUnittest_CompactJoinHistogram();
 };	// class CHistogramTest
 }  // namespace gpnaucrates
 
@@ -106,6 +106,9 @@ public:
 	// test join cardinality estimation over histograms with NDVRemain information
 	static GPOS_RESULT EresUnittest_JoinNDVRemain();
 
+	// join statistics cache test
+	static GPOS_RESULT EresUnittest_JoinStatsCache();
+
 	// join buckets tests
 	static GPOS_RESULT EresUnittest_Join();
 
@@ -122,6 +122,9 @@ public:
 	// test that stats copy methods copy all fields
 	static GPOS_RESULT EresUnittest_CStatisticsCopy();
 
+	// test the use of statistics on groups of columns
+	static GPOS_RESULT EresUnittest_MultiColStats();
+
 
 };	// class CStatisticsTest
 }  // namespace gpnaucrates
@@ -193,6 +193,10 @@ public:
 											IMDId *mdid, const CName &name,
 											BOOL fPartitioned = false);
 
+	// generate a table descriptor of the given relation in the metadata
+	static CTableDescriptor *PtabdescFromMDRelation(CMemoryPool *mp,
+													IMDId *mdid);
+
 	// generate a get expression
 	static CExpression *PexprLogicalGet(CMemoryPool *mp,
 										CTableDescriptor *ptabdesc,
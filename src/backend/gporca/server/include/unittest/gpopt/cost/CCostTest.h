@@ -18,6 +18,8 @@ namespace gpopt
 {
 using namespace gpos;
 
+class CPhysicalTableScan;
+
 //---------------------------------------------------------------------------
 //	@class:
 //		CCostTest
@@ -32,6 +34,9 @@ private:
 	// test cost model parameters
 	static void TestParams(CMemoryPool *mp);
 
+	// table scan of the given relation
+	static CPhysicalTableScan *PopTableScan(CMemoryPool *mp, ULONG ulTableId);
+
 public:
 	// unittests
 	static GPOS_RESULT EresUnittest();
@@ -41,6 +46,9 @@ public:
 	static GPOS_RESULT EresUnittest_Parsing();
 	static GPOS_RESULT EresUnittest_ParsingWithException();
 	static GPOS_RESULT EresUnittest_SetParams();
+	static GPOS_RESULT EresUnittest_OperatorMemoryQuota();
+	static GPOS_RESULT EresUnittest_ScanWidth();
+	static GPOS_RESULT EresUnittest_SkewedDistribution();
 
 };	// class CCostTest
 }  // namespace gpopt
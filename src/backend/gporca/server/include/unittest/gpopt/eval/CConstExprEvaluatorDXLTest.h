@@ -58,6 +58,9 @@ private:
 		// dummy value to return
 		INT m_val;
 
+		// number of evaluated expressions
+		ULONG m_ulCalls;
+
 		// private copy ctor
 		CDummyConstDXLNodeEvaluator(const CDummyConstDXLNodeEvaluator &);
 
@@ -65,7 +68,7 @@ private:
 		// ctor
 		CDummyConstDXLNodeEvaluator(CMemoryPool *mp, CMDAccessor *md_accessor,
 									INT val)
-			: m_mp(mp), m_pmda(md_accessor), m_val(val)
+			: m_mp(mp), m_pmda(md_accessor), m_val(val), m_ulCalls(0)
 		{
 		}
 
@@ -83,6 +86,13 @@ private:
 		{
 			return true;
 		}
+
+		// number of evaluated expressions
+		ULONG
+		UlCalls() const
+		{
+			return m_ulCalls;
+		}
 	};
 
 	// value  which the dummy constant evaluator should produce
@@ -100,6 +110,9 @@ public:
 
 	// test that evaluation fails for a scalar with variables
 	static GPOS_RESULT EresUnittest_ScalarContainingVariables();
+
+	// test that identical expressions are only evaluated once
+	static GPOS_RESULT EresUnittest_Memoization();
 };
 }  // namespace gpopt
 
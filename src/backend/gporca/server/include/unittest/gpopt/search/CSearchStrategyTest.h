@@ -68,6 +68,9 @@ public:
 	// test exception handling when parsing search strategy
 	static GPOS_RESULT EresUnittest_ParsingWithException();
 
+	// test reusing costs of equivalent cost contexts across search stages
+	static GPOS_RESULT EresUnittest_ReusedCosts();
+
 };	// CSearchStrategyTest
 
 }  // namespace gpopt
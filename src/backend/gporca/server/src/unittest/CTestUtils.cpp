@@ -270,6 +270,43 @@ CTestUtils::PtabdescCreate(CMemoryPool *mp, ULONG num_cols, IMDId *mdid,
 	return ptabdesc;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTestUtils::PtabdescFromMDRelation
+//
+//	@doc:
+//		Generate a table descriptor with the columns, distribution policy and
+//		storage type of the given relation in the metadata
+//
+//---------------------------------------------------------------------------
+CTableDescriptor *
+CTestUtils::PtabdescFromMDRelation(CMemoryPool *mp, IMDId *mdid)
+{
+	CMDAccessor *md_accessor = COptCtxt::PoctxtFromTLS()->Pmda();
+	const IMDRelation *pmdrel = md_accessor->RetrieveRel(mdid);
+	CName nameTable(pmdrel->Mdname().GetMDName());
+
+	CTableDescriptor *ptabdesc = GPOS_NEW(mp) CTableDescriptor(
+		mp, mdid, nameTable,
+		false,	// convert_hash_to_random
+		pmdrel->GetRelDistribution(), pmdrel->RetrieveRelStorageType(),
+		0  // ulExecuteAsUser
+	);
+
+	for (ULONG ul = 0; ul < pmdrel->ColumnCount(); ul++)
+	{
+		const IMDColumn *pmdcol = pmdrel->GetMdCol(ul);
+		CName nameColumn(pmdcol->Mdname().GetMDName());
+		CColumnDescriptor *pcoldesc = GPOS_NEW(mp) CColumnDescriptor(
+			mp, md_accessor->RetrieveType(pmdcol->MdidType()),
+			pmdcol->TypeModifier(), nameColumn, pmdcol->AttrNum(),
+			pmdcol->IsNullable(), pmdcol->Length());
+		ptabdesc->AddColumn(pcoldesc);
+	}
+
+	return ptabdesc;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTestUtils::PexprLogicalGet
@@ -161,11 +161,52 @@ Eres_SerializeCalibratedCostModel()
 	return gpos::GPOS_OK;
 }
 
+static gpos::GPOS_RESULT
+Eres_SerializeCostModelProfile()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// parameters that differ from their defaults are serialized along with
+	// the NLJ factor, in the order of their ids
+	const WCHAR *const wszExpectedString =
+		L"<dxl:CostModelConfig CostModelType=\"1\" SegmentsForCosting=\"3\">"
+		"<dxl:CostParams>"
+		"<dxl:CostParam Name=\"TupProcBandwidth\" Value=\"2048.000000\" LowerBound=\"2048.000000\" UpperBound=\"2048.000000\"/>"
+		"<dxl:CostParam Name=\"NLJFactor\" Value=\"1.000000\" LowerBound=\"0.500000\" UpperBound=\"1.500000\"/>"
+		"<dxl:CostParam Name=\"ScalarFuncCostUnit\" Value=\"0.000200\" LowerBound=\"0.000200\" UpperBound=\"0.000200\"/>"
+		"</dxl:CostParams>"
+		"</dxl:CostModelConfig>";
+	gpos::CAutoP<CWStringDynamic> apwsExpected(
+		GPOS_NEW(mp) CWStringDynamic(mp, wszExpectedString));
+
+	const ULONG ulSegments = 3;
+	CCostModelParamsGPDB *pcp = GPOS_NEW(mp) CCostModelParamsGPDB(mp);
+	pcp->SetParam("TupProcBandwidth", 2048.0, 2048.0, 2048.0);
+	pcp->SetParam("ScalarFuncCostUnit", 2.0e-04, 2.0e-04, 2.0e-04);
+	GPOS_RTL_ASSERT(
+		2.0e-04 ==
+		pcp->PcpLookup(CCostModelParamsGPDB::EcpScalarFuncCost)->Get());
+	gpos::CAutoRef<CCostModelGPDB> apcm(
+		GPOS_NEW(mp) CCostModelGPDB(mp, ulSegments, pcp));
+
+	CWStringDynamic wsActual(mp);
+	COstreamString os(&wsActual);
+	CXMLSerializer xml_serializer(mp, os, false);
+	CCostModelConfigSerializer cmcSerializer(apcm.Value());
+	cmcSerializer.Serialize(xml_serializer);
+
+	GPOS_RTL_ASSERT(apwsExpected->Equals(&wsActual));
+
+	return gpos::GPOS_OK;
+}
+
 gpos::GPOS_RESULT
 CParseHandlerCostModelTest::EresUnittest()
 {
 	CUnittest rgut[] = {GPOS_UNITTEST_FUNC(Eres_ParseCalibratedCostModel),
-						GPOS_UNITTEST_FUNC(Eres_SerializeCalibratedCostModel)};
+						GPOS_UNITTEST_FUNC(Eres_SerializeCalibratedCostModel),
+						GPOS_UNITTEST_FUNC(Eres_SerializeCostModelProfile)};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
 }
@@ -243,7 +243,16 @@ CFilterCardinalityTest::EresUnittest_CStatisticsFilterArrayCmpAny()
 		 PstatspredArrayCmpAnySimple},
 		{"../data/dxl/statistics/ArrayCmpAny-Input-1.xml",
 		 "../data/dxl/statistics/ArrayCmpAny-Output-1.xml",
-		 PstatspredArrayCmpAnyDuplicate}};
+		 PstatspredArrayCmpAnyDuplicate},
+		{"../data/dxl/statistics/ArrayCmpAny-Input-1.xml",
+		 "../data/dxl/statistics/ArrayCmpAny-Output-1.xml",
+		 PstatspredArrayCmpAnyNulls},
+		{"../data/dxl/statistics/ArrayCmpAny-Input-2.xml",
+		 "../data/dxl/statistics/ArrayCmpAny-Output-2.xml",
+		 PstatspredArrayCmpAnyNumeric},
+		{"../data/dxl/statistics/ArrayCmpAny-Input-1.xml",
+		 "../data/dxl/statistics/ArrayCmpAny-Output-1.xml",
+		 PstatspredArrayCmpAnyMixedTypes}};
 
 	const ULONG ulTestCases = GPOS_ARRAY_SIZE(rgstatsdisjtc);
 
@@ -291,6 +300,25 @@ CFilterCardinalityTest::PstatspredArrayCmpAnyDuplicate(CMemoryPool *mp)
 	return GPOS_NEW(mp) CStatsPredConj(pdrgpstatspred);
 }
 
+// create a 'col IN (...)' filter with nulls, which match no rows
+CStatsPred *
+CFilterCardinalityTest::PstatspredArrayCmpAnyNulls(CMemoryPool *mp)
+{
+	CStatsPredPtrArry *pdrgpstatspred = GPOS_NEW(mp) CStatsPredPtrArry(mp);
+
+	CPointArray *arr = GPOS_NEW(mp) CPointArray(mp);
+	arr->Append(CTestUtils::PpointInt4NullVal(mp));
+	arr->Append(CTestUtils::PpointInt4(mp, 15));
+	arr->Append(CTestUtils::PpointInt4(mp, 1));
+	arr->Append(CTestUtils::PpointInt4NullVal(mp));
+	arr->Append(CTestUtils::PpointInt4(mp, 2));
+
+	pdrgpstatspred->Append(
+		GPOS_NEW(mp) CStatsPredArrayCmp(1, CStatsPred::EstatscmptEq, arr));
+
+	return GPOS_NEW(mp) CStatsPredConj(pdrgpstatspred);
+}
+
 // reads a DXL document, generates the statistics object, performs a
 // filter operation on it, serializes it into a DXL document and
 // compares the generated DXL document with the expected DXL document.
@@ -482,6 +510,55 @@ CFilterCardinalityTest::PstatspredConj(CMemoryPool *mp)
 	return GPOS_NEW(mp) CStatsPredConj(pdrgpstatspredConj3);
 }
 
+// create a 'col IN (...)' filter on a numeric column, whose points and
+// bucket bounds are counted on their double mapping
+CStatsPred *
+CFilterCardinalityTest::PstatspredArrayCmpAnyNumeric(CMemoryPool *mp)
+{
+	CWStringDynamic *pstr1 =
+		GPOS_NEW(mp) CWStringDynamic(mp, GPOS_WSZ_LIT("AAAACgAAAgABAA=="));
+	CWStringDynamic *pstr2 =
+		GPOS_NEW(mp) CWStringDynamic(mp, GPOS_WSZ_LIT("AAAACgAAAgACAA=="));
+	CWStringDynamic *pstr15 =
+		GPOS_NEW(mp) CWStringDynamic(mp, GPOS_WSZ_LIT("AAAACgAAAgAPAA=="));
+
+	CStatsPredPtrArry *pdrgpstatspred = GPOS_NEW(mp) CStatsPredPtrArry(mp);
+
+	CPointArray *arr = GPOS_NEW(mp) CPointArray(mp);
+	arr->Append(CCardinalityTestUtils::PpointNumeric(mp, pstr15, CDouble(15)));
+	arr->Append(CCardinalityTestUtils::PpointNumeric(mp, pstr1, CDouble(1)));
+	arr->Append(CCardinalityTestUtils::PpointNumeric(mp, pstr2, CDouble(2)));
+	arr->Append(CCardinalityTestUtils::PpointNumeric(mp, pstr1, CDouble(1)));
+
+	pdrgpstatspred->Append(
+		GPOS_NEW(mp) CStatsPredArrayCmp(1, CStatsPred::EstatscmptEq, arr));
+
+	GPOS_DELETE(pstr1);
+	GPOS_DELETE(pstr2);
+	GPOS_DELETE(pstr15);
+
+	return GPOS_NEW(mp) CStatsPredConj(pdrgpstatspred);
+}
+
+// create a 'col IN (...)' filter whose points are not of the bucket type,
+// which are counted on their datums instead of a mapping
+CStatsPred *
+CFilterCardinalityTest::PstatspredArrayCmpAnyMixedTypes(CMemoryPool *mp)
+{
+	CStatsPredPtrArry *pdrgpstatspred = GPOS_NEW(mp) CStatsPredPtrArry(mp);
+
+	CPointArray *arr = GPOS_NEW(mp) CPointArray(mp);
+	arr->Append(CTestUtils::PpointInt8(mp, 2));
+	arr->Append(CTestUtils::PpointInt8(mp, 15));
+	arr->Append(CTestUtils::PpointInt8(mp, 1));
+	arr->Append(CTestUtils::PpointInt8(mp, 15));
+
+	pdrgpstatspred->Append(
+		GPOS_NEW(mp) CStatsPredArrayCmp(1, CStatsPred::EstatscmptEq, arr));
+
+	return GPOS_NEW(mp) CStatsPredConj(pdrgpstatspred);
+}
+
 // reads a DXL document, generates the statistics object, performs a
 // filter operation on it, serializes it into a DXL document and
 // compares the generated DXL document with the expected DXL document.
@@ -21,6 +21,7 @@
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 
+#include "gpopt/optimizer/COptimizerConfig.h"
 #include "naucrates/statistics/CHistogram.h"
 #include "naucrates/statistics/CPoint.h"
 
@@ -39,12 +40,23 @@ CHistogramTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramInt4),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramBool),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_Skew),
+		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_MaxValueFrequency),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramValid),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_MergeUnion),
 		GPOS_UNITTEST_FUNC(
 			CHistogramTest::EresUnittest_MergeUnionDoubleLessThanEpsilon)};
 
 
+	// tests that install their own optimization context
+	CUnittest rgut[] = {
+		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CompactJoinHistogram)};
+
+	GPOS_RESULT eres = CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+	if (GPOS_OK != eres)
+	{
+		return eres;
+	}
+
 	CAutoMemoryPool amp;
 	CMemoryPool *mp = amp.Pmp();
 
@@ -323,6 +335,50 @@ CHistogramTest::EresUnittest_Skew()
 	return GPOS_OK;
 }
 
+// frequency of the most common value, from singleton buckets, range buckets,
+// and NULLs
+GPOS_RESULT
+CHistogramTest::EresUnittest_MaxValueFrequency()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// a value holding 20% of the rows, next to 100 values holding 50%
+	CBucketArray *pdrgppbucket1 = GPOS_NEW(mp) CBucketArray(mp);
+	pdrgppbucket1->Append(CCardinalityTestUtils::PbucketInteger(
+		mp, 1, 100, true /* is_lower_closed */, false /* is_upper_closed */,
+		CDouble(0.5), CDouble(100.0)));
+	pdrgppbucket1->Append(CCardinalityTestUtils::PbucketInteger(
+		mp, 100, 100, true /* is_lower_closed */, true /* is_upper_closed */,
+		CDouble(0.2), CDouble(1.0)));
+	CHistogram *histogram1 = GPOS_NEW(mp)
+		CHistogram(mp, pdrgppbucket1, true /* is_well_defined */,
+				   CDouble(0.1) /* null_freq */,
+				   CDouble(10.0) /* distinct_remaining */,
+				   CDouble(0.2) /* freq_remaining */);
+	GPOS_RTL_ASSERT(
+		CDouble::Equals(histogram1->GetMaxValueFrequency().Get(), 0.2, 1e-6));
+
+	// NULLs hash to the same segment, like a single value
+	CBucketArray *pdrgppbucket2 = GPOS_NEW(mp) CBucketArray(mp);
+	pdrgppbucket2->Append(CCardinalityTestUtils::PbucketInteger(
+		mp, 1, 100, true /* is_lower_closed */, false /* is_upper_closed */,
+		CDouble(0.3), CDouble(100.0)));
+	CHistogram *histogram2 = GPOS_NEW(mp)
+		CHistogram(mp, pdrgppbucket2, true /* is_well_defined */,
+				   CDouble(0.3) /* null_freq */,
+				   CDouble(0.0) /* distinct_remaining */,
+				   CDouble(0.0) /* freq_remaining */);
+	GPOS_RTL_ASSERT(
+		CDouble::Equals(histogram2->GetMaxValueFrequency().Get(), 0.5, 1e-6));
+
+	GPOS_DELETE(histogram1);
+	GPOS_DELETE(histogram2);
+
+	return GPOS_OK;
+}
+
 // basic merge commutativity test
 GPOS_RESULT
 CHistogramTest::EresUnittest_MergeUnion()
@@ -431,4 +487,77 @@ CHistogramTest::EresUnittest_MergeUnionDoubleLessThanEpsilon()
 
 	return GPOS_OK;
 }
+
+// join histograms are compacted to the maximum number of derived buckets,
+// keeping their frequency and NDV
+GPOS_RESULT
+CHistogramTest::EresUnittest_CompactJoinHistogram()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// derived histograms have at most 4 buckets
+	const ULONG max_derived_buckets = 4;
+	COptimizerConfig *optimizer_config = GPOS_NEW(mp) COptimizerConfig(
+		GPOS_NEW(mp) CEnumeratorConfig(mp, 0 /*plan_id*/, 0 /*ullSamples*/),
+		GPOS_NEW(mp) CStatisticsConfig(
+			mp, 0.75 /* damping_factor_filter */,
+			0.01 /* damping_factor_join */, 0.75 /* damping_factor_groupby */,
+			MAX_STATS_BUCKETS, max_derived_buckets),
+		CCTEConfig::PcteconfDefault(mp), CTestUtils::GetCostModel(mp),
+		CHint::PhintDefault(mp), CWindowOids::GetWindowOids(mp));
+	CAutoOptCtxt aoc(mp, &mda, NULL /* pceeval */, optimizer_config);
+
+	// [0, 100), [100, 200), ... [900, 1000) and
+	// [50, 150), [150, 250), ... [950, 1050); their join has 19 buckets
+	CBucketArray *buckets1 = GPOS_NEW(mp) CBucketArray(mp);
+	CBucketArray *buckets2 = GPOS_NEW(mp) CBucketArray(mp);
+	for (INT i = 0; i < 10; i++)
+	{
+		buckets1->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(
+			mp, i * 100, (i + 1) * 100, CDouble(0.1), CDouble(100.0)));
+		buckets2->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(
+			mp, i * 100 + 50, (i + 1) * 100 + 50, CDouble(0.1),
+			CDouble(50.0)));
+	}
+	CHistogram *histogram1 = GPOS_NEW(mp) CHistogram(mp, buckets1);
+	CHistogram *histogram2 = GPOS_NEW(mp) CHistogram(mp, buckets2);
+
+	// the same join, without compaction
+	CHistogram *expected =
+		histogram1->MakeJoinHistogram(CStatsPred::EstatscmptEq, histogram2);
+	(void) expected->NormalizeHistogram();
+	GPOS_RTL_ASSERT(max_derived_buckets < expected->GetNumBuckets());
+
+	CDouble scale_factor(0.0);
+	CHistogram *result = histogram1->MakeJoinHistogramNormalize(
+		CStatsPred::EstatscmptEq, 1000, histogram2, 1000, &scale_factor);
+
+	{
+		CAutoTrace at(mp);
+		result->OsPrint(at.Os());
+	}
+
+	GPOS_RTL_ASSERT(max_derived_buckets == result->GetNumBuckets());
+	GPOS_RTL_ASSERT(result->IsValid());
+	GPOS_RTL_ASSERT(
+		(result->GetFrequency() - expected->GetFrequency()).Absolute() <
+		CStatistics::Epsilon);
+	GPOS_RTL_ASSERT(
+		(result->GetNumDistinct() - expected->GetNumDistinct()).Absolute() <
+		CStatistics::Epsilon);
+
+	GPOS_DELETE(histogram1);
+	GPOS_DELETE(histogram2);
+	GPOS_DELETE(expected);
+	GPOS_DELETE(result);
+
+	return GPOS_OK;
+}
+
 // EOF
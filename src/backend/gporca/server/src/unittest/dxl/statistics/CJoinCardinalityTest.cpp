@@ -22,6 +22,7 @@
 #include "gpos/string/CWStringDynamic.h"
 
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/statistics/CJoinStatsCache.h"
 #include "naucrates/statistics/CStatisticsUtils.h"
 
 #include "unittest/base.h"
@@ -36,6 +37,7 @@ CJoinCardinalityTest::EresUnittest()
 	CUnittest rgutSharedOptCtxt[] = {
 		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_Join),
 		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_JoinNDVRemain),
+		GPOS_UNITTEST_FUNC(CJoinCardinalityTest::EresUnittest_JoinStatsCache),
 	};
 
 	// run tests with shared optimization context first
@@ -183,6 +185,135 @@ CJoinCardinalityTest::EresUnittest_JoinNDVRemain()
 	return eres;
 }
 
+//	test that commutative and associative variants of an inner join share
+//	the cached join statistics
+GPOS_RESULT
+CJoinCardinalityTest::EresUnittest_JoinStatsCache()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	CColumnFactory *col_factory = COptCtxt::PoctxtFromTLS()->Pcf();
+	const IMDTypeInt4 *pmdtypeint4 =
+		COptCtxt::PoctxtFromTLS()->Pmda()->PtMDType<IMDTypeInt4>();
+	CColRef *pcrA = col_factory->PcrCreate(pmdtypeint4, default_type_modifier);
+	CColRef *pcrB = col_factory->PcrCreate(pmdtypeint4, default_type_modifier);
+	CColRef *pcrC = col_factory->PcrCreate(pmdtypeint4, default_type_modifier);
+
+	// stand-ins for the statistics of three base relations
+	IStatistics *pstatsA = CStatistics::MakeEmptyStats(mp);
+	IStatistics *pstatsB = CStatistics::MakeEmptyStats(mp);
+	IStatistics *pstatsC = CStatistics::MakeEmptyStats(mp);
+
+	CExpression *pexprAB = CUtils::PexprScalarEqCmp(mp, pcrA, pcrB);
+	CExpression *pexprBC = CUtils::PexprScalarEqCmp(mp, pcrB, pcrC);
+
+	// stand-ins for derived join statistics
+	IStatistics *pstatsJoinAB = CStatistics::MakeEmptyStats(mp);
+	IStatistics *pstatsJoinBC = CStatistics::MakeEmptyStats(mp);
+	IStatistics *pstatsJoinABC = CStatistics::MakeEmptyStats(mp);
+
+	GPOS_RESULT eres = GPOS_OK;
+	{
+		CJoinStatsCache cache(mp);
+		CJoinStatsCache::CSignature *signature = NULL;
+		IStatisticsArray *pdrgpstat = NULL;
+		IStatistics *stats = NULL;
+
+		// A join B
+		pdrgpstat = GPOS_NEW(mp) IStatisticsArray(mp);
+		pstatsA->AddRef();
+		pdrgpstat->Append(pstatsA);
+		pstatsB->AddRef();
+		pdrgpstat->Append(pstatsB);
+		stats = cache.PstatsLookup(pdrgpstat, pexprAB, &signature);
+		pdrgpstat->Release();
+		GPOS_RTL_ASSERT(NULL == stats && NULL != signature);
+		cache.Insert(signature, pstatsJoinAB);
+
+		// B join A
+		pdrgpstat = GPOS_NEW(mp) IStatisticsArray(mp);
+		pstatsB->AddRef();
+		pdrgpstat->Append(pstatsB);
+		pstatsA->AddRef();
+		pdrgpstat->Append(pstatsA);
+		stats = cache.PstatsLookup(pdrgpstat, pexprAB, &signature);
+		pdrgpstat->Release();
+		if (pstatsJoinAB != stats)
+		{
+			eres = GPOS_FAILED;
+		}
+		CRefCount::SafeRelease(stats);
+
+		// (A join B) join C
+		pdrgpstat = GPOS_NEW(mp) IStatisticsArray(mp);
+		pstatsJoinAB->AddRef();
+		pdrgpstat->Append(pstatsJoinAB);
+		pstatsC->AddRef();
+		pdrgpstat->Append(pstatsC);
+		stats = cache.PstatsLookup(pdrgpstat, pexprBC, &signature);
+		pdrgpstat->Release();
+		GPOS_RTL_ASSERT(NULL == stats && NULL != signature);
+		cache.Insert(signature, pstatsJoinABC);
+
+		// B join C
+		pdrgpstat = GPOS_NEW(mp) IStatisticsArray(mp);
+		pstatsB->AddRef();
+		pdrgpstat->Append(pstatsB);
+		pstatsC->AddRef();
+		pdrgpstat->Append(pstatsC);
+		stats = cache.PstatsLookup(pdrgpstat, pexprBC, &signature);
+		pdrgpstat->Release();
+		GPOS_RTL_ASSERT(NULL == stats && NULL != signature);
+		cache.Insert(signature, pstatsJoinBC);
+
+		// A join (B join C)
+		pdrgpstat = GPOS_NEW(mp) IStatisticsArray(mp);
+		pstatsA->AddRef();
+		pdrgpstat->Append(pstatsA);
+		pstatsJoinBC->AddRef();
+		pdrgpstat->Append(pstatsJoinBC);
+		stats = cache.PstatsLookup(pdrgpstat, pexprAB, &signature);
+		pdrgpstat->Release();
+		if (pstatsJoinABC != stats)
+		{
+			eres = GPOS_FAILED;
+		}
+		CRefCount::SafeRelease(stats);
+
+		// A join C under a different predicate is not the same join
+		pdrgpstat = GPOS_NEW(mp) IStatisticsArray(mp);
+		pstatsA->AddRef();
+		pdrgpstat->Append(pstatsA);
+		pstatsC->AddRef();
+		pdrgpstat->Append(pstatsC);
+		stats = cache.PstatsLookup(pdrgpstat, pexprAB, &signature);
+		pdrgpstat->Release();
+		if (NULL != stats)
+		{
+			eres = GPOS_FAILED;
+		}
+		CRefCount::SafeRelease(stats);
+		CRefCount::SafeRelease(signature);
+
+		if (6 != cache.UlLookups() || 2 != cache.UlHits())
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+
+	pstatsJoinABC->Release();
+	pstatsJoinBC->Release();
+	pstatsJoinAB->Release();
+	pexprBC->Release();
+	pexprAB->Release();
+	pstatsC->Release();
+	pstatsB->Release();
+	pstatsA->Release();
+
+	return eres;
+}
+
 //	join buckets tests
 GPOS_RESULT
 CJoinCardinalityTest::EresUnittest_Join()
@@ -18,11 +18,14 @@
 #include <stdint.h>
 
 #include "gpos/error/CAutoTrace.h"
+#include "gpos/task/CAutoTraceFlag.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 
 #include "gpopt/base/CQueryContext.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
+#include "gpopt/mdcache/CAutoMDAccessor.h"
+#include "gpopt/operators/CLogicalGet.h"
 #include "gpopt/operators/CLogicalInnerJoin.h"
 #include "gpopt/operators/CScalarProjectElement.h"
 #include "naucrates/base/CDatumBoolGPDB.h"
@@ -49,6 +52,8 @@ using namespace gpopt;
 
 const CHAR *szQuerySelect = "../data/dxl/statistics/SelectQuery.xml";
 const CHAR *szPlanSelect = "../data/dxl/statistics/SelectPlan.xml";
+const CHAR *szMultiColStatsMetadata =
+	"../data/dxl/statistics/MultiColStats-Metadata.xml";
 
 // unittest for statistics objects
 GPOS_RESULT
@@ -68,6 +73,7 @@ CStatisticsTest::EresUnittest()
 	CUnittest rgutSeparateOptCtxt[] = {
 		GPOS_UNITTEST_FUNC(
 			CStatisticsTest::EresUnittest_GbAggWithRepeatedGbCols),
+		GPOS_UNITTEST_FUNC(CStatisticsTest::EresUnittest_MultiColStats),
 	};
 
 	// run tests with shared optimization context first
@@ -751,4 +757,170 @@ CStatisticsTest::EresUnittest_CStatisticsCopy()
 	return eres;
 }
 
+// test the use of the statistics that ANALYZE collects on groups of
+// columns: table t has 200 combinations of (a, b), and b is determined by a
+// in 80% of the rows
+GPOS_RESULT
+CStatisticsTest::EresUnittest_MultiColStats()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// reset metadata cache
+	CMDCache::Reset();
+
+	CMDProviderMemory *pmdp =
+		GPOS_NEW(mp) CMDProviderMemory(mp, szMultiColStatsMetadata);
+	CAutoMDAccessor amda(mp, pmdp, CTestUtils::m_sysidDefault);
+	CAutoOptCtxt aoc(mp, amda.Pmda(), NULL /* pceeval */,
+					 CTestUtils::GetCostModel(mp));
+
+	CWStringConst strAlias(GPOS_WSZ_LIT("t"));
+	CExpression *pexprGet = CTestUtils::PexprLogicalGet(
+		mp,
+		CTestUtils::PtabdescFromMDRelation(
+			mp, GPOS_NEW(mp) CMDIdGPDB(IMDId::EmdidRel, 80010, 1, 1)),
+		&strAlias);
+	CColRefArray *colrefs =
+		CLogicalGet::PopConvert(pexprGet->Pop())->PdrgpcrOutput();
+	const ULONG colid_a = (*colrefs)[0]->Id();
+	const ULONG colid_b = (*colrefs)[1]->Id();
+	const ULONG colid_c = (*colrefs)[2]->Id();
+
+	// grouping on a and b uses the number of combinations
+	ULongPtrArray *grouping_cols = Pdrgpul(mp, colid_a, colid_b);
+	CDoubleArray *ndvs = GPOS_NEW(mp) CDoubleArray(mp);
+	ndvs->Append(GPOS_NEW(mp) CDouble(100.0));
+	ndvs->Append(GPOS_NEW(mp) CDouble(100.0));
+	CDoubleArray *result = CStatisticsUtils::CombineNdvsWithMultiColStats(
+		mp, CDouble(10000.0), grouping_cols, ndvs);
+	GPOS_RTL_ASSERT(1 == result->Size());
+	GPOS_RTL_ASSERT(CDouble::Equals(200.0, (*result)[0]->Get()));
+	result->Release();
+	ndvs->Release();
+
+	// after a filter that keeps half of the rows, the number of
+	// combinations is halved, but stays at least the NDV of a
+	ndvs = GPOS_NEW(mp) CDoubleArray(mp);
+	ndvs->Append(GPOS_NEW(mp) CDouble(50.0));
+	ndvs->Append(GPOS_NEW(mp) CDouble(20.0));
+	result = CStatisticsUtils::CombineNdvsWithMultiColStats(
+		mp, CDouble(5000.0), grouping_cols, ndvs);
+	GPOS_RTL_ASSERT(1 == result->Size());
+	GPOS_RTL_ASSERT(CDouble::Equals(100.0, (*result)[0]->Get()));
+	result->Release();
+
+	result = CStatisticsUtils::CombineNdvsWithMultiColStats(
+		mp, CDouble(1000.0), grouping_cols, ndvs);
+	GPOS_RTL_ASSERT(1 == result->Size());
+	GPOS_RTL_ASSERT(CDouble::Equals(50.0, (*result)[0]->Get()));
+	result->Release();
+	ndvs->Release();
+	grouping_cols->Release();
+
+	// columns that do not cover a group keep their NDVs
+	grouping_cols = Pdrgpul(mp, colid_a, colid_c);
+	ndvs = GPOS_NEW(mp) CDoubleArray(mp);
+	ndvs->Append(GPOS_NEW(mp) CDouble(100.0));
+	ndvs->Append(GPOS_NEW(mp) CDouble(30.0));
+	result = CStatisticsUtils::CombineNdvsWithMultiColStats(
+		mp, CDouble(10000.0), grouping_cols, ndvs);
+	GPOS_RTL_ASSERT(2 == result->Size());
+	GPOS_RTL_ASSERT(CDouble::Equals(100.0, (*result)[0]->Get()));
+	GPOS_RTL_ASSERT(CDouble::Equals(30.0, (*result)[1]->Get()));
+	result->Release();
+	ndvs->Release();
+	grouping_cols->Release();
+
+	// equality predicates on a, b and c with selectivities 1/100, 1/100
+	// and 1/4: the predicates on a and b are combined into
+	// 1/100 * (0.8 + 0.2 * 1/100)
+	CDoubleArray *scale_factors = GPOS_NEW(mp) CDoubleArray(mp);
+	scale_factors->Append(GPOS_NEW(mp) CDouble(100.0));
+	scale_factors->Append(GPOS_NEW(mp) CDouble(100.0));
+	scale_factors->Append(GPOS_NEW(mp) CDouble(4.0));
+	ULongPtrArray *scale_factor_colids = Pdrgpul(mp, colid_a, colid_b);
+	scale_factor_colids->Append(GPOS_NEW(mp) ULONG(colid_c));
+	CBitSet *eq_colids = GPOS_NEW(mp) CBitSet(mp);
+	(void) eq_colids->ExchangeSet(colid_a);
+	(void) eq_colids->ExchangeSet(colid_b);
+	(void) eq_colids->ExchangeSet(colid_c);
+	result = CFilterStatsProcessor::ApplyDependencies(
+		mp, scale_factors, scale_factor_colids, eq_colids);
+	GPOS_RTL_ASSERT(2 == result->Size());
+	GPOS_RTL_ASSERT(CDouble::Equals(1.0 / (0.01 * (0.8 + 0.2 * 0.01)),
+									(*result)[0]->Get(), 1e-6));
+	GPOS_RTL_ASSERT(CDouble::Equals(4.0, (*result)[1]->Get()));
+	result->Release();
+	eq_colids->Release();
+
+	// a range predicate on b is not combined with the equality on a
+	eq_colids = GPOS_NEW(mp) CBitSet(mp);
+	(void) eq_colids->ExchangeSet(colid_a);
+	(void) eq_colids->ExchangeSet(colid_c);
+	result = CFilterStatsProcessor::ApplyDependencies(
+		mp, scale_factors, scale_factor_colids, eq_colids);
+	GPOS_RTL_ASSERT(3 == result->Size());
+	GPOS_RTL_ASSERT(CDouble::Equals(100.0, (*result)[0]->Get()));
+	GPOS_RTL_ASSERT(CDouble::Equals(100.0, (*result)[1]->Get()));
+	GPOS_RTL_ASSERT(CDouble::Equals(4.0, (*result)[2]->Get()));
+	result->Release();
+	eq_colids->Release();
+	scale_factors->Release();
+	scale_factor_colids->Release();
+
+	// in a self-join, a and b of different instances of t are not combined
+	CWStringConst strAlias2(GPOS_WSZ_LIT("t2"));
+	CExpression *pexprGet2 = CTestUtils::PexprLogicalGet(
+		mp,
+		CTestUtils::PtabdescFromMDRelation(
+			mp, GPOS_NEW(mp) CMDIdGPDB(IMDId::EmdidRel, 80010, 1, 1)),
+		&strAlias2);
+	const ULONG colid_b2 = (*CLogicalGet::PopConvert(pexprGet2->Pop())
+							   ->PdrgpcrOutput())[1]
+							   ->Id();
+
+	grouping_cols = Pdrgpul(mp, colid_a, colid_b2);
+	ndvs = GPOS_NEW(mp) CDoubleArray(mp);
+	ndvs->Append(GPOS_NEW(mp) CDouble(100.0));
+	ndvs->Append(GPOS_NEW(mp) CDouble(100.0));
+	result = CStatisticsUtils::CombineNdvsWithMultiColStats(
+		mp, CDouble(10000.0), grouping_cols, ndvs);
+	GPOS_RTL_ASSERT(2 == result->Size());
+	result->Release();
+
+	scale_factors = GPOS_NEW(mp) CDoubleArray(mp);
+	scale_factors->Append(GPOS_NEW(mp) CDouble(100.0));
+	scale_factors->Append(GPOS_NEW(mp) CDouble(100.0));
+	eq_colids = GPOS_NEW(mp) CBitSet(mp);
+	(void) eq_colids->ExchangeSet(colid_a);
+	(void) eq_colids->ExchangeSet(colid_b2);
+	result = CFilterStatsProcessor::ApplyDependencies(
+		mp, scale_factors, grouping_cols, eq_colids);
+	GPOS_RTL_ASSERT(2 == result->Size());
+	GPOS_RTL_ASSERT(CDouble::Equals(100.0, (*result)[0]->Get()));
+	GPOS_RTL_ASSERT(CDouble::Equals(100.0, (*result)[1]->Get()));
+	result->Release();
+	eq_colids->Release();
+	scale_factors->Release();
+	grouping_cols->Release();
+
+	// nothing is combined when the statistics are disabled
+	{
+		CAutoTraceFlag atf(EopttraceDisableMultiColStats, true);
+		grouping_cols = Pdrgpul(mp, colid_a, colid_b);
+		result = CStatisticsUtils::CombineNdvsWithMultiColStats(
+			mp, CDouble(10000.0), grouping_cols, ndvs);
+		GPOS_RTL_ASSERT(2 == result->Size());
+		result->Release();
+		grouping_cols->Release();
+	}
+	ndvs->Release();
+
+	pexprGet2->Release();
+	pexprGet->Release();
+
+	return GPOS_OK;
+}
+
 // EOF
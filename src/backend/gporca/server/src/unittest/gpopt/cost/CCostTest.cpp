@@ -14,15 +14,20 @@
 #include "gpos/task/CAutoTraceFlag.h"
 
 #include "gpdbcost/CCostModelGPDB.h"
+#include "gpopt/base/CCostContext.h"
 #include "gpopt/cost/CCost.h"
 #include "gpopt/cost/ICostModelParams.h"
 #include "gpopt/engine/CEngine.h"
+#include "gpopt/mdcache/CAutoMDAccessor.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/minidump/CMinidumperUtils.h"
+#include "gpopt/operators/CLogicalGet.h"
 #include "gpopt/operators/CLogicalInnerJoin.h"
+#include "gpopt/operators/CPhysicalTableScan.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
 #include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/dxl/parser/CParseHandlerDXL.h"
+#include "naucrates/md/CMDProviderMemory.h"
 
 #include "unittest/base.h"
 #include "unittest/gpopt/CTestUtils.h"
@@ -44,6 +49,9 @@ CCostTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CCostTest::EresUnittest_Params),
 		GPOS_UNITTEST_FUNC(CCostTest::EresUnittest_Parsing),
 		GPOS_UNITTEST_FUNC(EresUnittest_SetParams),
+		GPOS_UNITTEST_FUNC(EresUnittest_OperatorMemoryQuota),
+		GPOS_UNITTEST_FUNC(EresUnittest_ScanWidth),
+		GPOS_UNITTEST_FUNC(EresUnittest_SkewedDistribution),
 
 		// TODO: : re-enable test after resolving exception throwing problem on OSX
 		// GPOS_UNITTEST_FUNC_THROW(CCostTest::EresUnittest_ParsingWithException, gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag),
@@ -380,4 +388,264 @@ CCostTest::EresUnittest_SetParams()
 	return GPOS_OK;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::EresUnittest_OperatorMemoryQuota
+//
+//	@doc:
+//		Test of splitting the query memory budget among memory-intensive
+//		operators
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCostTest::EresUnittest_OperatorMemoryQuota()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// no memory budget, spilling is judged by the fixed threshold
+	CHint *phintDefault = CHint::PhintDefault(mp);
+	GPOS_RTL_ASSERT(0.0 ==
+					CCostModelGPDB::DOperatorMemoryQuota(phintDefault));
+	phintDefault->Release();
+
+	// 1MB shared by four memory-intensive operators
+	CHint *phint = GPOS_NEW(mp)
+		CHint(gpos::int_max, gpos::int_max, JOIN_ORDER_DP_THRESHOLD,
+			  BROADCAST_THRESHOLD, true, PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD,
+			  XFORM_BIND_THRESHOLD, SKEW_FACTOR, 1024 /*query_memory_kb*/,
+			  4 /*memory_intensive_operators*/);
+	GPOS_RTL_ASSERT(256.0 * 1024 ==
+					CCostModelGPDB::DOperatorMemoryQuota(phint));
+	phint->Release();
+
+	// unknown number of operators, the whole budget goes to each of them
+	phint = GPOS_NEW(mp)
+		CHint(gpos::int_max, gpos::int_max, JOIN_ORDER_DP_THRESHOLD,
+			  BROADCAST_THRESHOLD, true, PUSH_GROUP_BY_BELOW_SETOP_THRESHOLD,
+			  XFORM_BIND_THRESHOLD, SKEW_FACTOR, 1024 /*query_memory_kb*/,
+			  0 /*memory_intensive_operators*/);
+	GPOS_RTL_ASSERT(1024.0 * 1024 ==
+					CCostModelGPDB::DOperatorMemoryQuota(phint));
+	phint->Release();
+
+	const CDouble dQuota(1024.0 * 1024);
+	const CDouble dUnit(2.0);
+
+	// a sort spills its whole input once the input exceeds the quota
+	GPOS_RTL_ASSERT(0.0 == CCostModelGPDB::DSortSpillCost(
+							   dQuota, CDouble(1024), CDouble(1024), dUnit));
+	GPOS_RTL_ASSERT(2048.0 * 1024 * 2 ==
+					CCostModelGPDB::DSortSpillCost(dQuota, CDouble(2048),
+												   CDouble(1024), dUnit));
+	GPOS_RTL_ASSERT(0.0 == CCostModelGPDB::DSortSpillCost(
+							   CDouble(0.0), CDouble(2048), CDouble(1024),
+							   dUnit));
+
+	// a hash agg spills the input of the groups that do not fit, here half
+	// of them
+	GPOS_RTL_ASSERT(0.0 == CCostModelGPDB::DHashAggSpillCost(
+							   dQuota, dQuota, CDouble(4096), CDouble(100),
+							   dUnit));
+	GPOS_RTL_ASSERT(4096.0 * 100 * 0.5 * 2 ==
+					CCostModelGPDB::DHashAggSpillCost(
+						dQuota, dQuota * 2, CDouble(4096), CDouble(100),
+						dUnit));
+	GPOS_RTL_ASSERT(0.0 == CCostModelGPDB::DHashAggSpillCost(
+							   CDouble(0.0), dQuota * 2, CDouble(4096),
+							   CDouble(100), dUnit));
+
+	// a hash join spills once the inner side exceeds the quota, and the
+	// fixed threshold when the quota is unknown
+	CCostModelGPDB *pcm = GPOS_NEW(mp) CCostModelGPDB(mp, GPOPT_TEST_SEGMENTS);
+	ICostModelParams *pcp = pcm->GetCostModelParams();
+	const CDouble dHJSpillingMemThreshold =
+		pcp->PcpLookup(CCostModelParamsGPDB::EcpHJSpillingMemThreshold)->Get();
+	GPOS_RTL_ASSERT(dQuota < dHJSpillingMemThreshold);
+	GPOS_RTL_ASSERT(!CCostModelGPDB::FHashJoinSpills(
+		dQuota, dHJSpillingMemThreshold, dQuota));
+	GPOS_RTL_ASSERT(CCostModelGPDB::FHashJoinSpills(
+		dQuota, dHJSpillingMemThreshold, dQuota * 2));
+	GPOS_RTL_ASSERT(!CCostModelGPDB::FHashJoinSpills(
+		CDouble(0.0), dHJSpillingMemThreshold, dQuota * 2));
+	GPOS_RTL_ASSERT(CCostModelGPDB::FHashJoinSpills(
+		CDouble(0.0), dHJSpillingMemThreshold, dHJSpillingMemThreshold * 2));
+
+	// and costs more per tuple when it spills
+	GPOS_RTL_ASSERT(
+		pcp->PcpLookup(CCostModelParamsGPDB::EcpJoinFeedingTupColumnCostUnit)
+			->Get() <
+		pcp->PcpLookup(
+			   CCostModelParamsGPDB::EcpHJFeedingTupColumnSpillingCostUnit)
+			->Get());
+	GPOS_RTL_ASSERT(
+		pcp->PcpLookup(CCostModelParamsGPDB::EcpJoinFeedingTupWidthCostUnit)
+			->Get() <
+		pcp->PcpLookup(
+			   CCostModelParamsGPDB::EcpHJFeedingTupWidthSpillingCostUnit)
+			->Get());
+	GPOS_RTL_ASSERT(
+		pcp->PcpLookup(CCostModelParamsGPDB::EcpHJHashingTupWidthCostUnit)
+			->Get() <
+		pcp->PcpLookup(
+			   CCostModelParamsGPDB::EcpHJHashingTupWidthSpillingCostUnit)
+			->Get());
+	pcm->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::PopTableScan
+//
+//	@doc:
+//		Generate a table scan of the given relation, outputting all of its
+//		columns
+//
+//---------------------------------------------------------------------------
+CPhysicalTableScan *
+CCostTest::PopTableScan(CMemoryPool *mp, ULONG ulTableId)
+{
+	CTableDescriptor *ptabdesc = CTestUtils::PtabdescFromMDRelation(
+		mp, GPOS_NEW(mp) CMDIdGPDB(IMDId::EmdidRel, ulTableId, 1, 1));
+	const CName &nameTable = ptabdesc->Name();
+
+	CLogicalGet *popGet = GPOS_NEW(mp)
+		CLogicalGet(mp, GPOS_NEW(mp) CName(mp, nameTable), ptabdesc);
+	CColRefArray *pdrgpcrOutput = popGet->PdrgpcrOutput();
+	ptabdesc->AddRef();
+	pdrgpcrOutput->AddRef();
+	popGet->Release();
+
+	return GPOS_NEW(mp) CPhysicalTableScan(
+		mp, GPOS_NEW(mp) CName(mp, nameTable), ptabdesc, pdrgpcrOutput);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::EresUnittest_ScanWidth
+//
+//	@doc:
+//		Test that scans of column-oriented tables are costed by the
+//		compressed width of the columns they read, and scans of heap tables
+//		by the width of the whole row
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCostTest::EresUnittest_ScanWidth()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// reset metadata cache
+	CMDCache::Reset();
+
+	CMDProviderMemory *pmdp = GPOS_NEW(mp)
+		CMDProviderMemory(mp, "../data/dxl/cost/ScanWidth-Metadata.xml");
+	CAutoMDAccessor amda(mp, pmdp, CTestUtils::m_sysidDefault);
+	CAutoOptCtxt aoc(mp, amda.Pmda(), NULL,
+					 /* pceeval */ CTestUtils::GetCostModel(mp));
+
+	const CDouble dDefaultWidth(12.0);
+	CPhysicalTableScan *popHeap = PopTableScan(mp, 80001);
+	CPhysicalTableScan *popAOCO = PopTableScan(mp, 80002);
+	CPhysicalTableScan *popUnanalyzed = PopTableScan(mp, 80003);
+
+	// no required columns are known
+	GPOS_RTL_ASSERT(dDefaultWidth ==
+					CCostModelGPDB::DScanWidth(popAOCO, NULL, dDefaultWidth));
+
+	// a heap table is read row by row
+	CColRefSet *pcrs = GPOS_NEW(mp) CColRefSet(mp);
+	pcrs->Include((*popHeap->PdrgpcrOutput())[0]);
+	GPOS_RTL_ASSERT(dDefaultWidth ==
+					CCostModelGPDB::DScanWidth(popHeap, pcrs, dDefaultWidth));
+	pcrs->Release();
+
+	// a column-oriented table only reads the required columns, at their
+	// compressed width
+	pcrs = GPOS_NEW(mp) CColRefSet(mp);
+	pcrs->Include((*popAOCO->PdrgpcrOutput())[0]);
+	pcrs->Include((*popAOCO->PdrgpcrOutput())[2]);
+	GPOS_RTL_ASSERT(2.5 ==
+					CCostModelGPDB::DScanWidth(popAOCO, pcrs, dDefaultWidth));
+	pcrs->Release();
+
+	// and the narrowest column when none is required
+	pcrs = GPOS_NEW(mp) CColRefSet(mp);
+	GPOS_RTL_ASSERT(0.5 ==
+					CCostModelGPDB::DScanWidth(popAOCO, pcrs, dDefaultWidth));
+	pcrs->Release();
+
+	// without compressed widths the whole row is costed
+	pcrs = GPOS_NEW(mp) CColRefSet(mp);
+	pcrs->Include((*popUnanalyzed->PdrgpcrOutput())[0]);
+	GPOS_RTL_ASSERT(dDefaultWidth == CCostModelGPDB::DScanWidth(
+										 popUnanalyzed, pcrs, dDefaultWidth));
+	pcrs->Release();
+
+	popHeap->Release();
+	popAOCO->Release();
+	popUnanalyzed->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::EresUnittest_SkewedDistribution
+//
+//	@doc:
+//		Test that a hashed distribution is costed by the rows of its busiest
+//		host, which receives the most common value of the distribution key
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCostTest::EresUnittest_SkewedDistribution()
+{
+	const ULONG ulHosts = 4;
+	const CDouble rows(1000000.0);
+
+	// a distribution key with many values spreads the rows evenly
+	GPOS_RTL_ASSERT(
+		CDouble(250000.0) ==
+		CCostContext::DRowsPerHostHashed(rows, CDouble(1000.0), CDouble(0.0),
+										 ulHosts));
+
+	// and so does one whose most common value is not larger than the share
+	// of a host
+	GPOS_RTL_ASSERT(
+		CDouble(250000.0) ==
+		CCostContext::DRowsPerHostHashed(rows, CDouble(1000.0), CDouble(0.25),
+										 ulHosts));
+
+	// a key with fewer values than hosts only uses some of the hosts
+	GPOS_RTL_ASSERT(
+		CDouble(500000.0) ==
+		CCostContext::DRowsPerHostHashed(rows, CDouble(2.0), CDouble(0.0),
+										 ulHosts));
+
+	// a value in 60% of the rows makes its host receive it, and its share of
+	// the other 40%, which raises the rows costed above the uniform spread
+	const CDouble dRowsSkewed = CCostContext::DRowsPerHostHashed(
+		rows, CDouble(1000.0), CDouble(0.6), ulHosts);
+	GPOS_RTL_ASSERT(CDouble::Equals(700000.0, dRowsSkewed.Get(), 1.0));
+	GPOS_RTL_ASSERT(CDouble(250000.0) < dRowsSkewed);
+
+	// the busiest host is not less loaded than the hosts used by few values
+	GPOS_RTL_ASSERT(CDouble::Equals(
+		700000.0,
+		CCostContext::DRowsPerHostHashed(rows, CDouble(2.0), CDouble(0.6),
+										 ulHosts)
+			.Get(),
+		1.0));
+
+	return GPOS_OK;
+}
+
 // EOF
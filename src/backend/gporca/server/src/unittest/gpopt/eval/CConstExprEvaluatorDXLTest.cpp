@@ -17,6 +17,8 @@
 
 #include "unittest/gpopt/eval/CConstExprEvaluatorDXLTest.h"
 
+#include "gpos/memory/CAutoMemoryPool.h"
+
 #include "gpopt/base/CAutoOptCtxt.h"
 #include "gpopt/base/CUtils.h"
 #include "gpopt/eval/CConstExprEvaluatorDXL.h"
@@ -51,6 +53,8 @@ CConstExprEvaluatorDXLTest::CDummyConstDXLNodeEvaluator::EvaluateExpr(
 	const gpdxl::CDXLNode * /*pdxlnExpr*/
 )
 {
+	m_ulCalls++;
+
 	const IMDTypeInt4 *pmdtypeint4 = m_pmda->PtMDType<IMDTypeInt4>();
 	pmdtypeint4->MDId()->AddRef();
 
@@ -85,6 +89,8 @@ CConstExprEvaluatorDXLTest::EresUnittest()
 										 EresUnittest_ScalarContainingVariables,
 									 gpdxl::ExmaGPOPT,
 									 gpdxl::ExmiEvalUnsupportedScalarExpr),
+			GPOS_UNITTEST_FUNC(
+				CConstExprEvaluatorDXLTest::EresUnittest_Memoization),
 		};
 
 		return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -191,4 +197,57 @@ CConstExprEvaluatorDXLTest::EresUnittest_ScalarContainingVariables()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorDXLTest::EresUnittest_Memoization
+//
+//	@doc:
+//		Test that structurally identical expressions are evaluated once, even
+//		when they are allocated from different memory pools.
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorDXLTest::EresUnittest_Memoization()
+{
+	CTestUtils::CTestSetup testsetup;
+	CMemoryPool *mp = testsetup.Pmp();
+	CDummyConstDXLNodeEvaluator consteval(mp, testsetup.Pmda(),
+										  m_iDefaultEvalValue);
+	CConstExprEvaluatorDXL *pceeval =
+		GPOS_NEW(mp) CConstExprEvaluatorDXL(mp, testsetup.Pmda(), &consteval);
+
+	const ULONG ulRepeats = 3;
+	for (ULONG ul = 0; ul < ulRepeats; ul++)
+	{
+		CAutoMemoryPool amp;
+		CMemoryPool *pmpLocal = amp.Pmp();
+
+		CExpression *pexprCmp = CUtils::PexprScalarEqCmp(
+			pmpLocal, CUtils::PexprScalarConstInt4(pmpLocal, 200 /*val*/),
+			CUtils::PexprScalarConstInt4(pmpLocal, 100 /*val*/));
+
+		CExpression *pexprResult = pceeval->PexprEval(pexprCmp);
+		GPOS_RTL_ASSERT(COperator::EopScalarConst ==
+						pexprResult->Pop()->Eopid());
+		pexprResult->Release();
+		pexprCmp->Release();
+	}
+
+	// a different expression has to be evaluated
+	CExpression *pexprCmp = CUtils::PexprScalarEqCmp(
+		mp, CUtils::PexprScalarConstInt4(mp, 200 /*val*/),
+		CUtils::PexprScalarConstInt4(mp, 101 /*val*/));
+	CExpression *pexprResult = pceeval->PexprEval(pexprCmp);
+	pexprResult->Release();
+	pexprCmp->Release();
+
+	GPOS_RTL_ASSERT(2 == consteval.UlCalls());
+	GPOS_RTL_ASSERT(2 == pceeval->UlEvaluations());
+	GPOS_RTL_ASSERT(ulRepeats - 1 == pceeval->UlCacheHits());
+
+	pceeval->Release();
+
+	return GPOS_OK;
+}
+
 // EOF
@@ -48,6 +48,7 @@ CSearchStrategyTest::EresUnittest()
 		GPOS_UNITTEST_FUNC_THROW(
 			CSearchStrategyTest::EresUnittest_ParsingWithException,
 			gpdxl::ExmaDXL, gpdxl::ExmiDXLXercesParseError),
+		GPOS_UNITTEST_FUNC(CSearchStrategyTest::EresUnittest_ReusedCosts),
 	};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -207,6 +208,60 @@ CSearchStrategyTest::EresUnittest_ParsingWithException()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CSearchStrategyTest::EresUnittest_ReusedCosts
+//
+//	@doc:
+//		Test reusing costs of equivalent cost contexts. The second search
+//		stage finds better plans for child contexts costed in the first
+//		one, so costs computed in the first stage must not be reused;
+//		debug builds check that every reused cost equals the cost computed
+//		from scratch
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSearchStrategyTest::EresUnittest_ReusedCosts()
+{
+	CAutoMemoryPool amp;
+	CMemoryPool *mp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(mp, CMDCache::Pcache());
+	mda.RegisterProvider(CTestUtils::m_sysidDefault, pmdp);
+
+	ULONG ulReusedCosts = 0;
+
+	// install opt context in TLS
+	{
+		CAutoOptCtxt aoc(mp, &mda, NULL, /* pceeval */
+						 CTestUtils::GetCostModel(mp));
+		CExpression *pexpr = CTestUtils::PexprLogicalNAryJoin(mp);
+		CQueryContext *pqc = CTestUtils::PqcGenerate(mp, pexpr);
+
+		CEngine eng(mp);
+		eng.Init(pqc, PdrgpssRandom(mp));
+		eng.Optimize();
+
+		CExpression *pexprPlan = eng.PexprExtractPlan();
+		ulReusedCosts = eng.UlReusedCosts();
+
+		pexprPlan->Release();
+		GPOS_DELETE(pqc);
+		pexpr->Release();
+	}
+
+	if (0 == ulReusedCosts)
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CSearchStrategyTest::PdrgpssRandom
@@ -119,6 +119,8 @@ _copyPlannedStmt(const PlannedStmt *from)
 	COPY_NODE_FIELD(queryPartOids);
 	COPY_NODE_FIELD(queryPartsMetadata);
 	COPY_NODE_FIELD(numSelectorsPerScanId);
+	COPY_NODE_FIELD(feedbackKeys);
+	COPY_NODE_FIELD(feedbackFingerprints);
 	COPY_NODE_FIELD(rowMarks);
 	COPY_NODE_FIELD(relationOids);
 	COPY_NODE_FIELD(invalItems);
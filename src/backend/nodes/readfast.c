@@ -1369,6 +1369,8 @@ _readPlannedStmt(void)
 	READ_NODE_FIELD(queryPartOids);
 	READ_NODE_FIELD(queryPartsMetadata);
 	READ_NODE_FIELD(numSelectorsPerScanId);
+	READ_NODE_FIELD(feedbackKeys);
+	READ_NODE_FIELD(feedbackFingerprints);
 	READ_NODE_FIELD(rowMarks);
 	READ_NODE_FIELD(relationOids);
 	/* invalItems not serialized in outfast.c */
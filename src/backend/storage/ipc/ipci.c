@@ -64,6 +64,8 @@
 #include "executor/instrument.h"
 #include "executor/spi.h"
 #include "utils/workfile_mgr.h"
+#include "utils/mdsharedcache.h"
+#include "utils/cardfeedback.h"
 #include "utils/session_state.h"
 #include "cdb/cdbendpoint.h"
 #include "replication/gp_replication.h"
@@ -181,6 +183,8 @@ CreateSharedMemoryAndSemaphores(int port)
 		size = add_size(size, CheckpointerShmemSize());
 		size = add_size(size, CancelBackendMsgShmemSize());
 		size = add_size(size, WorkFileShmemSize());
+		size = add_size(size, MDSharedCacheShmemSize());
+		size = add_size(size, CardFeedbackShmemSize());
 
 #ifdef FAULT_INJECTOR
 		size = add_size(size, FaultInjector_ShmemSize());
@@ -354,6 +358,8 @@ CreateSharedMemoryAndSemaphores(int port)
 	AsyncShmemInit();
 	BackendCancelShmemInit();
 	WorkFileShmemInit();
+	MDSharedCacheShmemInit();
+	CardFeedbackShmemInit();
 
 	/*
 	 * Set up Instrumentation free list
@@ -8,13 +8,19 @@
  *
  * gp_opt_version: This function wraps LibraryVersion. 
  *
+ * gp_opt_mdcache_stats: This function wraps MDCacheStats.
+ *
+ * gp_opt_mdsharedcache_stats: Statistics of the shared metadata cache tier.
+ *
  * Copyright(c) 2012 - present, EMC/Greenplum
  */
 
 #include "postgres.h"
 
+#include "access/htup_details.h"
 #include "funcapi.h"
 #include "utils/builtins.h"
+#include "utils/mdsharedcache.h"
 
 extern Datum EnableXform(PG_FUNCTION_ARGS);
 
@@ -60,3 +66,52 @@ gp_opt_version(PG_FUNCTION_ARGS __attribute__((unused)))
 	return CStringGetTextDatum("Server has been compiled without ORCA");
 #endif
 }
+
+extern Datum MDCacheStats(PG_FUNCTION_ARGS);
+
+/*
+* Returns the statistics of the optimizer metadata cache of this session.
+*/
+Datum
+gp_opt_mdcache_stats(PG_FUNCTION_ARGS)
+{
+#ifdef USE_ORCA
+	return MDCacheStats(fcinfo);
+#else
+	FuncCallContext *funcctx;
+
+	if (SRF_IS_FIRSTCALL())
+		funcctx = SRF_FIRSTCALL_INIT();
+
+	funcctx = SRF_PERCALL_SETUP();
+	SRF_RETURN_DONE(funcctx);
+#endif
+}
+
+/*
+* Returns the statistics of the shared tier of the optimizer metadata cache,
+* all zero if it is disabled.
+*/
+Datum
+gp_opt_mdsharedcache_stats(PG_FUNCTION_ARGS)
+{
+	MDSharedCacheStats stats;
+	TupleDesc	tupdesc;
+	Datum		values[6];
+	bool		nulls[6];
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	MemSet(nulls, 0, sizeof(nulls));
+
+	values[0] = BoolGetDatum(MDSharedCacheGetStats(&stats));
+	values[1] = Int64GetDatum((int64) stats.entries);
+	values[2] = Int64GetDatum((int64) stats.bytes);
+	values[3] = Int64GetDatum((int64) stats.hits);
+	values[4] = Int64GetDatum((int64) stats.misses);
+	values[5] = Int64GetDatum((int64) stats.resets);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(BlessTupleDesc(tupdesc),
+													  values, nulls)));
+}
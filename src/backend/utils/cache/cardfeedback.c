@@ -0,0 +1,339 @@
+/*-------------------------------------------------------------------------
+ *
+ * cardfeedback.c
+ *	  Store of row counts observed while executing ORCA plans.
+ *
+ * When optimizer_cardinality_feedback is on, ORCA tags the nodes of the
+ * plans it produces with a feedback key, a hash of the logical expression
+ * the node computes: the base relations, the predicates applied to them and
+ * the grouping columns.  The key does not depend on the physical shape of
+ * the plan, so a hash join and a nested loop join of the same relations with
+ * the same predicates share a key.  At the end of execution, the dispatcher
+ * records the number of rows each tagged node actually produced, and later
+ * optimizations of queries containing the same expression use the observed
+ * count instead of the estimate.
+ *
+ * The store is a fixed-size open-addressing table in shared memory, sized
+ * by optimizer_cardinality_feedback_entries.  Each key may only live in a
+ * short window of slots after its home slot; when the window is full, the
+ * least recently used entry of the window is replaced.  Only the latest
+ * observation of a key is kept.  Keys are hashes, so each entry also keeps
+ * a fingerprint, the other half of ORCA's 64-bit key hash, and only an entry
+ * with the same key and fingerprint matches.  The store is shared by all
+ * the databases of the cluster, so the database is part of the key too.
+ *
+ * The store only exists on the coordinator, where the plans are made, and
+ * only if optimizer_cardinality_feedback_entries is set.
+ *
+ * An observation depends on the relations of the plan it was made on, as
+ * listed in PlannedStmt.relationOids.  The observations of a relation expire
+ * when it is analyzed, and when its relcache entry is invalidated, which is
+ * what TRUNCATE and DDL do; that is, when the cached plans on the relation
+ * are invalidated too.  To keep invalidation cheap, the relations are hashed
+ * into a 64-bit mask per entry, and invalidating a relation only stamps its
+ * bit with the current clock: an entry has expired once any of its bits was
+ * stamped after the entry was recorded.  Relations that share a bit expire
+ * each other's observations, which is harmless.
+ *
+ * Copyright (c) 2026-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/utils/cache/cardfeedback.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/hash.h"
+#include "cdb/cdbvars.h"
+#include "miscadmin.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/cardfeedback.h"
+#include "utils/guc.h"
+#include "utils/inval.h"
+
+/* number of slots a key may occupy after its home slot */
+#define CARDFEEDBACK_PROBES		8
+
+/* number of bits of the relation masks */
+#define CARDFEEDBACK_RELBITS	64
+
+#define CardFeedbackRelBit(relid) \
+	(((uint64) 1) << \
+	 (DatumGetUInt32(hash_uint32((uint32) (relid))) % CARDFEEDBACK_RELBITS))
+
+typedef struct CardFeedbackEntry
+{
+	uint32		key;			/* feedback key, 0 if the slot is unused */
+	uint32		fingerprint;	/* rest of the key hash, checked on lookup */
+	Oid			dbid;			/* database the plan ran in */
+	uint64		relmask;		/* bits of the relations of the plan */
+	uint64		lastused;		/* value of the clock at the last update */
+	double		rows;			/* latest observed number of rows */
+} CardFeedbackEntry;
+
+typedef struct CardFeedbackControl
+{
+	LWLock	   *lock;			/* protects all the fields below */
+	uint64		clock;			/* bumped by every recorded observation and
+								 * every invalidation */
+	uint64		invalidated[CARDFEEDBACK_RELBITS];	/* clock at the last
+													 * invalidation of a
+													 * relation of each bit */
+	int			nentries;		/* number of slots */
+	int			nused;			/* number of used slots */
+	CardFeedbackEntry entries[1];	/* VARIABLE LENGTH ARRAY */
+} CardFeedbackControl;
+
+static CardFeedbackControl *CardFeedback = NULL;
+
+static void CardFeedbackRelCallback(Datum arg, Oid relid);
+static bool CardFeedbackExpired(CardFeedbackEntry *entry);
+
+Size
+CardFeedbackShmemSize(void)
+{
+	Size		size;
+
+	if (optimizer_cardinality_feedback_entries <= 0 ||
+		Gp_role != GP_ROLE_DISPATCH)
+		return 0;
+
+	size = offsetof(CardFeedbackControl, entries);
+	size = add_size(size, mul_size(optimizer_cardinality_feedback_entries,
+								   sizeof(CardFeedbackEntry)));
+
+	return size;
+}
+
+void
+CardFeedbackShmemInit(void)
+{
+	bool		found;
+
+	if (optimizer_cardinality_feedback_entries <= 0 ||
+		Gp_role != GP_ROLE_DISPATCH)
+		return;
+
+	CardFeedback = (CardFeedbackControl *)
+		ShmemInitStruct("ORCA Cardinality Feedback", CardFeedbackShmemSize(),
+						&found);
+
+	if (!found)
+	{
+		CardFeedback->lock = LWLockAssign();
+		CardFeedback->clock = 0;
+		MemSet(CardFeedback->invalidated, 0,
+			   sizeof(CardFeedback->invalidated));
+		CardFeedback->nentries = optimizer_cardinality_feedback_entries;
+		CardFeedback->nused = 0;
+		MemSet(CardFeedback->entries, 0,
+			   mul_size(CardFeedback->nentries, sizeof(CardFeedbackEntry)));
+	}
+}
+
+/*
+ * InitCardFeedback: initialize module during InitPostgres.
+ *
+ * Register the relcache callback that expires the observations of a
+ * relation when it is truncated or altered.  Like the plan cache's, it runs
+ * in every backend, so whichever backend gets to the invalidation first
+ * expires the observations.
+ */
+void
+InitCardFeedback(void)
+{
+	if (CardFeedbackEnabled())
+		CacheRegisterRelcacheCallback(CardFeedbackRelCallback, (Datum) 0);
+}
+
+bool
+CardFeedbackEnabled(void)
+{
+	return NULL != CardFeedback;
+}
+
+/*
+ * Return the relation mask of a plan on the given relations.
+ */
+uint64
+CardFeedbackRelationMask(List *relationOids)
+{
+	uint64		relmask = 0;
+	ListCell   *lc;
+
+	foreach(lc, relationOids)
+		relmask |= CardFeedbackRelBit(lfirst_oid(lc));
+
+	return relmask;
+}
+
+/*
+ * Record the number of rows produced by a plan node with the given key, in a
+ * plan with the given relation mask.
+ */
+void
+CardFeedbackRecord(uint32 key, uint32 fingerprint, uint64 relmask,
+				   double rows)
+{
+	CardFeedbackEntry *victim = NULL;
+	int			nprobes;
+	int			i;
+
+	if (!CardFeedbackEnabled() || 0 == key)
+		return;
+
+	nprobes = Min(CARDFEEDBACK_PROBES, CardFeedback->nentries);
+
+	LWLockAcquire(CardFeedback->lock, LW_EXCLUSIVE);
+
+	for (i = 0; i < nprobes; i++)
+	{
+		CardFeedbackEntry *entry =
+			&CardFeedback->entries[(key + i) % CardFeedback->nentries];
+
+		if (entry->key == key && entry->fingerprint == fingerprint &&
+			entry->dbid == MyDatabaseId)
+		{
+			victim = entry;
+			break;
+		}
+
+		if (0 == entry->key || CardFeedbackExpired(entry))
+		{
+			/* keep looking, the key may live further down the window */
+			if (NULL == victim ||
+				(0 != victim->key && !CardFeedbackExpired(victim)))
+				victim = entry;
+			continue;
+		}
+
+		if (NULL == victim ||
+			(0 != victim->key && !CardFeedbackExpired(victim) &&
+			 entry->lastused < victim->lastused))
+			victim = entry;
+	}
+
+	Assert(NULL != victim);
+
+	if (0 == victim->key)
+		CardFeedback->nused++;
+
+	victim->key = key;
+	victim->fingerprint = fingerprint;
+	victim->dbid = MyDatabaseId;
+	victim->relmask = relmask;
+	victim->rows = rows;
+	victim->lastused = ++CardFeedback->clock;
+
+	LWLockRelease(CardFeedback->lock);
+}
+
+/*
+ * Expire the observations made on plans on the given relation, or on all
+ * relations if relid is InvalidOid.
+ */
+void
+CardFeedbackInvalidateRelation(Oid relid)
+{
+	uint64		relmask;
+	int			i;
+
+	if (!CardFeedbackEnabled())
+		return;
+
+	relmask = OidIsValid(relid) ? CardFeedbackRelBit(relid) : ~((uint64) 0);
+
+	LWLockAcquire(CardFeedback->lock, LW_EXCLUSIVE);
+
+	CardFeedback->clock++;
+	for (i = 0; i < CARDFEEDBACK_RELBITS; i++)
+	{
+		if (relmask & ((uint64) 1 << i))
+			CardFeedback->invalidated[i] = CardFeedback->clock;
+	}
+
+	LWLockRelease(CardFeedback->lock);
+}
+
+/*
+ * Return a palloc'd copy of all the unexpired observations of the current
+ * database in the store, and their number in *nobservations.
+ */
+CardFeedbackObservation *
+CardFeedbackSnapshot(int *nobservations)
+{
+	CardFeedbackObservation *result;
+	int			n = 0;
+	int			i;
+
+	*nobservations = 0;
+
+	if (!CardFeedbackEnabled())
+		return NULL;
+
+	LWLockAcquire(CardFeedback->lock, LW_SHARED);
+
+	result = (CardFeedbackObservation *)
+		palloc(Max(CardFeedback->nused, 1) * sizeof(CardFeedbackObservation));
+
+	for (i = 0; i < CardFeedback->nentries && n < CardFeedback->nused; i++)
+	{
+		CardFeedbackEntry *entry = &CardFeedback->entries[i];
+
+		if (0 == entry->key || entry->dbid != MyDatabaseId ||
+			CardFeedbackExpired(entry))
+			continue;
+
+		result[n].key = entry->key;
+		result[n].fingerprint = entry->fingerprint;
+		result[n].rows = entry->rows;
+		n++;
+	}
+
+	LWLockRelease(CardFeedback->lock);
+
+	*nobservations = n;
+
+	return result;
+}
+
+/*
+ * Has the observation of an entry expired, because a relation of the plan it
+ * was made on was invalidated since?  The caller must hold the lock.
+ */
+static bool
+CardFeedbackExpired(CardFeedbackEntry *entry)
+{
+	int			i;
+
+	for (i = 0; i < CARDFEEDBACK_RELBITS; i++)
+	{
+		if ((entry->relmask & ((uint64) 1 << i)) &&
+			CardFeedback->invalidated[i] >= entry->lastused)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * CardFeedbackRelCallback
+ *		Relcache inval callback function
+ */
+static void
+CardFeedbackRelCallback(Datum arg, Oid relid)
+{
+	/*
+	 * Relcache invalidations are frequent, and most of the time nothing was
+	 * ever recorded; don't take the lock then.  An observation recorded
+	 * concurrently is made on a plan that holds a lock on its relations, so
+	 * it can't race with the invalidation of one of them.
+	 */
+	if (0 == CardFeedback->nused)
+		return;
+
+	CardFeedbackInvalidateRelation(relid);
+}
@@ -103,6 +103,7 @@
 #include "storage/smgr.h"
 #include "utils/catcache.h"
 #include "utils/inval.h"
+#include "utils/mdsharedcache.h"
 #include "utils/memdebug.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
@@ -1006,6 +1007,13 @@ AtEOXact_Inval(bool isCommit)
 		ProcessInvalidationMessagesMulti(&transInvalInfo->PriorCmdInvalidMsgs,
 										 SendSharedInvalidMessages);
 
+		/*
+		 * The messages are in the queue now, so other backends will see our
+		 * changes once they catch up.  Make sure that nobody reuses metadata
+		 * translated from the old catalog contents in the meantime.
+		 */
+		MDSharedCacheInvalidate();
+
 		if (transInvalInfo->RelcacheInitFileInval)
 			RelationCacheInitFilePostInvalidate();
 	}
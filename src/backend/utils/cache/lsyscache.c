@@ -36,6 +36,7 @@
 #include "catalog/pg_proc.h"
 #include "catalog/pg_range.h"
 #include "catalog/pg_statistic.h"
+#include "catalog/pg_statistic_multicol.h"
 #include "catalog/pg_trigger.h"
 #include "catalog/pg_type.h"
 #include "cdb/cdbpartition.h"
@@ -3674,6 +3675,39 @@ get_att_stats(Oid relid, AttrNumber attrnum)
 	return result;
 }
 
+/*
+ * get_multicol_stats
+ *
+ *		Get the statistics on groups of columns of a relation. Return a list
+ *		of copies of the pg_statistic_multicol tuples.
+ */
+List *
+get_multicol_stats(Oid relid)
+{
+	List	   *result = NIL;
+	HeapTuple	htup;
+	Relation	statrel;
+	ScanKeyData scankey;
+	SysScanDesc sscan;
+
+	statrel = heap_open(StatisticMultiColRelationId, AccessShareLock);
+
+	ScanKeyInit(&scankey,
+				Anum_pg_statistic_multicol_starelid,
+				BTEqualStrategyNumber, F_OIDEQ,
+				ObjectIdGetDatum(relid));
+	sscan = systable_beginscan(statrel, StatisticMultiColRelidIndexId, true,
+							   NULL, 1, &scankey);
+
+	while (HeapTupleIsValid(htup = systable_getnext(sscan)))
+		result = lappend(result, heap_copytuple(htup));
+
+	systable_endscan(sscan);
+	heap_close(statrel, AccessShareLock);
+
+	return result;
+}
+
 /*				---------- PG_NAMESPACE CACHE ----------				 */
 
 /*
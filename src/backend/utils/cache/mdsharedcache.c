@@ -0,0 +1,358 @@
+/*-------------------------------------------------------------------------
+ *
+ * mdsharedcache.c
+ *	  Shared-memory tier of the ORCA metadata cache.
+ *
+ * Every backend keeps its own ORCA metadata cache (CMDCache), which is
+ * populated by translating relcache/syscache entries to DXL.  With many
+ * sessions, the same catalog objects get translated over and over again.
+ * This module keeps the serialized DXL of metadata objects in a fixed-size
+ * shared-memory arena, keyed by the serialized metadata id, so that a
+ * backend with a cold local cache only pays for parsing the DXL.
+ *
+ * The DXL text is position independent, so entries are simply copied in and
+ * out of the arena.  The arena is a bump allocator: it is never compacted,
+ * it is emptied as a whole when it runs out of space, or when the first
+ * entry of a new generation is inserted.
+ *
+ * Invalidation piggybacks on the regular catalog invalidation mechanism.
+ * Whenever a transaction that sent invalidation messages commits, it bumps
+ * the shared generation counter (see AtEOXact_Inval()).  A query snapshots
+ * the generation before it catches up with pending invalidations, and only
+ * uses entries published under that same generation.  Entries published by
+ * a backend that had not yet seen the latest invalidations are therefore
+ * never handed out.
+ *
+ * Transactions that have been assigned an xid may have uncommitted catalog
+ * changes of their own, so they neither read from nor publish to the shared
+ * tier.  Relations whose indexes are only visible to newer snapshots
+ * (indcheckxmin) are recorded with the TransactionXmin of the publisher, and
+ * are only handed out to backends whose TransactionXmin is at least as new.
+ *
+ * Copyright (c) 2026-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/backend/utils/cache/mdsharedcache.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/transam.h"
+#include "access/xact.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "storage/spin.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/inval.h"
+#include "utils/mdsharedcache.h"
+#include "utils/snapmgr.h"
+
+/* assumed average size of a serialized object, used to size the hash table */
+#define MDSHAREDCACHE_AVG_ENTRY_SIZE	2048
+#define MDSHAREDCACHE_MIN_ENTRIES		128
+
+typedef struct MDSharedCacheEntry
+{
+	char		key[MDSHAREDCACHE_KEYLEN];	/* serialized mdid, hash key */
+	Size		offset;			/* offset of the object in the arena */
+	Size		len;			/* length of the object in bytes */
+	TransactionId xmin;			/* TransactionXmin of the publisher */
+} MDSharedCacheEntry;
+
+typedef struct MDSharedCacheControl
+{
+	slock_t		mutex;			/* protects generation and counters */
+	uint64		generation;		/* bumped by every committed invalidation */
+	uint64		hits;
+	uint64		misses;
+	uint64		resets;
+
+	LWLock	   *lock;			/* protects the fields below and the hash */
+	uint64		arena_generation;	/* generation of the arena contents */
+	Size		arena_size;
+	Size		arena_used;
+	char		arena[1];		/* VARIABLE LENGTH ARRAY */
+} MDSharedCacheControl;
+
+static MDSharedCacheControl *MDSharedCache = NULL;
+static HTAB *MDSharedCacheHash = NULL;
+
+static Size MDSharedCacheArenaSize(void);
+static long MDSharedCacheMaxEntries(void);
+static void MDSharedCacheResetLocked(uint64 generation);
+
+/*
+ * Size of the object arena, as configured by optimizer_mdcache_shared_size.
+ */
+static Size
+MDSharedCacheArenaSize(void)
+{
+	return mul_size((Size) optimizer_mdcache_shared_size, 1024);
+}
+
+static long
+MDSharedCacheMaxEntries(void)
+{
+	return Max((long) (MDSharedCacheArenaSize() / MDSHAREDCACHE_AVG_ENTRY_SIZE),
+			   MDSHAREDCACHE_MIN_ENTRIES);
+}
+
+Size
+MDSharedCacheShmemSize(void)
+{
+	Size		size;
+
+	if (optimizer_mdcache_shared_size <= 0)
+		return 0;
+
+	size = offsetof(MDSharedCacheControl, arena);
+	size = add_size(size, MDSharedCacheArenaSize());
+	size = add_size(size, hash_estimate_size(MDSharedCacheMaxEntries(),
+											 sizeof(MDSharedCacheEntry)));
+
+	return size;
+}
+
+void
+MDSharedCacheShmemInit(void)
+{
+	HASHCTL		info;
+	bool		found;
+
+	if (optimizer_mdcache_shared_size <= 0)
+		return;
+
+	MDSharedCache = (MDSharedCacheControl *)
+		ShmemInitStruct("ORCA Shared Metadata Cache",
+						add_size(offsetof(MDSharedCacheControl, arena),
+								 MDSharedCacheArenaSize()),
+						&found);
+
+	if (!found)
+	{
+		SpinLockInit(&MDSharedCache->mutex);
+		MDSharedCache->generation = 1;
+		MDSharedCache->hits = 0;
+		MDSharedCache->misses = 0;
+		MDSharedCache->resets = 0;
+		MDSharedCache->lock = LWLockAssign();
+		MDSharedCache->arena_generation = 1;
+		MDSharedCache->arena_size = MDSharedCacheArenaSize();
+		MDSharedCache->arena_used = 0;
+	}
+
+	MemSet(&info, 0, sizeof(info));
+	info.keysize = MDSHAREDCACHE_KEYLEN;
+	info.entrysize = sizeof(MDSharedCacheEntry);
+
+	MDSharedCacheHash = ShmemInitHash("ORCA Shared Metadata Cache Hash",
+									  MDSharedCacheMaxEntries(),
+									  MDSharedCacheMaxEntries(),
+									  &info,
+									  HASH_ELEM);
+}
+
+bool
+MDSharedCacheEnabled(void)
+{
+	return NULL != MDSharedCache;
+}
+
+/*
+ * Called at the start of each ORCA optimization.  Returns the generation the
+ * query should use for lookups and inserts, or 0 if the shared tier must not
+ * be used by this query.
+ *
+ * The generation is read before catching up with pending invalidation
+ * messages, so everything the backend translates afterwards is at least as
+ * new as that generation.
+ */
+uint64
+MDSharedCacheBeginQuery(void)
+{
+	uint64		generation;
+
+	if (!MDSharedCacheEnabled())
+		return 0;
+
+	/* we may have made catalog changes that nobody else can see yet */
+	if (TransactionIdIsValid(GetTopTransactionIdIfAny()))
+		return 0;
+
+	SpinLockAcquire(&MDSharedCache->mutex);
+	generation = MDSharedCache->generation;
+	SpinLockRelease(&MDSharedCache->mutex);
+
+	AcceptInvalidationMessages();
+
+	return generation;
+}
+
+/*
+ * Invalidate all entries of the shared tier.  Called when a transaction that
+ * sent catalog invalidation messages commits.
+ */
+void
+MDSharedCacheInvalidate(void)
+{
+	if (!MDSharedCacheEnabled())
+		return;
+
+	SpinLockAcquire(&MDSharedCache->mutex);
+	MDSharedCache->generation++;
+	SpinLockRelease(&MDSharedCache->mutex);
+}
+
+/*
+ * Look up the serialized object for the given key.  Returns a palloc'd copy,
+ * and its length in *len, or NULL if there is no usable entry.
+ */
+char *
+MDSharedCacheLookup(uint64 generation, const char *key, Size *len)
+{
+	MDSharedCacheEntry *entry;
+	char	   *result = NULL;
+
+	if (0 == generation || strlen(key) >= MDSHAREDCACHE_KEYLEN)
+		return NULL;
+
+	Assert(MDSharedCacheEnabled());
+
+	LWLockAcquire(MDSharedCache->lock, LW_SHARED);
+
+	if (MDSharedCache->arena_generation == generation)
+	{
+		entry = (MDSharedCacheEntry *) hash_search(MDSharedCacheHash, key,
+												   HASH_FIND, NULL);
+		if (NULL != entry &&
+			TransactionIdFollowsOrEquals(TransactionXmin, entry->xmin))
+		{
+			result = palloc(entry->len);
+			memcpy(result, MDSharedCache->arena + entry->offset, entry->len);
+			*len = entry->len;
+		}
+	}
+
+	LWLockRelease(MDSharedCache->lock);
+
+	SpinLockAcquire(&MDSharedCache->mutex);
+	if (NULL != result)
+		MDSharedCache->hits++;
+	else
+		MDSharedCache->misses++;
+	SpinLockRelease(&MDSharedCache->mutex);
+
+	return result;
+}
+
+/*
+ * Publish a serialized object under the given key.  Returns false if the
+ * object was not stored, e.g. because the generation has moved on since the
+ * object was translated.
+ */
+bool
+MDSharedCacheInsert(uint64 generation, const char *key, const char *data,
+					Size len)
+{
+	MDSharedCacheEntry *entry;
+	uint64		current_generation;
+	bool		found;
+
+	if (0 == generation || strlen(key) >= MDSHAREDCACHE_KEYLEN)
+		return false;
+
+	Assert(MDSharedCacheEnabled());
+
+	if (MAXALIGN(len) > MDSharedCache->arena_size)
+		return false;
+
+	LWLockAcquire(MDSharedCache->lock, LW_EXCLUSIVE);
+
+	SpinLockAcquire(&MDSharedCache->mutex);
+	current_generation = MDSharedCache->generation;
+	SpinLockRelease(&MDSharedCache->mutex);
+
+	/* the object may have been translated from an outdated catalog */
+	if (current_generation != generation)
+	{
+		LWLockRelease(MDSharedCache->lock);
+		return false;
+	}
+
+	if (MDSharedCache->arena_generation != generation ||
+		MDSharedCache->arena_used + MAXALIGN(len) > MDSharedCache->arena_size ||
+		hash_get_num_entries(MDSharedCacheHash) >= MDSharedCacheMaxEntries())
+	{
+		MDSharedCacheResetLocked(generation);
+	}
+
+	entry = (MDSharedCacheEntry *) hash_search(MDSharedCacheHash, key,
+											   HASH_ENTER_NULL, &found);
+
+	if (NULL != entry && !found)
+	{
+		entry->offset = MDSharedCache->arena_used;
+		entry->len = len;
+		entry->xmin = TransactionXmin;
+		memcpy(MDSharedCache->arena + entry->offset, data, len);
+		MDSharedCache->arena_used += MAXALIGN(len);
+	}
+
+	LWLockRelease(MDSharedCache->lock);
+
+	return NULL != entry && !found;
+}
+
+/*
+ * Fill in the current size and the cumulative counters of the shared tier.
+ * Returns false if the shared tier is disabled.
+ */
+bool
+MDSharedCacheGetStats(MDSharedCacheStats *stats)
+{
+	MemSet(stats, 0, sizeof(*stats));
+
+	if (!MDSharedCacheEnabled())
+		return false;
+
+	LWLockAcquire(MDSharedCache->lock, LW_SHARED);
+	stats->entries = hash_get_num_entries(MDSharedCacheHash);
+	stats->bytes = MDSharedCache->arena_used;
+	LWLockRelease(MDSharedCache->lock);
+
+	SpinLockAcquire(&MDSharedCache->mutex);
+	stats->hits = MDSharedCache->hits;
+	stats->misses = MDSharedCache->misses;
+	stats->resets = MDSharedCache->resets;
+	SpinLockRelease(&MDSharedCache->mutex);
+
+	return true;
+}
+
+/*
+ * Empty the arena and the hash table, and start a new generation of entries.
+ * Caller must hold the lock in exclusive mode.
+ */
+static void
+MDSharedCacheResetLocked(uint64 generation)
+{
+	HASH_SEQ_STATUS status;
+	MDSharedCacheEntry *entry;
+
+	hash_seq_init(&status, MDSharedCacheHash);
+	while ((entry = (MDSharedCacheEntry *) hash_seq_search(&status)) != NULL)
+	{
+		if (hash_search(MDSharedCacheHash, entry->key, HASH_REMOVE, NULL) == NULL)
+			elog(ERROR, "ORCA shared metadata cache hash table corrupted");
+	}
+
+	MDSharedCache->arena_generation = generation;
+	MDSharedCache->arena_used = 0;
+
+	SpinLockAcquire(&MDSharedCache->mutex);
+	MDSharedCache->resets++;
+	SpinLockRelease(&MDSharedCache->mutex);
+}
@@ -63,6 +63,7 @@
 #include "tcop/idle_resource_cleaner.h"
 #include "utils/acl.h"
 #include "utils/backend_cancel.h"
+#include "utils/cardfeedback.h"
 #include "utils/faultinjector.h"
 #include "utils/fmgroids.h"
 #include "utils/guc.h"
@@ -734,6 +735,7 @@ InitPostgres(const char *in_dbname, Oid dboid, const char *username,
 	RelationCacheInitialize();
 	InitCatalogCache();
 	InitPlanCache();
+	InitCardFeedback();
 
 	/* Initialize portal manager */
 	EnablePortalManager();
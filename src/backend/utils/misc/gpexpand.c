@@ -24,6 +24,7 @@
 #include "catalog/pg_stat_last_operation.h"
 #include "catalog/pg_stat_last_shoperation.h"
 #include "catalog/pg_statistic.h"
+#include "catalog/pg_statistic_multicol.h"
 #include "cdb/cdbutil.h"
 #include "cdb/cdbvars.h"
 #include "postmaster/fts.h"
@@ -133,6 +134,7 @@ gp_expand_protect_catalog_changes(Relation relation)
 		case StatLastOpRelationId:
 		case StatLastShOpRelationId:
 		case StatisticRelationId:
+		case StatisticMultiColRelationId:
 		case PartitionEncodingRelationId:
 		case AuthTimeConstraintRelationId:
 			/* these catalog tables are only meaningful on qd */
@@ -306,6 +306,10 @@ int			optimizer_minidump;
 int			optimizer_cost_model;
 bool		optimizer_metadata_caching;
 int			optimizer_mdcache_size;
+int			optimizer_mdcache_shared_size;
+bool		optimizer_cardinality_feedback;
+bool		optimizer_cost_memory_quota;
+int			optimizer_cardinality_feedback_entries;
 bool		optimizer_use_gpdb_allocators;
 
 /* Optimizer debugging GUCs */
@@ -325,6 +329,7 @@ bool		optimizer_print_xform_results;
 /* array of xforms disable flags */
 bool		optimizer_xforms[OPTIMIZER_XFORMS_COUNT] = {[0 ... OPTIMIZER_XFORMS_COUNT - 1] = false};
 char	   *optimizer_search_strategy_path = NULL;
+char	   *optimizer_cost_profile_path = NULL;
 
 /* GUCs to tell Optimizer to enable a physical operator */
 bool		optimizer_enable_indexjoin;
@@ -340,6 +345,7 @@ bool		optimizer_enable_partition_selection;
 bool		optimizer_enable_outerjoin_rewrite;
 bool		optimizer_enable_multiple_distinct_aggs;
 bool		optimizer_enable_direct_dispatch;
+bool		optimizer_enable_direct_plan_translation;
 bool		optimizer_enable_hashjoin_redistribute_broadcast_children;
 bool		optimizer_enable_broadcast_nestloop_outer_child;
 bool		optimizer_discard_redistribute_hashjoin;
@@ -402,11 +408,13 @@ int			optimizer_cte_inlining_bound;
 int			optimizer_push_group_by_below_setop_threshold;
 int			optimizer_xform_bind_threshold;
 int			optimizer_skew_factor;
+int			optimizer_max_derived_histogram_buckets;
 bool		optimizer_force_multistage_agg;
 bool		optimizer_force_three_stage_scalar_dqa;
 bool		optimizer_force_expanded_distinct_aggs;
 bool		optimizer_force_agg_skew_avoidance;
 bool		optimizer_penalize_skew;
+bool		optimizer_penalize_mcv_skew;
 bool		optimizer_prune_computed_columns;
 bool		optimizer_push_requirements_from_consumer_to_producer;
 bool		optimizer_enforce_subplans;
@@ -1746,6 +1754,15 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"gp_statistics_multicol", PGC_USERSET, STATS_ANALYZE,
+			gettext_noop("Collect statistics on groups of columns in ANALYZE, and use them in GPORCA."),
+			NULL
+		},
+		&gp_statistics_multicol,
+		true,
+		NULL, NULL, NULL
+	},
 	{
 		{"gp_resqueue_priority", PGC_POSTMASTER, RESOURCES_MGM,
 			gettext_noop("Enables priority scheduling."),
@@ -2165,6 +2182,26 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_cardinality_feedback", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Record the row counts of executed GPORCA plans and use them in later cardinality estimates."),
+			NULL
+		},
+		&optimizer_cardinality_feedback,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_cost_memory_quota", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Cost the spilling of GPORCA sorts, hash aggregates and hash joins against the memory quota of the query."),
+			NULL
+		},
+		&optimizer_cost_memory_quota,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_print_missing_stats", PGC_USERSET, LOGGING_WHAT,
 			gettext_noop("Print columns with missing statistics."),
@@ -2425,6 +2462,16 @@ struct config_bool ConfigureNamesBool_gp[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"optimizer_enable_direct_plan_translation", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Translate simple plans of the optimizer directly into a plan, without DXL."),
+			NULL,
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_enable_direct_plan_translation,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"optimizer_control", PGC_SUSET, DEVELOPER_OPTIONS,
 			gettext_noop("Allow/disallow turning the optimizer on or off."),
@@ -2555,6 +2602,17 @@ struct config_bool ConfigureNamesBool_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_penalize_mcv_skew", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Cost hash distributed operators by the rows of the segment that receives the most common value of the distribution key."),
+			NULL,
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_penalize_mcv_skew,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_multilevel_partitioning", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Enable optimization of queries on multilevel partitioned tables."),
@@ -4526,6 +4584,18 @@ struct config_int ConfigureNamesInt_gp[] =
             NULL, NULL, NULL
     },
 
+	{
+		{"optimizer_max_derived_histogram_buckets", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Maximum number of buckets of a histogram derived for a join or union by GPORCA."),
+			gettext_noop("Adjacent buckets are merged once a derived histogram grows past this limit. "
+						 "A value of 0 disables the limit."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_max_derived_histogram_buckets,
+		500, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"optimizer_join_order_threshold", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Maximum number of join children to use dynamic programming based join ordering algorithm."),
@@ -4569,6 +4639,27 @@ struct config_int ConfigureNamesInt_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_mdcache_shared_size", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the size of the MDCache tier shared by all sessions."),
+			gettext_noop("A value of 0 disables the shared tier."),
+			GUC_UNIT_KB
+		},
+		&optimizer_mdcache_shared_size,
+		0, 0, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"optimizer_cardinality_feedback_entries", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the number of row counts of executed plans kept for cardinality feedback."),
+			gettext_noop("A value of 0 disables cardinality feedback."),
+		},
+		&optimizer_cardinality_feedback_entries,
+		0, 0, INT_MAX / 1024,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"memory_profiler_dataset_size", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Set the size in GB"),
@@ -5028,6 +5119,17 @@ struct config_string ConfigureNamesString_gp[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"optimizer_cost_profile_path", PGC_SUSET, QUERY_TUNING_COST,
+			gettext_noop("Sets the file with the cost model parameters used by gp optimizer."),
+			gettext_noop("An empty string selects the built-in cost model parameters."),
+			GUC_NOT_IN_SAMPLE
+		},
+		&optimizer_cost_profile_path,
+		"",
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gp_default_storage_options", PGC_USERSET, APPENDONLY_TABLES,
 			gettext_noop("default options for appendonly storage."),
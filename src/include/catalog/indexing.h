@@ -410,6 +410,9 @@ DECLARE_INDEX(pg_attribute_encoding_attrelid_index, 6236, on pg_attribute_encodi
 DECLARE_UNIQUE_INDEX(pg_attribute_encoding_attrelid_attnum_index, 6237, on pg_attribute_encoding using btree(attrelid oid_ops, attnum int2_ops));
 #define AttributeEncodingAttrelidAttnumIndexId	6237
 
+DECLARE_INDEX(pg_statistic_multicol_starelid_index, 6239, on pg_statistic_multicol using btree(starelid oid_ops));
+#define StatisticMultiColRelidIndexId	6239
+
 DECLARE_UNIQUE_INDEX(pg_type_encoding_typid_index, 6207, on pg_type_encoding using btree(typid oid_ops));
 #define TypeEncodingTypidIndexId	6207
 
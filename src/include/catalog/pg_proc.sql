@@ -304,6 +304,10 @@
  CREATE FUNCTION enable_xform(text) RETURNS text LANGUAGE internal IMMUTABLE STRICT AS 'enable_xform' WITH (OID=6088, DESCRIPTION="enables transformations in the optimizer");
 
  CREATE FUNCTION gp_opt_version() RETURNS text LANGUAGE internal IMMUTABLE STRICT AS 'gp_opt_version' WITH (OID=6089, DESCRIPTION="Returns the optimizer and gpos library versions");
+
+ CREATE FUNCTION gp_opt_mdcache_stats(OUT mdtype text, OUT entries int8, OUT bytes int8, OUT hits int8, OUT inserts int8, OUT evictions int8) RETURNS SETOF pg_catalog.record LANGUAGE internal VOLATILE AS 'gp_opt_mdcache_stats' WITH (OID=6090, DESCRIPTION="statistics: optimizer metadata cache of the current session, per object type");
+
+ CREATE FUNCTION gp_opt_mdsharedcache_stats(OUT enabled bool, OUT entries int8, OUT bytes int8, OUT hits int8, OUT misses int8, OUT resets int8) RETURNS pg_catalog.record LANGUAGE internal VOLATILE AS 'gp_opt_mdsharedcache_stats' WITH (OID=6091, DESCRIPTION="statistics: shared tier of the optimizer metadata cache");
  
  
   -- functions for the complex data type
@@ -22,7 +22,7 @@
 
    WARNING: DO NOT MODIFY THE FOLLOWING SECTION: 
    Generated by catullus.pl version 8
-   on Wed May 29 10:02:27 2019
+   on Mon Oct 19 01:01:05 2026
 
    Please make your changes in pg_proc.sql
 */
@@ -620,6 +620,14 @@ DESCR("enables transformations in the optimizer");
 DATA(insert OID = 6089 ( gp_opt_version  PGNSP PGUID 12 1 0 0 0 f f f f t f i 0 0 25 "" _null_ _null_ _null_ _null_ gp_opt_version _null_ _null_ _null_ n a ));
 DESCR("Returns the optimizer and gpos library versions");
 
+/* gp_opt_mdcache_stats(OUT mdtype text, OUT entries int8, OUT bytes int8, OUT hits int8, OUT inserts int8, OUT evictions int8) => SETOF pg_catalog.record */
+DATA(insert OID = 6090 ( gp_opt_mdcache_stats  PGNSP PGUID 12 1 1000 0 0 f f f f f t v 0 0 2249 "" "{25,20,20,20,20,20}" "{o,o,o,o,o,o}" "{mdtype,entries,bytes,hits,inserts,evictions}" _null_ gp_opt_mdcache_stats _null_ _null_ _null_ n a ));
+DESCR("statistics: optimizer metadata cache of the current session, per object type");
+
+/* gp_opt_mdsharedcache_stats(OUT enabled bool, OUT entries int8, OUT bytes int8, OUT hits int8, OUT misses int8, OUT resets int8) => pg_catalog.record */
+DATA(insert OID = 6091 ( gp_opt_mdsharedcache_stats  PGNSP PGUID 12 1 0 0 0 f f f f f f v 0 0 2249 "" "{16,20,20,20,20,20}" "{o,o,o,o,o,o}" "{enabled,entries,bytes,hits,misses,resets}" _null_ gp_opt_mdsharedcache_stats _null_ _null_ _null_ n a ));
+DESCR("statistics: shared tier of the optimizer metadata cache");
+
 
   /* functions for the complex data type */
 /* complex_in(cstring) => complex */
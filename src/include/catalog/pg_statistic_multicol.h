@@ -0,0 +1,75 @@
+/*-------------------------------------------------------------------------
+ *
+ * pg_statistic_multicol.h
+ *	  statistics on groups of columns of a relation, collected by ANALYZE
+ *
+ * Each row describes one group of columns: the number of distinct value
+ * combinations of the group, and the degree to which the last column of the
+ * group is functionally determined by the preceding ones.  The groups are
+ * the key columns of multi-column indexes and the distribution key of the
+ * relation.
+ *
+ * Copyright (c) 2026-Present VMware, Inc. or its affiliates.
+ *
+ *
+ * IDENTIFICATION
+ *	    src/include/catalog/pg_statistic_multicol.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PG_STATISTIC_MULTICOL_H
+#define PG_STATISTIC_MULTICOL_H
+
+#include "catalog/genbki.h"
+
+/* ----------------
+ *		pg_statistic_multicol definition.  cpp turns this into
+ *		typedef struct FormData_pg_statistic_multicol
+ * ----------------
+ */
+#define StatisticMultiColRelationId	6238
+
+CATALOG(pg_statistic_multicol,6238) BKI_WITHOUT_OIDS
+{
+	Oid			starelid;		/* relation containing the columns */
+
+	/*
+	 * standistinct is the number of distinct value combinations of the
+	 * group, with the same conventions as pg_statistic.stadistinct: a
+	 * negative value is the negative of a multiplier for the number of rows.
+	 */
+	float4		standistinct;
+
+	/*
+	 * stadependency is the fraction of sampled rows in which the last key
+	 * column is determined by the values of the other key columns.
+	 */
+	float4		stadependency;
+
+	int2vector	stakeys;		/* column numbers of the group */
+} FormData_pg_statistic_multicol;
+
+/* GPDB added foreign key definitions for gpcheckcat. */
+FOREIGN_KEY(starelid REFERENCES pg_class(oid));
+
+/* ----------------
+ *		Form_pg_statistic_multicol corresponds to a pointer to a tuple with
+ *		the format of pg_statistic_multicol relation.
+ * ----------------
+ */
+typedef FormData_pg_statistic_multicol *Form_pg_statistic_multicol;
+
+/* ----------------
+ *		compiler constants for pg_statistic_multicol
+ * ----------------
+ */
+#define Natts_pg_statistic_multicol					4
+#define Anum_pg_statistic_multicol_starelid			1
+#define Anum_pg_statistic_multicol_standistinct		2
+#define Anum_pg_statistic_multicol_stadependency	3
+#define Anum_pg_statistic_multicol_stakeys			4
+
+/* maximum number of columns in a group */
+#define STATISTIC_MULTICOL_MAX_KEYS		8
+
+#endif   /* PG_STATISTIC_MULTICOL_H */
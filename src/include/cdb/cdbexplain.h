@@ -107,6 +107,26 @@ cdbexplain_recvExecStats(struct PlanState              *planstate,
                          int                            sliceIndex,
                          struct CdbExplain_ShowStatCtx *showstatctx);
 
+/*
+ * cdbexplain_gatherExecStats
+ *    Called by qDisp at the end of execution to transfer the EXPLAIN ANALYZE
+ *    statistics of all slices to the PlanState tree, unless that has
+ *    already been done.
+ */
+void
+cdbexplain_gatherExecStats(struct QueryDesc *queryDesc);
+
+/*
+ * cdbexplain_getActualRows
+ *    Called by qDisp to get the total number of rows a PlanState node
+ *    produced in all the processes that executed it.  Returns false if the
+ *    statistics of the node have not been gathered, or if some process
+ *    executed the node other than exactly once or did not run it to
+ *    end-of-stream.
+ */
+bool
+cdbexplain_getActualRows(struct PlanState *planstate, double *rows);
+
 /*
  * cdbexplain_showExecStatsBegin
  *    Called by qDisp process to create a CdbExplain_ShowStatCtx structure
@@ -821,6 +821,9 @@ extern bool 	gp_statistics_pullup_from_child_partition;
 /* Extract numdistinct from foreign key relationship */
 extern bool		gp_statistics_use_fkeys;
 
+/* Collect and use statistics on groups of columns */
+extern bool		gp_statistics_multicol;
+
 /* Analyze tools */
 extern int gp_motion_slice_noop;
 
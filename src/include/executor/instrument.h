@@ -81,6 +81,7 @@ typedef struct Instrumentation
 	const char *sortMethod;		/* CDB: Type of sort */
 	const char *sortSpaceType;	/* CDB: Sort space type (Memory / Disk) */
 	long		sortSpaceUsed;	/* CDB: Memory / Disk used by sort(KBytes) */
+	bool		eos;			/* CDB: TRUE once node returned end-of-stream */
 	struct CdbExplain_NodeSummary *cdbNodeSummary;	/* stats from all qExecs */
 } Instrumentation;
 
@@ -34,6 +34,7 @@ typedef struct NumericData *Numeric;
 typedef struct HeapTupleData *HeapTuple;
 struct PartitionNode;
 typedef struct RelationData *Relation;
+struct StdRdOptions;
 struct Value;
 typedef struct tupleDesc *TupleDesc;
 struct Query;
@@ -59,6 +60,7 @@ struct Motion;
 struct Var;
 struct Const;
 struct ArrayExpr;
+struct CardFeedbackObservation;
 
 namespace gpdb
 {
@@ -197,6 +199,9 @@ void FreeAttrStatsSlot(AttStatsSlot *sslot);
 // attribute statistics
 HeapTuple GetAttStats(Oid relid, AttrNumber attnum);
 
+// statistics on groups of columns, as pg_statistic_multicol tuples
+List *GetMultiColStats(Oid relid);
+
 // does a function exist with the given oid
 bool FunctionExists(Oid oid);
 
@@ -697,6 +702,25 @@ void MDCacheResetTransientState(void);
 // returns true if cache is in transient state
 bool MDCacheInTransientState(void);
 
+// returns the generation of the shared metadata cache tier to be used by the
+// current query, or 0 if the shared tier must not be used
+uint64 MDSharedCacheBeginQuery(void);
+
+// look up a serialized metadata object in the shared metadata cache tier
+char *MDSharedCacheLookup(uint64 generation, const char *key, Size *len);
+
+// publish a serialized metadata object in the shared metadata cache tier
+bool MDSharedCacheInsert(uint64 generation, const char *key, const char *data,
+						 Size len);
+
+// copy of the row counts observed while executing earlier plans, or NULL if
+// cardinality feedback is disabled
+CardFeedbackObservation *CardFeedbackSnapshot(int *num_observations);
+
+// memory available to the operators of the current query on each segment,
+// in KB, as granted by the resource group or statement_mem
+uint64 GetQueryMemoryKB(void);
+
 // returns true if a query cancel is requested in GPDB
 bool IsAbortRequested(void);
 
@@ -717,8 +741,14 @@ void *GPDBMemoryContextAlloc(MemoryContext context, Size size);
 
 MemoryContext GPDBAllocSetContextCreate();
 
+// create a short-lived memory context under the current memory context
+MemoryContext GPDBTempAllocSetContextCreate(const char *name);
+
 void GPDBMemoryContextDelete(MemoryContext context);
 
+// highest amount of memory held by the given memory context
+Size GPDBMemoryContextGetPeakSpace(MemoryContext context);
+
 bool IsTypeRange(Oid typid);
 
 }  //namespace gpdb
@@ -49,12 +49,20 @@ private:
 	// memory pool
 	CMemoryPool *m_mp;
 
+	// generation of the shared metadata cache tier used by this query,
+	// 0 if the shared tier is not used
+	ULLONG m_shared_cache_generation;
+
 	// private copy ctor
 	CMDProviderRelcache(const CMDProviderRelcache &);
 
+	// build the shared metadata cache key of the given mdid
+	static BOOL GetSharedCacheKey(IMDId *md_id, CHAR *key, ULONG key_len);
+
 public:
 	// ctor/dtor
-	explicit CMDProviderRelcache(CMemoryPool *mp);
+	explicit CMDProviderRelcache(CMemoryPool *mp,
+								 ULLONG shared_cache_generation = 0);
 
 	~CMDProviderRelcache()
 	{
@@ -113,6 +113,12 @@ private:
 	// number of partition selectors for each dynamic scan
 	ULongPtrArray *m_num_partition_selectors_array;
 
+	// cardinality feedback key of each plan node, indexed by plan node id
+	ULongPtrArray *m_feedback_keys_array;
+
+	// cardinality feedback key fingerprint of each plan node
+	ULongPtrArray *m_feedback_fingerprints_array;
+
 	// list of all subplan entries
 	List **m_subplan_entries_list;
 
@@ -174,6 +180,12 @@ public:
 	// return list containing number of partition selectors for every scan id
 	List *GetNumPartitionSelectorsList() const;
 
+	// return list containing the cardinality feedback key of every plan node
+	List *GetFeedbackKeysList() const;
+
+	// return list containing the feedback key fingerprint of every plan node
+	List *GetFeedbackFingerprintsList() const;
+
 	List *GetSubplanEntriesList();
 
 	// index of result relation in the rtable
@@ -192,6 +204,9 @@ public:
 	// increment the number of partition selectors for the given scan id
 	void IncrementPartitionSelectors(ULONG scan_id);
 
+	// record the cardinality feedback key of the given plan node
+	void AddFeedbackKey(ULONG plan_node_id, ULLONG feedback_key);
+
 	void AddSubplan(Plan *);
 
 	// add CTAS information
@@ -97,6 +97,12 @@ public:
 	CDXLTranslateContext(CMemoryPool *mp, BOOL is_child_agg_node,
 						 ULongToColParamMap *original);
 
+	// ctor for a context sharing the given params hashmap instead of copying
+	// it, so that all the contexts of a plan see one map
+	CDXLTranslateContext(CMemoryPool *mp, BOOL is_child_agg_node,
+						 const Query *query,
+						 ULongToColParamMap *shared_colid_to_paramid_map);
+
 	~CDXLTranslateContext();
 
 	// is parent an aggregate node
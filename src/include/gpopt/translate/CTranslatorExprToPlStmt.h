@@ -0,0 +1,200 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2026 VMware, Inc. or its affiliates.
+//
+//	@filename:
+//		CTranslatorExprToPlStmt.h
+//
+//	@doc:
+//		Class translating the physical plan found by the optimizer directly
+//		into a GPDB PlannedStmt, without building a DXL plan
+//
+//	@test:
+//
+//
+//---------------------------------------------------------------------------
+
+#ifndef GPDXL_CTranslatorExprToPlStmt_H
+#define GPDXL_CTranslatorExprToPlStmt_H
+
+extern "C" {
+#include "postgres.h"
+
+#include "nodes/plannodes.h"
+#include "utils/palloc.h"
+}
+
+#include "gpos/base.h"
+
+#include "gpopt/base/CColRef.h"
+#include "gpopt/translate/CContextDXLToPlStmt.h"
+#include "gpopt/translate/CDXLTranslateContext.h"
+#include "gpopt/translate/IPlanTranslator.h"
+#include "naucrates/dxl/CIdGenerator.h"
+
+// fwd declarations
+namespace gpopt
+{
+class CExpression;
+class CMDAccessor;
+}  // namespace gpopt
+
+struct PlannedStmt;
+struct Plan;
+struct Query;
+
+namespace gpdxl
+{
+using namespace gpopt;
+
+//---------------------------------------------------------------------------
+//	@class:
+//		CTranslatorExprToPlStmt
+//
+//	@doc:
+//		Single pass translator of physical expression trees into PlannedStmt.
+//		It supports a gather motion on top of table scans and their union
+//		alls, and produces the same plan as the translation through DXL.
+//		The translation contexts of all nodes share one params hashmap.
+//
+//---------------------------------------------------------------------------
+class CTranslatorExprToPlStmt : public IPlanTranslator
+{
+private:
+	// memory pool
+	CMemoryPool *m_mp;
+
+	// meta data accessor
+	CMDAccessor *m_md_accessor;
+
+	// memory context in which the plan is built
+	MemoryContext m_plan_cxt;
+
+	// original query
+	const Query *m_query;
+
+	// can the statement set the command tag
+	bool m_can_set_tag;
+
+	// generators of plan, motion and param ids
+	CIdGenerator m_plan_id_generator;
+	CIdGenerator m_motion_id_generator;
+	CIdGenerator m_param_id_generator;
+
+	// range table and subplans of the plan
+	List *m_table_list;
+	List *m_subplans_list;
+
+	// context of the plan
+	CContextDXLToPlStmt m_dxl_to_plstmt_context;
+
+	// params hashmap shared by the translation contexts of all nodes
+	ULongToColParamMap *m_colid_to_paramid_map;
+
+	// translated statement
+	PlannedStmt *m_planned_stmt;
+
+	// private copy ctor
+	CTranslatorExprToPlStmt(const CTranslatorExprToPlStmt &);
+
+	// check whether the given plan can be translated directly
+	static BOOL IsSupported(CExpression *pexpr, CMDNameArray *pdrgpmdname);
+
+	// check whether the given operator below the root can be translated
+	static BOOL IsSupportedChild(CExpression *pexpr);
+
+	// check whether the given column has a name ORCA could not interpret
+	static BOOL IsUnknownName(const CWStringConst *str);
+
+	// columns of the given set, ordered by the given array first
+	CColRefArray *PdrgpcrOrdered(CColRefSet *pcrs, CColRefArray *colref_array);
+
+	// columns of the given order followed by the remaining required ones
+	CColRefArray *PdrgpcrMerge(CColRefArray *pdrgpcrOrder,
+							   CColRefArray *pdrgpcrRequired);
+
+	// columns a node is remapped to, NULL if it is not remapped
+	CColRefArray *PdrgpcrRequired(CExpression *pexpr, BOOL fRemap);
+
+	// columns in the project list of the given node, before any remapping
+	CColRefArray *PdrgpcrProjList(CExpression *pexpr,
+								  CColRefArray *colref_array);
+
+	// columns in the project list of the result node remapping the given
+	// project list, NULL if no result node is needed
+	CColRefArray *PdrgpcrRemap(CColRefArray *pdrgpcrProjList,
+							   CColRefArray *pdrgpcrRequired,
+							   CColRefArray *pdrgpcrOrder);
+
+	// translate the given node, remapping its output columns if needed
+	Plan *TranslateExpr(CExpression *pexpr, CColRefArray *colref_array,
+						BOOL fRemap, CDXLTranslateContext *output_context);
+
+	// translate the given node, adding a result node on top if its project
+	// list does not have the required columns in the given order
+	Plan *TranslateExprRemapped(CExpression *pexpr, CColRefArray *colref_array,
+								CColRefArray *pdrgpcrRequired,
+								CColRefArray *pdrgpcrOrder,
+								CDXLTranslateContext *output_context);
+
+	// translate the given node with the given project list
+	Plan *TranslateNode(CExpression *pexpr, CColRefArray *colref_array,
+						CColRefArray *pdrgpcrProjList,
+						CDXLTranslateContext *output_context);
+
+	Plan *TranslateTblScan(CExpression *pexprTblScan,
+						   CColRefArray *pdrgpcrProjList,
+						   CDXLTranslateContext *output_context);
+
+	Plan *TranslateUnionAll(CExpression *pexprUnionAll,
+							CColRefArray *pdrgpcrProjList,
+							CDXLTranslateContext *output_context);
+
+	Plan *TranslateGatherMotion(CExpression *pexprMotion,
+								CColRefArray *colref_array,
+								CColRefArray *pdrgpcrProjList,
+								CDXLTranslateContext *output_context);
+
+	// translate the columns of a child into the target list of its parent
+	List *TranslateTargetListFromChild(CColRefArray *pdrgpcrProjList,
+									   const CDXLTranslateContext *child_context,
+									   CDXLTranslateContext *output_context);
+
+	// translate the costs of the given node
+	void TranslatePlanCosts(CExpression *pexpr, Plan *plan);
+
+	// round a cost the way it is rounded in a DXL plan
+	Cost CostFromDouble(DOUBLE value);
+
+	// remember the cardinality feedback key of the given node
+	void AddFeedbackKey(CExpression *pexpr, Plan *plan);
+
+	// assemble the planned statement of the given plan
+	PlannedStmt *AssemblePlannedStmt(Plan *plan);
+
+public:
+	// ctor
+	CTranslatorExprToPlStmt(CMemoryPool *mp, CMDAccessor *md_accessor,
+							MemoryContext plan_cxt, const Query *orig_query,
+							bool can_set_tag,
+							DistributionHashOpsKind distribution_hashops);
+
+	// dtor
+	virtual ~CTranslatorExprToPlStmt();
+
+	// translate the given plan in the plan memory context
+	virtual BOOL FTranslate(CExpression *pexprPlan, CColRefArray *colref_array,
+							CMDNameArray *pdrgpmdname);
+
+	// translated statement, NULL if the plan was not translated
+	PlannedStmt *
+	GetPlannedStmt() const
+	{
+		return m_planned_stmt;
+	}
+};
+}  // namespace gpdxl
+
+#endif	// !GPDXL_CTranslatorExprToPlStmt_H
+
+// EOF
@@ -193,6 +193,9 @@ private:
 											CMDAccessor *md_accessor,
 											IMDId *mdid);
 
+	// retrieve the statistics on groups of columns of a relation
+	static IMDCacheObject *RetrieveMultiColStats(CMemoryPool *mp, IMDId *mdid);
+
 	// retrieve cast object from the relcache
 	static IMDCacheObject *RetrieveCast(CMemoryPool *mp, IMDId *mdid);
 
@@ -243,6 +246,15 @@ private:
 		CMemoryPool *mp, CMDAccessor *md_accessor, Relation rel,
 		IMDRelation::Erelstoragetype rel_storage_type);
 
+	// return the average width of the column at the given position
+	static ULONG RetrieveColumnWidth(CMemoryPool *mp, Relation rel,
+									 ULONG attno_idx);
+
+	// estimate the compressed widths of the columns of a column-oriented table
+	static void EstimateCompressedColumnWidths(Relation rel,
+											   const ULONG *col_lens,
+											   DOUBLE *compressed_widths);
+
 	// return the dxl representation of the column's default value
 	static CDXLNode *GetDefaultColumnValue(CMemoryPool *mp,
 										   CMDAccessor *md_accessor,
@@ -51,6 +51,9 @@ public:
 	// return total allocated size include management overhead
 	ULLONG TotalAllocatedSize() const;
 
+	// return the highest amount of memory held by the pool
+	ULLONG PeakAllocatedSize() const;
+
 	// get user requested size of allocation
 	static ULONG UserSizeOfAlloc(const void *ptr);
 };
@@ -42,6 +42,8 @@ class CMDAccessor;
 class CQueryContext;
 class COptimizerConfig;
 class ICostModel;
+class CCostModelParamsGPDB;
+class CStatisticsConfig;
 }  // namespace gpopt
 
 struct PlannedStmt;
@@ -125,7 +127,15 @@ private:
 
 	// create optimizer configuration object
 	static COptimizerConfig *CreateOptimizerConfig(CMemoryPool *mp,
-												   ICostModel *cost_model);
+												   ICostModel *cost_model,
+												   Query *query);
+
+	// enable cardinality feedback and load the observed row counts
+	static void LoadCardinalityFeedback(CStatisticsConfig *stats_conf);
+
+	// estimate the number of memory-intensive operators in a plan for the
+	// given query
+	static ULONG EstimateMemoryIntensiveOperators(Query *query);
 
 	// optimize a query to a physical DXL
 	static void *OptimizeTask(void *ptr);
@@ -139,6 +149,10 @@ private:
 	// load search strategy from given path
 	static CSearchStageArray *LoadSearchStrategy(CMemoryPool *mp, char *path);
 
+	// load cost model parameters from given path
+	static CCostModelParamsGPDB *LoadCostModelParams(CMemoryPool *mp,
+													 char *path);
+
 	// helper for converting wide character string to regular string
 	static CHAR *CreateMultiByteCharStringFromWCString(const WCHAR *wcstr);
 
@@ -116,6 +116,16 @@ typedef struct PlannedStmt
 	 */
 	List	   *numSelectorsPerScanId;
 
+	/*
+	 * GPDB: cardinality feedback key of every plan node, as computed by ORCA.
+	 * Element #i in the list corresponds to plan node id i; 0 means the node
+	 * has no key.  NIL if the plan carries no keys.  feedbackFingerprints
+	 * holds the rest of each node's 64-bit key hash, which the feedback store
+	 * compares on lookup to tell apart expressions whose keys collide.
+	 */
+	List	   *feedbackKeys;
+	List	   *feedbackFingerprints;
+
 	List	   *rowMarks;		/* a list of PlanRowMark's */
 
 	List	   *relationOids;	/* OIDs of relations the plan depends on */
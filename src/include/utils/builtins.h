@@ -1388,6 +1388,10 @@ extern Datum enable_xform(PG_FUNCTION_ARGS);
 /* Optimizer's version */
 extern Datum gp_opt_version(PG_FUNCTION_ARGS);
 
+/* Optimizer's metadata cache statistics */
+extern Datum gp_opt_mdcache_stats(PG_FUNCTION_ARGS);
+extern Datum gp_opt_mdsharedcache_stats(PG_FUNCTION_ARGS);
+
 /* query_metrics.c */
 extern Datum gp_instrument_shmem_summary(PG_FUNCTION_ARGS);
 
@@ -0,0 +1,37 @@
+/*-------------------------------------------------------------------------
+ *
+ * cardfeedback.h
+ *	  Store of row counts observed while executing ORCA plans.
+ *
+ * Copyright (c) 2026-Present VMware, Inc. or its affiliates.
+ *
+ * src/include/utils/cardfeedback.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef CARDFEEDBACK_H
+#define CARDFEEDBACK_H
+
+#include "nodes/pg_list.h"
+
+/* one observation, as handed out by CardFeedbackSnapshot() */
+typedef struct CardFeedbackObservation
+{
+	uint32		key;			/* feedback key computed by ORCA */
+	uint32		fingerprint;	/* rest of ORCA's key hash */
+	double		rows;			/* number of rows produced */
+} CardFeedbackObservation;
+
+extern Size CardFeedbackShmemSize(void);
+extern void CardFeedbackShmemInit(void);
+
+extern void InitCardFeedback(void);
+
+extern bool CardFeedbackEnabled(void);
+extern uint64 CardFeedbackRelationMask(List *relationOids);
+extern void CardFeedbackRecord(uint32 key, uint32 fingerprint, uint64 relmask,
+				   double rows);
+extern void CardFeedbackInvalidateRelation(Oid relid);
+extern CardFeedbackObservation *CardFeedbackSnapshot(int *nobservations);
+
+#endif   /* CARDFEEDBACK_H */
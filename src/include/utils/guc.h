@@ -433,8 +433,12 @@ extern int  optimizer_log_failure;
 extern bool	optimizer_trace_fallback;
 extern int optimizer_minidump;
 extern int  optimizer_cost_model;
+extern bool optimizer_cost_memory_quota;
 extern bool optimizer_metadata_caching;
 extern int	optimizer_mdcache_size;
+extern int	optimizer_mdcache_shared_size;
+extern bool optimizer_cardinality_feedback;
+extern int	optimizer_cardinality_feedback_entries;
 
 /* Optimizer debugging GUCs */
 extern bool optimizer_print_query;
@@ -453,6 +457,7 @@ extern bool optimizer_print_xform_results;
 /* array of xforms disable flags */
 extern bool optimizer_xforms[OPTIMIZER_XFORMS_COUNT];
 extern char *optimizer_search_strategy_path;
+extern char *optimizer_cost_profile_path;
 
 /* GUCs to tell Optimizer to enable a physical operator */
 extern bool optimizer_enable_indexjoin;
@@ -482,6 +487,7 @@ extern bool optimizer_enable_dml;
 extern bool optimizer_enable_dml_triggers;
 extern bool	optimizer_enable_dml_constraints;
 extern bool optimizer_enable_direct_dispatch;
+extern bool optimizer_enable_direct_plan_translation;
 extern bool optimizer_enable_master_only_queries;
 extern bool optimizer_enable_hashjoin;
 extern bool optimizer_enable_dynamictablescan;
@@ -532,11 +538,13 @@ extern int optimizer_cte_inlining_bound;
 extern int optimizer_push_group_by_below_setop_threshold;
 extern int optimizer_xform_bind_threshold;
 extern int optimizer_skew_factor;
+extern int optimizer_max_derived_histogram_buckets;
 extern bool optimizer_force_multistage_agg;
 extern bool optimizer_force_three_stage_scalar_dqa;
 extern bool optimizer_force_expanded_distinct_aggs;
 extern bool optimizer_force_agg_skew_avoidance;
 extern bool optimizer_penalize_skew;
+extern bool optimizer_penalize_mcv_skew;
 extern bool optimizer_prune_computed_columns;
 extern bool optimizer_push_requirements_from_consumer_to_producer;
 extern bool optimizer_enforce_subplans;
@@ -0,0 +1,40 @@
+/*-------------------------------------------------------------------------
+ *
+ * mdsharedcache.h
+ *	  Shared-memory tier of the ORCA metadata cache.
+ *
+ * Copyright (c) 2026-Present VMware, Inc. or its affiliates.
+ *
+ * src/include/utils/mdsharedcache.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef MDSHAREDCACHE_H
+#define MDSHAREDCACHE_H
+
+/* maximum length of a serialized metadata id used as a lookup key */
+#define MDSHAREDCACHE_KEYLEN	64
+
+typedef struct MDSharedCacheStats
+{
+	uint64		entries;		/* objects currently stored */
+	uint64		bytes;			/* arena space used by them */
+	uint64		hits;			/* lookups that found a usable entry */
+	uint64		misses;			/* lookups that did not */
+	uint64		resets;			/* times the arena was emptied */
+} MDSharedCacheStats;
+
+extern Size MDSharedCacheShmemSize(void);
+extern void MDSharedCacheShmemInit(void);
+
+extern bool MDSharedCacheEnabled(void);
+extern uint64 MDSharedCacheBeginQuery(void);
+extern void MDSharedCacheInvalidate(void);
+
+extern char *MDSharedCacheLookup(uint64 generation, const char *key, Size *len);
+extern bool MDSharedCacheInsert(uint64 generation, const char *key,
+								const char *data, Size len);
+
+extern bool MDSharedCacheGetStats(MDSharedCacheStats *stats);
+
+#endif   /* MDSHAREDCACHE_H */
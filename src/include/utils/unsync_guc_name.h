@@ -271,6 +271,7 @@
 		"gp_set_proc_affinity",
 		"gp_sort_flags",
 		"gp_sort_max_distinct",
+		"gp_statistics_multicol",
 		"gp_statistics_pullup_from_child_partition",
 		"gp_statistics_use_fkeys",
 		"gp_subtrans_warn_limit",
@@ -353,8 +354,12 @@
 		"optimizer_apply_left_outer_to_union_all_disregarding_stats",
 		"optimizer_array_constraints",
 		"optimizer_array_expansion_threshold",
+		"optimizer_cardinality_feedback",
+		"optimizer_cardinality_feedback_entries",
 		"optimizer_control",
+		"optimizer_cost_memory_quota",
 		"optimizer_cost_model",
+		"optimizer_cost_profile_path",
 		"optimizer_cost_threshold",
 		"optimizer_cte_inlining",
 		"optimizer_damping_factor_filter",
@@ -369,6 +374,7 @@
 		"optimizer_enable_ctas",
 		"optimizer_enable_derive_stats_all_groups",
 		"optimizer_enable_direct_dispatch",
+		"optimizer_enable_direct_plan_translation",
 		"optimizer_enable_dml",
 		"optimizer_enable_dml_constraints",
 		"optimizer_enable_dml_triggers",
@@ -421,12 +427,15 @@
 		"optimizer_join_order_threshold",
 		"optimizer_log",
 		"optimizer_log_failure",
+		"optimizer_max_derived_histogram_buckets",
+		"optimizer_mdcache_shared_size",
 		"optimizer_metadata_caching",
 		"optimizer_minidump",
 		"optimizer_multilevel_partitioning",
 		"optimizer_nestloop_factor",
 		"optimizer_parallel_union",
 		"optimizer_penalize_broadcast_threshold",
+		"optimizer_penalize_mcv_skew",
 		"optimizer_penalize_skew",
 		"optimizer_print_expression_properties",
 		"optimizer_print_group_properties",
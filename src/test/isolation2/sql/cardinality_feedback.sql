@@ -0,0 +1,61 @@
+-- With optimizer_cardinality_feedback on, the row counts of the plan nodes
+-- of completed queries are recorded on the coordinator, and GPORCA uses them
+-- instead of its estimates when it optimizes the same expressions again.
+
+-- start_ignore
+! gpconfig -c optimizer_cardinality_feedback_entries -v 4096;
+! gpstop -rai;
+-- end_ignore
+
+set optimizer = on;
+create table cardfb (a int, b int) distributed by (a);
+insert into cardfb select i % 1000, i % 1000 from generate_series(1, 10000) i;
+analyze cardfb;
+
+-- estimated number of rows of the top plan node of a query
+create function cardfb_rows(query text) returns int as $$ declare ln text; begin for ln in execute 'explain ' || query loop if ln ~ 'rows=' then return substring(ln from 'rows=(\d+)')::int; end if; end loop; return null; end; $$ language plpgsql;
+
+set optimizer_cardinality_feedback = on;
+
+-- 1000 rows match an expression GPORCA estimates with a default selectivity
+select cardfb_rows('select * from cardfb where a + b < 200') = 1000 as feedback_applied;
+
+-- a query stopped by a LIMIT does not record the rows of its scan
+select count(*) from (select * from cardfb where a + b < 200 limit 1) s;
+select cardfb_rows('select * from cardfb where a + b < 200') = 1000 as feedback_applied;
+
+-- a completed query does
+select count(*) from cardfb where a + b < 200;
+select cardfb_rows('select * from cardfb where a + b < 200') = 1000 as feedback_applied;
+
+-- ANALYZE expires the recorded row counts of the table
+analyze cardfb;
+select cardfb_rows('select * from cardfb where a + b < 200') = 1000 as feedback_applied;
+
+-- and so does DDL
+select count(*) from cardfb where a + b < 200;
+select cardfb_rows('select * from cardfb where a + b < 200') = 1000 as feedback_applied;
+alter table cardfb add column c int;
+select cardfb_rows('select * from cardfb where a + b < 200') = 1000 as feedback_applied;
+
+-- and TRUNCATE
+select count(*) from cardfb where a + b < 200;
+select cardfb_rows('select * from cardfb where a + b < 200') = 1000 as feedback_applied;
+truncate cardfb;
+select cardfb_rows('select * from cardfb where a + b < 200') = 1000 as feedback_applied;
+
+-- nothing is recorded with the parameter off
+reset optimizer_cardinality_feedback;
+insert into cardfb select i % 1000, i % 1000 from generate_series(1, 10000) i;
+analyze cardfb;
+select count(*) from cardfb where a + b < 200;
+set optimizer_cardinality_feedback = on;
+select cardfb_rows('select * from cardfb where a + b < 200') = 1000 as feedback_applied;
+
+drop function cardfb_rows(text);
+drop table cardfb;
+
+-- start_ignore
+! gpconfig -r optimizer_cardinality_feedback_entries;
+! gpstop -rai;
+-- end_ignore
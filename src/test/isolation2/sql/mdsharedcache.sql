@@ -0,0 +1,46 @@
+-- The shared tier of the optimizer metadata cache lets a session reuse the
+-- metadata another session translated, unless the session settings that
+-- change the translated metadata differ.
+
+-- start_ignore
+! gpconfig -c optimizer_mdcache_shared_size -v 8MB;
+! gpstop -rai;
+-- end_ignore
+
+set optimizer = off;
+create table mdsharedcache_t (a int, b int) distributed by (a);
+create table mdsharedcache_stats (step text, hits int8, misses int8) distributed randomly;
+
+select enabled from gp_opt_mdsharedcache_stats();
+
+-- the first session translates the metadata and shares it
+1: set optimizer = on;
+1: select count(*) from mdsharedcache_t;
+insert into mdsharedcache_stats select 'first', hits, misses from gp_opt_mdsharedcache_stats();
+select entries > 0 as shared, bytes > 0 as stored from gp_opt_mdsharedcache_stats();
+
+-- the second session finds it in the shared tier
+2: set optimizer = on;
+2: select count(*) from mdsharedcache_t;
+insert into mdsharedcache_stats select 'second', hits, misses from gp_opt_mdsharedcache_stats();
+
+-- the third session translates the partitioning differently, and must not
+-- pick up what the others stored
+3: set optimizer = on;
+3: set optimizer_multilevel_partitioning = off;
+3: select count(*) from mdsharedcache_t;
+insert into mdsharedcache_stats select 'third', hits, misses from gp_opt_mdsharedcache_stats();
+
+select s.hits > f.hits as hit from mdsharedcache_stats f, mdsharedcache_stats s where f.step = 'first' and s.step = 'second';
+select t.hits = s.hits as hit, t.misses > s.misses as missed from mdsharedcache_stats s, mdsharedcache_stats t where s.step = 'second' and t.step = 'third';
+
+1q:
+2q:
+3q:
+drop table mdsharedcache_t;
+drop table mdsharedcache_stats;
+
+-- start_ignore
+! gpconfig -r optimizer_mdcache_shared_size;
+! gpstop -rai;
+-- end_ignore
@@ -506,3 +506,30 @@ select relhassubclass from gp_dist_random('pg_class') where relname = 'test_tb_1
 ANALYZE;
 select relhassubclass from pg_class where relname = 'test_tb_14644';
 select relhassubclass from gp_dist_random('pg_class') where relname = 'test_tb_14644';
+
+-- Statistics on groups of columns: the key columns of multi-column indexes
+-- and the distribution key. c is determined by b, b is not determined by a.
+create table analyze_multicol (a int, b int, c int) distributed by (a, b);
+create index analyze_multicol_b_c on analyze_multicol (b, c);
+insert into analyze_multicol select i % 20, i % 40, (i % 40) / 2 from generate_series(1, 1000) i;
+analyze analyze_multicol;
+select 'analyze_multicol'::regclass::oid as analyze_multicol_oid \gset
+select stakeys, standistinct, stadependency from pg_statistic_multicol
+  where starelid = :analyze_multicol_oid order by stakeys::text;
+-- a column list does not remove the groups it does not cover
+analyze analyze_multicol(a);
+select count(*) from pg_statistic_multicol where starelid = :analyze_multicol_oid;
+-- dropping a column removes the groups that contain it
+alter table analyze_multicol drop column c;
+select stakeys, standistinct, stadependency from pg_statistic_multicol
+  where starelid = :analyze_multicol_oid order by stakeys::text;
+drop table analyze_multicol;
+select count(*) from pg_statistic_multicol where starelid = :analyze_multicol_oid;
+-- nothing is collected with gp_statistics_multicol off
+create table analyze_multicol_off (a int, b int) distributed by (a, b);
+insert into analyze_multicol_off select i % 20, i % 40 from generate_series(1, 1000) i;
+set gp_statistics_multicol = off;
+analyze analyze_multicol_off;
+reset gp_statistics_multicol;
+select count(*) from pg_statistic_multicol where starelid = 'analyze_multicol_off'::regclass;
+drop table analyze_multicol_off;
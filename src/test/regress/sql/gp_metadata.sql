@@ -1,2 +1,14 @@
 select version() ~ '^PostgreSQL ([0-9]+\.)([0-9]+)(\.[0-9]+)?(devel)?(beta[0-9])? \(Greenplum Database ([0-9]+\.){2}[0-9]+.+' as version;
 select gp_opt_version() ~ '^(GPOPT version: 4.0.0, Xerces version: ([0-9]+\.){2}[0-9]+|Server has been compiled without ORCA)$' as version;
+-- one row per type of metadata object, none without ORCA
+select count(*) = case when gp_opt_version() = 'Server has been compiled without ORCA' then 0 else 13 end as count from gp_opt_mdcache_stats();
+-- when ORCA plans the queries, it inserts the metadata of a new table into
+-- the cache, then hits it
+create table mdcache_stats_t (a int, b int) distributed by (a);
+select coalesce(sum(hits), 0) as hits_before, coalesce(sum(inserts), 0) as inserts_before from gp_opt_mdcache_stats() \gset
+select count(*) from mdcache_stats_t;
+select count(*) from mdcache_stats_t;
+select current_setting('optimizer') = 'off' or (sum(inserts) > :inserts_before and sum(hits) > :hits_before) as inserted_and_hit from gp_opt_mdcache_stats();
+drop table mdcache_stats_t;
+-- the shared tier is disabled by default
+select * from gp_opt_mdsharedcache_stats();
@@ -3612,6 +3612,57 @@ DROP TABLE d, r;
 
 reset optimizer_trace_fallback;
 
+-- Plans translated directly into a PlannedStmt, without DXL, are the same
+-- as the plans translated through DXL, and return the same rows
+create table direct_plan_t1 (a int, b text, c numeric) distributed by (a);
+create table direct_plan_t2 (c numeric, a int, b text) distributed randomly;
+create table direct_plan_t3 (a int, d int, b text) distributed by (b);
+alter table direct_plan_t3 drop column d;
+insert into direct_plan_t1 select i, 'one ' || i, i / 3.0 from generate_series(1, 100) i;
+insert into direct_plan_t2 select i / 7.0, i, 'two ' || i from generate_series(1, 50) i;
+insert into direct_plan_t3 select i, 'three ' || i from generate_series(1, 30) i;
+analyze direct_plan_t1;
+analyze direct_plan_t2;
+analyze direct_plan_t3;
+
+create function direct_plan_matches(query text) returns boolean as $$
+declare
+	r record;
+	dxl_plan text := '';
+	direct_plan text := '';
+	dxl_rows text;
+	direct_rows text;
+begin
+	perform set_config('optimizer_enable_direct_plan_translation', 'off', false);
+	for r in execute 'explain verbose ' || query loop
+		dxl_plan := dxl_plan || r."QUERY PLAN" || E'\n';
+	end loop;
+	execute 'select md5(string_agg(q::text, '','' order by q::text)) from ('
+		|| query || ') q' into dxl_rows;
+
+	perform set_config('optimizer_enable_direct_plan_translation', 'on', false);
+	for r in execute 'explain verbose ' || query loop
+		direct_plan := direct_plan || r."QUERY PLAN" || E'\n';
+	end loop;
+	execute 'select md5(string_agg(q::text, '','' order by q::text)) from ('
+		|| query || ') q' into direct_rows;
+
+	perform set_config('optimizer_enable_direct_plan_translation', 'off', false);
+	return dxl_plan = direct_plan and dxl_rows = direct_rows;
+end;
+$$ language plpgsql;
+
+select direct_plan_matches('select * from direct_plan_t1');
+select direct_plan_matches('select b, a from direct_plan_t3');
+select direct_plan_matches('select a, a from direct_plan_t2');
+select direct_plan_matches('select a, b from direct_plan_t1 union all select a, b from direct_plan_t2 union all select a, b from direct_plan_t3');
+select direct_plan_matches('select c, b from direct_plan_t1 union all select c, b from direct_plan_t2');
+-- filtered scans are translated through DXL
+select direct_plan_matches('select * from direct_plan_t1 where a = 1');
+
+drop function direct_plan_matches(text);
+drop table direct_plan_t1, direct_plan_t2, direct_plan_t3;
+
 -- start_ignore
 DROP SCHEMA orca CASCADE;
 -- end_ignore